@@ -390,8 +390,32 @@ namespace bgfx
 		};
 	};
 
+	/// Frame phase timed in `Stats::phaseStats`.
+	///
+	/// @attention C99 equivalent is `bgfx_phase_t`.
+	///
+	struct Phase
+	{
+		/// Phases:
+		enum Enum
+		{
+			EncoderApiWait,   //!< API thread waiting for encoders to end.
+			FreeAllHandles,   //!< API thread releasing handles destroyed during frame.
+			ExecCommandsPre,  //!< Render thread executing resource commands before submit.
+			Sort,             //!< Sorting draw calls.
+			Submit,           //!< Renderer backend submit, sort and uniform commit included.
+			UniformCommit,    //!< Renderer backend committing uniforms.
+			ExecCommandsPost, //!< Render thread executing resource commands after submit.
+			TextureUpdate,    //!< Render thread updating textures, included in resource commands and submit.
+			Flip,             //!< Presenting back buffer.
+
+			Count
+		};
+	};
+
 	static const uint16_t kInvalidHandle = UINT16_MAX;
 
+	BGFX_HANDLE(DrawBundleHandle)
 	BGFX_HANDLE(DynamicIndexBufferHandle)
 	BGFX_HANDLE(DynamicVertexBufferHandle)
 	BGFX_HANDLE(FrameBufferHandle)
@@ -670,8 +694,13 @@ namespace bgfx
 		struct Limits
 		{
 			uint16_t maxEncoders;     //!< Maximum number of encoder threads.
+			uint16_t maxSortThreads;  //!< Number of helper threads used to sort draw calls. 0 disables parallel sort.
+			uint16_t maxTextureDecodeThreads; //!< Number of worker threads decoding `BGFX_TEXTURE_ASYNC` textures.
+			uint16_t statsWindow;     //!< Number of frames `Stats::phaseStats` are computed over.
+			uint32_t maxDrawCalls;    //!< Maximum number of draw calls per frame.
 			uint32_t transientVbSize; //!< Maximum transient vertex buffer size.
 			uint32_t transientIbSize; //!< Maximum transient index buffer size.
+			uint64_t textureMemoryBudget; //!< Texture memory budget in bytes kept by dropping mips of `BGFX_TEXTURE_STREAMING` textures. 0 disables streaming.
 		};
 
 		Limits limits;
@@ -925,6 +954,20 @@ namespace bgfx
 		int64_t cpuTimeEnd;   //!< Encoder thread CPU submit end time.
 	};
 
+	/// Phase timing, in nanoseconds, over last `Init::Limits::statsWindow`
+	/// frames.
+	///
+	/// @attention C99 equivalent is `bgfx_phase_stats_t`.
+	///
+	struct PhaseStats
+	{
+		int64_t last; //!< Time spent in the last frame.
+		int64_t min;  //!< Minimum time.
+		int64_t avg;  //!< Average time.
+		int64_t max;  //!< Maximum time.
+		int64_t p99;  //!< 99th percentile time.
+	};
+
 	/// Renderer statistics data.
 	///
 	/// @attention C99 equivalent is `bgfx_stats_t`.
@@ -967,6 +1010,26 @@ namespace bgfx
 		int64_t rtMemoryUsed;               //!< Estimate of render target memory used.
 		int32_t transientVbUsed;            //!< Amount of transient vertex buffer used.
 		int32_t transientIbUsed;            //!< Amount of transient index buffer used.
+		int32_t transientVbWasted;          //!< Amount of transient vertex buffer left unused in encoder chunks.
+		int32_t transientIbWasted;          //!< Amount of transient index buffer left unused in encoder chunks.
+
+		uint32_t cmdBufferUsed;             //!< Resource command buffer data used by frame, in bytes.
+		uint32_t cmdBufferHighWater;        //!< Highest resource command buffer usage of any frame, in bytes.
+		uint32_t cmdBufferCapacity;         //!< Memory reserved for frame resource command buffers, in bytes.
+
+		uint32_t uniformDataWritten;        //!< Uniform data written by encoders, in bytes.
+		uint32_t uniformDataSkipped;        //!< Uniform data encoders referenced instead of writing repeated value.
+		uint32_t uniformDataUpdated;        //!< Uniform data that changed value in renderer backend.
+		uint32_t uniformDataRedundant;      //!< Uniform data renderer backend skipped as already set.
+
+		uint32_t numTextureUpdates;         //!< Number of texture updates submitted.
+		uint32_t numTextureUploads;         //!< Number of texture uploads after merging adjacent updates.
+		uint32_t textureUploadSize;         //!< Texture data uploaded after merging adjacent updates, in bytes.
+
+		uint32_t numMemoryAllocs;           //!< Number of `bgfx::alloc`/`bgfx::copy` calls during frame.
+		uint32_t numMemoryAllocsPooled;     //!< Number of `bgfx::alloc`/`bgfx::copy` calls served from frame memory pool.
+		uint32_t memoryAllocSize;           //!< Memory requested by `bgfx::alloc`/`bgfx::copy` during frame, in bytes.
+		uint32_t memoryPoolSize;            //!< Memory reserved by frame memory pool, in bytes.
 
 		uint32_t numPrims[Topology::Count]; //!< Number of primitives rendered.
 
@@ -983,6 +1046,9 @@ namespace bgfx
 
 		uint8_t       numEncoders;          //!< Number of encoders used during frame.
 		EncoderStats* encoderStats;         //!< Array of encoder stats.
+
+		uint16_t   numPhaseFrames;          //!< Number of frames phase stats are computed over.
+		PhaseStats phaseStats[Phase::Count]; //!< Per-phase timing, see `Phase::Enum`.
 	};
 
 	/// Encoders are used for submitting draw calls from multiple threads. Only one encoder
@@ -1141,6 +1207,92 @@ namespace bgfx
 			, uint16_t _num = 1
 			);
 
+		/// Returns number of requested or maximum available indices.
+		///
+		/// @param[in] _num Number of required indices.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_get_avail_transient_index_buffer`.
+		///
+		uint32_t getAvailTransientIndexBuffer(uint32_t _num);
+
+		/// Returns number of requested or maximum available vertices.
+		///
+		/// @param[in] _num Number of required vertices.
+		/// @param[in] _decl Vertex declaration.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_get_avail_transient_vertex_buffer`.
+		///
+		uint32_t getAvailTransientVertexBuffer(
+			  uint32_t _num
+			, const VertexDecl& _decl
+			);
+
+		/// Returns number of requested or maximum available instance buffer slots.
+		///
+		/// @param[in] _num Number of required instances.
+		/// @param[in] _stride Stride per instance.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_get_avail_instance_data_buffer`.
+		///
+		uint32_t getAvailInstanceDataBuffer(
+			  uint32_t _num
+			, uint16_t _stride
+			);
+
+		/// Allocate transient index buffer from encoder's chunk of frame
+		/// transient index buffer.
+		///
+		/// @param[out] _tib TransientIndexBuffer structure is filled and is valid
+		///   for the duration of frame, and it can be reused for multiple draw
+		///   calls.
+		/// @param[in] _num Number of indices to allocate.
+		///
+		/// @remarks
+		///   Encoder reserves `BGFX_CONFIG_TRANSIENT_CHUNK_SIZE` bytes at once
+		///   and sub-allocates from it without taking any lock. Unused part of
+		///   the chunk is reported in `Stats::transientIbWasted`.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_transient_index_buffer`.
+		///
+		void allocTransientIndexBuffer(
+			  TransientIndexBuffer* _tib
+			, uint32_t _num
+			);
+
+		/// Allocate transient vertex buffer from encoder's chunk of frame
+		/// transient vertex buffer.
+		///
+		/// @param[out] _tvb TransientVertexBuffer structure is filled and is valid
+		///   for the duration of frame, and it can be reused for multiple draw
+		///   calls.
+		/// @param[in] _num Number of vertices to allocate.
+		/// @param[in] _decl Vertex declaration.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_transient_vertex_buffer`.
+		///
+		void allocTransientVertexBuffer(
+			  TransientVertexBuffer* _tvb
+			, uint32_t _num
+			, const VertexDecl& _decl
+			);
+
+		/// Allocate instance data buffer from encoder's chunk of frame
+		/// transient vertex buffer.
+		///
+		/// @param[out] _idb InstanceDataBuffer structure is filled and is valid
+		///   for duration of frame, and it can be reused for multiple draw
+		///   calls.
+		/// @param[in] _num Number of instances.
+		/// @param[in] _stride Instance stride. Must be multiple of 16.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_alloc_instance_data_buffer`.
+		///
+		void allocInstanceDataBuffer(
+			  InstanceDataBuffer* _idb
+			, uint32_t _num
+			, uint16_t _stride
+			);
+
 		/// Set index buffer for draw primitive.
 		///
 		/// @param[in] _handle Index buffer.
@@ -1460,6 +1612,81 @@ namespace bgfx
 			, bool _preserveState = false
 			);
 
+		/// Submit batch of primitives for rendering. Per draw properties are
+		/// passed as arrays of `_num` elements.
+		///
+		/// @param[in] _id View id.
+		/// @param[in] _num Number of draw calls in batch.
+		/// @param[in] _program Program for each draw call.
+		/// @param[in] _transform Matrix cache index for each draw call, see
+		///   `allocTransform`. If NULL, transform set on encoder is used.
+		/// @param[in] _vertexBuffer Vertex buffer for each draw call. Whole
+		///   vertex buffer is used as stream 0.
+		/// @param[in] _indexBuffer Index buffer for each draw call. If NULL,
+		///   draw calls are not indexed.
+		/// @param[in] _state Render state for each draw call. If NULL, state
+		///   set on encoder is used.
+		/// @param[in] _depth Depth for sorting for each draw call. If NULL,
+		///   depth is 0.
+		///
+		/// @remarks
+		///   Uniforms, textures, stencil and scissor set on encoder before
+		///   this call are shared by all draw calls in batch. Draw state is
+		///   cleared after submit. Draw calls without vertex buffer and
+		///   index buffer have nothing to draw, and are discarded.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_submit_batch`.
+		///
+		void submitBatch(
+			  ViewId _id
+			, uint32_t _num
+			, const ProgramHandle* _program
+			, const uint32_t* _transform
+			, const VertexBufferHandle* _vertexBuffer
+			, const IndexBufferHandle* _indexBuffer
+			, const uint64_t* _state
+			, const uint32_t* _depth = NULL
+			);
+
+		/// Start recording draw calls into draw bundle. Until `endDrawBundle`
+		/// is called, draw calls submitted with this encoder are stored in
+		/// draw bundle instead of current frame.
+		///
+		/// @param[in] _handle Draw bundle handle. Previous content of draw
+		///   bundle is discarded.
+		///
+		/// @remarks
+		///   - View id passed to `submit` while recording is ignored, view is
+		///     specified when draw bundle is submitted.
+		///   - Draw state that is not submitted yet is discarded when recording
+		///     starts and ends.
+		///   - Transient buffers and transient transform memory are valid only
+		///     for one frame, and must not be used in draw bundle.
+		///   - Occlusion queries, compute dispatches, and blits can't be
+		///     recorded.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_begin_draw_bundle`.
+		///
+		void beginDrawBundle(DrawBundleHandle _handle);
+
+		/// End recording draw calls into draw bundle.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_end_draw_bundle`.
+		///
+		void endDrawBundle();
+
+		/// Submit all draw calls recorded in draw bundle.
+		///
+		/// @param[in] _id View id.
+		/// @param[in] _handle Draw bundle handle.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_submit_draw_bundle`.
+		///
+		void submit(
+			  ViewId _id
+			, DrawBundleHandle _handle
+			);
+
 		/// Set compute index buffer.
 		///
 		/// @param[in] _stage Compute stage.
@@ -1932,6 +2159,9 @@ namespace bgfx
 	///     occurs. Default behavior is that flip occurs before rendering new
 	///     frame. This flag only has effect when `BGFX_CONFIG_MULTITHREADED=0`.
 	///   - `BGFX_RESET_SRGB_BACKBUFFER` - Enable sRGB backbuffer.
+	///   - `BGFX_RESET_SYNC_READ_BACK` - Read back textures and screen shots
+	///     in the frame they are requested, instead of after renderer read
+	///     back latency. This stalls rendering until GPU is done.
 	/// @param[in] _format Texture format. See: `TextureFormat::Enum`.
 	///
 	/// @attention This call doesn't actually change window size, it just
@@ -2624,6 +2854,21 @@ namespace bgfx
 	/// @param[out] _info When non-`NULL` is specified it returns parsed texture information.
 	/// @returns Texture handle.
 	///
+	/// @remarks
+	///   With `BGFX_TEXTURE_ASYNC` flag, mip extraction and conversion of formats
+	///   not supported by renderer are done on worker thread, and texture is
+	///   created in one of following frames. Until then, 2D texture samples
+	///   internal fallback texture, and other texture types are not bound.
+	///   Pending texture can't be updated or read back.
+	///
+	///   With `BGFX_TEXTURE_STREAMING` flag, and non-zero
+	///   `Init::Limits::textureMemoryBudget`, texture memory is kept until
+	///   texture is destroyed. Top mips of textures that weren't used recently
+	///   are dropped while texture memory is over budget, and uploaded again
+	///   once texture is used and budget allows it. `_skip` is the lowest number
+	///   of mips skipped. Streamed texture can't be updated or read back, and
+	///   can't be combined with `BGFX_TEXTURE_ASYNC`.
+	///
 	/// @attention C99 equivalent is `bgfx_create_texture`.
 	///
 	TextureHandle createTexture(
@@ -2763,6 +3008,9 @@ namespace bgfx
 	///
 	/// @attention It's valid to update only mutable texture. See `bgfx::createTexture2D` for more info.
 	///
+	/// @remarks Updates of `BGFX_TEXTURE_ATLAS` texture submitted in the same frame can be
+	///   uploaded as one region, texels of that region not written by any update are cleared.
+	///
 	/// @attention C99 equivalent is `bgfx_update_texture_2d`.
 	///
 	void updateTexture2D(
@@ -3144,6 +3392,23 @@ namespace bgfx
 	///
 	void destroy(OcclusionQueryHandle _handle);
 
+	/// Create draw bundle. Draw bundle stores draw calls recorded once, and
+	/// can be submitted every frame without rebuilding their draw state.
+	///
+	/// @returns Handle to draw bundle object.
+	///
+	/// @attention C99 equivalent is `bgfx_create_draw_bundle`.
+	///
+	DrawBundleHandle createDrawBundle();
+
+	/// Destroy draw bundle.
+	///
+	/// @param[in] _handle Handle to draw bundle object.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_draw_bundle`.
+	///
+	void destroy(DrawBundleHandle _handle);
+
 	/// Set palette color value.
 	///
 	/// @param[in] _index Index into palette.
@@ -3329,6 +3594,32 @@ namespace bgfx
 		, ViewMode::Enum _mode = ViewMode::Default
 		);
 
+	/// Enable automatic instancing for view. After sorting, consecutive
+	/// draw calls in view that differ only by model transform are merged
+	/// into single instanced draw call, with model matrices passed as
+	/// instance data.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _enabled Enable automatic instancing.
+	///
+	/// @remarks
+	///   Only draw calls with single transform, without instance data,
+	///   indirect buffer, or occlusion query are merged. Draw calls that
+	///   can't be merged get their first transform as instance data, so
+	///   vertex shaders used in view must read model matrix from
+	///   `i_data0`-`i_data3` (see `BGFX_AUTO_INSTANCE_MODEL` in
+	///   `bgfx_shader.sh`). Draw calls with their own instance data buffer
+	///   keep it, and it must start with model matrix. Draw calls whose
+	///   transform doesn't fit into transient vertex buffer are dropped.
+	///   Requires `BGFX_CAPS_INSTANCING`.
+	///
+	/// @attention C99 equivalent is `bgfx_set_view_auto_instancing`.
+	///
+	void setViewAutoInstancing(
+		  ViewId _id
+		, bool _enabled
+		);
+
 	/// Set view frame buffer.
 	///
 	/// @param[in] _id View id.
@@ -3849,6 +4140,67 @@ namespace bgfx
 		, bool _preserveState = false
 		);
 
+	/// Submit batch of primitives for rendering.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _num Number of draw calls in batch.
+	/// @param[in] _program Program for each draw call.
+	/// @param[in] _transform Matrix cache index for each draw call. If NULL,
+	///   transform set with `setTransform` is used.
+	/// @param[in] _vertexBuffer Vertex buffer for each draw call.
+	/// @param[in] _indexBuffer Index buffer for each draw call. If NULL,
+	///   draw calls are not indexed.
+	/// @param[in] _state Render state for each draw call. If NULL, state set
+	///   with `setState` is used.
+	/// @param[in] _depth Depth for sorting for each draw call. If NULL,
+	///   depth is 0.
+	///
+	/// @remarks
+	///   See `Encoder::submitBatch`.
+	///
+	/// @attention C99 equivalent is `bgfx_submit_batch`.
+	///
+	void submitBatch(
+		  ViewId _id
+		, uint32_t _num
+		, const ProgramHandle* _program
+		, const uint32_t* _transform
+		, const VertexBufferHandle* _vertexBuffer
+		, const IndexBufferHandle* _indexBuffer
+		, const uint64_t* _state
+		, const uint32_t* _depth = NULL
+		);
+
+	/// Start recording draw calls into draw bundle.
+	///
+	/// @param[in] _handle Draw bundle handle. Previous content of draw
+	///   bundle is discarded.
+	///
+	/// @remarks
+	///   See `Encoder::beginDrawBundle` for restrictions while recording.
+	///
+	/// @attention C99 equivalent is `bgfx_begin_draw_bundle`.
+	///
+	void beginDrawBundle(DrawBundleHandle _handle);
+
+	/// End recording draw calls into draw bundle.
+	///
+	/// @attention C99 equivalent is `bgfx_end_draw_bundle`.
+	///
+	void endDrawBundle();
+
+	/// Submit all draw calls recorded in draw bundle.
+	///
+	/// @param[in] _id View id.
+	/// @param[in] _handle Draw bundle handle.
+	///
+	/// @attention C99 equivalent is `bgfx_submit_draw_bundle`.
+	///
+	void submit(
+		  ViewId _id
+		, DrawBundleHandle _handle
+		);
+
 	/// Set compute index buffer.
 	///
 	/// @param[in] _stage Compute stage.
@@ -4067,6 +4419,85 @@ namespace bgfx
 		, const char* _filePath
 		);
 
+	/// Begin capturing frames into trace file. Every following `bgfx::frame`
+	/// writes frame, as it's handed to renderer, into trace.
+	///
+	/// @param[in] _filePath Trace file path.
+	///
+	/// @returns True if trace file is opened.
+	///
+	/// @remarks
+	///   Resources created before capture began are not part of trace. For
+	///   trace to be replayed with renderer other than noop, capture must
+	///   begin before any resource is created. Screen shots, texture reads
+	///   and window frame buffers are not captured.
+	///
+	/// @attention Trace can be replayed only by the same bgfx version built
+	///   with the same configuration.
+	/// @attention C99 equivalent is `bgfx_frame_trace_begin`.
+	///
+	bool frameTraceBegin(const char* _filePath);
+
+	/// End capturing frames. Capture is ended on shutdown too.
+	///
+	/// @attention C99 equivalent is `bgfx_frame_trace_end`.
+	///
+	void frameTraceEnd();
+
+	/// Replay frames from trace file. Every following `bgfx::frame` submits
+	/// next frame from trace, replacing draw calls submitted by API, until
+	/// trace ends.
+	///
+	/// @param[in] _filePath Trace file path, captured with `bgfx::frameTraceBegin`.
+	///
+	/// @returns Number of frames in trace, or 0 if trace can't be replayed.
+	///
+	/// @remarks
+	///   bgfx must be initialized with resolution and limits trace was
+	///   captured with, see `bgfx::FrameTraceHeader` in `src/frame_trace.h`.
+	///   Application must not create resources while replaying.
+	///
+	/// @attention C99 equivalent is `bgfx_frame_trace_replay`.
+	///
+	uint32_t frameTraceReplay(const char* _filePath);
+
+	/// Begin recording bgfx internal profiler scopes from all threads, and
+	/// writing them as Chrome trace event JSON, viewable with
+	/// `chrome://tracing` or Perfetto UI.
+	///
+	/// @param[in] _filePath Trace file path prefix. Each dump writes scopes
+	///   recorded since previous dump into `<_filePath>-<frame>.json`, and
+	///   the last one into `<_filePath>-end.json`.
+	/// @param[in] _dumpInterval Dump every `_dumpInterval` frames. When 0,
+	///   trace is dumped only by `bgfx::profilerTraceDump` and
+	///   `bgfx::profilerTraceEnd`.
+	///
+	/// @returns True if recording began. bgfx must be built with
+	///   `BGFX_CONFIG_PROFILER`.
+	///
+	/// @remarks
+	///   Scopes are recorded into per-thread ring buffer, dump contains at
+	///   most `BGFX_CONFIG_PROFILER_TRACE_EVENTS` latest scope events of
+	///   each thread.
+	///
+	/// @attention C99 equivalent is `bgfx_profiler_trace_begin`.
+	///
+	bool profilerTraceBegin(const char* _filePath, uint32_t _dumpInterval = 0);
+
+	/// Dump profiler scopes recorded since previous dump on next
+	/// `bgfx::frame`.
+	///
+	/// @attention C99 equivalent is `bgfx_profiler_trace_dump`.
+	///
+	void profilerTraceDump();
+
+	/// End recording profiler scopes, and dump remaining ones. Recording is
+	/// ended on shutdown too.
+	///
+	/// @attention C99 equivalent is `bgfx_profiler_trace_end`.
+	///
+	void profilerTraceEnd();
+
 } // namespace bgfx
 
 #endif // BGFX_H_HEADER_GUARD
@@ -377,6 +377,26 @@ typedef enum bgfx_view_mode
 
 } bgfx_view_mode_t;
 
+/**
+ * Frame phase timed in `Stats::phaseStats`.
+ *
+ */
+typedef enum bgfx_phase
+{
+    BGFX_PHASE_ENCODER_API_WAIT,              /** ( 0) API thread waiting for encoders to end. */
+    BGFX_PHASE_FREE_ALL_HANDLES,              /** ( 1) API thread releasing handles destroyed during frame. */
+    BGFX_PHASE_EXEC_COMMANDS_PRE,             /** ( 2) Render thread executing resource commands before submit. */
+    BGFX_PHASE_SORT,                          /** ( 3) Sorting draw calls.            */
+    BGFX_PHASE_SUBMIT,                        /** ( 4) Renderer backend submit, sort and uniform commit included. */
+    BGFX_PHASE_UNIFORM_COMMIT,                /** ( 5) Renderer backend committing uniforms. */
+    BGFX_PHASE_EXEC_COMMANDS_POST,            /** ( 6) Render thread executing resource commands after submit. */
+    BGFX_PHASE_TEXTURE_UPDATE,                /** ( 7) Render thread updating textures, included in resource commands and submit. */
+    BGFX_PHASE_FLIP,                          /** ( 8) Presenting back buffer.        */
+
+    BGFX_PHASE_COUNT
+
+} bgfx_phase_t;
+
 /**
  * Render frame enum.
  *
@@ -438,6 +458,8 @@ typedef struct bgfx_callback_vtbl_s
 
 } bgfx_callback_vtbl_t;
 
+typedef struct bgfx_draw_bundle_handle_s { uint16_t idx; } bgfx_draw_bundle_handle_t;
+
 typedef struct bgfx_dynamic_index_buffer_handle_s { uint16_t idx; } bgfx_dynamic_index_buffer_handle_t;
 
 typedef struct bgfx_dynamic_vertex_buffer_handle_s { uint16_t idx; } bgfx_dynamic_vertex_buffer_handle_t;
@@ -606,8 +628,13 @@ typedef struct bgfx_resolution_s
 typedef struct bgfx_init_limits_s
 {
     uint16_t             maxEncoders;        /** Maximum number of encoder threads.       */
+    uint16_t             maxSortThreads;     /** Number of helper threads used to sort draw calls. 0 disables parallel sort. */
+    uint16_t             maxTextureDecodeThreads; /** Number of worker threads decoding `BGFX_TEXTURE_ASYNC` textures. */
+    uint16_t             statsWindow;        /** Number of frames `Stats::phaseStats` are computed over. */
+    uint32_t             maxDrawCalls;       /** Maximum number of draw calls per frame.  */
     uint32_t             transientVbSize;    /** Maximum transient vertex buffer size.    */
     uint32_t             transientIbSize;    /** Maximum transient index buffer size.     */
+    uint64_t             textureMemoryBudget; /** Texture memory budget in bytes kept by dropping mips of `BGFX_TEXTURE_STREAMING` textures. 0 disables streaming. */
 
 } bgfx_init_limits_t;
 
@@ -796,6 +823,21 @@ typedef struct bgfx_encoder_stats_s
 
 } bgfx_encoder_stats_t;
 
+/**
+ * Phase timing, in nanoseconds, over last `Init::Limits::statsWindow`
+ * frames.
+ *
+ */
+typedef struct bgfx_phase_stats_s
+{
+    int64_t              last;               /** Time spent in the last frame.            */
+    int64_t              min;                /** Minimum time.                            */
+    int64_t              avg;                /** Average time.                            */
+    int64_t              max;                /** Maximum time.                            */
+    int64_t              p99;                /** 99th percentile time.                    */
+
+} bgfx_phase_stats_t;
+
 /**
  * Renderer statistics data.
  * @remarks All time values are high-resolution timestamps, while
@@ -832,6 +874,22 @@ typedef struct bgfx_stats_s
     int64_t              rtMemoryUsed;       /** Estimate of render target memory used.   */
     int32_t              transientVbUsed;    /** Amount of transient vertex buffer used.  */
     int32_t              transientIbUsed;    /** Amount of transient index buffer used.   */
+    int32_t              transientVbWasted;  /** Amount of transient vertex buffer left unused in encoder chunks. */
+    int32_t              transientIbWasted;  /** Amount of transient index buffer left unused in encoder chunks. */
+    uint32_t             cmdBufferUsed;      /** Resource command buffer data used by frame, in bytes. */
+    uint32_t             cmdBufferHighWater; /** Highest resource command buffer usage of any frame, in bytes. */
+    uint32_t             cmdBufferCapacity;  /** Memory reserved for frame resource command buffers, in bytes. */
+    uint32_t             uniformDataWritten; /** Uniform data written by encoders, in bytes. */
+    uint32_t             uniformDataSkipped; /** Uniform data encoders referenced instead of writing repeated value. */
+    uint32_t             uniformDataUpdated; /** Uniform data that changed value in renderer backend. */
+    uint32_t             uniformDataRedundant; /** Uniform data renderer backend skipped as already set. */
+    uint32_t             numTextureUpdates;  /** Number of texture updates submitted.     */
+    uint32_t             numTextureUploads;  /** Number of texture uploads after merging adjacent updates. */
+    uint32_t             textureUploadSize;  /** Texture data uploaded after merging adjacent updates, in bytes. */
+    uint32_t             numMemoryAllocs;    /** Number of `bgfx::alloc`/`bgfx::copy` calls during frame. */
+    uint32_t             numMemoryAllocsPooled; /** Number of `bgfx::alloc`/`bgfx::copy` calls served from frame memory pool. */
+    uint32_t             memoryAllocSize;    /** Memory requested by `bgfx::alloc`/`bgfx::copy` during frame, in bytes. */
+    uint32_t             memoryPoolSize;     /** Memory reserved by frame memory pool, in bytes. */
     uint32_t             numPrims[BGFX_TOPOLOGY_COUNT]; /** Number of primitives rendered.           */
     int64_t              gpuMemoryMax;       /** Maximum available GPU memory for application. */
     int64_t              gpuMemoryUsed;      /** Amount of GPU memory used by the application. */
@@ -843,6 +901,8 @@ typedef struct bgfx_stats_s
     bgfx_view_stats_t*   viewStats;          /** Array of View stats.                     */
     uint8_t              numEncoders;        /** Number of encoders used during frame.    */
     bgfx_encoder_stats_t* encoderStats;      /** Array of encoder stats.                  */
+    uint16_t             numPhaseFrames;     /** Number of frames phase stats are computed over. */
+    bgfx_phase_stats_t   phaseStats[BGFX_PHASE_COUNT]; /** Per-phase timing, see `Phase::Enum`.     */
 
 } bgfx_stats_t;
 
@@ -1089,6 +1149,9 @@ BGFX_C_API void bgfx_shutdown();
  *      occurs. Default behavior is that flip occurs before rendering new
  *      frame. This flag only has effect when `BGFX_CONFIG_MULTITHREADED=0`.
  *    - `BGFX_RESET_SRGB_BACKBUFFER` - Enable sRGB backbuffer.
+ *    - `BGFX_RESET_SYNC_READ_BACK` - Read back textures and screen shots
+ *      in the frame they are requested, instead of after renderer read
+ *      back latency. This stalls rendering until GPU is done.
  * @param[in] _format Texture format. See: `TextureFormat::Enum`.
  *
  */
@@ -1798,6 +1861,8 @@ BGFX_C_API bgfx_texture_handle_t bgfx_create_texture_cube(uint16_t _size, bool _
 /**
  * Update 2D texture.
  * @attention It's valid to update only mutable texture. See `bgfx::createTexture2D` for more info.
+ * @remarks Updates of `BGFX_TEXTURE_ATLAS` texture submitted in the same frame can be
+ *   uploaded as one region, texels of that region not written by any update are cleared.
  *
  * @param[in] _handle Texture handle.
  * @param[in] _layer Layer in texture array.
@@ -2100,6 +2165,20 @@ BGFX_C_API bgfx_occlusion_query_result_t bgfx_get_result(bgfx_occlusion_query_ha
  */
 BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _handle);
 
+/**
+ * Create draw bundle.
+ *
+ */
+BGFX_C_API bgfx_draw_bundle_handle_t bgfx_create_draw_bundle();
+
+/**
+ * Destroy draw bundle.
+ *
+ * @param[in] _handle Handle to draw bundle object.
+ *
+ */
+BGFX_C_API void bgfx_destroy_draw_bundle(bgfx_draw_bundle_handle_t _handle);
+
 /**
  * Set palette color value.
  *
@@ -2217,6 +2296,28 @@ BGFX_C_API void bgfx_set_view_clear_mrt(bgfx_view_id_t _id, uint16_t _flags, flo
  */
 BGFX_C_API void bgfx_set_view_mode(bgfx_view_id_t _id, bgfx_view_mode_t _mode);
 
+/**
+ * Enable automatic instancing for view. After sorting, consecutive
+ * draw calls in view that differ only by model transform are merged
+ * into single instanced draw call, with model matrices passed as
+ * instance data.
+ * @remarks
+ *   Only draw calls with single transform, without instance data,
+ *   indirect buffer, or occlusion query are merged. Draw calls that
+ *   can't be merged get their first transform as instance data, so
+ *   vertex shaders used in view must read model matrix from
+ *   `i_data0`-`i_data3` (see `BGFX_AUTO_INSTANCE_MODEL` in
+ *   `bgfx_shader.sh`). Draw calls with their own instance data buffer
+ *   keep it, and it must start with model matrix. Draw calls whose
+ *   transform doesn't fit into transient vertex buffer are dropped.
+ *   Requires `BGFX_CAPS_INSTANCING`.
+ *
+ * @param[in] _id View id.
+ * @param[in] _enabled Enable automatic instancing.
+ *
+ */
+BGFX_C_API void bgfx_set_view_auto_instancing(bgfx_view_id_t _id, bool _enabled);
+
 /**
  * Set view frame buffer.
  * @remarks
@@ -2396,6 +2497,80 @@ BGFX_C_API uint32_t bgfx_encoder_alloc_transform(bgfx_encoder_t* _this, bgfx_tra
  */
 BGFX_C_API void bgfx_encoder_set_uniform(bgfx_encoder_t* _this, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
 
+/**
+ * Returns number of requested or maximum available indices.
+ *
+ * @param[in] _num Number of required indices.
+ *
+ * @returns Number of requested or maximum available indices.
+ *
+ */
+BGFX_C_API uint32_t bgfx_encoder_get_avail_transient_index_buffer(bgfx_encoder_t* _this, uint32_t _num);
+
+/**
+ * Returns number of requested or maximum available vertices.
+ *
+ * @param[in] _num Number of required vertices.
+ * @param[in] _decl Vertex declaration.
+ *
+ * @returns Number of requested or maximum available vertices.
+ *
+ */
+BGFX_C_API uint32_t bgfx_encoder_get_avail_transient_vertex_buffer(bgfx_encoder_t* _this, uint32_t _num, const bgfx_vertex_decl_t * _decl);
+
+/**
+ * Returns number of requested or maximum available instance buffer slots.
+ *
+ * @param[in] _num Number of required instances.
+ * @param[in] _stride Stride per instance.
+ *
+ * @returns Number of requested or maximum available instance buffer slots.
+ *
+ */
+BGFX_C_API uint32_t bgfx_encoder_get_avail_instance_data_buffer(bgfx_encoder_t* _this, uint32_t _num, uint16_t _stride);
+
+/**
+ * Allocate transient index buffer from encoder's chunk of frame
+ * transient index buffer.
+ * @remarks
+ *   Encoder reserves `BGFX_CONFIG_TRANSIENT_CHUNK_SIZE` bytes at once
+ *   and sub-allocates from it without taking any lock. Unused part of
+ *   the chunk is reported in `Stats::transientIbWasted`.
+ *
+ * @param[out] _tib TransientIndexBuffer structure is filled and is valid
+ *  for the duration of frame, and it can be reused for multiple draw
+ *  calls.
+ * @param[in] _num Number of indices to allocate.
+ *
+ */
+BGFX_C_API void bgfx_encoder_alloc_transient_index_buffer(bgfx_encoder_t* _this, bgfx_transient_index_buffer_t* _tib, uint32_t _num);
+
+/**
+ * Allocate transient vertex buffer from encoder's chunk of frame
+ * transient vertex buffer.
+ *
+ * @param[out] _tvb TransientVertexBuffer structure is filled and is valid
+ *  for the duration of frame, and it can be reused for multiple draw
+ *  calls.
+ * @param[in] _num Number of vertices to allocate.
+ * @param[in] _decl Vertex declaration.
+ *
+ */
+BGFX_C_API void bgfx_encoder_alloc_transient_vertex_buffer(bgfx_encoder_t* _this, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_decl_t * _decl);
+
+/**
+ * Allocate instance data buffer from encoder's chunk of frame
+ * transient vertex buffer.
+ *
+ * @param[out] _idb InstanceDataBuffer structure is filled and is valid
+ *  for duration of frame, and it can be reused for multiple draw
+ *  calls.
+ * @param[in] _num Number of instances.
+ * @param[in] _stride Instance stride. Must be multiple of 16.
+ *
+ */
+BGFX_C_API void bgfx_encoder_alloc_instance_data_buffer(bgfx_encoder_t* _this, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride);
+
 /**
  * Set index buffer for draw primitive.
  *
@@ -2578,6 +2753,49 @@ BGFX_C_API void bgfx_encoder_submit_occlusion_query(bgfx_encoder_t* _this, bgfx_
  */
 BGFX_C_API void bgfx_encoder_submit_indirect(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState);
 
+/**
+ * Submit batch of primitives for rendering. Per draw properties are
+ * passed as arrays of `_num` elements.
+ *
+ * @param[in] _id View id.
+ * @param[in] _num Number of draw calls in batch.
+ * @param[in] _program Program for each draw call.
+ * @param[in] _transform Matrix cache index for each draw call. If NULL,
+ *  transform set on encoder is used.
+ * @param[in] _vertexBuffer Vertex buffer for each draw call.
+ * @param[in] _indexBuffer Index buffer for each draw call. If NULL, draw
+ *  calls are not indexed.
+ * @param[in] _state Render state for each draw call. If NULL, state set
+ *  on encoder is used.
+ * @param[in] _depth Depth for sorting for each draw call. If NULL, depth
+ *  is 0.
+ *
+ */
+BGFX_C_API void bgfx_encoder_submit_batch(bgfx_encoder_t* _this, bgfx_view_id_t _id, uint32_t _num, const bgfx_program_handle_t* _program, const uint32_t* _transform, const bgfx_vertex_buffer_handle_t* _vertexBuffer, const bgfx_index_buffer_handle_t* _indexBuffer, const uint64_t* _state, const uint32_t* _depth);
+
+/**
+ * Start recording draw calls into draw bundle.
+ *
+ * @param[in] _handle Draw bundle handle.
+ *
+ */
+BGFX_C_API void bgfx_encoder_begin_draw_bundle(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle);
+
+/**
+ * End recording draw calls into draw bundle.
+ *
+ */
+BGFX_C_API void bgfx_encoder_end_draw_bundle(bgfx_encoder_t* _this);
+
+/**
+ * Submit all draw calls recorded in draw bundle.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Draw bundle handle.
+ *
+ */
+BGFX_C_API void bgfx_encoder_submit_draw_bundle(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle);
+
 /**
  * Set compute index buffer.
  *
@@ -2711,6 +2929,82 @@ BGFX_C_API void bgfx_encoder_blit(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgf
  */
 BGFX_C_API void bgfx_request_screen_shot(bgfx_frame_buffer_handle_t _handle, const char* _filePath);
 
+/**
+ * Begin capturing frames into trace file. Every following `bgfx::frame`
+ * writes frame, as it's handed to renderer, into trace.
+ * @remarks
+ *   Resources created before capture began are not part of trace. For
+ *   trace to be replayed with renderer other than noop, capture must
+ *   begin before any resource is created. Screen shots, texture reads
+ *   and window frame buffers are not captured.
+ * @attention Trace can be replayed only by the same bgfx version built
+ *   with the same configuration.
+ *
+ * @param[in] _filePath Trace file path.
+ *
+ * @returns True if trace file is opened.
+ *
+ */
+BGFX_C_API bool bgfx_frame_trace_begin(const char* _filePath);
+
+/**
+ * End capturing frames. Capture is ended on shutdown too.
+ *
+ */
+BGFX_C_API void bgfx_frame_trace_end();
+
+/**
+ * Replay frames from trace file. Every following `bgfx::frame` submits
+ * next frame from trace, replacing draw calls submitted by API, until
+ * trace ends.
+ * @remarks
+ *   bgfx must be initialized with resolution and limits trace was
+ *   captured with, see `bgfx::FrameTraceHeader` in `src/frame_trace.h`.
+ *   Application must not create resources while replaying.
+ *
+ * @param[in] _filePath Trace file path, captured with `bgfx::frameTraceBegin`.
+ *
+ * @returns Number of frames in trace, or 0 if trace can't be replayed.
+ *
+ */
+BGFX_C_API uint32_t bgfx_frame_trace_replay(const char* _filePath);
+
+/**
+ * Begin recording bgfx internal profiler scopes from all threads, and
+ * writing them as Chrome trace event JSON, viewable with
+ * `chrome://tracing` or Perfetto UI.
+ * @remarks
+ *   Scopes are recorded into per-thread ring buffer, dump contains at
+ *   most `BGFX_CONFIG_PROFILER_TRACE_EVENTS` latest scope events of
+ *   each thread.
+ *
+ * @param[in] _filePath Trace file path prefix. Each dump writes scopes
+ *   recorded since previous dump into `<_filePath>-<frame>.json`, and
+ *   the last one into `<_filePath>-end.json`.
+ * @param[in] _dumpInterval Dump every `_dumpInterval` frames. When 0,
+ *   trace is dumped only by `bgfx::profilerTraceDump` and
+ *   `bgfx::profilerTraceEnd`.
+ *
+ * @returns True if recording began. bgfx must be built with
+ *   `BGFX_CONFIG_PROFILER`.
+ *
+ */
+BGFX_C_API bool bgfx_profiler_trace_begin(const char* _filePath, uint32_t _dumpInterval);
+
+/**
+ * Dump profiler scopes recorded since previous dump on next
+ * `bgfx::frame`.
+ *
+ */
+BGFX_C_API void bgfx_profiler_trace_dump();
+
+/**
+ * End recording profiler scopes, and dump remaining ones. Recording is
+ * ended on shutdown too.
+ *
+ */
+BGFX_C_API void bgfx_profiler_trace_end();
+
 /**
  * Render frame.
  * @attention `bgfx::renderFrame` is blocking call. It waits for
@@ -3105,6 +3399,48 @@ BGFX_C_API void bgfx_submit_occlusion_query(bgfx_view_id_t _id, bgfx_program_han
  */
 BGFX_C_API void bgfx_submit_indirect(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState);
 
+/**
+ * Submit batch of primitives for rendering.
+ *
+ * @param[in] _id View id.
+ * @param[in] _num Number of draw calls in batch.
+ * @param[in] _program Program for each draw call.
+ * @param[in] _transform Matrix cache index for each draw call. If NULL,
+ *  transform set on encoder is used.
+ * @param[in] _vertexBuffer Vertex buffer for each draw call.
+ * @param[in] _indexBuffer Index buffer for each draw call. If NULL, draw
+ *  calls are not indexed.
+ * @param[in] _state Render state for each draw call. If NULL, state set
+ *  on encoder is used.
+ * @param[in] _depth Depth for sorting for each draw call. If NULL, depth
+ *  is 0.
+ *
+ */
+BGFX_C_API void bgfx_submit_batch(bgfx_view_id_t _id, uint32_t _num, const bgfx_program_handle_t* _program, const uint32_t* _transform, const bgfx_vertex_buffer_handle_t* _vertexBuffer, const bgfx_index_buffer_handle_t* _indexBuffer, const uint64_t* _state, const uint32_t* _depth);
+
+/**
+ * Start recording draw calls into draw bundle.
+ *
+ * @param[in] _handle Draw bundle handle.
+ *
+ */
+BGFX_C_API void bgfx_begin_draw_bundle(bgfx_draw_bundle_handle_t _handle);
+
+/**
+ * End recording draw calls into draw bundle.
+ *
+ */
+BGFX_C_API void bgfx_end_draw_bundle();
+
+/**
+ * Submit all draw calls recorded in draw bundle.
+ *
+ * @param[in] _id View id.
+ * @param[in] _handle Draw bundle handle.
+ *
+ */
+BGFX_C_API void bgfx_submit_draw_bundle(bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle);
+
 /**
  * Set compute index buffer.
  *
@@ -3320,6 +3656,8 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_CREATE_OCCLUSION_QUERY,
     BGFX_FUNCTION_ID_GET_RESULT,
     BGFX_FUNCTION_ID_DESTROY_OCCLUSION_QUERY,
+    BGFX_FUNCTION_ID_CREATE_DRAW_BUNDLE,
+    BGFX_FUNCTION_ID_DESTROY_DRAW_BUNDLE,
     BGFX_FUNCTION_ID_SET_PALETTE_COLOR,
     BGFX_FUNCTION_ID_SET_PALETTE_COLOR_RGBA8,
     BGFX_FUNCTION_ID_SET_VIEW_NAME,
@@ -3329,6 +3667,7 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_SET_VIEW_CLEAR,
     BGFX_FUNCTION_ID_SET_VIEW_CLEAR_MRT,
     BGFX_FUNCTION_ID_SET_VIEW_MODE,
+    BGFX_FUNCTION_ID_SET_VIEW_AUTO_INSTANCING,
     BGFX_FUNCTION_ID_SET_VIEW_FRAME_BUFFER,
     BGFX_FUNCTION_ID_SET_VIEW_TRANSFORM,
     BGFX_FUNCTION_ID_SET_VIEW_ORDER,
@@ -3344,6 +3683,12 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_ENCODER_SET_TRANSFORM_CACHED,
     BGFX_FUNCTION_ID_ENCODER_ALLOC_TRANSFORM,
     BGFX_FUNCTION_ID_ENCODER_SET_UNIFORM,
+    BGFX_FUNCTION_ID_ENCODER_GET_AVAIL_TRANSIENT_INDEX_BUFFER,
+    BGFX_FUNCTION_ID_ENCODER_GET_AVAIL_TRANSIENT_VERTEX_BUFFER,
+    BGFX_FUNCTION_ID_ENCODER_GET_AVAIL_INSTANCE_DATA_BUFFER,
+    BGFX_FUNCTION_ID_ENCODER_ALLOC_TRANSIENT_INDEX_BUFFER,
+    BGFX_FUNCTION_ID_ENCODER_ALLOC_TRANSIENT_VERTEX_BUFFER,
+    BGFX_FUNCTION_ID_ENCODER_ALLOC_INSTANCE_DATA_BUFFER,
     BGFX_FUNCTION_ID_ENCODER_SET_INDEX_BUFFER,
     BGFX_FUNCTION_ID_ENCODER_SET_DYNAMIC_INDEX_BUFFER,
     BGFX_FUNCTION_ID_ENCODER_SET_TRANSIENT_INDEX_BUFFER,
@@ -3360,6 +3705,10 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_ENCODER_SUBMIT,
     BGFX_FUNCTION_ID_ENCODER_SUBMIT_OCCLUSION_QUERY,
     BGFX_FUNCTION_ID_ENCODER_SUBMIT_INDIRECT,
+    BGFX_FUNCTION_ID_ENCODER_SUBMIT_BATCH,
+    BGFX_FUNCTION_ID_ENCODER_BEGIN_DRAW_BUNDLE,
+    BGFX_FUNCTION_ID_ENCODER_END_DRAW_BUNDLE,
+    BGFX_FUNCTION_ID_ENCODER_SUBMIT_DRAW_BUNDLE,
     BGFX_FUNCTION_ID_ENCODER_SET_COMPUTE_INDEX_BUFFER,
     BGFX_FUNCTION_ID_ENCODER_SET_COMPUTE_VERTEX_BUFFER,
     BGFX_FUNCTION_ID_ENCODER_SET_COMPUTE_DYNAMIC_INDEX_BUFFER,
@@ -3371,6 +3720,12 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_ENCODER_DISCARD,
     BGFX_FUNCTION_ID_ENCODER_BLIT,
     BGFX_FUNCTION_ID_REQUEST_SCREEN_SHOT,
+    BGFX_FUNCTION_ID_FRAME_TRACE_BEGIN,
+    BGFX_FUNCTION_ID_FRAME_TRACE_END,
+    BGFX_FUNCTION_ID_FRAME_TRACE_REPLAY,
+    BGFX_FUNCTION_ID_PROFILER_TRACE_BEGIN,
+    BGFX_FUNCTION_ID_PROFILER_TRACE_DUMP,
+    BGFX_FUNCTION_ID_PROFILER_TRACE_END,
     BGFX_FUNCTION_ID_RENDER_FRAME,
     BGFX_FUNCTION_ID_SET_PLATFORM_DATA,
     BGFX_FUNCTION_ID_GET_INTERNAL_DATA,
@@ -3402,6 +3757,10 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_SUBMIT,
     BGFX_FUNCTION_ID_SUBMIT_OCCLUSION_QUERY,
     BGFX_FUNCTION_ID_SUBMIT_INDIRECT,
+    BGFX_FUNCTION_ID_SUBMIT_BATCH,
+    BGFX_FUNCTION_ID_BEGIN_DRAW_BUNDLE,
+    BGFX_FUNCTION_ID_END_DRAW_BUNDLE,
+    BGFX_FUNCTION_ID_SUBMIT_DRAW_BUNDLE,
     BGFX_FUNCTION_ID_SET_COMPUTE_INDEX_BUFFER,
     BGFX_FUNCTION_ID_SET_COMPUTE_VERTEX_BUFFER,
     BGFX_FUNCTION_ID_SET_COMPUTE_DYNAMIC_INDEX_BUFFER,
@@ -3512,6 +3871,8 @@ struct bgfx_interface_vtbl
     bgfx_occlusion_query_handle_t (*create_occlusion_query)();
     bgfx_occlusion_query_result_t (*get_result)(bgfx_occlusion_query_handle_t _handle, int32_t* _result);
     void (*destroy_occlusion_query)(bgfx_occlusion_query_handle_t _handle);
+    bgfx_draw_bundle_handle_t (*create_draw_bundle)();
+    void (*destroy_draw_bundle)(bgfx_draw_bundle_handle_t _handle);
     void (*set_palette_color)(uint8_t _index, const float _rgba[4]);
     void (*set_palette_color_rgba8)(uint8_t _index, uint32_t _rgba);
     void (*set_view_name)(bgfx_view_id_t _id, const char* _name);
@@ -3521,6 +3882,7 @@ struct bgfx_interface_vtbl
     void (*set_view_clear)(bgfx_view_id_t _id, uint16_t _flags, uint32_t _rgba, float _depth, uint8_t _stencil);
     void (*set_view_clear_mrt)(bgfx_view_id_t _id, uint16_t _flags, float _depth, uint8_t _stencil, uint8_t _c0, uint8_t _c1, uint8_t _c2, uint8_t _c3, uint8_t _c4, uint8_t _c5, uint8_t _c6, uint8_t _c7);
     void (*set_view_mode)(bgfx_view_id_t _id, bgfx_view_mode_t _mode);
+    void (*set_view_auto_instancing)(bgfx_view_id_t _id, bool _enabled);
     void (*set_view_frame_buffer)(bgfx_view_id_t _id, bgfx_frame_buffer_handle_t _handle);
     void (*set_view_transform)(bgfx_view_id_t _id, const void* _view, const void* _proj);
     void (*set_view_order)(bgfx_view_id_t _id, uint16_t _num, const bgfx_view_id_t* _order);
@@ -3536,6 +3898,12 @@ struct bgfx_interface_vtbl
     void (*encoder_set_transform_cached)(bgfx_encoder_t* _this, uint32_t _cache, uint16_t _num);
     uint32_t (*encoder_alloc_transform)(bgfx_encoder_t* _this, bgfx_transform_t* _transform, uint16_t _num);
     void (*encoder_set_uniform)(bgfx_encoder_t* _this, bgfx_uniform_handle_t _handle, const void* _value, uint16_t _num);
+    uint32_t (*encoder_get_avail_transient_index_buffer)(bgfx_encoder_t* _this, uint32_t _num);
+    uint32_t (*encoder_get_avail_transient_vertex_buffer)(bgfx_encoder_t* _this, uint32_t _num, const bgfx_vertex_decl_t * _decl);
+    uint32_t (*encoder_get_avail_instance_data_buffer)(bgfx_encoder_t* _this, uint32_t _num, uint16_t _stride);
+    void (*encoder_alloc_transient_index_buffer)(bgfx_encoder_t* _this, bgfx_transient_index_buffer_t* _tib, uint32_t _num);
+    void (*encoder_alloc_transient_vertex_buffer)(bgfx_encoder_t* _this, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_decl_t * _decl);
+    void (*encoder_alloc_instance_data_buffer)(bgfx_encoder_t* _this, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride);
     void (*encoder_set_index_buffer)(bgfx_encoder_t* _this, bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*encoder_set_dynamic_index_buffer)(bgfx_encoder_t* _this, bgfx_dynamic_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices);
     void (*encoder_set_transient_index_buffer)(bgfx_encoder_t* _this, const bgfx_transient_index_buffer_t* _tib, uint32_t _firstIndex, uint32_t _numIndices);
@@ -3552,6 +3920,10 @@ struct bgfx_interface_vtbl
     void (*encoder_submit)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, uint32_t _depth, bool _preserveState);
     void (*encoder_submit_occlusion_query)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, bool _preserveState);
     void (*encoder_submit_indirect)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState);
+    void (*encoder_submit_batch)(bgfx_encoder_t* _this, bgfx_view_id_t _id, uint32_t _num, const bgfx_program_handle_t* _program, const uint32_t* _transform, const bgfx_vertex_buffer_handle_t* _vertexBuffer, const bgfx_index_buffer_handle_t* _indexBuffer, const uint64_t* _state, const uint32_t* _depth);
+    void (*encoder_begin_draw_bundle)(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle);
+    void (*encoder_end_draw_bundle)(bgfx_encoder_t* _this);
+    void (*encoder_submit_draw_bundle)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle);
     void (*encoder_set_compute_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_vertex_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*encoder_set_compute_dynamic_index_buffer)(bgfx_encoder_t* _this, uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
@@ -3563,6 +3935,12 @@ struct bgfx_interface_vtbl
     void (*encoder_discard)(bgfx_encoder_t* _this);
     void (*encoder_blit)(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_texture_handle_t _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, bgfx_texture_handle_t _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
     void (*request_screen_shot)(bgfx_frame_buffer_handle_t _handle, const char* _filePath);
+    bool (*frame_trace_begin)(const char* _filePath);
+    void (*frame_trace_end)();
+    uint32_t (*frame_trace_replay)(const char* _filePath);
+    bool (*profiler_trace_begin)(const char* _filePath, uint32_t _dumpInterval);
+    void (*profiler_trace_dump)();
+    void (*profiler_trace_end)();
     bgfx_render_frame_t (*render_frame)(int32_t _msecs);
     void (*set_platform_data)(const bgfx_platform_data_t * _data);
     const bgfx_internal_data_t* (*get_internal_data)();
@@ -3594,6 +3972,10 @@ struct bgfx_interface_vtbl
     void (*submit)(bgfx_view_id_t _id, bgfx_program_handle_t _program, uint32_t _depth, bool _preserveState);
     void (*submit_occlusion_query)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_occlusion_query_handle_t _occlusionQuery, uint32_t _depth, bool _preserveState);
     void (*submit_indirect)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_indirect_buffer_handle_t _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState);
+    void (*submit_batch)(bgfx_view_id_t _id, uint32_t _num, const bgfx_program_handle_t* _program, const uint32_t* _transform, const bgfx_vertex_buffer_handle_t* _vertexBuffer, const bgfx_index_buffer_handle_t* _indexBuffer, const uint64_t* _state, const uint32_t* _depth);
+    void (*begin_draw_bundle)(bgfx_draw_bundle_handle_t _handle);
+    void (*end_draw_bundle)();
+    void (*submit_draw_bundle)(bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle);
     void (*set_compute_index_buffer)(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_vertex_buffer)(uint8_t _stage, bgfx_vertex_buffer_handle_t _handle, bgfx_access_t _access);
     void (*set_compute_dynamic_index_buffer)(uint8_t _stage, bgfx_dynamic_index_buffer_handle_t _handle, bgfx_access_t _access);
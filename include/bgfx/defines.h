@@ -6,7 +6,7 @@
 #ifndef BGFX_DEFINES_H_HEADER_GUARD
 #define BGFX_DEFINES_H_HEADER_GUARD
 
-#define BGFX_API_VERSION UINT32_C(99)
+#define BGFX_API_VERSION UINT32_C(119)
 
 /// Color RGB/alpha/depth write. When it's not specified write will be disabled.
 #define BGFX_STATE_WRITE_R                 UINT64_C(0x0000000000000001) //!< Enable R write.
@@ -364,6 +364,9 @@
 #define BGFX_TEXTURE_SRGB                UINT64_C(0x0000200000000000) //!< Sample texture as sRGB.
 #define BGFX_TEXTURE_BLIT_DST            UINT64_C(0x0000400000000000) //!< Texture will be used as blit destination.
 #define BGFX_TEXTURE_READ_BACK           UINT64_C(0x0000800000000000) //!< Texture will be used for read back from GPU.
+#define BGFX_TEXTURE_ASYNC               UINT64_C(0x0001000000000000) //!< Texture data will be parsed and converted on worker thread.
+#define BGFX_TEXTURE_STREAMING           UINT64_C(0x0002000000000000) //!< Texture top mips can be dropped to stay within texture memory budget.
+#define BGFX_TEXTURE_ATLAS               UINT64_C(0x0004000000000000) //!< Texels between sub-rects updated in the same frame are unused, and can be cleared.
 
 /// Sampler flags.
 #define BGFX_SAMPLER_NONE                UINT32_C(0x00000000) //!<
@@ -472,6 +475,7 @@
 #define BGFX_RESET_HIDPI                 UINT32_C(0x00020000) //!< Enable HiDPI rendering.
 #define BGFX_RESET_DEPTH_CLAMP           UINT32_C(0x00040000) //!< Enable depth clamp.
 #define BGFX_RESET_SUSPEND               UINT32_C(0x00080000) //!< Suspend rendering.
+#define BGFX_RESET_SYNC_READ_BACK        UINT32_C(0x00100000) //!< Read back textures and screen shots in the frame they are requested.
 #define BGFX_RESET_RESERVED_SHIFT        31                   //!< Internal bits shift.
 #define BGFX_RESET_RESERVED_MASK         UINT32_C(0x80000000) //!< Internal bits mask.
 
@@ -168,10 +168,12 @@ function bgfxProjectBase(_kind, _defines)
 			path.join(BGFX_DIR, "src/bgfx.cpp"),
 			path.join(BGFX_DIR, "src/debug_**.cpp"),
 			path.join(BGFX_DIR, "src/dxgi.cpp"),
+			path.join(BGFX_DIR, "src/frame_trace.cpp"),
 			path.join(BGFX_DIR, "src/glcontext_**.cpp"),
 			path.join(BGFX_DIR, "src/hmd**.cpp"),
 			path.join(BGFX_DIR, "src/image.cpp"),
 			path.join(BGFX_DIR, "src/nvapi.cpp"),
+			path.join(BGFX_DIR, "src/profiler_trace.cpp"),
 			path.join(BGFX_DIR, "src/renderer_**.cpp"),
 			path.join(BGFX_DIR, "src/shader**.cpp"),
 			path.join(BGFX_DIR, "src/topology.cpp"),
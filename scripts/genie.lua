@@ -507,4 +507,6 @@ if _OPTIONS["with-tools"] then
 	dofile "texturec.lua"
 	dofile "texturev.lua"
 	dofile "geometryc.lua"
+	dofile "bench.lua"
+	dofile "bgfx-replay.lua"
 end
@@ -6,10 +6,12 @@
 #include "bgfx.cpp"
 #include "debug_renderdoc.cpp"
 #include "dxgi.cpp"
+#include "frame_trace.cpp"
 #include "glcontext_egl.cpp"
 #include "glcontext_glx.cpp"
 #include "glcontext_wgl.cpp"
 #include "nvapi.cpp"
+#include "profiler_trace.cpp"
 #include "renderer_d3d11.cpp"
 #include "renderer_d3d12.cpp"
 #include "renderer_d3d9.cpp"
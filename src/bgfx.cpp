@@ -242,6 +242,7 @@ namespace bgfx
 
 	CallbackI* g_callback = NULL;
 	bx::AllocatorI* g_allocator = NULL;
+	ProfilerTrace g_profilerTrace;
 
 	Caps g_caps;
 
@@ -1191,187 +1192,1641 @@ namespace bgfx
 			return;
 		}
 
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		BX_CHECK(NULL == m_drawBundle || !isValid(_occlusionQuery)
+			, "Occlusion query can't be submitted into draw bundle."
+			);
+
+		uint32_t renderItemIdx = UINT32_MAX;
+		if (NULL == m_drawBundle)
+		{
+			renderItemIdx = allocRenderItem();
+			if (UINT32_MAX == renderItemIdx)
+			{
+				discard();
+				++m_numDropped;
+				return;
+			}
+
+			m_draw.m_bindIdx = addRenderBind(m_bind);
+			++m_numSubmitted;
+		}
+
+		UniformBuffer* uniformBuffer = getUniformBuffer();
+		m_uniformEnd = uniformBuffer->getPos();
+
+		m_key.m_program = isValid(_program)
+			? _program
+			: ProgramHandle{0}
+			;
+
+		m_draw.m_uniformIdx   = m_uniformIdx;
+		m_draw.m_uniformBegin = m_uniformBegin;
+		m_draw.m_uniformEnd   = m_uniformEnd;
+
+		if (UINT8_MAX != m_draw.m_streamMask)
+		{
+			uint32_t numVertices = UINT32_MAX;
+			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
+				; 0 != streamMask
+				; streamMask >>= 1, idx += 1
+				)
+			{
+				const uint32_t ntz = bx::uint32_cnttz(streamMask);
+				streamMask >>= ntz;
+				idx         += ntz;
+				numVertices = bx::min(numVertices, m_numVertices[idx]);
+			}
+
+			m_draw.m_numVertices = numVertices;
+		}
+		else
+		{
+			m_draw.m_numVertices = m_numVertices[0];
+		}
+
+		if (NULL != m_drawBundle)
+		{
+			// View and view dependent parts of sort key are resolved when
+			// bundle is submitted.
+			SortKey key = m_key;
+			key.m_depth = _depth;
+			m_drawBundle->add(key, m_draw, m_bind);
+
+			// Dynamic buffers can move when resized, store offset relative
+			// to buffer start and resolve it when bundle is submitted.
+			for (uint8_t slot = 0; slot < DrawBundle::DynamicSlot::Count; ++slot)
+			{
+				const uint16_t handle = m_dynamicRef[slot];
+				if (kInvalidHandle == handle)
+				{
+					continue;
+				}
+
+				if (DrawBundle::DynamicSlot::IndexBuffer == slot)
+				{
+					const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[handle];
+					if (isValid(m_draw.m_indexBuffer) )
+					{
+						m_drawBundle->addDynamicRef(slot, handle, m_draw.m_startIndex - dib.m_startIndex);
+					}
+				}
+				else if (DrawBundle::DynamicSlot::InstanceDataBuffer == slot)
+				{
+					const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[handle];
+					if (isValid(m_draw.m_instanceDataBuffer) )
+					{
+						m_drawBundle->addDynamicRef(slot, handle, m_draw.m_instanceDataOffset - dvb.m_startVertex*dvb.m_stride);
+					}
+				}
+				else if (0 != (m_draw.m_streamMask & (1<<slot) ) )
+				{
+					const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[handle];
+					m_drawBundle->addDynamicRef(slot, handle, m_draw.m_stream[slot].m_startVertex - dvb.m_startVertex);
+				}
+			}
+		}
+		else
+		{
+			m_key.m_view = _id;
+
+			SortKey::Enum type = SortKey::SortProgram;
+			switch (s_ctx->m_view[_id].m_mode)
+			{
+			case ViewMode::Sequential:      m_key.m_seq   = s_ctx->getSeqIncr(_id); type = SortKey::SortSequence; break;
+			case ViewMode::DepthAscending:  m_key.m_depth =            _depth;      type = SortKey::SortDepth;    break;
+			case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX-_depth;      type = SortKey::SortDepth;    break;
+			default: break;
+			}
+
+			uint64_t key = m_key.encodeDraw(type);
+			addSortKey(key, renderItemIdx);
+
+			if (isValid(_occlusionQuery) )
+			{
+				m_draw.m_stateFlags |= BGFX_STATE_INTERNAL_OCCLUSION_QUERY;
+				m_draw.m_occlusionQuery = _occlusionQuery;
+			}
+
+			m_frame->m_renderItem[renderItemIdx].draw = m_draw;
+		}
+
+		if (!_preserveState)
+		{
+			m_draw.clear();
+			m_bind.clear();
+			m_uniformBegin = m_uniformEnd;
+			clearDynamicRefs();
+		}
+	}
+
+	// Batch draws use whole vertex and index buffer, so draw without either
+	// of them has no vertices and no indices, and it's discarded same as
+	// submit discards such draw call.
+	static inline bool isBatchDrawEmpty(const VertexBufferHandle* _vertexBuffer, const IndexBufferHandle* _indexBuffer, uint32_t _idx)
+	{
+		return !isValid(_vertexBuffer[_idx])
+			&& (NULL == _indexBuffer || !isValid(_indexBuffer[_idx]) )
+			;
+	}
+
+	static uint32_t countBatchDraws(uint32_t _num, const VertexBufferHandle* _vertexBuffer, const IndexBufferHandle* _indexBuffer)
+	{
+		uint32_t num = 0;
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			num += !isBatchDrawEmpty(_vertexBuffer, _indexBuffer, ii);
+		}
+
+		return num;
+	}
+
+	void EncoderImpl::submitBatch(
+		  ViewId _id
+		, uint32_t _num
+		, const ProgramHandle* _program
+		, const uint32_t* _transform
+		, const VertexBufferHandle* _vertexBuffer
+		, const IndexBufferHandle* _indexBuffer
+		, const uint64_t* _state
+		, const uint32_t* _depth
+		)
+	{
+		BX_CHECK(NULL == m_drawBundle, "Draw batch can't be submitted while recording draw bundle.");
+
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
+		{
+			m_uniformSet.clear();
+		}
+
+		if (m_discard)
+		{
+			discard();
+			return;
+		}
+
+		const uint32_t bindIdx = addRenderBind(m_bind);
+
+		UniformBuffer* uniformBuffer = getUniformBuffer();
+		m_uniformEnd = uniformBuffer->getPos();
+
+		// State set on encoder before submitBatch is shared by all draws in
+		// batch, only per draw fields are written into render items.
+		RenderDraw draw = m_draw;
+		draw.m_uniformIdx   = m_uniformIdx;
+		draw.m_uniformBegin = m_uniformBegin;
+		draw.m_uniformEnd   = m_uniformEnd;
+		draw.m_bindIdx      = bindIdx;
+		draw.m_startIndex   = 0;
+		draw.m_numIndices   = UINT32_MAX;
+		draw.m_numVertices  = UINT32_MAX;
+		draw.m_streamMask   = 0;
+		draw.m_stream[0].clear();
+		draw.m_indexBuffer.idx = kInvalidHandle;
+		draw.m_numMatrices  = NULL != _transform ? 1 : draw.m_numMatrices;
+
+		SortKey key = m_key;
+		key.m_view = _id;
+
+		// Sequence numbers are reserved only for draws that aren't empty.
+		const ViewMode::Enum mode = s_ctx->m_view[_id].m_mode;
+		const uint32_t numSeq = ViewMode::Sequential == mode
+			? countBatchDraws(_num, _vertexBuffer, _indexBuffer)
+			: 0
+			;
+
+		SortKey::Enum type = SortKey::SortProgram;
+		uint32_t seq       = 0;
+		uint32_t depthXor  = 0;
+		switch (mode)
+		{
+		case ViewMode::Sequential:      seq      = s_ctx->getSeqIncr(_id, numSeq); type = SortKey::SortSequence; break;
+		case ViewMode::DepthAscending:                                             type = SortKey::SortDepth;    break;
+		case ViewMode::DepthDescending: depthXor = UINT32_MAX;                     type = SortKey::SortDepth;    break;
+		default: break;
+		}
+
+		// Encoder can't hold more than maxDrawCalls keys, draws over that
+		// limit would be dropped by allocRenderItem anyway.
+		reserveSortKeys(_num);
+		const uint32_t maxNum = bx::min<uint32_t>(_num, m_maxSortKeys - m_numSortKeys);
+
+		// Sort keys are computed in separate pass, loop only reads input
+		// arrays and writes keys. Empty draws are skipped in both passes.
+		uint64_t* sortKeys = &m_sortKeys[m_numSortKeys];
+		uint32_t numKeys = 0;
+		for (uint32_t ii = 0; ii < _num && numKeys < maxNum; ++ii)
+		{
+			if (isBatchDrawEmpty(_vertexBuffer, _indexBuffer, ii) )
+			{
+				continue;
+			}
+
+			const ProgramHandle program = _program[ii];
+			key.m_program = isValid(program) ? program : ProgramHandle{0};
+			key.m_trans   = NULL != _state ? getTrans(_state[ii]) : m_key.m_trans;
+			key.m_depth   = (NULL != _depth ? _depth[ii] : 0) ^ depthXor;
+			key.m_seq     = seq + numKeys;
+			sortKeys[numKeys++] = key.encodeDraw(type);
+		}
+
+		RenderItemCount* sortValues = &m_sortValues[m_numSortKeys];
+		uint32_t num = 0;
+		for (uint32_t ii = 0; num < numKeys; ++ii)
+		{
+			if (isBatchDrawEmpty(_vertexBuffer, _indexBuffer, ii) )
+			{
+				continue;
+			}
+
+			const uint32_t renderItemIdx = allocRenderItem();
+			if (UINT32_MAX == renderItemIdx)
+			{
+				break;
+			}
+
+			sortValues[num++] = RenderItemCount(renderItemIdx);
+
+			RenderDraw& renderDraw = m_frame->m_renderItem[renderItemIdx].draw;
+			renderDraw = draw;
+
+			const VertexBufferHandle vertexBuffer = _vertexBuffer[ii];
+			renderDraw.m_stream[0].m_handle = vertexBuffer;
+			renderDraw.m_streamMask         = isValid(vertexBuffer) ? 1 : 0;
+
+			if (NULL != _indexBuffer)
+			{
+				renderDraw.m_indexBuffer = _indexBuffer[ii];
+			}
+
+			if (NULL != _state)
+			{
+				renderDraw.m_stateFlags = _state[ii];
+			}
+
+			if (NULL != _transform)
+			{
+				renderDraw.m_startMatrix = _transform[ii];
+			}
+		}
+
+		m_numSortKeys  += num;
+		m_numSubmitted += num;
+		m_numDropped   += _num - num;
+
+		m_draw.clear();
+		m_bind.clear();
+		m_uniformBegin = m_uniformEnd;
+	}
+
+	void EncoderImpl::allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num)
+	{
+		uint32_t offset = allocTransientIndexBuffer(_num);
+
+		TransientIndexBuffer& tib = *m_frame->m_transientIb;
+
+		_tib->data       = &tib.data[offset];
+		_tib->size       = _num * 2;
+		_tib->handle     = tib.handle;
+		_tib->startIndex = bx::strideAlign(offset, 2)/2;
+	}
+
+	void EncoderImpl::allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl)
+	{
+		// Declaration lookup is the only part that needs resource lock, it's
+		// cached per encoder since handle stays valid until end of frame.
+		if (m_lastDeclHash != _decl.m_hash
+		|| !isValid(m_lastDeclHandle) )
+		{
+			BGFX_MUTEX_SCOPE(s_ctx->m_resourceApiLock);
+
+			m_lastDeclHandle = s_ctx->findTransientVertexDecl(_decl);
+			m_lastDeclHash   = _decl.m_hash;
+		}
+
+		uint32_t offset = allocTransientVertexBuffer(_num, _decl.m_stride);
+
+		TransientVertexBuffer& dvb = *m_frame->m_transientVb;
+
+		_tvb->data        = &dvb.data[offset];
+		_tvb->size        = _num * _decl.m_stride;
+		_tvb->startVertex = bx::strideAlign(offset, _decl.m_stride)/_decl.m_stride;
+		_tvb->stride      = _decl.m_stride;
+		_tvb->handle      = dvb.handle;
+		_tvb->decl        = m_lastDeclHandle;
+	}
+
+	void EncoderImpl::allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
+	{
+		uint16_t stride = BX_ALIGN_16(_stride);
+		uint32_t offset = allocTransientVertexBuffer(_num, stride);
+
+		TransientVertexBuffer& dvb = *m_frame->m_transientVb;
+
+		_idb->data   = &dvb.data[offset];
+		_idb->size   = _num * stride;
+		_idb->offset = offset;
+		_idb->num    = _num;
+		_idb->stride = stride;
+		_idb->handle = dvb.handle;
+	}
+
+	void EncoderImpl::submit(ViewId _id, const DrawBundle& _drawBundle)
+	{
+		BX_CHECK(NULL == m_drawBundle, "Draw bundle can't be submitted while recording draw bundle.");
+
+		const uint32_t num = _drawBundle.m_num;
+		if (0 == num)
+		{
+			return;
+		}
+
+		// Append bundle uniform stream to encoder's stream. Uniforms set on
+		// encoder but not consumed by draw call yet are moved after it, so
+		// that they still apply to next draw call.
+		const uint32_t bundleUniformSize = _drawBundle.m_uniformBuffer->getPos();
+		const uint32_t pendingUniformSize = m_frame->m_uniformBuffer[m_uniformIdx]->getPos() - m_uniformBegin;
+		UniformBuffer::update(
+			  &m_frame->m_uniformBuffer[m_uniformIdx]
+			, bundleUniformSize + pendingUniformSize + (64<<10)
+			, bx::max<uint32_t>(bundleUniformSize + pendingUniformSize, 1<<20)
+			);
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		const uint32_t uniformBase = uniformBuffer->getPos();
+		uniformBuffer->copy(_drawBundle.m_uniformBuffer, 0, bundleUniformSize);
+
+		if (0 != pendingUniformSize)
+		{
+			uniformBuffer->copy(uniformBuffer, m_uniformBegin, uniformBase);
+		}
+
+		m_uniformBegin = uniformBase + bundleUniformSize;
+		m_uniformEnd   = m_uniformBegin;
+
+		// Relocate bundle matrices into frame matrix cache. Index 0 is identity
+		// in both.
+		uint32_t matrixBase = 0;
+		uint16_t numMatrices = uint16_t(bx::min<uint32_t>(_drawBundle.m_numMatrices-1, UINT16_MAX) );
+		if (0 != numMatrices)
+		{
+			matrixBase = m_frame->m_frameCache.m_matrixCache.reserve(&numMatrices);
+			bx::memCopy(
+				  m_frame->m_frameCache.m_matrixCache.toPtr(matrixBase)
+				, &_drawBundle.m_matrix[1]
+				, numMatrices*sizeof(Matrix4)
+				);
+		}
+
+		uint32_t rectBase = 0;
+		uint16_t numRects = uint16_t(bx::min<uint32_t>(_drawBundle.m_numRects, UINT16_MAX) );
+		if (0 != numRects)
+		{
+			rectBase = m_frame->m_frameCache.m_rectCache.reserve(&numRects);
+			bx::memCopy(
+				  &m_frame->m_frameCache.m_rectCache.m_cache[rectBase]
+				, _drawBundle.m_rect
+				, numRects*sizeof(Rect)
+				);
+		}
+
+		const ViewMode::Enum mode = s_ctx->m_view[_id].m_mode;
+		const uint64_t view = (uint64_t(_id) << kSortKeyViewBitShift) & kSortKeyViewMask;
+		const uint32_t seq  = ViewMode::Sequential == mode
+			? s_ctx->getSeqIncr(_id, num)
+			: 0
+			;
+
+		uint32_t localBindIdx = UINT32_MAX;
+		uint32_t bindIdx      = 0;
+
+		const DrawBundle::DynamicRefArray& dynamicRef = _drawBundle.m_dynamicRef;
+		uint32_t dynamicRefIdx = 0;
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			if (localBindIdx != _drawBundle.m_draw[ii].m_bindIdx)
+			{
+				localBindIdx = _drawBundle.m_draw[ii].m_bindIdx;
+				bindIdx      = addRenderBind(_drawBundle.m_bind[localBindIdx]);
+			}
+
+			const uint32_t renderItemIdx = allocRenderItem();
+			if (UINT32_MAX == renderItemIdx)
+			{
+				m_numDropped += num - ii;
+				break;
+			}
+
+			++m_numSubmitted;
+
+			RenderDraw& draw = m_frame->m_renderItem[renderItemIdx].draw;
+			draw = _drawBundle.m_draw[ii];
+			draw.m_uniformIdx    = m_uniformIdx;
+			draw.m_bindIdx       = bindIdx;
+			draw.m_uniformBegin += uniformBase;
+			draw.m_uniformEnd   += uniformBase;
+			// Matrices and rects that didn't fit into frame cache fall back to
+			// identity and no scissor.
+			draw.m_startMatrix = 0 != draw.m_startMatrix && draw.m_startMatrix+draw.m_numMatrices-1 <= numMatrices
+				? draw.m_startMatrix - 1 + matrixBase
+				: 0
+				;
+			draw.m_scissor = draw.m_scissor < numRects
+				? uint16_t(draw.m_scissor + rectBase)
+				: UINT16_MAX
+				;
+
+			for (; dynamicRefIdx < dynamicRef.size() && ii == dynamicRef[dynamicRefIdx].m_draw; ++dynamicRefIdx)
+			{
+				const DrawBundle::DynamicRef& ref = dynamicRef[dynamicRefIdx];
+				if (DrawBundle::DynamicSlot::IndexBuffer == ref.m_slot)
+				{
+					const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[ref.m_handle];
+					draw.m_indexBuffer = dib.m_handle;
+					draw.m_startIndex  = dib.m_startIndex + ref.m_offset;
+				}
+				else if (DrawBundle::DynamicSlot::InstanceDataBuffer == ref.m_slot)
+				{
+					const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[ref.m_handle];
+					draw.m_instanceDataBuffer = dvb.m_handle;
+					draw.m_instanceDataOffset = dvb.m_startVertex*dvb.m_stride + ref.m_offset;
+				}
+				else
+				{
+					const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[ref.m_handle];
+					Stream& stream = draw.m_stream[ref.m_slot];
+					stream.m_handle      = dvb.m_handle;
+					stream.m_startVertex = dvb.m_startVertex + ref.m_offset;
+				}
+			}
+
+			uint64_t key;
+			switch (mode)
+			{
+			case ViewMode::Sequential:
+				{
+					SortKey sortKey = _drawBundle.m_key[ii];
+					sortKey.m_view = _id;
+					sortKey.m_seq  = seq + ii;
+					key = sortKey.encodeDraw(SortKey::SortSequence);
+				}
+				break;
+
+			case ViewMode::DepthAscending:
+			case ViewMode::DepthDescending:
+				{
+					SortKey sortKey = _drawBundle.m_key[ii];
+					sortKey.m_view  = _id;
+					sortKey.m_depth = ViewMode::DepthAscending == mode
+						? sortKey.m_depth
+						: UINT32_MAX-sortKey.m_depth
+						;
+					key = sortKey.encodeDraw(SortKey::SortDepth);
+				}
+				break;
+
+			default:
+				key = _drawBundle.m_sortKey[ii] | view;
+				break;
+			}
+
+			addSortKey(key, renderItemIdx);
+		}
+	}
+
+	void EncoderImpl::dispatch(ViewId _id, ProgramHandle _handle, uint32_t _numX, uint32_t _numY, uint32_t _numZ)
+	{
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
+		{
+			m_uniformSet.clear();
+		}
+
+		BX_CHECK(NULL == m_drawBundle, "Compute can't be dispatched into draw bundle.");
+
+		if (m_discard
+		||  NULL != m_drawBundle)
+		{
+			discard();
+			return;
+		}
+
+		const uint32_t renderItemIdx = allocRenderItem();
+		if (UINT32_MAX == renderItemIdx)
+		{
+			discard();
+			++m_numDropped;
+			return;
+		}
+
+		++m_numSubmitted;
+
+		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+		m_uniformEnd = uniformBuffer->getPos();
+
+		m_compute.m_bindIdx     = addRenderBind(m_bind);
+		m_compute.m_startMatrix = m_draw.m_startMatrix;
+		m_compute.m_numMatrices = m_draw.m_numMatrices;
+		m_compute.m_numX   = bx::max(_numX, 1u);
+		m_compute.m_numY   = bx::max(_numY, 1u);
+		m_compute.m_numZ   = bx::max(_numZ, 1u);
+
+		m_key.m_program = _handle;
+		m_key.m_depth   = 0;
+		m_key.m_view    = _id;
+		m_key.m_seq     = s_ctx->getSeqIncr(_id);
+
+		uint64_t key = m_key.encodeCompute();
+		addSortKey(key, renderItemIdx);
+
+		m_compute.m_uniformIdx   = m_uniformIdx;
+		m_compute.m_uniformBegin = m_uniformBegin;
+		m_compute.m_uniformEnd   = m_uniformEnd;
+		m_frame->m_renderItem[renderItemIdx].compute = m_compute;
+
+		m_compute.clear();
+		m_bind.clear();
+		m_uniformBegin = m_uniformEnd;
+	}
+
+	void EncoderImpl::flushSortKeys()
+	{
+		const uint32_t num = m_numSortKeys;
+		if (0 == num)
+		{
+			return;
+		}
+
+		m_numSortKeys = 0;
+
+		const uint32_t begin = bx::atomicFetchAndAdd<uint32_t>(&m_frame->m_numRenderItems, num);
+
+		bx::radixSort(m_sortKeys, m_tempKeys, m_sortValues, m_tempValues, num);
+
+		{
+			// Frame sort key arrays can be reallocated by other encoder
+			// committing render item page.
+			bx::MutexScope lock(m_frame->m_sortKeyLock);
+
+			BX_CHECK(begin+num <= m_frame->m_maxSortKeys
+				, "Sort keys %d are out of frame sort key storage (max: %d)."
+				, begin+num
+				, m_frame->m_maxSortKeys
+				);
+			bx::memCopy(&m_frame->m_sortKeys[begin],   m_sortKeys,   num*sizeof(uint64_t) );
+			bx::memCopy(&m_frame->m_sortValues[begin], m_sortValues, num*sizeof(RenderItemCount) );
+		}
+
+		Frame::SortRun& run = m_frame->m_sortRun[m_uniformIdx];
+		run.m_begin = begin;
+		run.m_num   = num;
+	}
+
+	void EncoderImpl::blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth)
+	{
+		BX_WARN(m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS
+			, "Exceed number of available blit items per frame. BGFX_CONFIG_MAX_BLIT_ITEMS is %d. Skipping blit."
+			, BGFX_CONFIG_MAX_BLIT_ITEMS
+			);
+		if (m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS)
+		{
+			uint16_t item = m_frame->m_numBlitItems++;
+
+			BlitItem& bi = m_frame->m_blitItem[item];
+			bi.m_srcX    = _srcX;
+			bi.m_srcY    = _srcY;
+			bi.m_srcZ    = _srcZ;
+			bi.m_dstX    = _dstX;
+			bi.m_dstY    = _dstY;
+			bi.m_dstZ    = _dstZ;
+			bi.m_width   = _width;
+			bi.m_height  = _height;
+			bi.m_depth   = _depth;
+			bi.m_srcMip  = _srcMip;
+			bi.m_dstMip  = _dstMip;
+			bi.m_src     = _src;
+			bi.m_dst     = _dst;
+
+			BlitKey key;
+			key.m_view = _id;
+			key.m_item = item;
+			m_frame->m_blitKeys[item] = key.encode();
+		}
+	}
+
+	ParallelRadixSort::ParallelRadixSort()
+		: m_keys(NULL)
+		, m_tempKeys(NULL)
+		, m_values(NULL)
+		, m_tempValues(NULL)
+		, m_viewRemap(NULL)
+		, m_num(0)
+		, m_numChunks(0)
+		, m_chunkSize(0)
+		, m_shift(0)
+		, m_next(0)
+		, m_phase(Phase::Histogram)
+		, m_numThreads(0)
+		, m_exit(false)
+	{
+	}
+
+	ParallelRadixSort::~ParallelRadixSort()
+	{
+		BX_CHECK(0 == m_numThreads, "Sort threads are still running.");
+	}
+
+	void ParallelRadixSort::init(uint16_t _numThreads)
+	{
+		m_numThreads = bx::min<uint16_t>(_numThreads, BGFX_CONFIG_MAX_SORT_THREADS);
+		m_exit       = false;
+
+		BX_TRACE("Parallel sort %s (%d helper threads).", 0 != m_numThreads ? "enabled" : "disabled", m_numThreads);
+
+		for (uint32_t ii = 0, num = m_numThreads; ii < num; ++ii)
+		{
+			m_thread[ii].init(threadFunc, this, 0, "bgfx - sort thread");
+		}
+	}
+
+	void ParallelRadixSort::shutdown()
+	{
+		if (0 == m_numThreads)
+		{
+			return;
+		}
+
+		m_exit = true;
+		m_workSem.post(m_numThreads);
+
+		for (uint32_t ii = 0, num = m_numThreads; ii < num; ++ii)
+		{
+			m_thread[ii].shutdown();
+		}
+
+		m_numThreads = 0;
+	}
+
+	int32_t ParallelRadixSort::threadFunc(bx::Thread* /*_self*/, void* _userData)
+	{
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Sort Thread");
+
+		ParallelRadixSort* radixSort = (ParallelRadixSort*)_userData;
+
+		for (;;)
+		{
+			radixSort->m_workSem.wait();
+
+			if (radixSort->m_exit)
+			{
+				break;
+			}
+
+			radixSort->execute();
+			radixSort->m_doneSem.post();
+		}
+
+		return bx::kExitSuccess;
+	}
+
+	void ParallelRadixSort::dispatch(Phase::Enum _phase)
+	{
+		m_phase = _phase;
+		m_next  = 0;
+
+		m_workSem.post(m_numThreads);
+
+		// Calling thread takes chunks too, helper threads that wake up late
+		// will find no work left and just signal completion.
+		execute();
+
+		for (uint32_t ii = 0, num = m_numThreads; ii < num; ++ii)
+		{
+			m_doneSem.wait();
+		}
+	}
+
+	void ParallelRadixSort::execute()
+	{
+		for (uint32_t chunk = bx::atomicFetchAndAdd<uint32_t>(&m_next, 1)
+			; chunk < m_numChunks
+			; chunk = bx::atomicFetchAndAdd<uint32_t>(&m_next, 1)
+			)
+		{
+			if (Phase::Histogram == m_phase)
+			{
+				histogram(chunk);
+			}
+			else
+			{
+				scatter(chunk);
+			}
+		}
+	}
+
+	void ParallelRadixSort::histogram(uint32_t _chunk)
+	{
+		const uint32_t begin = bx::min(_chunk*m_chunkSize, m_num);
+		const uint32_t end   = bx::min(begin+m_chunkSize,  m_num);
+
+		uint32_t* histogram = m_histogram[_chunk];
+		bx::memSet(histogram, 0, sizeof(m_histogram[0]) );
+
+		uint64_t*     keys      = m_keys;
+		const ViewId* viewRemap = m_viewRemap;
+		const uint32_t shift    = m_shift;
+
+		bool sorted = true;
+		uint64_t prevKey = 0;
+
+		for (uint32_t ii = begin; ii < end; ++ii)
+		{
+			uint64_t key = keys[ii];
+
+			if (NULL != viewRemap)
+			{
+				key = SortKey::remapView(key, viewRemap);
+				keys[ii] = key;
+			}
+
+			++histogram[(key>>shift) & kRadixMask];
+			sorted &= prevKey <= key;
+			prevKey = key;
+		}
+
+		m_sorted[_chunk] = sorted;
+	}
+
+	void ParallelRadixSort::scatter(uint32_t _chunk)
+	{
+		const uint32_t begin = bx::min(_chunk*m_chunkSize, m_num);
+		const uint32_t end   = bx::min(begin+m_chunkSize,  m_num);
+
+		uint32_t* offset = m_histogram[_chunk];
+
+		const uint64_t*        keys       = m_keys;
+		const RenderItemCount* values     = m_values;
+		uint64_t*              tempKeys   = m_tempKeys;
+		RenderItemCount*       tempValues = m_tempValues;
+		const uint32_t shift = m_shift;
+
+		for (uint32_t ii = begin; ii < end; ++ii)
+		{
+			const uint64_t key  = keys[ii];
+			const uint32_t dest = offset[(key>>shift) & kRadixMask]++;
+			tempKeys[dest]   = key;
+			tempValues[dest] = values[ii];
+		}
+	}
+
+	bool ParallelRadixSort::isSorted() const
+	{
+		for (uint32_t ii = 0, num = m_numChunks; ii < num; ++ii)
+		{
+			if (!m_sorted[ii])
+			{
+				return false;
+			}
+		}
+
+		for (uint32_t ii = 1, num = m_numChunks; ii < num; ++ii)
+		{
+			const uint32_t first = ii*m_chunkSize;
+			if (first < m_num
+			&&  m_keys[first-1] > m_keys[first])
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void ParallelRadixSort::sort(
+		  uint64_t* _keys
+		, uint64_t* _tempKeys
+		, RenderItemCount* _values
+		, RenderItemCount* _tempValues
+		, uint32_t _num
+		, const ViewId* _viewRemap
+		)
+	{
+		BX_CHECK(0 != m_numThreads, "Parallel sort is not initialized.");
+
+		m_keys       = _keys;
+		m_tempKeys   = _tempKeys;
+		m_values     = _values;
+		m_tempValues = _tempValues;
+		m_viewRemap  = _viewRemap;
+		m_num        = _num;
+		m_numChunks  = m_numThreads+1;
+		m_chunkSize  = (_num + m_numChunks - 1) / m_numChunks;
+
+		for (uint32_t pass = 0; pass < kNumPasses; ++pass)
+		{
+			m_shift = pass*kRadixBits;
+
+			dispatch(Phase::Histogram);
+			m_viewRemap = NULL;
+
+			if (isSorted() )
+			{
+				break;
+			}
+
+			// Exclusive prefix sum in bucket-major, chunk-minor order, so that
+			// each chunk scatters into its own range and sort stays stable.
+			bool skip = false;
+			uint32_t offset = 0;
+			for (uint32_t bucket = 0; bucket < kHistogramSize; ++bucket)
+			{
+				const uint32_t bucketBegin = offset;
+
+				for (uint32_t chunk = 0, numChunks = m_numChunks; chunk < numChunks; ++chunk)
+				{
+					const uint32_t count = m_histogram[chunk][bucket];
+					m_histogram[chunk][bucket] = offset;
+					offset += count;
+				}
+
+				skip |= offset - bucketBegin == _num;
+			}
+
+			// All keys have the same digit, scatter would be identity copy.
+			if (skip)
+			{
+				continue;
+			}
+
+			dispatch(Phase::Scatter);
+
+			bx::swap(m_keys,   m_tempKeys);
+			bx::swap(m_values, m_tempValues);
+		}
+
+		if (m_keys != _keys)
+		{
+			bx::memCopy(_keys,   m_keys,   _num*sizeof(uint64_t) );
+			bx::memCopy(_values, m_values, _num*sizeof(RenderItemCount) );
+		}
+	}
+
+	TextureDecoder::TextureDecoder()
+		: m_numThreads(0)
+		, m_exit(false)
+	{
+		m_pending.m_head = NULL;
+		m_pending.m_tail = NULL;
+		m_done.m_head    = NULL;
+		m_done.m_tail    = NULL;
+	}
+
+	TextureDecoder::~TextureDecoder()
+	{
+		BX_CHECK(0 == m_numThreads, "Texture decode threads are still running.");
+	}
+
+	void TextureDecoder::init(uint16_t _numThreads)
+	{
+		m_numThreads = bx::min<uint16_t>(_numThreads, BGFX_CONFIG_MAX_TEXTURE_DECODE_THREADS);
+		m_exit       = false;
+
+		BX_TRACE("Texture decode threads: %d.", m_numThreads);
+
+		for (uint32_t ii = 0, num = m_numThreads; ii < num; ++ii)
+		{
+			m_thread[ii].init(threadFunc, this, 0, "bgfx - texture decode thread");
+		}
+	}
+
+	static void releaseTextureMemory(const Memory* _mem)
+	{
+		bx::MemoryReader reader(_mem->data, _mem->size);
+
+		uint32_t magic;
+		bx::read(&reader, magic);
+
+		if (BGFX_CHUNK_MAGIC_TEX == magic)
+		{
+			TextureCreate tc;
+			bx::read(&reader, tc);
+
+			if (NULL != tc.m_mem)
+			{
+				release(tc.m_mem);
+			}
+		}
+
+		release(_mem);
+	}
+
+	void TextureDecoder::shutdown()
+	{
+		if (0 != m_numThreads)
+		{
+			m_exit = true;
+			m_workSem.post(m_numThreads);
+
+			for (uint32_t ii = 0, num = m_numThreads; ii < num; ++ii)
+			{
+				m_thread[ii].shutdown();
+			}
+
+			m_numThreads = 0;
+		}
+
+		for (TextureDecodeJob* job = m_pending.pop(); NULL != job; job = m_pending.pop() )
+		{
+			releaseTextureMemory(job->m_mem);
+			BX_DELETE(g_allocator, job);
+		}
+
+		for (TextureDecodeJob* job = m_done.pop(); NULL != job; job = m_done.pop() )
+		{
+			releaseTextureMemory(job->m_mem);
+
+			if (NULL != job->m_result)
+			{
+				releaseTextureMemory(job->m_result);
+			}
+
+			BX_DELETE(g_allocator, job);
+		}
+	}
+
+	TextureDecodeJob* TextureDecoder::push(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip, bool _fallback)
+	{
+		TextureDecodeJob* job = BX_NEW(g_allocator, TextureDecodeJob);
+		job->m_next     = NULL;
+		job->m_mem      = _mem;
+		job->m_result   = NULL;
+		job->m_flags    = _flags;
+		job->m_handle   = _handle;
+		job->m_skip     = _skip;
+		job->m_fallback = _fallback;
+		job->m_canceled = false;
+		job->m_failed   = false;
+
+		if (0 == m_numThreads)
+		{
+			job->m_failed = !decode(job->m_result, _mem, _skip);
+			m_done.push(job);
+			return job;
+		}
+
+		{
+			bx::MutexScope lock(m_lock);
+			m_pending.push(job);
+		}
+
+		m_workSem.post();
+
+		return job;
+	}
+
+	TextureDecodeJob* TextureDecoder::pop()
+	{
+		bx::MutexScope lock(m_lock);
+		return m_done.pop();
+	}
+
+	bool TextureDecoder::decode(const Memory*& _result, const Memory* _mem, uint8_t _skip)
+	{
+		_result = NULL;
+
+		bimg::ImageContainer imageContainer;
+		if (!bimg::imageParse(imageContainer, _mem->data, _mem->size) )
+		{
+			return false;
+		}
+
+		const uint16_t formatCaps = imageContainer.m_cubeMap
+			? BGFX_CAPS_FORMAT_TEXTURE_CUBE
+			: 1 < imageContainer.m_depth
+			? BGFX_CAPS_FORMAT_TEXTURE_3D
+			: BGFX_CAPS_FORMAT_TEXTURE_2D
+			;
+
+		// Volume textures are decoded slice by slice by renderer, only skipped
+		// mips are dropped here.
+		const bool convert = true
+			&& 1 >= imageContainer.m_depth
+			&& 0 == (g_caps.formats[imageContainer.m_format] & formatCaps)
+			&& 0 != (g_caps.formats[TextureFormat::RGBA8]    & formatCaps)
+			;
+
+		const uint8_t startLod = bx::min<uint8_t>(_skip, imageContainer.m_numMips-1);
+
+		if (!convert
+		&&  0 == startLod)
+		{
+			return true;
+		}
+
+		const uint32_t width    = bx::max<uint32_t>(1, imageContainer.m_width >>startLod);
+		const uint32_t height   = bx::max<uint32_t>(1, imageContainer.m_height>>startLod);
+		const uint32_t depth    = bx::max<uint32_t>(1, imageContainer.m_depth >>startLod);
+		const uint8_t  numMips  = imageContainer.m_numMips-startLod;
+		const uint16_t numSides = imageContainer.m_numLayers * (imageContainer.m_cubeMap ? 6 : 1);
+
+		uint32_t size    = 0;
+		uint32_t maxTemp = 0;
+
+		for (uint16_t side = 0; side < numSides; ++side)
+		{
+			for (uint8_t lod = 0; lod < numMips; ++lod)
+			{
+				bimg::ImageMip mip;
+				if (!bimg::imageGetRawData(imageContainer, side, lod+startLod, _mem->data, _mem->size, mip) )
+				{
+					return false;
+				}
+
+				if (convert)
+				{
+					const uint32_t mipWidth  = bx::max<uint32_t>(1, width >>lod);
+					const uint32_t mipHeight = bx::max<uint32_t>(1, height>>lod);
+					size   += mipWidth*mipHeight*4;
+					maxTemp = bx::max<uint32_t>(maxTemp, mip.m_width*mip.m_height*4);
+				}
+				else
+				{
+					size += mip.m_size;
+				}
+			}
+		}
+
+		const Memory* raw = alloc(size);
+		uint8_t* dst = raw->data;
+		uint8_t* temp = convert ? (uint8_t*)BX_ALLOC(g_allocator, maxTemp) : NULL;
+
+		for (uint16_t side = 0; side < numSides; ++side)
+		{
+			for (uint8_t lod = 0; lod < numMips; ++lod)
+			{
+				bimg::ImageMip mip;
+				bimg::imageGetRawData(imageContainer, side, lod+startLod, _mem->data, _mem->size, mip);
+
+				if (convert)
+				{
+					// Decoded mip is block aligned, copy out only texels.
+					const uint32_t mipWidth  = bx::max<uint32_t>(1, width >>lod);
+					const uint32_t mipHeight = bx::max<uint32_t>(1, height>>lod);
+					bimg::imageDecodeToRgba8(g_allocator, temp, mip.m_data, mip.m_width, mip.m_height, mip.m_width*4, mip.m_format);
+					bx::memCopy(dst, temp, mipWidth*4, mipHeight, mip.m_width*4, mipWidth*4);
+					dst += mipWidth*mipHeight*4;
+				}
+				else
+				{
+					bx::memCopy(dst, mip.m_data, mip.m_size);
+					dst += mip.m_size;
+				}
+			}
+		}
+
+		if (NULL != temp)
+		{
+			BX_FREE(g_allocator, temp);
+		}
+
+		const Memory* mem = alloc(sizeof(uint32_t)+sizeof(TextureCreate) );
+
+		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+		bx::write(&writer, magic);
+
+		TextureCreate tc;
+		tc.m_width     = uint16_t(width);
+		tc.m_height    = uint16_t(height);
+		tc.m_depth     = uint16_t(1 < imageContainer.m_depth ? depth : 0);
+		tc.m_numLayers = imageContainer.m_numLayers;
+		tc.m_numMips   = numMips;
+		tc.m_format    = convert ? TextureFormat::RGBA8 : TextureFormat::Enum(imageContainer.m_format);
+		tc.m_cubeMap   = imageContainer.m_cubeMap;
+		tc.m_mem       = raw;
+		bx::write(&writer, tc);
+
+		_result = mem;
+
+		return true;
+	}
+
+	void TextureDecoder::Queue::push(TextureDecodeJob* _job)
+	{
+		_job->m_next = NULL;
+
+		if (NULL == m_tail)
+		{
+			m_head = _job;
+		}
+		else
+		{
+			m_tail->m_next = _job;
+		}
+
+		m_tail = _job;
+	}
+
+	TextureDecodeJob* TextureDecoder::Queue::pop()
+	{
+		TextureDecodeJob* job = m_head;
+
+		if (NULL != job)
+		{
+			m_head = job->m_next;
+			m_tail = NULL == m_head ? NULL : m_tail;
+		}
+
+		return job;
+	}
+
+	int32_t TextureDecoder::threadFunc(bx::Thread* /*_self*/, void* _userData)
+	{
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Texture Decode Thread");
+
+		TextureDecoder* decoder = (TextureDecoder*)_userData;
+
+		for (;;)
+		{
+			decoder->m_workSem.wait();
+
+			if (decoder->m_exit)
+			{
+				break;
+			}
+
+			TextureDecodeJob* job;
+			{
+				bx::MutexScope lock(decoder->m_lock);
+				job = decoder->m_pending.pop();
+			}
+
+			if (NULL != job)
+			{
+				job->m_failed = !decode(job->m_result, job->m_mem, job->m_skip);
+
+				bx::MutexScope lock(decoder->m_lock);
+				decoder->m_done.push(job);
+			}
+		}
+
+		return bx::kExitSuccess;
+	}
+
+	// Returns index of first key in [_begin, _end) with view equal or greater
+	// than _view.
+	static uint32_t viewLowerBound(const uint64_t* _keys, uint32_t _begin, uint32_t _end, uint32_t _view)
+	{
+		uint32_t num = _end - _begin;
+
+		while (0 < num)
+		{
+			const uint32_t half = num/2;
+			const uint32_t mid  = _begin + half;
+
+			if (SortKey::decodeView(_keys[mid]) < _view)
+			{
+				_begin = mid + 1;
+				num   -= half + 1;
+			}
+			else
+			{
+				num = half;
+			}
+		}
+
+		return _begin;
+	}
+
+	// K-way merge of sorted segments. Ties are taken from segment with lower
+	// index, so order of runs is preserved for equal keys.
+	static uint32_t mergeSegments(
+		  uint64_t* _outKeys
+		, RenderItemCount* _outValues
+		, uint32_t _out
+		, const uint64_t* _keys
+		, const RenderItemCount* _values
+		, uint32_t* _cursor
+		, uint32_t* _end
+		, uint32_t _num
+		, const ViewId* _viewRemap
+		)
+	{
+		while (1 < _num)
+		{
+			uint32_t minIdx = 0;
+			uint64_t minKey = _keys[_cursor[0] ];
+
+			for (uint32_t ii = 1; ii < _num; ++ii)
+			{
+				const uint64_t key = _keys[_cursor[ii] ];
+				if (key < minKey)
+				{
+					minIdx = ii;
+					minKey = key;
+				}
+			}
+
+			const uint32_t idx = _cursor[minIdx]++;
+			_outKeys[_out]   = SortKey::remapView(minKey, _viewRemap);
+			_outValues[_out] = _values[idx];
+			++_out;
+
+			if (_cursor[minIdx] == _end[minIdx])
+			{
+				--_num;
+				for (uint32_t ii = minIdx; ii < _num; ++ii)
+				{
+					_cursor[ii] = _cursor[ii+1];
+					_end[ii]    = _end[ii+1];
+				}
+			}
+		}
+
+		if (1 == _num)
 		{
-			discard();
-			++m_numDropped;
-			return;
+			for (uint32_t idx = _cursor[0], end = _end[0]; idx < end; ++idx, ++_out)
+			{
+				_outKeys[_out]   = SortKey::remapView(_keys[idx], _viewRemap);
+				_outValues[_out] = _values[idx];
+			}
 		}
 
-		++m_numSubmitted;
+		return _out;
+	}
 
-		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
-		m_uniformEnd = uniformBuffer->getPos();
+	void Frame::mergeRenderBinds()
+	{
+		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+		{
+			BindTable& bindTable = m_bindTable[ii];
+			const SortRun& run = m_sortRun[ii];
 
-		m_key.m_program = isValid(_program)
-			? _program
-			: ProgramHandle{0}
-			;
+			if (1 >= bindTable.m_num
+			||  0 == run.m_num)
+			{
+				continue;
+			}
 
-		m_key.m_view = _id;
+			bool identity = true;
+			for (uint32_t jj = 0, numBinds = bindTable.m_num; jj < numBinds; ++jj)
+			{
+				const uint32_t idx = addRenderBind(bindTable.m_bind[jj], bindTable.m_hash[jj]);
+				bindTable.m_remap[jj] = idx;
+				identity &= idx == jj;
+			}
 
-		SortKey::Enum type = SortKey::SortProgram;
-		switch (s_ctx->m_view[_id].m_mode)
-		{
-		case ViewMode::Sequential:      m_key.m_seq   = s_ctx->getSeqIncr(_id); type = SortKey::SortSequence; break;
-		case ViewMode::DepthAscending:  m_key.m_depth =            _depth;      type = SortKey::SortDepth;    break;
-		case ViewMode::DepthDescending: m_key.m_depth = UINT32_MAX-_depth;      type = SortKey::SortDepth;    break;
-		default: break;
+			if (identity)
+			{
+				continue;
+			}
+
+			// Every render item submitted by encoder has sort key in encoder's
+			// run.
+			for (uint32_t jj = run.m_begin, end = run.m_begin + run.m_num; jj < end; ++jj)
+			{
+				RenderItem& renderItem = m_renderItem[m_sortValues[jj] ];
+
+				if (0 != (m_sortKeys[jj] & kSortKeyDrawBit) )
+				{
+					renderItem.draw.m_bindIdx = bindTable.m_remap[renderItem.draw.m_bindIdx];
+				}
+				else
+				{
+					renderItem.compute.m_bindIdx = bindTable.m_remap[renderItem.compute.m_bindIdx];
+				}
+			}
 		}
+	}
 
-		uint64_t key = m_key.encodeDraw(type);
+	bool Frame::mergeSortRuns(const ViewId* _viewRemap)
+	{
+		uint32_t runBegin[BGFX_CONFIG_MAX_SORT_MERGE_RUNS];
+		uint32_t runEnd[BGFX_CONFIG_MAX_SORT_MERGE_RUNS];
+		uint32_t numRuns = 0;
 
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+		{
+			const SortRun& run = m_sortRun[ii];
+			if (0 != run.m_num)
+			{
+				if (BGFX_CONFIG_MAX_SORT_MERGE_RUNS == numRuns)
+				{
+					return false;
+				}
 
-		m_draw.m_uniformIdx   = m_uniformIdx;
-		m_draw.m_uniformBegin = m_uniformBegin;
-		m_draw.m_uniformEnd   = m_uniformEnd;
+				runBegin[numRuns] = run.m_begin;
+				runEnd[numRuns]   = run.m_begin + run.m_num;
+				++numRuns;
+			}
+		}
 
-		if (UINT8_MAX != m_draw.m_streamMask)
+		bool identity = true;
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 		{
-			uint32_t numVertices = UINT32_MAX;
-			for (uint32_t idx = 0, streamMask = m_draw.m_streamMask
-				; 0 != streamMask
-				; streamMask >>= 1, idx += 1
-				)
+			// View order that is not permutation can't be merged per view.
+			if (_viewRemap[m_viewRemap[ii] ] != ii)
 			{
-				const uint32_t ntz = bx::uint32_cnttz(streamMask);
-				streamMask >>= ntz;
-				idx         += ntz;
-				numVertices = bx::min(numVertices, m_numVertices[idx]);
+				return false;
 			}
 
-			m_draw.m_numVertices = numVertices;
+			identity &= m_viewRemap[ii] == ii;
 		}
-		else
+
+		if (identity
+		&&  1 >= numRuns)
 		{
-			m_draw.m_numVertices = m_numVertices[0];
+			return true;
 		}
 
-		if (isValid(_occlusionQuery) )
+		uint64_t*        tempKeys   = s_ctx->m_tempKeys;
+		RenderItemCount* tempValues = s_ctx->m_tempValues;
+
+		uint32_t cursor[BGFX_CONFIG_MAX_SORT_MERGE_RUNS];
+		uint32_t end[BGFX_CONFIG_MAX_SORT_MERGE_RUNS];
+		uint32_t out = 0;
+
+		if (identity)
 		{
-			m_draw.m_stateFlags |= BGFX_STATE_INTERNAL_OCCLUSION_QUERY;
-			m_draw.m_occlusionQuery = _occlusionQuery;
+			bx::memCopy(cursor, runBegin, numRuns*sizeof(uint32_t) );
+			bx::memCopy(end,    runEnd,   numRuns*sizeof(uint32_t) );
+			out = mergeSegments(tempKeys, tempValues, out, m_sortKeys, m_sortValues, cursor, end, numRuns, _viewRemap);
 		}
+		else
+		{
+			// Runs are sorted by view id submitted, but output must follow view
+			// order. View is the most significant part of key, so for each view
+			// in order, merge only its segment from every run.
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			{
+				const uint32_t view = m_viewRemap[ii];
+				uint32_t num = 0;
 
-		m_frame->m_renderItem[renderItemIdx].draw = m_draw;
-		m_frame->m_renderItemBind[renderItemIdx]  = m_bind;
+				for (uint32_t run = 0; run < numRuns; ++run)
+				{
+					const uint32_t first = viewLowerBound(m_sortKeys, runBegin[run], runEnd[run], view);
+					const uint32_t last  = viewLowerBound(m_sortKeys, first,         runEnd[run], view+1);
 
-		if (!_preserveState)
-		{
-			m_draw.clear();
-			m_bind.clear();
-			m_uniformBegin = m_uniformEnd;
+					if (first != last)
+					{
+						cursor[num] = first;
+						end[num]    = last;
+						++num;
+					}
+				}
+
+				out = mergeSegments(tempKeys, tempValues, out, m_sortKeys, m_sortValues, cursor, end, num, _viewRemap);
+			}
 		}
+
+		BX_CHECK(out == m_numRenderItems, "Merged %d sort keys, expected %d.", out, m_numRenderItems);
+
+		bx::memCopy(m_sortKeys,   tempKeys,   out*sizeof(uint64_t) );
+		bx::memCopy(m_sortValues, tempValues, out*sizeof(RenderItemCount) );
+
+		return true;
 	}
 
-	void EncoderImpl::dispatch(ViewId _id, ProgramHandle _handle, uint32_t _numX, uint32_t _numY, uint32_t _numZ)
+	void Frame::sort()
 	{
-		if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
+		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
+
+		const int64_t timeBegin = bx::getHPCounter();
+
+		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 		{
-			m_uniformSet.clear();
+			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
 		}
 
-		if (m_discard)
+		s_ctx->reserveTempKeys(m_numRenderItems);
+
+		if (mergeSortRuns(viewRemap) )
 		{
-			discard();
-			return;
+			// Encoders already sorted their own keys.
 		}
-
-		const uint32_t renderItemIdx = bx::atomicFetchAndAddsat<uint32_t>(&m_frame->m_numRenderItems, 1, BGFX_CONFIG_MAX_DRAW_CALLS);
-		if (BGFX_CONFIG_MAX_DRAW_CALLS-1 <= renderItemIdx)
+		else if (s_ctx->m_parallelSort.isEnabled()
+		&&  BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS <= m_numRenderItems)
 		{
-			discard();
-			++m_numDropped;
-			return;
+			s_ctx->m_parallelSort.sort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems, viewRemap);
+		}
+		else
+		{
+			for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+			{
+				m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
+			}
+			bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
 		}
 
-		++m_numSubmitted;
-
-		UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
-		m_uniformEnd = uniformBuffer->getPos();
-
-		m_compute.m_startMatrix = m_draw.m_startMatrix;
-		m_compute.m_numMatrices = m_draw.m_numMatrices;
-		m_compute.m_numX   = bx::max(_numX, 1u);
-		m_compute.m_numY   = bx::max(_numY, 1u);
-		m_compute.m_numZ   = bx::max(_numZ, 1u);
-
-		m_key.m_program = _handle;
-		m_key.m_depth   = 0;
-		m_key.m_view    = _id;
-		m_key.m_seq     = s_ctx->getSeqIncr(_id);
+		if (0 != (g_caps.supported & BGFX_CAPS_INSTANCING) )
+		{
+			autoInstance();
+		}
 
-		uint64_t key = m_key.encodeCompute();
-		m_frame->m_sortKeys[renderItemIdx]   = key;
-		m_frame->m_sortValues[renderItemIdx] = RenderItemCount(renderItemIdx);
+		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		{
+			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+		}
+		bx::radixSort(m_blitKeys, (uint32_t*)s_ctx->m_tempKeys, m_numBlitItems);
 
-		m_compute.m_uniformIdx   = m_uniformIdx;
-		m_compute.m_uniformBegin = m_uniformBegin;
-		m_compute.m_uniformEnd   = m_uniformEnd;
-		m_frame->m_renderItem[renderItemIdx].compute = m_compute;
-		m_frame->m_renderItemBind[renderItemIdx]     = m_bind;
+		m_phaseTime[Phase::Sort] = bx::getHPCounter() - timeBegin;
+	}
 
-		m_compute.clear();
-		m_bind.clear();
-		m_uniformBegin = m_uniformEnd;
+	// Draw call can be instanced when its only transform is in matrix cache,
+	// and nothing else is drawn per instance or depends on draw call count.
+	static bool isAutoInstanceable(const RenderDraw& _draw)
+	{
+		return true
+			&& 1 == _draw.m_numMatrices
+			&& 1 == _draw.m_numInstances
+			&& !isValid(_draw.m_instanceDataBuffer)
+			&& !isValid(_draw.m_indirectBuffer)
+			&& !isValid(_draw.m_occlusionQuery)
+			;
 	}
 
-	void EncoderImpl::blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth)
+	// Draw call _b can be merged into instanced draw call _a when everything
+	// but model transform is the same. Empty uniform range means _b doesn't
+	// change any uniforms set by draw calls before it.
+	static bool isSameInstance(const RenderDraw& _a, const RenderDraw& _b)
 	{
-		BX_WARN(m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS
-			, "Exceed number of available blit items per frame. BGFX_CONFIG_MAX_BLIT_ITEMS is %d. Skipping blit."
-			, BGFX_CONFIG_MAX_BLIT_ITEMS
-			);
-		if (m_frame->m_numBlitItems < BGFX_CONFIG_MAX_BLIT_ITEMS)
+		if (_a.m_streamMask != _b.m_streamMask)
 		{
-			uint16_t item = m_frame->m_numBlitItems++;
+			return false;
+		}
 
-			BlitItem& bi = m_frame->m_blitItem[item];
-			bi.m_srcX    = _srcX;
-			bi.m_srcY    = _srcY;
-			bi.m_srcZ    = _srcZ;
-			bi.m_dstX    = _dstX;
-			bi.m_dstY    = _dstY;
-			bi.m_dstZ    = _dstZ;
-			bi.m_width   = _width;
-			bi.m_height  = _height;
-			bi.m_depth   = _depth;
-			bi.m_srcMip  = _srcMip;
-			bi.m_dstMip  = _dstMip;
-			bi.m_src     = _src;
-			bi.m_dst     = _dst;
+		for (uint32_t idx = 0, streamMask = _a.m_streamMask
+			; 0 != streamMask
+			; streamMask >>= 1, idx += 1
+			)
+		{
+			const uint32_t ntz = bx::uint32_cnttz(streamMask);
+			streamMask >>= ntz;
+			idx         += ntz;
 
-			BlitKey key;
-			key.m_view = _id;
-			key.m_item = item;
-			m_frame->m_blitKeys[item] = key.encode();
+			const Stream& a = _a.m_stream[idx];
+			const Stream& b = _b.m_stream[idx];
+			if (a.m_handle.idx    != b.m_handle.idx
+			||  a.m_decl.idx      != b.m_decl.idx
+			||  a.m_startVertex   != b.m_startVertex)
+			{
+				return false;
+			}
 		}
+
+		return true
+			&& _a.m_stateFlags      == _b.m_stateFlags
+			&& _a.m_stencil         == _b.m_stencil
+			&& _a.m_rgba            == _b.m_rgba
+			&& _a.m_startIndex      == _b.m_startIndex
+			&& _a.m_numIndices      == _b.m_numIndices
+			&& _a.m_numVertices     == _b.m_numVertices
+			&& _a.m_scissor         == _b.m_scissor
+			&& _a.m_bindIdx         == _b.m_bindIdx
+			&& _a.m_submitFlags     == _b.m_submitFlags
+			&& _a.m_indexBuffer.idx == _b.m_indexBuffer.idx
+			&& _b.m_uniformBegin    == _b.m_uniformEnd
+			;
 	}
 
-	void Frame::sort()
+	void Frame::autoInstance()
 	{
-		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
+		bool enabled = false;
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS && !enabled; ++ii)
+		{
+			enabled = m_view[ii].m_autoInstancing;
+		}
 
-		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
-		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		if (!enabled)
 		{
-			viewRemap[m_viewRemap[ii] ] = ViewId(ii);
+			return;
 		}
 
-		for (uint32_t ii = 0, num = m_numRenderItems; ii < num; ++ii)
+		BGFX_PROFILER_SCOPE("bgfx/Auto instance", 0xff2040ff);
+
+		const uint16_t stride = sizeof(Matrix4);
+		const MatrixCache& matrixCache = m_frameCache.m_matrixCache;
+		TransientVertexBuffer& tvb = *m_transientVb;
+
+		// Shaders used in auto-instanced view read model transform from
+		// instance data, so every draw call in view needs it, merged or not.
+		// Draw calls with their own instance data buffer keep it.
+		uint32_t numNeeded = 0;
+		for (uint32_t ii = 0, numItems = m_numRenderItems; ii < numItems; ++ii)
 		{
-			m_sortKeys[ii] = SortKey::remapView(m_sortKeys[ii], viewRemap);
+			SortKey key;
+			if (!key.decode(m_sortKeys[ii], m_viewRemap)
+			&&  m_view[key.m_view].m_autoInstancing)
+			{
+				const RenderDraw& draw = m_renderItem[m_sortValues[ii] ].draw;
+				if (!isValid(draw.m_instanceDataBuffer) )
+				{
+					numNeeded += bx::max<uint32_t>(draw.m_numInstances, 1);
+				}
+			}
 		}
-		bx::radixSort(m_sortKeys, s_ctx->m_tempKeys, m_sortValues, s_ctx->m_tempValues, m_numRenderItems);
 
-		for (uint32_t ii = 0, num = m_numBlitItems; ii < num; ++ii)
+		uint32_t numAvail = numNeeded;
+		const uint32_t offset = reserveTransient(&m_vboffset, g_caps.limits.transientVbSize, stride, numAvail);
+		BX_WARN(numAvail == numNeeded
+			, "Auto instancing: transient vertex buffer can't hold %d model transforms, draw calls without it are dropped."
+			, numNeeded
+			);
+
+		uint32_t numUsed = 0;
+		uint32_t num     = 0;
+		for (uint32_t ii = 0, numItems = m_numRenderItems; ii < numItems;)
 		{
-			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
+			const uint64_t encodedKey = m_sortKeys[ii];
+			const RenderItemCount itemIdx = m_sortValues[ii];
+
+			m_sortKeys[num]   = encodedKey;
+			m_sortValues[num] = itemIdx;
+			++num;
+
+			SortKey key;
+			const bool isCompute = key.decode(encodedKey, m_viewRemap);
+			RenderDraw& draw = m_renderItem[itemIdx].draw;
+
+			if (isCompute
+			|| !m_view[key.m_view].m_autoInstancing
+			||  isValid(draw.m_instanceDataBuffer) )
+			{
+				++ii;
+				continue;
+			}
+
+			if (!isAutoInstanceable(draw) )
+			{
+				// Draw call is not merged, but still gets its transform as
+				// instance data, once for each instance.
+				const uint32_t numInstances = bx::max<uint32_t>(draw.m_numInstances, 1);
+				if (numUsed + numInstances > numAvail)
+				{
+					--num;
+					++ii;
+					continue;
+				}
+
+				for (uint32_t jj = 0; jj < numInstances; ++jj)
+				{
+					bx::memCopy(&tvb.data[offset + (numUsed+jj)*stride], matrixCache.m_cache[draw.m_startMatrix].un.val, stride);
+				}
+
+				draw.m_instanceDataBuffer.idx = tvb.handle.idx;
+				draw.m_instanceDataOffset     = offset + numUsed*stride;
+				draw.m_instanceDataStride     = stride;
+				draw.m_numInstances           = numInstances;
+
+				numUsed += numInstances;
+				++ii;
+				continue;
+			}
+
+			uint32_t end = ii+1;
+			for (; end < numItems; ++end)
+			{
+				SortKey next;
+				if (next.decode(m_sortKeys[end], m_viewRemap)
+				||  next.m_view        != key.m_view
+				||  next.m_program.idx != key.m_program.idx)
+				{
+					break;
+				}
+
+				const RenderDraw& nextDraw = m_renderItem[m_sortValues[end] ].draw;
+				if (!isAutoInstanceable(nextDraw)
+				||  !isSameInstance(draw, nextDraw) )
+				{
+					break;
+				}
+			}
+
+			const uint32_t numInstances = bx::min<uint32_t>(end-ii, numAvail-numUsed);
+			if (0 == numInstances)
+			{
+				// Out of transient memory, draw call can't get its transform.
+				--num;
+				++ii;
+				continue;
+			}
+
+			for (uint32_t jj = 0; jj < numInstances; ++jj)
+			{
+				const RenderDraw& instance = m_renderItem[m_sortValues[ii+jj] ].draw;
+				bx::memCopy(&tvb.data[offset + (numUsed+jj)*stride], matrixCache.m_cache[instance.m_startMatrix].un.val, stride);
+			}
+
+			draw.m_instanceDataBuffer.idx = tvb.handle.idx;
+			draw.m_instanceDataOffset     = offset + numUsed*stride;
+			draw.m_instanceDataStride     = stride;
+			draw.m_numInstances           = numInstances;
+
+			numUsed += numInstances;
+			ii      += numInstances;
 		}
-		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
+
+		m_numRenderItems = num;
 	}
 
 	RenderFrame::Enum renderFrame(int32_t _msecs)
@@ -1422,9 +2877,30 @@ namespace bgfx
 
 	void UniformBuffer::writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num)
 	{
+		const uint32_t size = g_uniformTypeSize[_type]*_num;
 		uint32_t opcode = encodeOpcode(_type, _loc, _num, true);
 		write(opcode);
-		write(_value, g_uniformTypeSize[_type]*_num);
+		write(_value, size);
+		m_bytesWritten += sizeof(opcode) + size;
+	}
+
+	void UniformBuffer::writeUniformRef(UniformType::Enum _type, uint16_t _loc, uint32_t _pos, uint16_t _num)
+	{
+		uint32_t opcode = encodeOpcode(_type, _loc, _num, false);
+		write(opcode);
+		write(_pos);
+		m_bytesWritten += sizeof(opcode) + sizeof(_pos);
+		m_bytesSkipped += g_uniformTypeSize[_type]*_num;
+	}
+
+	bool UniformBuffer::isUniformEqual(uint32_t _pos, UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num) const
+	{
+		uint32_t opcode;
+		bx::memCopy(&opcode, &m_buffer[_pos], sizeof(opcode) );
+
+		return encodeOpcode(_type, _loc, _num, true) == opcode
+			&& 0 == bx::memCmp(&m_buffer[_pos + sizeof(opcode)], _value, g_uniformTypeSize[_type]*_num)
+			;
 	}
 
 	void UniformBuffer::writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num)
@@ -1743,6 +3219,8 @@ namespace bgfx
 	{
 		BX_CHECK(!m_rendererInitialized, "Already initialized?");
 
+		BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - API Thread");
+
 		m_init = _init;
 		m_init.resolution.reset &= ~BGFX_RESET_INTERNAL_FORCE;
 
@@ -1765,6 +3243,16 @@ namespace bgfx
 		m_debug   = BGFX_DEBUG_NONE;
 		m_frameTimeLast = bx::getHPCounter();
 
+		bx::memSet(m_dynIndexBufferShadow,  0, sizeof(m_dynIndexBufferShadow) );
+		bx::memSet(m_dynVertexBufferShadow, 0, sizeof(m_dynVertexBufferShadow) );
+
+		// Also used as scratch for sorting blit keys.
+		reserveTempKeys(bx::max<uint32_t>(BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE, BGFX_CONFIG_MAX_BLIT_ITEMS) );
+
+		m_parallelSort.init(_init.limits.maxSortThreads);
+		m_textureDecoder.init(_init.limits.maxTextureDecodeThreads);
+		m_phaseTimer.init(_init.limits.statsWindow);
+
 		m_submit->create();
 
 #if BGFX_CONFIG_MULTITHREADED
@@ -1891,11 +3379,35 @@ namespace bgfx
 
 		g_internalData.caps = getCaps();
 
+		// Resources bgfx created for itself, replay creates them too.
+		m_numInitResources = getNumResources();
+
 		return true;
 	}
 
-	void Context::shutdown()
-	{
+	void Context::shutdown()
+	{
+		// Frames submitted during shutdown are not part of trace.
+		m_frameTraceWriter.close();
+		m_frameTraceReader.close();
+		g_profilerTrace.close();
+
+		// Textures still being decoded are leaked by application, and are
+		// never created.
+		m_textureDecoder.shutdown();
+		m_numPendingTextures = 0;
+
+		for (uint16_t ii = 0, num = m_textureHandle.getNumHandles(); ii < num; ++ii)
+		{
+			m_textureRef[m_textureHandle.getHandleAt(ii)].m_decodeJob = NULL;
+		}
+
+		if (isValid(m_textureFallback) )
+		{
+			destroyTexture(m_textureFallback);
+			m_textureFallback.idx = kInvalidHandle;
+		}
+
 		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
 		frame();
 
@@ -1929,9 +3441,6 @@ namespace bgfx
 		BX_FREE(g_allocator, m_encoder);
 		BX_FREE(g_allocator, m_encoderStats);
 
-		m_dynVertexBufferAllocator.compact();
-		m_dynIndexBufferAllocator.compact();
-
 		BX_CHECK(m_vertexDeclHandle.getNumHandles() == m_declRef.m_vertexDeclMap.getNumElements()
 				, "VertexDeclRef mismatch, num handles %d, handles in hash map %d."
 				, m_vertexDeclHandle.getNumHandles()
@@ -1960,6 +3469,28 @@ namespace bgfx
 
 		m_submit->destroy();
 
+		m_parallelSort.shutdown();
+		m_memoryPool.shutdown();
+		m_phaseTimer.shutdown();
+		g_profilerTrace.shutdown();
+
+		BX_FREE(g_allocator, m_tempKeys);
+		BX_FREE(g_allocator, m_tempValues);
+		m_tempKeys    = NULL;
+		m_tempValues  = NULL;
+		m_maxTempKeys = 0;
+		BX_FREE(g_allocator, m_textureUpdateScratch);
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_dynIndexBufferShadow); ++ii)
+		{
+			BX_FREE(g_allocator, m_dynIndexBufferShadow[ii]);
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_dynVertexBufferShadow); ++ii)
+		{
+			BX_FREE(g_allocator, m_dynVertexBufferShadow[ii]);
+		}
+
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
 		{
 #define CHECK_HANDLE_LEAK(_name, _handleAlloc)                                        \
@@ -2034,9 +3565,15 @@ namespace bgfx
 			CHECK_HANDLE_LEAK_NAME   ("FrameBufferHandle",         m_frameBufferHandle,        FrameBufferRef, m_frameBufferRef);
 			CHECK_HANDLE_LEAK_RC_NAME("UniformHandle",             m_uniformHandle,            UniformRef,     m_uniformRef    );
 			CHECK_HANDLE_LEAK        ("OcclusionQueryHandle",      m_occlusionQueryHandle                                      );
+			CHECK_HANDLE_LEAK        ("DrawBundleHandle",          m_drawBundleHandle                                          );
 #undef CHECK_HANDLE_LEAK
 #undef CHECK_HANDLE_LEAK_NAME
 		}
+
+		for (uint16_t ii = 0, num = m_drawBundleHandle.getNumHandles(); ii < num; ++ii)
+		{
+			m_drawBundle[m_drawBundleHandle.getHandleAt(ii)].destroy();
+		}
 	}
 
 	void Context::freeDynamicBuffers()
@@ -2060,6 +3597,201 @@ namespace bgfx
 		m_numFreeOcclusionQueryHandles = 0;
 	}
 
+	void Context::moveDynamicIndexBuffer(DynamicIndexBufferHandle _handle, uint64_t _ptr, uint32_t _size)
+	{
+		DynamicIndexBuffer& dib = m_dynamicIndexBuffers[_handle.idx];
+		const uint32_t indexSize = 0 == (dib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+		const uint8_t* src = &m_dynIndexBufferShadow[dib.m_handle.idx][dib.m_startIndex*indexSize];
+
+		m_dynIndexBufferAllocator.free(uint64_t(dib.m_handle.idx)<<32 | dib.m_offset);
+
+		dib.m_handle.idx = uint16_t(_ptr>>32);
+		dib.m_offset     = uint32_t(_ptr);
+		dib.m_startIndex = bx::strideAlign(dib.m_offset, indexSize)/indexSize;
+
+		if (0 != _size)
+		{
+			const uint32_t offset = dib.m_startIndex*indexSize;
+			uint8_t* dst = &m_dynIndexBufferShadow[dib.m_handle.idx][offset];
+			bx::memCopy(dst, src, _size);
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicIndexBuffer);
+			cmdbuf.write(dib.m_handle);
+			cmdbuf.write(offset);
+			cmdbuf.write(_size);
+			cmdbuf.write(copy(dst, _size) );
+		}
+	}
+
+	void Context::defragDynamicIndexBuffers(uint32_t _budget)
+	{
+		uint32_t* used = (uint32_t*)alloca(sizeof(uint32_t)*BGFX_CONFIG_MAX_INDEX_BUFFERS);
+		bx::memSet(used, 0, sizeof(uint32_t)*BGFX_CONFIG_MAX_INDEX_BUFFERS);
+
+		// Buffers referenced by draw bundles can't move, bundles keep their
+		// location. Pools holding them are skipped.
+		for (uint16_t ii = 0, num = m_dynamicIndexBufferHandle.getNumHandles(); ii < num; ++ii)
+		{
+			const uint16_t idx = m_dynamicIndexBufferHandle.getHandleAt(ii);
+			const DynamicIndexBuffer& dib = m_dynamicIndexBuffers[idx];
+			used[dib.m_handle.idx] = 0 != m_dynamicIndexBufferBundleRef.m_refCount[idx]
+				? UINT32_MAX
+				: bx::uint32_satadd(used[dib.m_handle.idx], dib.m_size)
+				;
+		}
+
+		// Pool with least live data is the cheapest one to empty.
+		IndexBufferHandle pool = BGFX_INVALID_HANDLE;
+		for (uint16_t ii = 0, num = m_indexBufferHandle.getNumHandles(); ii < num; ++ii)
+		{
+			const uint16_t idx = m_indexBufferHandle.getHandleAt(ii);
+			if (NULL != m_dynIndexBufferShadow[idx]
+			&&  UINT32_MAX != used[idx]
+			&& (!isValid(pool) || used[idx] < used[pool.idx]) )
+			{
+				pool.idx = idx;
+			}
+		}
+
+		if (!isValid(pool) )
+		{
+			return;
+		}
+
+		const uint64_t begin = uint64_t(pool.idx)<<32;
+		const uint64_t end   = begin + m_indexBuffers[pool.idx].m_size;
+
+		// Live data must fit into free space of other pools.
+		const uint64_t poolFree = m_dynIndexBufferAllocator.getFreeSize(begin);
+		if (m_dynIndexBufferAllocator.getFreeSize() - poolFree < m_indexBuffers[pool.idx].m_size - poolFree)
+		{
+			return;
+		}
+
+		for (uint16_t ii = 0, num = m_dynamicIndexBufferHandle.getNumHandles(); ii < num && 0 != _budget; ++ii)
+		{
+			const DynamicIndexBufferHandle handle = { m_dynamicIndexBufferHandle.getHandleAt(ii) };
+			const DynamicIndexBuffer& dib = m_dynamicIndexBuffers[handle.idx];
+
+			if (dib.m_handle.idx != pool.idx)
+			{
+				continue;
+			}
+
+			const uint32_t indexSize = 0 == (dib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+			const uint32_t size = bx::min(dib.m_size, m_indexBuffers[pool.idx].m_size - dib.m_startIndex*indexSize);
+
+			const uint64_t ptr = m_dynIndexBufferAllocator.allocOutside(BX_ALIGN_16(size), begin, end);
+			if (ptr == NonLocalAllocator::kInvalidBlock)
+			{
+				break;
+			}
+
+			// Budget is soft limit, buffer larger than budget is still moved.
+			moveDynamicIndexBuffer(handle, ptr, size);
+			_budget = bx::uint32_satsub(_budget, size);
+		}
+
+		if (m_dynIndexBufferAllocator.remove(begin) )
+		{
+			destroyDynamicIndexBufferPool(pool);
+		}
+	}
+
+	void Context::moveDynamicVertexBuffer(DynamicVertexBufferHandle _handle, uint64_t _ptr, uint32_t _size)
+	{
+		DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[_handle.idx];
+		const uint8_t* src = &m_dynVertexBufferShadow[dvb.m_handle.idx][dvb.m_startVertex*dvb.m_stride];
+
+		m_dynVertexBufferAllocator.free(uint64_t(dvb.m_handle.idx)<<32 | dvb.m_offset);
+
+		dvb.m_handle.idx  = uint16_t(_ptr>>32);
+		dvb.m_offset      = uint32_t(_ptr);
+		dvb.m_startVertex = bx::strideAlign(dvb.m_offset, dvb.m_stride)/dvb.m_stride;
+
+		if (0 != _size)
+		{
+			const uint32_t offset = dvb.m_startVertex*dvb.m_stride;
+			uint8_t* dst = &m_dynVertexBufferShadow[dvb.m_handle.idx][offset];
+			bx::memCopy(dst, src, _size);
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicVertexBuffer);
+			cmdbuf.write(dvb.m_handle);
+			cmdbuf.write(offset);
+			cmdbuf.write(_size);
+			cmdbuf.write(copy(dst, _size) );
+		}
+	}
+
+	void Context::defragDynamicVertexBuffers(uint32_t _budget)
+	{
+		uint32_t* used = (uint32_t*)alloca(sizeof(uint32_t)*BGFX_CONFIG_MAX_VERTEX_BUFFERS);
+		bx::memSet(used, 0, sizeof(uint32_t)*BGFX_CONFIG_MAX_VERTEX_BUFFERS);
+
+		for (uint16_t ii = 0, num = m_dynamicVertexBufferHandle.getNumHandles(); ii < num; ++ii)
+		{
+			const uint16_t idx = m_dynamicVertexBufferHandle.getHandleAt(ii);
+			const DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[idx];
+			used[dvb.m_handle.idx] = 0 != m_dynamicVertexBufferBundleRef.m_refCount[idx]
+				? UINT32_MAX
+				: bx::uint32_satadd(used[dvb.m_handle.idx], dvb.m_size)
+				;
+		}
+
+		VertexBufferHandle pool = BGFX_INVALID_HANDLE;
+		for (uint16_t ii = 0, num = m_vertexBufferHandle.getNumHandles(); ii < num; ++ii)
+		{
+			const uint16_t idx = m_vertexBufferHandle.getHandleAt(ii);
+			if (NULL != m_dynVertexBufferShadow[idx]
+			&&  UINT32_MAX != used[idx]
+			&& (!isValid(pool) || used[idx] < used[pool.idx]) )
+			{
+				pool.idx = idx;
+			}
+		}
+
+		if (!isValid(pool) )
+		{
+			return;
+		}
+
+		const uint64_t begin = uint64_t(pool.idx)<<32;
+		const uint64_t end   = begin + m_vertexBuffers[pool.idx].m_size;
+
+		const uint64_t poolFree = m_dynVertexBufferAllocator.getFreeSize(begin);
+		if (m_dynVertexBufferAllocator.getFreeSize() - poolFree < m_vertexBuffers[pool.idx].m_size - poolFree)
+		{
+			return;
+		}
+
+		for (uint16_t ii = 0, num = m_dynamicVertexBufferHandle.getNumHandles(); ii < num && 0 != _budget; ++ii)
+		{
+			const DynamicVertexBufferHandle handle = { m_dynamicVertexBufferHandle.getHandleAt(ii) };
+			const DynamicVertexBuffer& dvb = m_dynamicVertexBuffers[handle.idx];
+
+			if (dvb.m_handle.idx != pool.idx)
+			{
+				continue;
+			}
+
+			const uint32_t size = bx::min(dvb.m_size, m_vertexBuffers[pool.idx].m_size - dvb.m_startVertex*dvb.m_stride);
+
+			const uint64_t ptr = m_dynVertexBufferAllocator.allocOutside(bx::strideAlign<16>(size, dvb.m_stride)+dvb.m_stride, begin, end);
+			if (ptr == NonLocalAllocator::kInvalidBlock)
+			{
+				break;
+			}
+
+			moveDynamicVertexBuffer(handle, ptr, size);
+			_budget = bx::uint32_satsub(_budget, size);
+		}
+
+		if (m_dynVertexBufferAllocator.remove(begin) )
+		{
+			destroyDynamicVertexBufferPool(pool);
+		}
+	}
+
 	void Context::freeAllHandles(Frame* _frame)
 	{
 		for (uint16_t ii = 0, num = _frame->m_freeIndexBuffer.getNumQueued(); ii < num; ++ii)
@@ -2089,7 +3821,17 @@ namespace bgfx
 
 		for (uint16_t ii = 0, num = _frame->m_freeTexture.getNumQueued(); ii < num; ++ii)
 		{
-			m_textureHandle.free(_frame->m_freeTexture.get(ii).idx);
+			const uint16_t idx = _frame->m_freeTexture.get(ii).idx;
+
+			TextureRef& ref = m_textureRef[idx];
+			if (ref.isStreamed() )
+			{
+				release(ref.m_streamMem);
+				ref.m_streamMem = NULL;
+				--m_numStreamedTextures;
+			}
+
+			m_textureHandle.free(idx);
 		}
 
 		for (uint16_t ii = 0, num = _frame->m_freeFrameBuffer.getNumQueued(); ii < num; ++ii)
@@ -2110,74 +3852,361 @@ namespace bgfx
 #if BGFX_CONFIG_MULTITHREADED
 		if (_forThread || BGFX_API_THREAD_MAGIC != s_threadIndex)
 		{
-			bx::MutexScope scopeLock(m_encoderApiLock);
+			bx::MutexScope scopeLock(m_encoderApiLock);
+
+			uint16_t idx = m_encoderHandle->alloc();
+			if (kInvalidHandle == idx)
+			{
+				return NULL;
+			}
+
+			encoder = &m_encoder[idx];
+			encoder->begin(m_submit, uint8_t(idx) );
+
+			if (BGFX_API_THREAD_MAGIC != s_threadIndex)
+			{
+				BGFX_PROFILER_SET_CURRENT_THREAD_NAME("bgfx - Encoder Thread");
+			}
+		}
+#else
+		BX_UNUSED(_forThread);
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		return reinterpret_cast<Encoder*>(encoder);
+	}
+
+	void Context::end(Encoder* _encoder)
+	{
+#if BGFX_CONFIG_MULTITHREADED
+		EncoderImpl* encoder = reinterpret_cast<EncoderImpl*>(_encoder);
+		if (encoder != &m_encoder[0])
+		{
+			encoder->end(true);
+			m_encoderEndSem.post();
+		}
+#else
+		BX_UNUSED(_encoder);
+#endif // BGFX_CONFIG_MULTITHREADED
+	}
+
+	uint32_t Context::frame(bool _capture)
+	{
+		m_encoder[0].end(true);
+
+#if BGFX_CONFIG_MULTITHREADED
+		bx::MutexScope resourceApiScope(m_resourceApiLock);
+
+		const int64_t encoderApiWaitBegin = bx::getHPCounter();
+		encoderApiWait();
+		bx::MutexScope encoderApiScope(m_encoderApiLock);
+#else
+		const int64_t encoderApiWaitBegin = bx::getHPCounter();
+		encoderApiWait();
+#endif // BGFX_CONFIG_MULTITHREADED
+
+		m_submit->m_phaseTime[Phase::EncoderApiWait] = bx::getHPCounter() - encoderApiWaitBegin;
+		m_submit->m_capture = _capture;
+
+		BGFX_PROFILER_SCOPE("bgfx/API thread frame", 0xff2040ff);
+		// wait for render thread to finish
+		renderSemWait();
+		frameNoRenderWait();
+
+		m_encoder[0].begin(m_submit, 0);
+
+		return m_frames;
+	}
+
+	void Context::frameNoRenderWait()
+	{
+		swap();
+
+		// release render thread
+		apiSemPost();
+	}
+
+	void Context::flushTextureDecodes()
+	{
+		if (0 == m_numPendingTextures)
+		{
+			return;
+		}
+
+		for (TextureDecodeJob* job = m_textureDecoder.pop(); NULL != job; job = m_textureDecoder.pop() )
+		{
+			--m_numPendingTextures;
+
+			if (job->m_canceled)
+			{
+				releaseTextureMemory(job->m_mem);
+
+				if (NULL != job->m_result)
+				{
+					releaseTextureMemory(job->m_result);
+				}
+			}
+			else
+			{
+				TextureRef& ref = m_textureRef[job->m_handle.idx];
+				ref.m_decodeJob = NULL;
+
+				const Memory* mem = job->m_mem;
+				uint8_t skip = job->m_skip;
+
+				// Texture data that failed to parse is passed to renderer as is,
+				// same as texture created without BGFX_TEXTURE_ASYNC.
+				BX_WARN(!job->m_failed
+					, "Failed to decode texture %d asynchronously."
+					, job->m_handle.idx
+					);
+
+				if (NULL != job->m_result)
+				{
+					releaseTextureMemory(job->m_mem);
+					mem  = job->m_result;
+					skip = 0;
+				}
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
+				cmdbuf.write(job->m_handle);
+				cmdbuf.write(mem);
+				cmdbuf.write(job->m_flags);
+				cmdbuf.write(skip);
+
+				setTextureName(job->m_handle);
+			}
+
+			BX_DELETE(g_allocator, job);
+		}
+
+		if (0 == m_numPendingTextures)
+		{
+			return;
+		}
+
+		// Textures still being decoded are replaced with fallback in binds
+		// submitted this frame. Image binds are left unbound, since fallback
+		// is shared and must not be written to. Bind hash must follow bind
+		// content, since renderers cache descriptors by it.
+		Frame* frame = m_submit;
+		for (uint32_t ii = 0, num = frame->m_numRenderBinds; ii < num; ++ii)
+		{
+			RenderBind& renderBind = frame->m_renderBind[ii];
+			bool changed = false;
+
+			for (uint32_t stage = 0; stage < BX_COUNTOF(renderBind.m_bind); ++stage)
+			{
+				Binding& bind = renderBind.m_bind[stage];
+
+				if ( (Binding::Texture == bind.m_type || Binding::Image == bind.m_type)
+				&&  kInvalidHandle   != bind.m_idx)
+				{
+					const TextureDecodeJob* job = m_textureRef[bind.m_idx].m_decodeJob;
+					if (NULL != job)
+					{
+						bind.m_idx = job->m_fallback && Binding::Texture == bind.m_type
+							? m_textureFallback.idx
+							: kInvalidHandle
+							;
+						changed = true;
+					}
+				}
+			}
+
+			if (changed)
+			{
+				frame->m_renderBindHash[ii] = bx::hash<bx::HashMurmur2A>(renderBind.m_bind, sizeof(renderBind.m_bind) );
+			}
+		}
+
+		// Blits from or to textures still being decoded are dropped. Blit keys
+		// are not sorted yet, key at index ii refers to blit item ii.
+		uint16_t numBlitItems = 0;
+		for (uint16_t ii = 0, num = frame->m_numBlitItems; ii < num; ++ii)
+		{
+			const BlitItem& bi = frame->m_blitItem[ii];
+
+			if (m_textureRef[bi.m_src.idx].isPending()
+			||  m_textureRef[bi.m_dst.idx].isPending() )
+			{
+				BX_TRACE("Skipping blit %d -> %d, texture is not decoded yet.", bi.m_src.idx, bi.m_dst.idx);
+				continue;
+			}
+
+			if (ii != numBlitItems)
+			{
+				BlitKey key;
+				key.decode(frame->m_blitKeys[ii]);
+				key.m_item = numBlitItems;
+
+				frame->m_blitItem[numBlitItems] = bi;
+				frame->m_blitKeys[numBlitItems] = key.encode();
+			}
+
+			++numBlitItems;
+		}
+
+		frame->m_numBlitItems = numBlitItems;
+	}
+
+	uint32_t Context::calcStreamedTextureSize(const bimg::ImageContainer& _imageContainer, uint8_t _skip)
+	{
+		const uint8_t startLod = bx::min<uint8_t>(_skip, uint8_t(_imageContainer.m_numMips-1) );
+
+		TextureInfo ti;
+		calcTextureSize(ti
+			, uint16_t(bx::max<uint32_t>(1, _imageContainer.m_width >>startLod) )
+			, uint16_t(bx::max<uint32_t>(1, _imageContainer.m_height>>startLod) )
+			, uint16_t(bx::max<uint32_t>(1, _imageContainer.m_depth >>startLod) )
+			, _imageContainer.m_cubeMap
+			, _imageContainer.m_numMips - startLod > 1
+			, _imageContainer.m_numLayers
+			, TextureFormat::Enum(_imageContainer.m_format)
+			);
+
+		return ti.storageSize;
+	}
+
+	void Context::setStreamedTextureSkip(TextureHandle _handle, uint8_t _skip, uint32_t _size)
+	{
+		TextureRef& ref = m_textureRef[_handle.idx];
+
+		m_textureMemoryUsed += int64_t(_size) - int64_t(ref.m_storageSize);
+		ref.m_storageSize = _size;
+		ref.m_skip        = _skip;
+
+		// Texture is recreated from retained memory in pre command buffer,
+		// before any draw of this frame uses it. Retained memory is released
+		// only when texture handle is freed, after this frame is rendered.
+		CommandBuffer& cmdbuf = m_submit->m_cmdPre;
+		cmdbuf.write(uint8_t(CommandBuffer::DestroyTexture) );
+		cmdbuf.write(_handle);
+
+		const Memory* mem = makeRef(ref.m_streamMem->data, ref.m_streamMem->size);
+
+		cmdbuf.write(uint8_t(CommandBuffer::CreateTexture) );
+		cmdbuf.write(_handle);
+		cmdbuf.write(mem);
+		cmdbuf.write(ref.m_streamFlags);
+		cmdbuf.write(_skip);
+
+		setTextureName(_handle);
+	}
+
+	void Context::updateTextureResidency()
+	{
+		if (0 == m_numStreamedTextures)
+		{
+			return;
+		}
+
+		const uint32_t frame = m_frames;
+
+		Frame* submit = m_submit;
+		for (uint32_t ii = 0, num = submit->m_numRenderBinds; ii < num; ++ii)
+		{
+			const RenderBind& renderBind = submit->m_renderBind[ii];
 
-			uint16_t idx = m_encoderHandle->alloc();
-			if (kInvalidHandle == idx)
+			for (uint32_t stage = 0; stage < BX_COUNTOF(renderBind.m_bind); ++stage)
 			{
-				return NULL;
-			}
+				const Binding& bind = renderBind.m_bind[stage];
 
-			encoder = &m_encoder[idx];
-			encoder->begin(m_submit, uint8_t(idx) );
+				if (Binding::Texture == bind.m_type
+				&&  kInvalidHandle   != bind.m_idx)
+				{
+					m_textureRef[bind.m_idx].m_lastUse = frame;
+				}
+			}
 		}
-#else
-		BX_UNUSED(_forThread);
-#endif // BGFX_CONFIG_MULTITHREADED
 
-		return reinterpret_cast<Encoder*>(encoder);
-	}
+		const int64_t budget = int64_t(m_init.limits.textureMemoryBudget);
 
-	void Context::end(Encoder* _encoder)
-	{
-#if BGFX_CONFIG_MULTITHREADED
-		EncoderImpl* encoder = reinterpret_cast<EncoderImpl*>(_encoder);
-		if (encoder != &m_encoder[0])
+		for (uint32_t change = 0; change < BGFX_CONFIG_MAX_TEXTURE_STREAMING_CHANGES; ++change)
 		{
-			encoder->end(true);
-			m_encoderEndSem.post();
-		}
-#else
-		BX_UNUSED(_encoder);
-#endif // BGFX_CONFIG_MULTITHREADED
-	}
+			TextureHandle handle = BGFX_INVALID_HANDLE;
 
-	uint32_t Context::frame(bool _capture)
-	{
-		m_encoder[0].end(true);
+			if (m_textureMemoryUsed > budget)
+			{
+				// Over budget, drop top mip of least recently used texture.
+				uint32_t lastUse = UINT32_MAX;
 
-#if BGFX_CONFIG_MULTITHREADED
-		bx::MutexScope resourceApiScope(m_resourceApiLock);
+				for (uint16_t ii = 0, num = m_textureHandle.getNumHandles(); ii < num; ++ii)
+				{
+					const uint16_t idx = m_textureHandle.getHandleAt(ii);
+					const TextureRef& ref = m_textureRef[idx];
 
-		encoderApiWait();
-		bx::MutexScope encoderApiScope(m_encoderApiLock);
-#else
-		encoderApiWait();
-#endif // BGFX_CONFIG_MULTITHREADED
+					if (ref.isStreamed()
+					&&  0 < ref.m_refCount
+					&&  ref.m_skip < ref.m_numMips-1
+					&&  ref.m_lastUse < lastUse)
+					{
+						handle.idx = idx;
+						lastUse = ref.m_lastUse;
+					}
+				}
 
-		m_submit->m_capture = _capture;
+				if (!isValid(handle) )
+				{
+					break;
+				}
 
-		BGFX_PROFILER_SCOPE("bgfx/API thread frame", 0xff2040ff);
-		// wait for render thread to finish
-		renderSemWait();
-		frameNoRenderWait();
+				const TextureRef& ref = m_textureRef[handle.idx];
+				const uint8_t skip = ref.m_skip + 1;
 
-		m_encoder[0].begin(m_submit, 0);
+				bimg::ImageContainer imageContainer;
+				bimg::imageParse(imageContainer, ref.m_streamMem->data, ref.m_streamMem->size);
+				setStreamedTextureSkip(handle, skip, calcStreamedTextureSize(imageContainer, skip) );
+			}
+			else
+			{
+				// Under budget, restore top mip of texture used this frame,
+				// which has most mips dropped.
+				uint8_t maxSkip = 0;
 
-		return m_frames;
-	}
+				for (uint16_t ii = 0, num = m_textureHandle.getNumHandles(); ii < num; ++ii)
+				{
+					const uint16_t idx = m_textureHandle.getHandleAt(ii);
+					const TextureRef& ref = m_textureRef[idx];
+
+					if (ref.isStreamed()
+					&&  0 < ref.m_refCount
+					&&  frame == ref.m_lastUse
+					&&  ref.m_minSkip < ref.m_skip
+					&&  maxSkip < ref.m_skip)
+					{
+						handle.idx = idx;
+						maxSkip = ref.m_skip;
+					}
+				}
 
-	void Context::frameNoRenderWait()
-	{
-		swap();
+				if (!isValid(handle) )
+				{
+					break;
+				}
 
-		// release render thread
-		apiSemPost();
+				const TextureRef& ref = m_textureRef[handle.idx];
+				const uint8_t skip = ref.m_skip - 1;
+
+				bimg::ImageContainer imageContainer;
+				bimg::imageParse(imageContainer, ref.m_streamMem->data, ref.m_streamMem->size);
+				const uint32_t size = calcStreamedTextureSize(imageContainer, skip);
+
+				if (m_textureMemoryUsed + int64_t(size) - int64_t(ref.m_storageSize) > budget)
+				{
+					break;
+				}
+
+				setStreamedTextureSkip(handle, skip, size);
+			}
+		}
 	}
 
 	void Context::swap()
 	{
+		m_submit->mergeRenderBinds();
 		freeDynamicBuffers();
+		flushTextureDecodes();
+		updateTextureResidency();
 		m_submit->m_resolution = m_init.resolution;
 		m_init.resolution.reset &= ~BGFX_RESET_INTERNAL_FORCE;
 		m_submit->m_debug = m_debug;
@@ -2192,11 +4221,28 @@ namespace bgfx
 			bx::memCopy(m_submit->m_colorPalette, m_clearColor, sizeof(m_clearColor) );
 		}
 
+		if (m_frameTraceReader.isOpen()
+		&&  !m_frameTraceReader.read(m_submit) )
+		{
+			m_frameTraceReader.close();
+		}
+
+		const int64_t freeAllHandlesBegin = bx::getHPCounter();
 		freeAllHandles(m_submit);
 		m_submit->resetFreeHandles();
+		m_submit->m_phaseTime[Phase::FreeAllHandles] = bx::getHPCounter() - freeAllHandlesBegin;
 
 		m_submit->finish();
 
+		if (m_frameTraceWriter.isOpen() )
+		{
+			m_frameTraceWriter.write(m_submit);
+		}
+
+		// Render thread is done with frame it rendered last, see
+		// Context::renderFrame.
+		m_phaseTimer.add(m_render->m_phaseTime);
+
 		bx::swap(m_render, m_submit);
 
 		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
@@ -2210,6 +4256,26 @@ namespace bgfx
 		m_frames++;
 		m_submit->start();
 
+		// Buffers are moved in newly started frame, while frame being
+		// rendered still uses old location. Buffers referenced by recorded
+		// draw bundles are not moved, see defragDynamicIndexBuffers.
+		if (0 != BGFX_CONFIG_DYNAMIC_BUFFER_DEFRAG_SIZE)
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			if (!isDrawBundleRecording() )
+			{
+				if (0 == (m_frames & 1) )
+				{
+					defragDynamicIndexBuffers(BGFX_CONFIG_DYNAMIC_BUFFER_DEFRAG_SIZE);
+				}
+				else
+				{
+					defragDynamicVertexBuffers(BGFX_CONFIG_DYNAMIC_BUFFER_DEFRAG_SIZE);
+				}
+			}
+		}
+
 		bx::memSet(m_seq, 0, sizeof(m_seq) );
 
 		m_submit->m_textVideoMem->resize(
@@ -2218,6 +4284,13 @@ namespace bgfx
 			, m_init.resolution.height
 			);
 
+		m_memoryPool.frame(m_submit->m_perfStats);
+
+		if (g_profilerTrace.isOpen() )
+		{
+			g_profilerTrace.frame(m_frames);
+		}
+
 		int64_t now = bx::getHPCounter();
 		m_submit->m_perfStats.cpuTimeFrame = now - m_frameTimeLast;
 		m_frameTimeLast = now;
@@ -2234,7 +4307,9 @@ namespace bgfx
 		if (m_rendererInitialized
 		&& !m_flipped)
 		{
+			const int64_t timeBegin = bx::getHPCounter();
 			m_renderCtx->flip();
+			m_flipTime = bx::getHPCounter() - timeBegin;
 			m_flipped = true;
 
 			if (m_renderCtx->isDeviceRemoved() )
@@ -2284,21 +4359,42 @@ namespace bgfx
 
 		if (apiSemWait(_msecs) )
 		{
+			m_render->m_perfStats.numTextureUpdates = 0;
+			m_render->m_perfStats.numTextureUploads = 0;
+			m_render->m_perfStats.textureUploadSize = 0;
+
+			// Flip happens outside of frame, and it's reported with the
+			// next frame.
+			int64_t* phaseTime = m_render->m_phaseTime;
+			phaseTime[Phase::Flip] = m_flipTime;
+			m_flipTime = 0;
+
 			{
 				BGFX_PROFILER_SCOPE("bgfx/Exec commands pre", 0xff2040ff);
+				const int64_t timeBegin = bx::getHPCounter();
 				rendererExecCommands(m_render->m_cmdPre);
+				phaseTime[Phase::ExecCommandsPre] = bx::getHPCounter() - timeBegin;
 			}
 
 			if (m_rendererInitialized)
 			{
 				BGFX_PROFILER_SCOPE("bgfx/Render submit", 0xff2040ff);
+				const int64_t timeBegin = bx::getHPCounter();
 				m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
+				phaseTime[Phase::Submit] = bx::getHPCounter() - timeBegin;
 				m_flipped = false;
+
+				for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+				{
+					phaseTime[Phase::UniformCommit] += m_render->m_uniformBuffer[ii]->m_commitTime;
+				}
 			}
 
 			{
 				BGFX_PROFILER_SCOPE("bgfx/Exec commands post", 0xff2040ff);
+				const int64_t timeBegin = bx::getHPCounter();
 				rendererExecCommands(m_render->m_cmdPost);
+				phaseTime[Phase::ExecCommandsPost] = bx::getHPCounter() - timeBegin;
 			}
 
 			renderSemPost();
@@ -2320,8 +4416,16 @@ namespace bgfx
 			;
 	}
 
-	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
+	bool rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end)
 	{
+		if (_begin >= _end)
+		{
+			return false;
+		}
+
+		const int64_t timeBegin = BX_ENABLED(BGFX_CONFIG_PHASE_TIME_UNIFORM_COMMIT) ? bx::getHPCounter() : 0;
+		bool changed = false;
+
 		_uniformBuffer->reset(_begin);
 		while (_uniformBuffer->getPos() < _end)
 		{
@@ -2339,82 +4443,148 @@ namespace bgfx
 			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
 
 			uint32_t size = g_uniformTypeSize[type]*num;
-			const char* data = _uniformBuffer->read(size);
 			if (UniformType::Count > type)
 			{
-				if (copy)
+				// Not copied uniform references identical value written earlier
+				// into the same buffer, see EncoderImpl::setUniform.
+				const char* data = copy
+					? _uniformBuffer->read(size)
+					: _uniformBuffer->getData(_uniformBuffer->read() + sizeof(uint32_t) )
+					;
+
+				if (_renderCtx->updateUniform(loc, data, size) )
 				{
-					_renderCtx->updateUniform(loc, data, size);
+					_uniformBuffer->m_bytesUpdated += size;
+					changed = true;
 				}
 				else
 				{
-					_renderCtx->updateUniform(loc, *(const char**)(data), size);
+					_uniformBuffer->m_bytesRedundant += size;
 				}
 			}
 			else
 			{
+				const char* data = _uniformBuffer->read(size);
 				_renderCtx->setMarker(data, uint16_t(size)-1);
 			}
 		}
+
+		if (BX_ENABLED(BGFX_CONFIG_PHASE_TIME_UNIFORM_COMMIT) )
+		{
+			_uniformBuffer->m_commitTime += bx::getHPCounter() - timeBegin;
+		}
+
+		return changed;
 	}
 
+	typedef TextureUpdateT<Rect> TextureUpdate;
+
 	void Context::flushTextureUpdateBatch(CommandBuffer& _cmdbuf)
 	{
 		if (m_textureUpdateBatch.sort() )
 		{
+			const int64_t timeBegin = bx::getHPCounter();
 			const uint32_t pos = _cmdbuf.m_pos;
 
-			uint32_t currentKey = UINT32_MAX;
+			TextureUpdate updates[BX_COUNTOF(m_textureUpdateBatch.m_keys)];
 
-			for (uint32_t ii = 0, num = m_textureUpdateBatch.m_num; ii < num; ++ii)
+			const uint32_t numUpdates = m_textureUpdateBatch.m_num;
+			uint32_t numUploads = 0;
+			uint32_t uploadSize = 0;
+
+			for (uint32_t ii = 0; ii < numUpdates;)
 			{
-				_cmdbuf.m_pos = m_textureUpdateBatch.m_values[ii];
+				const uint32_t key = m_textureUpdateBatch.m_keys[ii];
 
 				TextureHandle handle;
-				_cmdbuf.read(handle);
-
 				uint8_t side;
-				_cmdbuf.read(side);
-
 				uint8_t mip;
-				_cmdbuf.read(mip);
+				uint8_t format;
+				bool atlas;
 
-				Rect rect;
-				_cmdbuf.read(rect);
+				// Batch is sorted with stable radix sort, updates of the same
+				// texture side and mip are kept in submission order.
+				uint32_t num = 0;
+				for (; ii < numUpdates && key == m_textureUpdateBatch.m_keys[ii]; ++ii, ++num)
+				{
+					_cmdbuf.m_pos = m_textureUpdateBatch.m_values[ii];
 
-				uint16_t zz;
-				_cmdbuf.read(zz);
+					_cmdbuf.read(handle);
+					_cmdbuf.read(side);
+					_cmdbuf.read(mip);
+					_cmdbuf.read(format);
+					_cmdbuf.read(atlas);
+
+					TextureUpdate& update = updates[num];
+					_cmdbuf.read(update.m_rect);
+					_cmdbuf.read(update.m_z);
+					_cmdbuf.read(update.m_depth);
+					_cmdbuf.read(update.m_pitch);
+					_cmdbuf.read(update.m_mem);
+				}
 
-				uint16_t depth;
-				_cmdbuf.read(depth);
+				const bimg::TextureFormat::Enum fmt = bimg::TextureFormat::Enum(format);
+				const uint32_t bpp = bimg::getBitsPerPixel(fmt);
+				const bool mergeable = true
+					&& 0 != BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_SIZE
+					&& !bimg::isCompressed(fmt)
+					&& 0 == bpp % 8
+					;
 
-				uint16_t pitch;
-				_cmdbuf.read(pitch);
+				// Only atlas textures allow merged region to include texels
+				// not written by any update, see BGFX_TEXTURE_ATLAS.
+				const uint32_t maxWaste = atlas ? BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_WASTE : 0;
 
-				const Memory* mem;
-				_cmdbuf.read(mem);
+				m_renderCtx->updateTextureBegin(handle, side, mip);
 
-				uint32_t key = m_textureUpdateBatch.m_keys[ii];
-				if (key != currentKey)
+				for (uint32_t jj = 0; jj < num; ++numUploads)
 				{
-					if (currentKey != UINT32_MAX)
+					const TextureUpdate& first = updates[jj];
+
+					Rect rect = first.m_rect;
+					uint32_t covered = 0;
+					const uint32_t end = mergeable
+						? mergeTextureUpdates(rect, covered, updates, jj, num, bpp, maxWaste, BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_SIZE)
+						: jj + 1
+						;
+
+					if (end - jj == 1)
 					{
-						m_renderCtx->updateTextureEnd();
+						m_renderCtx->updateTexture(handle, side, mip, first.m_rect, first.m_z, first.m_depth, first.m_pitch, first.m_mem);
+						uploadSize += first.m_mem->size;
+						release(first.m_mem);
 					}
-					currentKey = key;
-					m_renderCtx->updateTextureBegin(handle, side, mip);
-				}
+					else
+					{
+						if (NULL == m_textureUpdateScratch)
+						{
+							m_textureUpdateScratch = (uint8_t*)BX_ALLOC(g_allocator, BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_SIZE);
+						}
 
-				m_renderCtx->updateTexture(handle, side, mip, rect, zz, depth, pitch, mem);
+						Memory mem;
+						mem.data = m_textureUpdateScratch;
+						mem.size = stageTextureUpdates(m_textureUpdateScratch, rect, covered, updates, jj, end, bpp);
 
-				release(mem);
-			}
+						for (uint32_t kk = jj; kk < end; ++kk)
+						{
+							release(updates[kk].m_mem);
+						}
+
+						m_renderCtx->updateTexture(handle, side, mip, rect, first.m_z, 1, UINT16_MAX, &mem);
+						uploadSize += mem.size;
+					}
+
+					jj = end;
+				}
 
-			if (currentKey != UINT32_MAX)
-			{
 				m_renderCtx->updateTextureEnd();
 			}
 
+			m_render->m_perfStats.numTextureUpdates += numUpdates;
+			m_render->m_perfStats.numTextureUploads += numUploads;
+			m_render->m_perfStats.textureUploadSize += uploadSize;
+			m_render->m_phaseTime[Phase::TextureUpdate] += bx::getHPCounter() - timeBegin;
+
 			m_textureUpdateBatch.reset();
 
 			_cmdbuf.m_pos = pos;
@@ -2653,6 +4823,10 @@ namespace bgfx
 			}
 		}
 
+		// Frame trace copies the same commands, see copyCommands in
+		// frame_trace.cpp. Update both when command is added.
+		BX_STATIC_ASSERT(CommandBuffer::Count == 33);
+
 		do
 		{
 			uint8_t command;
@@ -2947,23 +5121,7 @@ namespace bgfx
 						setDirectAccessPtr(handle, ptr);
 					}
 
-					bx::MemoryReader reader(mem->data, mem->size);
-
-					uint32_t magic;
-					bx::read(&reader, magic);
-
-					if (BGFX_CHUNK_MAGIC_TEX == magic)
-					{
-						TextureCreate tc;
-						bx::read(&reader, tc);
-
-						if (NULL != tc.m_mem)
-						{
-							release(tc.m_mem);
-						}
-					}
-
-					release(mem);
+					releaseTextureMemory(mem);
 				}
 				break;
 
@@ -2987,6 +5145,8 @@ namespace bgfx
 					uint8_t mip;
 					_cmdbuf.read(mip);
 
+					_cmdbuf.skip<uint8_t>();
+					_cmdbuf.skip<bool>();
 					_cmdbuf.skip<Rect>();
 					_cmdbuf.skip<uint16_t>();
 					_cmdbuf.skip<uint16_t>();
@@ -3282,8 +5442,13 @@ namespace bgfx
 		, allocator(NULL)
 	{
 		limits.maxEncoders     = BGFX_CONFIG_DEFAULT_MAX_ENCODERS;
+		limits.maxSortThreads  = BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS;
+		limits.maxTextureDecodeThreads = BGFX_CONFIG_DEFAULT_MAX_TEXTURE_DECODE_THREADS;
+		limits.statsWindow     = BGFX_CONFIG_DEFAULT_STATS_WINDOW;
+		limits.maxDrawCalls    = BGFX_CONFIG_DEFAULT_MAX_DRAW_CALLS;
 		limits.transientVbSize = BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE;
 		limits.transientIbSize = BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE;
+		limits.textureMemoryBudget = BGFX_CONFIG_DEFAULT_TEXTURE_MEMORY_BUDGET;
 	}
 
 	void Attachment::init(TextureHandle _handle, Access::Enum _access, uint16_t _layer, uint16_t _mip, uint8_t _resolve)
@@ -3310,6 +5475,31 @@ namespace bgfx
 			return false;
 		}
 
+		if (BGFX_CONFIG_MAX_SORT_THREADS < _init.limits.maxSortThreads)
+		{
+			BX_TRACE("init.limits.maxSortThreads must be between 0 and %d.", BGFX_CONFIG_MAX_SORT_THREADS);
+			return false;
+		}
+
+		if (BGFX_CONFIG_MAX_TEXTURE_DECODE_THREADS < _init.limits.maxTextureDecodeThreads)
+		{
+			BX_TRACE("init.limits.maxTextureDecodeThreads must be between 0 and %d.", BGFX_CONFIG_MAX_TEXTURE_DECODE_THREADS);
+			return false;
+		}
+
+		if (1 > _init.limits.statsWindow)
+		{
+			BX_TRACE("init.limits.statsWindow must be at least 1.");
+			return false;
+		}
+
+		if (1                          > _init.limits.maxDrawCalls
+		||  BGFX_CONFIG_MAX_DRAW_CALLS < _init.limits.maxDrawCalls)
+		{
+			BX_TRACE("init.limits.maxDrawCalls must be between 1 and %d.", BGFX_CONFIG_MAX_DRAW_CALLS);
+			return false;
+		}
+
 		struct ErrorState
 		{
 			enum Enum
@@ -3356,7 +5546,7 @@ namespace bgfx
 		}
 
 		bx::memSet(&g_caps, 0, sizeof(g_caps) );
-		g_caps.limits.maxDrawCalls            = BGFX_CONFIG_MAX_DRAW_CALLS;
+		g_caps.limits.maxDrawCalls            = _init.limits.maxDrawCalls;
 		g_caps.limits.maxBlits                = BGFX_CONFIG_MAX_BLIT_ITEMS;
 		g_caps.limits.maxTextureSize          = 0;
 		g_caps.limits.maxTextureLayers        = 1;
@@ -3533,6 +5723,66 @@ namespace bgfx
 		BGFX_ENCODER(setUniform(uniform.m_type, _handle, _value, UINT16_MAX != _num ? _num : uniform.m_num) );
 	}
 
+	uint32_t Encoder::getAvailTransientIndexBuffer(uint32_t _num)
+	{
+		BX_CHECK(0 < _num, "Requesting 0 indices.");
+		return BGFX_ENCODER(getAvailTransientIndexBuffer(_num) );
+	}
+
+	uint32_t Encoder::getAvailTransientVertexBuffer(uint32_t _num, const VertexDecl& _decl)
+	{
+		BX_CHECK(0 < _num, "Requesting 0 vertices.");
+		BX_CHECK(isValid(_decl), "Invalid VertexDecl.");
+		return BGFX_ENCODER(getAvailTransientVertexBuffer(_num, _decl.m_stride) );
+	}
+
+	uint32_t Encoder::getAvailInstanceDataBuffer(uint32_t _num, uint16_t _stride)
+	{
+		BX_CHECK(0 < _num, "Requesting 0 instances.");
+		return BGFX_ENCODER(getAvailTransientVertexBuffer(_num, _stride) );
+	}
+
+	void Encoder::allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num)
+	{
+		BX_CHECK(NULL != _tib, "_tib can't be NULL");
+		BX_CHECK(0 < _num, "Requesting 0 indices.");
+		BGFX_ENCODER(allocTransientIndexBuffer(_tib, _num) );
+		BX_CHECK(_num == _tib->size/2
+			, "Failed to allocate transient index buffer (requested %d, available %d). "
+			  "Use bgfx::Encoder::getAvailTransient* functions to ensure availability."
+			, _num
+			, _tib->size/2
+			);
+	}
+
+	void Encoder::allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl)
+	{
+		BX_CHECK(NULL != _tvb, "_tvb can't be NULL");
+		BX_CHECK(0 < _num, "Requesting 0 vertices.");
+		BX_CHECK(isValid(_decl), "Invalid VertexDecl.");
+		BGFX_ENCODER(allocTransientVertexBuffer(_tvb, _num, _decl) );
+		BX_CHECK(_num == _tvb->size / _decl.m_stride
+			, "Failed to allocate transient vertex buffer (requested %d, available %d). "
+			  "Use bgfx::Encoder::getAvailTransient* functions to ensure availability."
+			, _num
+			, _tvb->size / _decl.m_stride
+			);
+	}
+
+	void Encoder::allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride)
+	{
+		BGFX_CHECK_CAPS(BGFX_CAPS_INSTANCING, "Instancing is not supported!");
+		BX_CHECK(_stride == BX_ALIGN_16(_stride), "Stride must be multiple of 16.");
+		BX_CHECK(0 < _num, "Requesting 0 instanced data vertices.");
+		BGFX_ENCODER(allocInstanceDataBuffer(_idb, _num, _stride) );
+		BX_CHECK(_num == _idb->size / _stride
+			, "Failed to allocate instance data buffer (requested %d, available %d). "
+			  "Use bgfx::Encoder::getAvailTransient* functions to ensure availability."
+			, _num
+			, _idb->size / _stride
+			);
+	}
+
 	void Encoder::setIndexBuffer(IndexBufferHandle _handle)
 	{
 		setIndexBuffer(_handle, 0, UINT32_MAX);
@@ -3541,6 +5791,7 @@ namespace bgfx
 	void Encoder::setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
 	{
 		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_indexBufferHandle, _handle);
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::IndexBuffer, _handle.idx) );
 		BGFX_ENCODER(setIndexBuffer(_handle, _firstIndex, _numIndices) );
 	}
 
@@ -3553,7 +5804,9 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setIndexBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
 		const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_handle.idx];
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::DynamicIndexBuffer, _handle.idx) );
 		BGFX_ENCODER(setIndexBuffer(dib, _firstIndex, _numIndices) );
+		BGFX_ENCODER(setDynamicRef(DrawBundle::DynamicSlot::IndexBuffer, _handle.idx) );
 	}
 
 	void Encoder::setIndexBuffer(const TransientIndexBuffer* _tib)
@@ -3578,6 +5831,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setVertexBuffer", s_ctx->m_vertexBufferHandle, _handle);
 		BGFX_CHECK_HANDLE_INVALID_OK("setVertexBuffer", s_ctx->m_vertexDeclHandle, _declHandle);
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::VertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setVertexBuffer(_stream, _handle, _startVertex, _numVertices, _declHandle) );
 	}
 
@@ -3597,7 +5851,9 @@ namespace bgfx
 		BGFX_CHECK_HANDLE("setVertexBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		BGFX_CHECK_HANDLE_INVALID_OK("setVertexBuffer", s_ctx->m_vertexDeclHandle, _declHandle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::DynamicVertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setVertexBuffer(_stream, dvb, _startVertex, _numVertices, _declHandle) );
+		BGFX_ENCODER(setDynamicRef(_stream, _handle.idx) );
 	}
 
 	void Encoder::setVertexBuffer(uint8_t _stream, DynamicVertexBufferHandle _handle)
@@ -3645,6 +5901,7 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setInstanceDataBuffer", s_ctx->m_vertexBufferHandle, _handle);
 		const VertexBuffer& vb = s_ctx->m_vertexBuffers[_handle.idx];
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::VertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setInstanceDataBuffer(_handle, _startVertex, _num, vb.m_stride) );
 	}
 
@@ -3652,11 +5909,13 @@ namespace bgfx
 	{
 		BGFX_CHECK_HANDLE("setInstanceDataBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::DynamicVertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setInstanceDataBuffer(dvb.m_handle
 			, dvb.m_startVertex + _startVertex
 			, _num
 			, dvb.m_stride
 			) );
+		BGFX_ENCODER(setDynamicRef(DrawBundle::DynamicSlot::InstanceDataBuffer, _handle.idx) );
 	}
 
 	void Encoder::setInstanceCount(uint32_t _numInstances)
@@ -3670,6 +5929,10 @@ namespace bgfx
 		BGFX_CHECK_HANDLE("setTexture/UniformHandle", s_ctx->m_uniformHandle, _sampler);
 		BGFX_CHECK_HANDLE_INVALID_OK("setTexture/TextureHandle", s_ctx->m_textureHandle, _handle);
 		BX_CHECK(_stage < g_caps.limits.maxTextureSamplers, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxTextureSamplers);
+		if (isValid(_handle) )
+		{
+			BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::Texture, _handle.idx) );
+		}
 		BGFX_ENCODER(setTexture(_stage, _sampler, _handle, _flags) );
 	}
 
@@ -3679,36 +5942,92 @@ namespace bgfx
 		submit(_id, handle);
 	}
 
-	void Encoder::submit(ViewId _id, ProgramHandle _program, uint32_t _depth, bool _preserveState)
+	void Encoder::submit(ViewId _id, ProgramHandle _program, uint32_t _depth, bool _preserveState)
+	{
+		OcclusionQueryHandle handle = BGFX_INVALID_HANDLE;
+		submit(_id, _program, handle, _depth, _preserveState);
+	}
+
+	void Encoder::submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState)
+	{
+		BX_CHECK(false
+			|| !isValid(_occlusionQuery)
+			|| 0 != (g_caps.supported & BGFX_CAPS_OCCLUSION_QUERY)
+			, "Occlusion query is not supported! Use bgfx::getCaps to check BGFX_CAPS_OCCLUSION_QUERY backend renderer capabilities."
+			);
+		BGFX_CHECK_HANDLE_INVALID_OK("submit", s_ctx->m_programHandle, _program);
+		BGFX_CHECK_HANDLE_INVALID_OK("submit", s_ctx->m_occlusionQueryHandle, _occlusionQuery);
+		if (isValid(_program) )
+		{
+			BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::Program, _program.idx) );
+		}
+		BGFX_ENCODER(submit(_id, _program, _occlusionQuery, _depth, _preserveState) );
+	}
+
+	void Encoder::submit(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState)
+	{
+		BGFX_CHECK_HANDLE_INVALID_OK("submit", s_ctx->m_programHandle, _program);
+		BGFX_CHECK_HANDLE("submit", s_ctx->m_vertexBufferHandle, _indirectHandle);
+		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT, "Draw indirect is not supported!");
+		if (isValid(_program) )
+		{
+			BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::Program, _program.idx) );
+		}
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::IndirectBuffer, _indirectHandle.idx) );
+		BGFX_ENCODER(submit(_id, _program, _indirectHandle, _start, _num, _depth, _preserveState) );
+	}
+
+	void Encoder::submitBatch(
+		  ViewId _id
+		, uint32_t _num
+		, const ProgramHandle* _program
+		, const uint32_t* _transform
+		, const VertexBufferHandle* _vertexBuffer
+		, const IndexBufferHandle* _indexBuffer
+		, const uint64_t* _state
+		, const uint32_t* _depth
+		)
+	{
+		BX_CHECK(0 == _num || (NULL != _program && NULL != _vertexBuffer), "Program and vertex buffer arrays can't be NULL.");
+
+		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
+		{
+			for (uint32_t ii = 0; ii < _num; ++ii)
+			{
+				BGFX_CHECK_HANDLE_INVALID_OK("submitBatch", s_ctx->m_programHandle, _program[ii]);
+				BGFX_CHECK_HANDLE("submitBatch", s_ctx->m_vertexBufferHandle, _vertexBuffer[ii]);
+				if (NULL != _indexBuffer)
+				{
+					BGFX_CHECK_HANDLE("submitBatch", s_ctx->m_indexBufferHandle, _indexBuffer[ii]);
+				}
+			}
+		}
+
+		BGFX_ENCODER(submitBatch(_id, _num, _program, _transform, _vertexBuffer, _indexBuffer, _state, _depth) );
+	}
+
+	void Encoder::beginDrawBundle(DrawBundleHandle _handle)
 	{
-		OcclusionQueryHandle handle = BGFX_INVALID_HANDLE;
-		submit(_id, _program, handle, _depth, _preserveState);
+		BGFX_CHECK_HANDLE("beginDrawBundle", s_ctx->m_drawBundleHandle, _handle);
+		BGFX_ENCODER(beginDrawBundle(s_ctx->beginDrawBundle(_handle) ) );
 	}
 
-	void Encoder::submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState)
+	void Encoder::endDrawBundle()
 	{
-		BX_CHECK(false
-			|| !isValid(_occlusionQuery)
-			|| 0 != (g_caps.supported & BGFX_CAPS_OCCLUSION_QUERY)
-			, "Occlusion query is not supported! Use bgfx::getCaps to check BGFX_CAPS_OCCLUSION_QUERY backend renderer capabilities."
-			);
-		BGFX_CHECK_HANDLE_INVALID_OK("submit", s_ctx->m_programHandle, _program);
-		BGFX_CHECK_HANDLE_INVALID_OK("submit", s_ctx->m_occlusionQueryHandle, _occlusionQuery);
-		BGFX_ENCODER(submit(_id, _program, _occlusionQuery, _depth, _preserveState) );
+		s_ctx->endDrawBundle(BGFX_ENCODER(endDrawBundle() ) );
 	}
 
-	void Encoder::submit(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState)
+	void Encoder::submit(ViewId _id, DrawBundleHandle _handle)
 	{
-		BGFX_CHECK_HANDLE_INVALID_OK("submit", s_ctx->m_programHandle, _program);
-		BGFX_CHECK_HANDLE("submit", s_ctx->m_vertexBufferHandle, _indirectHandle);
-		BGFX_CHECK_CAPS(BGFX_CAPS_DRAW_INDIRECT, "Draw indirect is not supported!");
-		BGFX_ENCODER(submit(_id, _program, _indirectHandle, _start, _num, _depth, _preserveState) );
+		BGFX_CHECK_HANDLE("submit", s_ctx->m_drawBundleHandle, _handle);
+		BGFX_ENCODER(submit(_id, s_ctx->m_drawBundle[_handle.idx]) );
 	}
 
 	void Encoder::setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BX_CHECK(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_indexBufferHandle, _handle);
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::IndexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, _handle, _access) );
 	}
 
@@ -3716,6 +6035,7 @@ namespace bgfx
 	{
 		BX_CHECK(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_vertexBufferHandle, _handle);
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::VertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, _handle, _access) );
 	}
 
@@ -3724,6 +6044,7 @@ namespace bgfx
 		BX_CHECK(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_dynamicIndexBufferHandle, _handle);
 		const DynamicIndexBuffer& dib = s_ctx->m_dynamicIndexBuffers[_handle.idx];
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::DynamicIndexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, dib.m_handle, _access) );
 	}
 
@@ -3732,6 +6053,7 @@ namespace bgfx
 		BX_CHECK(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_dynamicVertexBufferHandle, _handle);
 		const DynamicVertexBuffer& dvb = s_ctx->m_dynamicVertexBuffers[_handle.idx];
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::DynamicVertexBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, dvb.m_handle, _access) );
 	}
 
@@ -3740,6 +6062,7 @@ namespace bgfx
 		BX_CHECK(_stage < g_caps.limits.maxComputeBindings, "Invalid stage %d (max %d).", _stage, g_caps.limits.maxComputeBindings);
 		BGFX_CHECK_HANDLE("setBuffer", s_ctx->m_vertexBufferHandle, _handle);
 		VertexBufferHandle handle = { _handle.idx };
+		BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::IndirectBuffer, _handle.idx) );
 		BGFX_ENCODER(setBuffer(_stage, handle, _access) );
 	}
 
@@ -3754,6 +6077,10 @@ namespace bgfx
 		BX_CHECK(_format != TextureFormat::BGRA8
 			, "Can't use TextureFormat::BGRA8 with compute, use TextureFormat::RGBA8 instead."
 			);
+		if (isValid(_handle) )
+		{
+			BGFX_ENCODER(addResourceRef(DrawBundle::ResourceRef::Texture, _handle.idx) );
+		}
 		BGFX_ENCODER(setImage(_stage, _handle, _mip, _access, _format) );
 	}
 
@@ -3827,7 +6154,7 @@ namespace bgfx
 		return g_caps.rendererType;
 	}
 
-	const Memory* alloc(uint32_t _size)
+	const Memory* allocUnpooled(uint32_t _size)
 	{
 		BX_CHECK(0 < _size, "Invalid memory operation. _size is 0.");
 		Memory* mem = (Memory*)BX_ALLOC(g_allocator, sizeof(Memory) + _size);
@@ -3836,6 +6163,29 @@ namespace bgfx
 		return mem;
 	}
 
+	const Memory* copyUnpooled(const void* _data, uint32_t _size)
+	{
+		const Memory* mem = allocUnpooled(_size);
+		bx::memCopy(mem->data, _data, _size);
+		return mem;
+	}
+
+	const Memory* alloc(uint32_t _size)
+	{
+		BX_CHECK(0 < _size, "Invalid memory operation. _size is 0.");
+
+		if (NULL != s_ctx)
+		{
+			const Memory* mem = s_ctx->m_memoryPool.alloc(_size);
+			if (NULL != mem)
+			{
+				return mem;
+			}
+		}
+
+		return allocUnpooled(_size);
+	}
+
 	const Memory* copy(const void* _data, uint32_t _size)
 	{
 		BX_CHECK(0 < _size, "Invalid memory operation. _size is 0.");
@@ -3851,6 +6201,387 @@ namespace bgfx
 		void* userData;
 	};
 
+	BX_STATIC_ASSERT(BGFX_CONFIG_MEMORY_POOL_CHUNK_SIZE >= 256 + BGFX_CONFIG_MAX_POOLED_MEMORY_SIZE
+		, "BGFX_CONFIG_MEMORY_POOL_CHUNK_SIZE must fit largest pooled memory block."
+		);
+
+#if BGFX_CONFIG_MULTITHREADED && defined(BX_THREAD_LOCAL)
+#	define BGFX_MEMORY_POOL_THREAD_LOCAL 1
+	// Cache of the current thread is valid only for generation of pool it
+	// was allocated in, caches are freed on bgfx::shutdown.
+	static BX_THREAD_LOCAL void*    s_memoryPoolCache;
+	static BX_THREAD_LOCAL uint32_t s_memoryPoolCacheGeneration;
+#else
+	// Without thread local storage all threads share one cache, and every
+	// allocation takes pool lock.
+#	define BGFX_MEMORY_POOL_THREAD_LOCAL 0
+#endif // BGFX_CONFIG_MULTITHREADED && defined(BX_THREAD_LOCAL)
+
+	static uint32_t s_memoryPoolGeneration;
+
+	static uint32_t atomicLoad(uint32_t* _ptr)
+	{
+		return bx::atomicFetchAndAdd<uint32_t>(_ptr, 0);
+	}
+
+	static uint32_t atomicTake(uint32_t* _ptr)
+	{
+		const uint32_t value = atomicLoad(_ptr);
+		bx::atomicFetchAndSub<uint32_t>(_ptr, value);
+		return value;
+	}
+
+	MemoryPool::MemoryPool()
+		: m_caches(NULL)
+		, m_shared(NULL)
+		, m_chunks(NULL)
+		, m_free(NULL)
+		, m_frame(0)
+		, m_generation(++s_memoryPoolGeneration)
+		, m_numChunks(0)
+		, m_numFree(0)
+		, m_minFree(0)
+		, m_numTrimFrames(0)
+	{
+	}
+
+	void MemoryPool::shutdown()
+	{
+		bx::MutexScope scope(m_lock);
+
+		for (ThreadCache* cache = m_caches; NULL != cache;)
+		{
+			ThreadCache* next = cache->m_next;
+
+			if (NULL != cache->m_current)
+			{
+				retire(cache->m_current);
+			}
+
+			BX_FREE(g_allocator, cache);
+			cache = next;
+		}
+		m_caches = NULL;
+		m_shared = NULL;
+
+		for (Chunk* chunk = m_free; NULL != chunk;)
+		{
+			Chunk* next = chunk->m_next;
+			destroy(chunk);
+			chunk = next;
+		}
+		m_free    = NULL;
+		m_numFree = 0;
+
+		BX_WARN(0 == m_numChunks, "Frame memory pool chunks with unreleased memory: %d.", m_numChunks);
+
+		// Chunks still referenced can't be freed, releasing their blocks
+		// after shutdown must not touch pool.
+		for (Chunk* chunk = m_chunks; NULL != chunk; chunk = chunk->m_nextChunk)
+		{
+			chunk->m_pool = NULL;
+		}
+		m_chunks = NULL;
+	}
+
+	MemoryPool::ThreadCache* MemoryPool::getThreadCache()
+	{
+#if BGFX_MEMORY_POOL_THREAD_LOCAL
+		if (m_generation == s_memoryPoolCacheGeneration)
+		{
+			return (ThreadCache*)s_memoryPoolCache;
+		}
+#else
+		if (NULL != m_shared)
+		{
+			return m_shared;
+		}
+#endif // BGFX_MEMORY_POOL_THREAD_LOCAL
+
+		ThreadCache* cache = (ThreadCache*)BX_ALLOC(g_allocator, sizeof(ThreadCache) );
+		bx::memSet(cache, 0, sizeof(ThreadCache) );
+
+		{
+			bx::MutexScope scope(m_lock);
+			cache->m_next = m_caches;
+			m_caches = cache;
+		}
+
+#if BGFX_MEMORY_POOL_THREAD_LOCAL
+		s_memoryPoolCache           = cache;
+		s_memoryPoolCacheGeneration = m_generation;
+#else
+		m_shared = cache;
+#endif // BGFX_MEMORY_POOL_THREAD_LOCAL
+
+		return cache;
+	}
+
+	const Memory* MemoryPool::alloc(uint32_t _size)
+	{
+#if !BGFX_MEMORY_POOL_THREAD_LOCAL
+		bx::MutexScope scope(m_lock);
+#endif // !BGFX_MEMORY_POOL_THREAD_LOCAL
+
+		ThreadCache* cache = getThreadCache();
+
+		bx::atomicFetchAndAdd<uint32_t>(&cache->m_numAllocs, 1);
+		bx::atomicFetchAndAdd<uint32_t>(&cache->m_allocSize, _size);
+
+		if (_size > BGFX_CONFIG_MAX_POOLED_MEMORY_SIZE)
+		{
+			return NULL;
+		}
+
+		const uint32_t size  = BX_ALIGN_16(uint32_t(sizeof(MemoryRef) ) + _size);
+		const uint32_t frame = atomicLoad(&m_frame);
+
+		Chunk* chunk = cache->m_current;
+
+		if (NULL == chunk
+		||  frame != cache->m_frame
+		||  chunk->m_offset + size > BGFX_CONFIG_MEMORY_POOL_CHUNK_SIZE)
+		{
+			bx::MutexScope lock(m_lock);
+
+			if (NULL != chunk)
+			{
+				retire(chunk);
+			}
+
+			chunk = acquire();
+			cache->m_current = chunk;
+			cache->m_frame   = frame;
+		}
+
+		bx::atomicFetchAndAdd<int32_t>(&chunk->m_refCount, 1);
+
+		MemoryRef* memRef = (MemoryRef*)( (uint8_t*)chunk + chunk->m_offset);
+		chunk->m_offset += size;
+
+		memRef->mem.data  = (uint8_t*)memRef + sizeof(MemoryRef);
+		memRef->mem.size  = _size;
+		memRef->releaseFn = release;
+		memRef->userData  = chunk;
+
+		bx::atomicFetchAndAdd<uint32_t>(&cache->m_numAllocsPooled, 1);
+
+		return &memRef->mem;
+	}
+
+	void MemoryPool::frame(Stats& _stats)
+	{
+		bx::MutexScope scope(m_lock);
+
+		// Threads switch to new chunk on their next allocation.
+		bx::atomicFetchAndAdd<uint32_t>(&m_frame, 1);
+
+		uint32_t numAllocs       = 0;
+		uint32_t numAllocsPooled = 0;
+		uint32_t allocSize       = 0;
+
+		for (ThreadCache* cache = m_caches; NULL != cache; cache = cache->m_next)
+		{
+			numAllocs       += atomicTake(&cache->m_numAllocs);
+			numAllocsPooled += atomicTake(&cache->m_numAllocsPooled);
+			allocSize       += atomicTake(&cache->m_allocSize);
+		}
+
+		// Chunks that stayed on free list for the whole window were not
+		// needed, and are returned to allocator.
+		if (++m_numTrimFrames > 64)
+		{
+			for (; 0 < m_minFree; --m_minFree)
+			{
+				Chunk* chunk = m_free;
+				m_free = chunk->m_next;
+				--m_numFree;
+				destroy(chunk);
+			}
+
+			m_numTrimFrames = 0;
+			m_minFree       = m_numFree;
+		}
+
+		_stats.numMemoryAllocs       = numAllocs;
+		_stats.numMemoryAllocsPooled = numAllocsPooled;
+		_stats.memoryAllocSize       = allocSize;
+		_stats.memoryPoolSize        = m_numChunks*BGFX_CONFIG_MEMORY_POOL_CHUNK_SIZE;
+	}
+
+	void MemoryPool::release(void* _ptr, void* _userData)
+	{
+		BX_UNUSED(_ptr);
+		Chunk* chunk = (Chunk*)_userData;
+
+		if (1 == bx::atomicFetchAndSub<int32_t>(&chunk->m_refCount, 1) )
+		{
+			MemoryPool* pool = chunk->m_pool;
+			BX_CHECK(NULL != pool, "Memory allocated with bgfx::alloc/copy is released after bgfx::shutdown.");
+
+			// Allocator chunk came from might be gone too, chunk is leaked.
+			if (NULL != pool)
+			{
+				bx::MutexScope scope(pool->m_lock);
+				chunk->m_next = pool->m_free;
+				pool->m_free  = chunk;
+				++pool->m_numFree;
+			}
+		}
+	}
+
+	MemoryPool::Chunk* MemoryPool::acquire()
+	{
+		Chunk* chunk = m_free;
+
+		if (NULL != chunk)
+		{
+			m_free = chunk->m_next;
+			--m_numFree;
+			m_minFree = bx::min(m_minFree, m_numFree);
+		}
+		else
+		{
+			chunk = (Chunk*)BX_ALLOC(g_allocator, BGFX_CONFIG_MEMORY_POOL_CHUNK_SIZE);
+			chunk->m_pool      = this;
+			chunk->m_prevChunk = NULL;
+			chunk->m_nextChunk = m_chunks;
+
+			if (NULL != m_chunks)
+			{
+				m_chunks->m_prevChunk = chunk;
+			}
+
+			m_chunks = chunk;
+			++m_numChunks;
+		}
+
+		// Pool keeps reference until chunk stops being current.
+		chunk->m_refCount = 1;
+		chunk->m_offset   = BX_ALIGN_16(uint32_t(sizeof(Chunk) ) );
+
+		return chunk;
+	}
+
+	void MemoryPool::retire(Chunk* _chunk)
+	{
+		if (1 == bx::atomicFetchAndSub<int32_t>(&_chunk->m_refCount, 1) )
+		{
+			_chunk->m_next = m_free;
+			m_free = _chunk;
+			++m_numFree;
+		}
+	}
+
+	void MemoryPool::destroy(Chunk* _chunk)
+	{
+		if (NULL != _chunk->m_prevChunk)
+		{
+			_chunk->m_prevChunk->m_nextChunk = _chunk->m_nextChunk;
+		}
+		else
+		{
+			m_chunks = _chunk->m_nextChunk;
+		}
+
+		if (NULL != _chunk->m_nextChunk)
+		{
+			_chunk->m_nextChunk->m_prevChunk = _chunk->m_prevChunk;
+		}
+
+		BX_FREE(g_allocator, _chunk);
+		--m_numChunks;
+	}
+
+	PhaseTimer::PhaseTimer()
+		: m_time(NULL)
+		, m_scratch(NULL)
+		, m_window(0)
+		, m_num(0)
+		, m_pos(0)
+	{
+		bx::memSet(m_last, 0, sizeof(m_last) );
+	}
+
+	void PhaseTimer::init(uint16_t _window)
+	{
+		m_window  = _window;
+		m_num     = 0;
+		m_pos     = 0;
+		m_time    = (int64_t*)BX_ALLOC(g_allocator, sizeof(int64_t)*m_window*Phase::Count);
+		m_scratch = (int64_t*)BX_ALLOC(g_allocator, sizeof(int64_t)*m_window);
+		bx::memSet(m_last, 0, sizeof(m_last) );
+	}
+
+	void PhaseTimer::shutdown()
+	{
+		BX_FREE(g_allocator, m_time);
+		BX_FREE(g_allocator, m_scratch);
+		m_time    = NULL;
+		m_scratch = NULL;
+	}
+
+	void PhaseTimer::add(const int64_t* _phaseTime)
+	{
+		const double toNs = 1000000000.0/double(bx::getHPFrequency() );
+
+		for (uint32_t ii = 0; ii < Phase::Count; ++ii)
+		{
+			const int64_t time = int64_t(double(_phaseTime[ii])*toNs);
+			m_time[ii*m_window + m_pos] = time;
+			m_last[ii] = time;
+		}
+
+		m_pos = (m_pos + 1) % m_window;
+		m_num = bx::min<uint16_t>(m_num + 1, m_window);
+	}
+
+	static int32_t compareTime(const void* _lhs, const void* _rhs)
+	{
+		const int64_t lhs = *(const int64_t*)_lhs;
+		const int64_t rhs = *(const int64_t*)_rhs;
+		return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+	}
+
+	void PhaseTimer::get(Stats& _stats)
+	{
+		_stats.numPhaseFrames = m_num;
+
+		for (uint32_t ii = 0; ii < Phase::Count; ++ii)
+		{
+			PhaseStats& phaseStats = _stats.phaseStats[ii];
+			phaseStats.last = m_last[ii];
+
+			if (0 == m_num)
+			{
+				phaseStats.min = 0;
+				phaseStats.avg = 0;
+				phaseStats.max = 0;
+				phaseStats.p99 = 0;
+				continue;
+			}
+
+			// Window is not in frame order, which doesn't matter for any of
+			// these.
+			bx::memCopy(m_scratch, &m_time[ii*m_window], sizeof(int64_t)*m_num);
+			bx::quickSort(m_scratch, m_num, sizeof(int64_t), compareTime);
+
+			int64_t sum = 0;
+			for (uint32_t jj = 0; jj < m_num; ++jj)
+			{
+				sum += m_scratch[jj];
+			}
+
+			// Nearest rank percentile.
+			const uint32_t p99 = (uint32_t(m_num)*99 + 99)/100 - 1;
+
+			phaseStats.min = m_scratch[0];
+			phaseStats.avg = sum / m_num;
+			phaseStats.max = m_scratch[m_num-1];
+			phaseStats.p99 = m_scratch[p99];
+		}
+	}
+
 	const Memory* makeRef(const void* _data, uint32_t _size, ReleaseFn _releaseFn, void* _userData)
 	{
 		MemoryRef* memRef = (MemoryRef*)BX_ALLOC(g_allocator, sizeof(MemoryRef) );
@@ -3873,9 +6604,16 @@ namespace bgfx
 		if (isMemoryRef(mem) )
 		{
 			MemoryRef* memRef = reinterpret_cast<MemoryRef*>(mem);
-			if (NULL != memRef->releaseFn)
+			const ReleaseFn releaseFn = memRef->releaseFn;
+			if (NULL != releaseFn)
 			{
-				memRef->releaseFn(mem->data, memRef->userData);
+				releaseFn(mem->data, memRef->userData);
+			}
+
+			if (MemoryPool::release == releaseFn)
+			{
+				// Block is part of memory pool chunk.
+				return;
 			}
 		}
 		BX_FREE(g_allocator, mem);
@@ -4621,6 +7359,16 @@ namespace bgfx
 		s_ctx->destroyOcclusionQuery(_handle);
 	}
 
+	DrawBundleHandle createDrawBundle()
+	{
+		return s_ctx->createDrawBundle();
+	}
+
+	void destroy(DrawBundleHandle _handle)
+	{
+		s_ctx->destroyDrawBundle(_handle);
+	}
+
 	void setPaletteColor(uint8_t _index, uint32_t _rgba)
 	{
 		const uint8_t rr = uint8_t(_rgba>>24);
@@ -4703,6 +7451,15 @@ namespace bgfx
 		s_ctx->setViewMode(_id, _mode);
 	}
 
+	void setViewAutoInstancing(ViewId _id, bool _enabled)
+	{
+		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
+		BX_CHECK(!_enabled || 0 != (g_caps.supported & BGFX_CAPS_INSTANCING)
+			, "Instancing is not supported! Use bgfx::getCaps to check BGFX_CAPS_INSTANCING backend renderer capabilities."
+			);
+		s_ctx->setViewAutoInstancing(_id, _enabled);
+	}
+
 	void setViewFrameBuffer(ViewId _id, FrameBufferHandle _handle)
 	{
 		BX_CHECK(checkView(_id), "Invalid view id: %d", _id);
@@ -4937,6 +7694,39 @@ namespace bgfx
 		s_ctx->m_encoder0->submit(_id, _program, _indirectHandle, _start, _num, _depth, _preserveState);
 	}
 
+	void submitBatch(
+		  ViewId _id
+		, uint32_t _num
+		, const ProgramHandle* _program
+		, const uint32_t* _transform
+		, const VertexBufferHandle* _vertexBuffer
+		, const IndexBufferHandle* _indexBuffer
+		, const uint64_t* _state
+		, const uint32_t* _depth
+		)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->submitBatch(_id, _num, _program, _transform, _vertexBuffer, _indexBuffer, _state, _depth);
+	}
+
+	void beginDrawBundle(DrawBundleHandle _handle)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->beginDrawBundle(_handle);
+	}
+
+	void endDrawBundle()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->endDrawBundle();
+	}
+
+	void submit(ViewId _id, DrawBundleHandle _handle)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->submit(_id, _handle);
+	}
+
 	void setBuffer(uint8_t _stage, IndexBufferHandle _handle, Access::Enum _access)
 	{
 		BGFX_CHECK_API_THREAD();
@@ -5007,6 +7797,42 @@ namespace bgfx
 		BGFX_CHECK_API_THREAD();
 		s_ctx->requestScreenShot(_handle, _filePath);
 	}
+
+	bool frameTraceBegin(const char* _filePath)
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->frameTraceBegin(_filePath);
+	}
+
+	void frameTraceEnd()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->frameTraceEnd();
+	}
+
+	uint32_t frameTraceReplay(const char* _filePath)
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->frameTraceReplay(_filePath);
+	}
+
+	bool profilerTraceBegin(const char* _filePath, uint32_t _dumpInterval)
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->profilerTraceBegin(_filePath, _dumpInterval);
+	}
+
+	void profilerTraceDump()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->profilerTraceDump();
+	}
+
+	void profilerTraceEnd()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->profilerTraceEnd();
+	}
 } // namespace bgfx
 
 #if BX_PLATFORM_WINDOWS
@@ -606,6 +606,19 @@ BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _hand
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API bgfx_draw_bundle_handle_t bgfx_create_draw_bundle()
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::createDrawBundle();
+	return handle_ret.c;
+}
+
+BGFX_C_API void bgfx_destroy_draw_bundle(bgfx_draw_bundle_handle_t _handle)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	bgfx::destroy(handle.cpp);
+}
+
 BGFX_C_API void bgfx_set_palette_color(uint8_t _index, const float _rgba[4])
 {
 	bgfx::setPaletteColor(_index, _rgba);
@@ -651,6 +664,11 @@ BGFX_C_API void bgfx_set_view_mode(bgfx_view_id_t _id, bgfx_view_mode_t _mode)
 	bgfx::setViewMode((bgfx::ViewId)_id, (bgfx::ViewMode::Enum)_mode);
 }
 
+BGFX_C_API void bgfx_set_view_auto_instancing(bgfx_view_id_t _id, bool _enabled)
+{
+	bgfx::setViewAutoInstancing((bgfx::ViewId)_id, _enabled);
+}
+
 BGFX_C_API void bgfx_set_view_frame_buffer(bgfx_view_id_t _id, bgfx_frame_buffer_handle_t _handle)
 {
 	union { bgfx_frame_buffer_handle_t c; bgfx::FrameBufferHandle cpp; } handle = { _handle };
@@ -739,6 +757,44 @@ BGFX_C_API void bgfx_encoder_set_uniform(bgfx_encoder_t* _this, bgfx_uniform_han
 	This->setUniform(handle.cpp, _value, _num);
 }
 
+BGFX_C_API uint32_t bgfx_encoder_get_avail_transient_index_buffer(bgfx_encoder_t* _this, uint32_t _num)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	return This->getAvailTransientIndexBuffer(_num);
+}
+
+BGFX_C_API uint32_t bgfx_encoder_get_avail_transient_vertex_buffer(bgfx_encoder_t* _this, uint32_t _num, const bgfx_vertex_decl_t * _decl)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	const bgfx::VertexDecl & decl = *(const bgfx::VertexDecl *)_decl;
+	return This->getAvailTransientVertexBuffer(_num, decl);
+}
+
+BGFX_C_API uint32_t bgfx_encoder_get_avail_instance_data_buffer(bgfx_encoder_t* _this, uint32_t _num, uint16_t _stride)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	return This->getAvailInstanceDataBuffer(_num, _stride);
+}
+
+BGFX_C_API void bgfx_encoder_alloc_transient_index_buffer(bgfx_encoder_t* _this, bgfx_transient_index_buffer_t* _tib, uint32_t _num)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->allocTransientIndexBuffer((bgfx::TransientIndexBuffer*)_tib, _num);
+}
+
+BGFX_C_API void bgfx_encoder_alloc_transient_vertex_buffer(bgfx_encoder_t* _this, bgfx_transient_vertex_buffer_t* _tvb, uint32_t _num, const bgfx_vertex_decl_t * _decl)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	const bgfx::VertexDecl & decl = *(const bgfx::VertexDecl *)_decl;
+	This->allocTransientVertexBuffer((bgfx::TransientVertexBuffer*)_tvb, _num, decl);
+}
+
+BGFX_C_API void bgfx_encoder_alloc_instance_data_buffer(bgfx_encoder_t* _this, bgfx_instance_data_buffer_t* _idb, uint32_t _num, uint16_t _stride)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->allocInstanceDataBuffer((bgfx::InstanceDataBuffer*)_idb, _num, _stride);
+}
+
 BGFX_C_API void bgfx_encoder_set_index_buffer(bgfx_encoder_t* _this, bgfx_index_buffer_handle_t _handle, uint32_t _firstIndex, uint32_t _numIndices)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -851,6 +907,32 @@ BGFX_C_API void bgfx_encoder_submit_indirect(bgfx_encoder_t* _this, bgfx_view_id
 	This->submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, _num, _depth, _preserveState);
 }
 
+BGFX_C_API void bgfx_encoder_submit_batch(bgfx_encoder_t* _this, bgfx_view_id_t _id, uint32_t _num, const bgfx_program_handle_t* _program, const uint32_t* _transform, const bgfx_vertex_buffer_handle_t* _vertexBuffer, const bgfx_index_buffer_handle_t* _indexBuffer, const uint64_t* _state, const uint32_t* _depth)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->submitBatch((bgfx::ViewId)_id, _num, (const bgfx::ProgramHandle*)_program, _transform, (const bgfx::VertexBufferHandle*)_vertexBuffer, (const bgfx::IndexBufferHandle*)_indexBuffer, _state, _depth);
+}
+
+BGFX_C_API void bgfx_encoder_begin_draw_bundle(bgfx_encoder_t* _this, bgfx_draw_bundle_handle_t _handle)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	This->beginDrawBundle(handle.cpp);
+}
+
+BGFX_C_API void bgfx_encoder_end_draw_bundle(bgfx_encoder_t* _this)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->endDrawBundle();
+}
+
+BGFX_C_API void bgfx_encoder_submit_draw_bundle(bgfx_encoder_t* _this, bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	This->submit((bgfx::ViewId)_id, handle.cpp);
+}
+
 BGFX_C_API void bgfx_encoder_set_compute_index_buffer(bgfx_encoder_t* _this, uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -928,6 +1010,36 @@ BGFX_C_API void bgfx_request_screen_shot(bgfx_frame_buffer_handle_t _handle, con
 	bgfx::requestScreenShot(handle.cpp, _filePath);
 }
 
+BGFX_C_API bool bgfx_frame_trace_begin(const char* _filePath)
+{
+	return bgfx::frameTraceBegin(_filePath);
+}
+
+BGFX_C_API void bgfx_frame_trace_end()
+{
+	bgfx::frameTraceEnd();
+}
+
+BGFX_C_API uint32_t bgfx_frame_trace_replay(const char* _filePath)
+{
+	return bgfx::frameTraceReplay(_filePath);
+}
+
+BGFX_C_API bool bgfx_profiler_trace_begin(const char* _filePath, uint32_t _dumpInterval)
+{
+	return bgfx::profilerTraceBegin(_filePath, _dumpInterval);
+}
+
+BGFX_C_API void bgfx_profiler_trace_dump()
+{
+	bgfx::profilerTraceDump();
+}
+
+BGFX_C_API void bgfx_profiler_trace_end()
+{
+	bgfx::profilerTraceEnd();
+}
+
 BGFX_C_API bgfx_render_frame_t bgfx_render_frame(int32_t _msecs)
 {
 	return (bgfx_render_frame_t)bgfx::renderFrame(_msecs);
@@ -1101,6 +1213,28 @@ BGFX_C_API void bgfx_submit_indirect(bgfx_view_id_t _id, bgfx_program_handle_t _
 	bgfx::submit((bgfx::ViewId)_id, program.cpp, indirectHandle.cpp, _start, _num, _depth, _preserveState);
 }
 
+BGFX_C_API void bgfx_submit_batch(bgfx_view_id_t _id, uint32_t _num, const bgfx_program_handle_t* _program, const uint32_t* _transform, const bgfx_vertex_buffer_handle_t* _vertexBuffer, const bgfx_index_buffer_handle_t* _indexBuffer, const uint64_t* _state, const uint32_t* _depth)
+{
+	bgfx::submitBatch((bgfx::ViewId)_id, _num, (const bgfx::ProgramHandle*)_program, _transform, (const bgfx::VertexBufferHandle*)_vertexBuffer, (const bgfx::IndexBufferHandle*)_indexBuffer, _state, _depth);
+}
+
+BGFX_C_API void bgfx_begin_draw_bundle(bgfx_draw_bundle_handle_t _handle)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	bgfx::beginDrawBundle(handle.cpp);
+}
+
+BGFX_C_API void bgfx_end_draw_bundle()
+{
+	bgfx::endDrawBundle();
+}
+
+BGFX_C_API void bgfx_submit_draw_bundle(bgfx_view_id_t _id, bgfx_draw_bundle_handle_t _handle)
+{
+	union { bgfx_draw_bundle_handle_t c; bgfx::DrawBundleHandle cpp; } handle = { _handle };
+	bgfx::submit((bgfx::ViewId)_id, handle.cpp);
+}
+
 BGFX_C_API void bgfx_set_compute_index_buffer(uint8_t _stage, bgfx_index_buffer_handle_t _handle, bgfx_access_t _access)
 {
 	union { bgfx_index_buffer_handle_t c; bgfx::IndexBufferHandle cpp; } handle = { _handle };
@@ -1294,6 +1428,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_occlusion_query,
 			bgfx_get_result,
 			bgfx_destroy_occlusion_query,
+			bgfx_create_draw_bundle,
+			bgfx_destroy_draw_bundle,
 			bgfx_set_palette_color,
 			bgfx_set_palette_color_rgba8,
 			bgfx_set_view_name,
@@ -1303,6 +1439,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_set_view_clear,
 			bgfx_set_view_clear_mrt,
 			bgfx_set_view_mode,
+			bgfx_set_view_auto_instancing,
 			bgfx_set_view_frame_buffer,
 			bgfx_set_view_transform,
 			bgfx_set_view_order,
@@ -1318,6 +1455,12 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_set_transform_cached,
 			bgfx_encoder_alloc_transform,
 			bgfx_encoder_set_uniform,
+			bgfx_encoder_get_avail_transient_index_buffer,
+			bgfx_encoder_get_avail_transient_vertex_buffer,
+			bgfx_encoder_get_avail_instance_data_buffer,
+			bgfx_encoder_alloc_transient_index_buffer,
+			bgfx_encoder_alloc_transient_vertex_buffer,
+			bgfx_encoder_alloc_instance_data_buffer,
 			bgfx_encoder_set_index_buffer,
 			bgfx_encoder_set_dynamic_index_buffer,
 			bgfx_encoder_set_transient_index_buffer,
@@ -1334,6 +1477,10 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_submit,
 			bgfx_encoder_submit_occlusion_query,
 			bgfx_encoder_submit_indirect,
+			bgfx_encoder_submit_batch,
+			bgfx_encoder_begin_draw_bundle,
+			bgfx_encoder_end_draw_bundle,
+			bgfx_encoder_submit_draw_bundle,
 			bgfx_encoder_set_compute_index_buffer,
 			bgfx_encoder_set_compute_vertex_buffer,
 			bgfx_encoder_set_compute_dynamic_index_buffer,
@@ -1345,6 +1492,12 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_discard,
 			bgfx_encoder_blit,
 			bgfx_request_screen_shot,
+			bgfx_frame_trace_begin,
+			bgfx_frame_trace_end,
+			bgfx_frame_trace_replay,
+			bgfx_profiler_trace_begin,
+			bgfx_profiler_trace_dump,
+			bgfx_profiler_trace_end,
 			bgfx_render_frame,
 			bgfx_set_platform_data,
 			bgfx_get_internal_data,
@@ -1376,6 +1529,10 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_submit,
 			bgfx_submit_occlusion_query,
 			bgfx_submit_indirect,
+			bgfx_submit_batch,
+			bgfx_begin_draw_bundle,
+			bgfx_end_draw_bundle,
+			bgfx_submit_draw_bundle,
 			bgfx_set_compute_index_buffer,
 			bgfx_set_compute_vertex_buffer,
 			bgfx_set_compute_dynamic_index_buffer,
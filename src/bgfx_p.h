@@ -52,10 +52,22 @@
 
 #if BGFX_CONFIG_PROFILER
 #	define BGFX_PROFILER_SCOPE(_name, _abgr)            ProfilerScope BX_CONCATENATE(profilerScope, __LINE__)(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_BEGIN(_name, _abgr)            g_callback->profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)    g_callback->profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_END()                          g_callback->profilerEnd()
-#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) BX_NOOP()
+#	define BGFX_PROFILER_BEGIN(_name, _abgr)                                                   \
+		BX_MACRO_BLOCK_BEGIN                                                                    \
+			g_profilerTrace.begin(_name, false);                                                \
+			g_callback->profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) );             \
+		BX_MACRO_BLOCK_END
+#	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)                                           \
+		BX_MACRO_BLOCK_BEGIN                                                                    \
+			g_profilerTrace.begin(_name, true);                                                 \
+			g_callback->profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) );      \
+		BX_MACRO_BLOCK_END
+#	define BGFX_PROFILER_END()                                                                 \
+		BX_MACRO_BLOCK_BEGIN                                                                    \
+			g_callback->profilerEnd();                                                          \
+			g_profilerTrace.end();                                                              \
+		BX_MACRO_BLOCK_END
+#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) g_profilerTrace.setThreadName(_name)
 #else
 #	define BGFX_PROFILER_SCOPE(_name, _abgr)            BX_NOOP()
 #	define BGFX_PROFILER_BEGIN(_name, _abgr)            BX_NOOP()
@@ -113,6 +125,7 @@ namespace bgfx
 #include <bx/cpu.h>
 #include <bx/debug.h>
 #include <bx/endian.h>
+#include <bx/file.h>
 #include <bx/float4x4_t.h>
 #include <bx/handlealloc.h>
 #include <bx/hash.h>
@@ -199,6 +212,9 @@ namespace stl = tinystl;
 namespace stl = std;
 #endif // BGFX_CONFIG_USE_TINYSTL
 
+#include "nonlocal_allocator.h"
+#include "texture_update.h"
+
 #if BX_PLATFORM_ANDROID
 #	include <android/native_window.h>
 #elif BX_PLATFORM_WINDOWS
@@ -469,22 +485,120 @@ namespace bgfx
 
 	typedef bx::StringT<&g_allocator> String;
 
+	// Built-in profiler sink, records BGFX_PROFILER_* scopes into ring buffer
+	// of the thread they were recorded on, and writes them as Chrome trace
+	// event JSON. Recording never blocks, dump reads rings on API thread
+	// while other threads keep recording.
+	class ProfilerTrace
+	{
+	public:
+		ProfilerTrace();
+
+		bool open(const char* _filePath, uint32_t _dumpInterval);
+		void close();
+
+		// Frees rings, threads allocate new ring next time they record.
+		void shutdown();
+
+		bool isOpen() const
+		{
+			return m_enabled;
+		}
+
+		void begin(const char* _name, bool _literal)
+		{
+			if (m_enabled)
+			{
+				record(EventType::Begin, _name, _literal);
+			}
+		}
+
+		void end()
+		{
+			if (m_enabled)
+			{
+				record(EventType::End, NULL, true);
+			}
+		}
+
+		void setThreadName(const char* _name);
+
+		void requestDump()
+		{
+			m_dumpRequested = true;
+		}
+
+		// Dumps when requested, or every dump interval frames.
+		void frame(uint32_t _frame);
+
+	private:
+		struct EventType
+		{
+			enum Enum
+			{
+				Begin,
+				End,
+			};
+		};
+
+		struct Event
+		{
+			int64_t     m_time;
+			const char* m_name;    // NULL when name is in m_copy.
+			char        m_copy[31];
+			uint8_t     m_type;
+		};
+
+		struct Ring
+		{
+			Ring*       m_next;
+			const char* m_name;
+			uint32_t    m_tid;
+			uint32_t    m_write; // Written by owning thread only.
+			uint32_t    m_read;  // Used by dump only.
+			Event       m_event[BGFX_CONFIG_PROFILER_TRACE_EVENTS];
+		};
+
+		void record(EventType::Enum _type, const char* _name, bool _literal);
+		Ring* getRing();
+		void dump(uint32_t _frame);
+
+		bx::Mutex m_lock; // Ring list.
+
+		Ring*    m_rings;
+		Event*   m_scratch;
+		int64_t  m_timeBegin;
+		uint32_t m_generation;
+		uint32_t m_numThreads;
+		uint32_t m_dumpInterval;
+		char     m_filePath[1024];
+
+		volatile bool m_enabled;
+		bool m_dumpRequested;
+	};
+
+	extern ProfilerTrace g_profilerTrace;
+
 	struct ProfilerScope
 	{
 		ProfilerScope(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
 		{
+			g_profilerTrace.begin(_name, true);
 			g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
 		}
 
 		~ProfilerScope()
 		{
 			g_callback->profilerEnd();
+			g_profilerTrace.end();
 		}
 	};
 
 	void setGraphicsDebuggerPresent(bool _present);
 	bool isGraphicsDebuggerPresent();
 	void release(const Memory* _mem);
+	const Memory* allocUnpooled(uint32_t _size);
+	const Memory* copyUnpooled(const void* _data, uint32_t _size);
 	const char* getAttribName(Attrib::Enum _attr);
 	const char* getAttribNameShort(Attrib::Enum _attr);
 	void getTextureSizeFromRatio(BackbufferRatio::Enum _ratio, uint16_t& _width, uint16_t& _height);
@@ -769,12 +883,21 @@ namespace bgfx
 
 	public:
 		CommandBuffer()
-			: m_pos(0)
-			, m_size(BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE)
+			: m_buffer(NULL)
+			, m_pos(0)
+			, m_size(UINT32_MAX)
+			, m_capacity(0)
+			, m_highWater(0)
+			, m_numLowFrames(0)
 		{
 			finish();
 		}
 
+		~CommandBuffer()
+		{
+			BX_FREE(g_allocator, m_buffer);
+		}
+
 		enum Enum
 		{
 			RendererInit,
@@ -810,12 +933,21 @@ namespace bgfx
 			DestroyUniform,
 			ReadTexture,
 			RequestScreenShot,
+
+			Count
 		};
 
 		void write(const void* _data, uint32_t _size)
 		{
-			BX_CHECK(m_size == BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE, "Called write outside start/finish?");
-			BX_CHECK(m_pos < m_size, "CommandBuffer::write error (pos: %d, size: %d).", m_pos, m_size);
+			BX_CHECK(UINT32_MAX == m_size, "Called write outside start/finish?");
+
+			if (m_pos + _size > m_capacity)
+			{
+				// Grow geometrically so a burst of commands doesn't copy
+				// the buffer once per chunk.
+				resize(bx::max(m_pos + _size, m_capacity*2) );
+			}
+
 			bx::memCopy(&m_buffer[m_pos], _data, _size);
 			m_pos += _size;
 		}
@@ -870,8 +1002,24 @@ namespace bgfx
 
 		void start()
 		{
+			// Memory is kept between frames. After burst of commands it's
+			// released gradually, once usage stays low for a while.
+			if (m_size < m_capacity/4
+			&&  BGFX_CONFIG_COMMAND_BUFFER_CHUNK_SIZE < m_capacity)
+			{
+				if (++m_numLowFrames > 64)
+				{
+					m_numLowFrames = 0;
+					resize(m_capacity/2);
+				}
+			}
+			else
+			{
+				m_numLowFrames = 0;
+			}
+
 			m_pos = 0;
-			m_size = BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE;
+			m_size = UINT32_MAX;
 		}
 
 		void finish()
@@ -880,11 +1028,21 @@ namespace bgfx
 			write(cmd);
 			m_size = m_pos;
 			m_pos = 0;
+			m_highWater = bx::max(m_highWater, m_size);
+		}
+
+		void resize(uint32_t _size)
+		{
+			m_capacity = bx::strideAlign(bx::max<uint32_t>(_size, 1), BGFX_CONFIG_COMMAND_BUFFER_CHUNK_SIZE);
+			m_buffer   = (uint8_t*)BX_REALLOC(g_allocator, m_buffer, m_capacity);
 		}
 
+		uint8_t* m_buffer;
 		uint32_t m_pos;
 		uint32_t m_size;
-		uint8_t m_buffer[BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE];
+		uint32_t m_capacity;
+		uint32_t m_highWater;
+		uint32_t m_numLowFrames;
 	};
 
 //
@@ -1139,7 +1297,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			return ViewId( (_key & kSortKeyViewMask) >> kSortKeyViewBitShift);
 		}
 
-		static uint64_t remapView(uint64_t _key, ViewId _viewRemap[BGFX_CONFIG_MAX_VIEWS])
+		static uint64_t remapView(uint64_t _key, const ViewId _viewRemap[BGFX_CONFIG_MAX_VIEWS])
 		{
 			const ViewId   oldView = decodeView(_key);
 			const uint64_t view    = uint64_t(_viewRemap[oldView]) << kSortKeyViewBitShift;
@@ -1180,7 +1338,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_view =   ViewId(_key >> 24);
 		}
 
-		static uint32_t remapView(uint32_t _key, ViewId _viewRemap[BGFX_CONFIG_MAX_VIEWS])
+		static uint32_t remapView(uint32_t _key, const ViewId _viewRemap[BGFX_CONFIG_MAX_VIEWS])
 		{
 			const ViewId   oldView  = ViewId(_key >> 24);
 			const uint32_t view     = uint32_t(_viewRemap[oldView]) << 24;
@@ -1281,6 +1439,16 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_num = 0;
 		}
 
+		uint32_t reserve(uint16_t* _num)
+		{
+			uint32_t num = *_num;
+			uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, num, BGFX_CONFIG_MAX_RECT_CACHE-1);
+			BX_WARN(first+num < BGFX_CONFIG_MAX_RECT_CACHE, "Rect cache overflow. %d (max: %d)", first+num, BGFX_CONFIG_MAX_RECT_CACHE);
+			num = bx::min(num, BGFX_CONFIG_MAX_RECT_CACHE-1-first);
+			*_num = (uint16_t)num;
+			return first;
+		}
+
 		uint32_t add(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
 		{
 			const uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(&m_num, 1, BGFX_CONFIG_MAX_RECT_CACHE-1);
@@ -1384,6 +1552,18 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			write(&_value, sizeof(uint32_t) );
 		}
 
+		void copy(const UniformBuffer* _src, uint32_t _begin, uint32_t _end)
+		{
+			BX_CHECK(_begin <= _end && _end <= _src->m_pos, "Copy out of bounds [%d, %d) (pos: %d).", _begin, _end, _src->m_pos);
+			write(&_src->m_buffer[_begin], _end - _begin);
+		}
+
+		const char* getData(uint32_t _pos) const
+		{
+			BX_CHECK(_pos < m_size, "Out of bounds %d (size: %d).", _pos, m_size);
+			return &m_buffer[_pos];
+		}
+
 		const char* read(uint32_t _size)
 		{
 			BX_CHECK(m_pos < m_size, "Out of bounds %d (size: %d).", m_pos, m_size);
@@ -1420,15 +1600,33 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_pos = 0;
 		}
 
+		void resetStats()
+		{
+			m_bytesWritten   = 0;
+			m_bytesSkipped   = 0;
+			m_bytesUpdated   = 0;
+			m_bytesRedundant = 0;
+			m_commitTime     = 0;
+		}
+
 		void writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num = 1);
+		void writeUniformRef(UniformType::Enum _type, uint16_t _loc, uint32_t _pos, uint16_t _num = 1);
 		void writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num = 1);
 		void writeMarker(const char* _marker);
+		bool isUniformEqual(uint32_t _pos, UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num = 1) const;
+
+		uint32_t m_bytesWritten;   //!< Uniform data written by encoder.
+		uint32_t m_bytesSkipped;   //!< Uniform data encoder referenced instead of writing it again.
+		uint32_t m_bytesUpdated;   //!< Uniform data that changed backend value.
+		uint32_t m_bytesRedundant; //!< Uniform data that backend already had.
+		int64_t  m_commitTime;     //!< Time renderer spent committing uniforms, see Phase::UniformCommit.
 
 	private:
 		UniformBuffer(uint32_t _size)
 			: m_size(_size)
 			, m_pos(0)
 		{
+			resetStats();
 			finish();
 		}
 
@@ -1530,15 +1728,21 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 	{
 		void clear()
 		{
+			// Binds are compared and hashed as raw memory, padding must be
+			// cleared too.
+			bx::memSet(m_bind, 0, sizeof(m_bind) );
+
 			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++ii)
 			{
-				Binding& bind = m_bind[ii];
-				bind.m_idx = kInvalidHandle;
-				bind.m_type = 0;
-				bind.m_samplerFlags = 0;
+				m_bind[ii].m_idx = kInvalidHandle;
 			}
 		};
 
+		bool isEqual(const RenderBind& _other) const
+		{
+			return 0 == bx::memCmp(m_bind, _other.m_bind, sizeof(m_bind) );
+		}
+
 		Binding m_bind[BGFX_CONFIG_MAX_TEXTURE_SAMPLERS];
 	};
 
@@ -1570,6 +1774,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_indirectBuffer.idx     = kInvalidHandle;
 			m_occlusionQuery.idx     = kInvalidHandle;
 			m_uniformIdx = UINT8_MAX;
+			m_bindIdx    = 0;
 		}
 
 		bool setStreamBit(uint8_t _stream, VertexBufferHandle _handle)
@@ -1598,6 +1803,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		uint16_t m_numIndirect;
 		uint16_t m_numMatrices;
 		uint16_t m_scissor;
+		uint32_t m_bindIdx;
 		uint8_t  m_submitFlags;
 		uint8_t  m_streamMask;
 		uint8_t  m_uniformIdx;
@@ -1621,6 +1827,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_numMatrices  = 0;
 			m_submitFlags  = 0;
 			m_uniformIdx   = UINT8_MAX;
+			m_bindIdx      = 0;
 
 			m_indirectBuffer.idx = kInvalidHandle;
 			m_startIndirect      = 0;
@@ -1638,6 +1845,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		uint16_t m_startIndirect;
 		uint16_t m_numIndirect;
 		uint16_t m_numMatrices;
+		uint32_t m_bindIdx;
 		uint8_t  m_submitFlags;
 		uint8_t  m_uniformIdx;
 	};
@@ -1724,6 +1932,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		int16_t           m_refCount;
 	};
 
+	struct TextureDecodeJob;
+
 	struct TextureRef
 	{
 		void init(
@@ -1747,9 +1957,33 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_owned       = false;
 			m_immutable   = _immutable;
 			m_rt          = _rt;
+			m_atlas       = false;
+			m_decodeJob   = NULL;
+			m_streamMem   = NULL;
+			m_streamFlags = 0;
+			m_lastUse     = 0;
+			m_skip        = 0;
+			m_minSkip     = 0;
+		}
+
+		bool isPending() const
+		{
+			return NULL != m_decodeJob;
+		}
+
+		bool isStreamed() const
+		{
+			return NULL != m_streamMem;
 		}
 
 		String   m_name;
+		bool     m_atlas;
+		TextureDecodeJob* m_decodeJob;
+		const Memory* m_streamMem;
+		uint64_t m_streamFlags;
+		uint32_t m_lastUse;
+		uint8_t  m_skip;
+		uint8_t  m_minSkip;
 		void*    m_ptr;
 		uint32_t m_storageSize;
 		int16_t  m_refCount;
@@ -1783,6 +2017,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			setScissor(0, 0, 0, 0);
 			setClear(BGFX_CLEAR_NONE, 0, 0.0f, 0);
 			setMode(ViewMode::Default);
+			setAutoInstancing(false);
 			setFrameBuffer(BGFX_INVALID_HANDLE);
 			setTransform(NULL, NULL);
 		}
@@ -1818,6 +2053,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_mode = uint8_t(_mode);
 		}
 
+		void setAutoInstancing(bool _enabled)
+		{
+			m_autoInstancing = _enabled;
+		}
+
 		void setFrameBuffer(FrameBufferHandle _handle)
 		{
 			m_fbh = _handle;
@@ -1851,6 +2091,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		Matrix4 m_proj;
 		FrameBufferHandle m_fbh;
 		uint8_t m_mode;
+		bool    m_autoInstancing;
 	};
 
 	struct FrameCache
@@ -1877,196 +2118,895 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		RectCache m_rectCache;
 	};
 
-	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
+	BX_STATIC_ASSERT(0 == BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE % BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK); // Page must hold whole encoder blocks.
+	BX_STATIC_ASSERT(0 == (BGFX_CONFIG_MAX_BIND_GROUPS & (BGFX_CONFIG_MAX_BIND_GROUPS-1) ) ); // Must be power of 2.
+	BX_STATIC_ASSERT(BGFX_CONFIG_MAX_BIND_GROUPS <= (32<<10) ); // Bind map holds twice as many 16-bit indices.
+	BX_STATIC_ASSERT(0 == (BGFX_CONFIG_MAX_ENCODER_BIND_GROUPS & (BGFX_CONFIG_MAX_ENCODER_BIND_GROUPS-1) ) ); // Must be power of 2.
+	BX_STATIC_ASSERT(BGFX_CONFIG_MAX_ENCODER_BIND_GROUPS <= (32<<10) ); // Bind map holds twice as many 16-bit indices.
+
+	// Array split into fixed size pages that are allocated when first used.
+	// Element references stay valid while array grows, so encoders can keep
+	// writing into committed pages while other encoders commit new ones.
+	template<typename Ty, uint32_t PageSizeT>
+	class PagedArrayT
 	{
-		Frame()
-			: m_waitSubmit(0)
-			, m_waitRender(0)
-			, m_capture(false)
+	public:
+		PagedArrayT()
+			: m_page(NULL)
+			, m_maxPages(0)
+			, m_numPages(0)
 		{
-			SortKey term;
-			term.reset();
-			term.m_program = BGFX_INVALID_HANDLE;
-			m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS]   = term.encodeDraw(SortKey::SortProgram);
-			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
-			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
+		}
 
-			m_perfStats.viewStats = m_viewStats;
+		void init(uint32_t _max)
+		{
+			m_maxPages = (_max + PageSizeT - 1) / PageSizeT;
+			m_numPages = 0;
+			m_page     = (Ty**)BX_ALLOC(g_allocator, sizeof(Ty*)*m_maxPages);
+			bx::memSet(m_page, 0, sizeof(Ty*)*m_maxPages);
 		}
 
-		~Frame()
+		void shutdown()
 		{
+			trim(0);
+			BX_FREE(g_allocator, m_page);
+			m_page     = NULL;
+			m_maxPages = 0;
 		}
 
-		void create()
+		bool commit(uint32_t _idx)
 		{
+			const uint32_t page = _idx / PageSizeT;
+
+			if (page < m_numPages)
 			{
-				const uint32_t num = g_caps.limits.maxEncoders;
+				bx::memoryBarrier();
+				return true;
+			}
 
-				m_uniformBuffer = (UniformBuffer**)BX_ALLOC(g_allocator, sizeof(UniformBuffer*)*num);
+			if (page >= m_maxPages)
+			{
+				return false;
+			}
 
-				for (uint32_t ii = 0; ii < num; ++ii)
-				{
-					m_uniformBuffer[ii] = UniformBuffer::create();
-				}
+			bx::MutexScope lock(m_mutex);
+
+			while (m_numPages <= page)
+			{
+				m_page[m_numPages] = (Ty*)BX_ALIGNED_ALLOC(g_allocator, sizeof(Ty)*PageSizeT, 64);
+
+				// Page pointer must be visible before page count.
+				bx::memoryBarrier();
+				++m_numPages;
 			}
 
-			reset();
-			start();
-			m_textVideoMem = BX_NEW(g_allocator, TextVideoMem);
+			return true;
 		}
 
-		void destroy()
+		void trim(uint32_t _numPages)
 		{
-			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+			for (uint32_t ii = _numPages, num = m_numPages; ii < num; ++ii)
 			{
-				UniformBuffer::destroy(m_uniformBuffer[ii]);
+				BX_ALIGNED_FREE(g_allocator, m_page[ii], 64);
+				m_page[ii] = NULL;
 			}
 
-			BX_FREE(g_allocator, m_uniformBuffer);
-			BX_DELETE(g_allocator, m_textVideoMem);
+			m_numPages = bx::min<uint32_t>(m_numPages, _numPages);
 		}
 
-		void reset()
+		uint32_t getNumPages() const
 		{
-			start();
-			finish();
-			resetFreeHandles();
+			return m_numPages;
 		}
 
-		void start()
+		Ty& operator[](uint32_t _idx)
 		{
-			m_perfStats.transientVbUsed = m_vboffset;
-			m_perfStats.transientIbUsed = m_iboffset;
+			BX_CHECK(_idx / PageSizeT < m_numPages, "Page is not committed %d (num pages: %d).", _idx / PageSizeT, m_numPages);
+			return m_page[_idx / PageSizeT][_idx % PageSizeT];
+		}
 
-			m_frameCache.reset();
-			m_numRenderItems = 0;
-			m_numBlitItems   = 0;
-			m_iboffset = 0;
-			m_vboffset = 0;
-			m_cmdPre.start();
-			m_cmdPost.start();
-			m_capture = false;
+		const Ty& operator[](uint32_t _idx) const
+		{
+			BX_CHECK(_idx / PageSizeT < m_numPages, "Page is not committed %d (num pages: %d).", _idx / PageSizeT, m_numPages);
+			return m_page[_idx / PageSizeT][_idx % PageSizeT];
 		}
 
-		void finish()
+	private:
+		Ty** m_page;
+		uint32_t m_maxPages;
+		volatile uint32_t m_numPages;
+		bx::Mutex m_mutex;
+	};
+
+	// Draw calls recorded once by encoder and spliced into frame each time
+	// bundle is submitted. Matrices, scissor rects and uniform stream are
+	// bundle local, and get relocated into frame on submit.
+	struct DrawBundle
+	{
+		// Resources referenced by bundle. Key is resource type in high 16 bits
+		// and handle index in low 16 bits.
+		struct ResourceRef
+		{
+			enum Enum
+			{
+				VertexBuffer,
+				IndexBuffer,
+				DynamicVertexBuffer,
+				DynamicIndexBuffer,
+				IndirectBuffer,
+				Texture,
+				Uniform,
+				Program,
+
+				Count
+			};
+		};
+
+		typedef stl::unordered_set<uint32_t> ResourceRefSet;
+
+		// Dynamic buffer slots of draw call. Vertex streams are slots 0 to
+		// BGFX_CONFIG_MAX_VERTEX_STREAMS-1.
+		struct DynamicSlot
 		{
-			m_cmdPre.finish();
-			m_cmdPost.finish();
+			enum Enum
+			{
+				IndexBuffer = BGFX_CONFIG_MAX_VERTEX_STREAMS,
+				InstanceDataBuffer,
 
-//			if (0 < m_numDropped)
-//			{
-//				BX_TRACE("Too many draw calls: %d, dropped %d (max: %d)"
-//					, m_numRenderItems+m_numDropped
-//					, m_numDropped
-//					, BGFX_CONFIG_MAX_DRAW_CALLS
-//					);
-//			}
-		}
+				Count
+			};
+		};
 
-		void sort();
+		// Dynamic buffer used by recorded draw call. Dynamic buffer can move
+		// when it's resized, so its handle and start are resolved when bundle
+		// is submitted, and only offset from buffer start is recorded.
+		struct DynamicRef
+		{
+			uint32_t m_draw;
+			uint32_t m_offset;
+			uint16_t m_handle;
+			uint8_t  m_slot;
+		};
 
-		uint32_t getAvailTransientIndexBuffer(uint32_t _num)
+		typedef stl::vector<DynamicRef> DynamicRefArray;
+
+		DrawBundle()
+			: m_key(NULL)
+			, m_sortKey(NULL)
+			, m_draw(NULL)
+			, m_bind(NULL)
+			, m_matrix(NULL)
+			, m_rect(NULL)
+			, m_uniformBuffer(NULL)
+			, m_num(0)
+			, m_max(0)
+			, m_numMatrices(0)
+			, m_maxMatrices(0)
+			, m_numRects(0)
+			, m_maxRects(0)
+			, m_numBinds(0)
+			, m_maxBinds(0)
+			, m_recording(false)
+			, m_destroyPending(false)
 		{
-			uint32_t offset   = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
-			uint32_t iboffset = offset + _num*sizeof(uint16_t);
-			iboffset = bx::min<uint32_t>(iboffset, g_caps.limits.transientIbSize);
-			uint32_t num = (iboffset-offset)/sizeof(uint16_t);
-			return num;
 		}
 
-		uint32_t allocTransientIndexBuffer(uint32_t& _num)
+		void create()
 		{
-			uint32_t offset = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
-			uint32_t num    = getAvailTransientIndexBuffer(_num);
-			m_iboffset = offset + num*sizeof(uint16_t);
-			_num = num;
-
-			return offset;
+			m_uniformBuffer = UniformBuffer::create(128<<10);
+			reset();
 		}
 
-		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
+		void destroy()
 		{
-			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
-			uint32_t vboffset = offset + _num * _stride;
-			vboffset = bx::min<uint32_t>(vboffset, g_caps.limits.transientVbSize);
-			uint32_t num = (vboffset-offset)/_stride;
-			return num;
+			BX_FREE(g_allocator, m_key);
+			BX_FREE(g_allocator, m_sortKey);
+			BX_ALIGNED_FREE(g_allocator, m_draw,   64);
+			BX_ALIGNED_FREE(g_allocator, m_bind,   64);
+			BX_ALIGNED_FREE(g_allocator, m_matrix, 16);
+			BX_FREE(g_allocator, m_rect);
+			UniformBuffer::destroy(m_uniformBuffer);
+
+			m_key           = NULL;
+			m_sortKey       = NULL;
+			m_draw          = NULL;
+			m_bind          = NULL;
+			m_matrix        = NULL;
+			m_rect          = NULL;
+			m_uniformBuffer = NULL;
+			m_max           = 0;
+			m_maxMatrices   = 0;
+			m_maxRects      = 0;
+			m_maxBinds      = 0;
+			m_recording      = false;
+			m_destroyPending = false;
+			m_resourceRef.clear();
+			m_dynamicRef.clear();
 		}
 
-		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
+		void reset()
 		{
-			uint32_t offset = bx::strideAlign(m_vboffset, _stride);
-			uint32_t num    = getAvailTransientVertexBuffer(_num, _stride);
-			m_vboffset = offset + num * _stride;
-			_num = num;
+			m_num      = 0;
+			m_numRects = 0;
+			m_numBinds = 0;
+			m_resourceRef.clear();
+			m_dynamicRef.clear();
 
-			return offset;
+			// Index 0 is identity, same as in MatrixCache.
+			m_numMatrices = 0;
+			reserveMatrices(1);
+			m_matrix[0].setIdentity();
+
+			m_uniformBuffer->reset();
 		}
 
-		bool free(IndexBufferHandle _handle)
+		uint32_t reserveMatrices(uint16_t _num)
 		{
-			return m_freeIndexBuffer.queue(_handle);
+			const uint32_t first = m_numMatrices;
+			BX_WARN(first + _num < BGFX_CONFIG_MAX_MATRIX_CACHE
+				, "Draw bundle has more matrices than fit into frame matrix cache. %d (max: %d)"
+				, first + _num
+				, BGFX_CONFIG_MAX_MATRIX_CACHE
+				);
+
+			if (first + _num > m_maxMatrices)
+			{
+				m_maxMatrices = bx::max<uint32_t>(first + _num, m_maxMatrices*2);
+				m_matrix = (Matrix4*)BX_ALIGNED_REALLOC(g_allocator, m_matrix, sizeof(Matrix4)*m_maxMatrices, 16);
+			}
+
+			m_numMatrices += _num;
+
+			return first;
 		}
 
-		bool free(VertexDeclHandle _handle)
+		uint32_t addMatrices(const void* _mtx, uint16_t _num)
 		{
-			return m_freeVertexDecl.queue(_handle);
+			if (NULL != _mtx)
+			{
+				const uint32_t first = reserveMatrices(_num);
+				bx::memCopy(&m_matrix[first], _mtx, sizeof(Matrix4)*_num);
+				return first;
+			}
+
+			return 0;
 		}
 
-		bool free(VertexBufferHandle _handle)
+		uint16_t addRect(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
 		{
-			return m_freeVertexBuffer.queue(_handle);
+			if (m_numRects == m_maxRects)
+			{
+				m_maxRects = bx::max<uint32_t>(16, m_maxRects*2);
+				m_rect = (Rect*)BX_REALLOC(g_allocator, m_rect, sizeof(Rect)*m_maxRects);
+			}
+
+			m_rect[m_numRects] = Rect(_x, _y, _width, _height);
+			return uint16_t(m_numRects++);
 		}
 
-		bool free(ShaderHandle _handle)
+		void add(const SortKey& _key, const RenderDraw& _draw, const RenderBind& _bind)
 		{
-			return m_freeShader.queue(_handle);
+			if (m_num == m_max)
+			{
+				m_max = bx::max<uint32_t>(64, m_max*2);
+				m_key     = (SortKey*)BX_REALLOC(g_allocator, m_key, sizeof(SortKey)*m_max);
+				m_sortKey = (uint64_t*)BX_REALLOC(g_allocator, m_sortKey, sizeof(uint64_t)*m_max);
+				m_draw    = (RenderDraw*)BX_ALIGNED_REALLOC(g_allocator, m_draw, sizeof(RenderDraw)*m_max, 64);
+			}
+
+			// Draw stores bundle local bind index, consecutive draws with
+			// same bind share it.
+			if (0 == m_numBinds
+			|| !m_bind[m_numBinds-1].isEqual(_bind) )
+			{
+				if (m_numBinds == m_maxBinds)
+				{
+					m_maxBinds = bx::max<uint32_t>(16, m_maxBinds*2);
+					m_bind     = (RenderBind*)BX_ALIGNED_REALLOC(g_allocator, m_bind, sizeof(RenderBind)*m_maxBinds, 64);
+				}
+
+				m_bind[m_numBinds++] = _bind;
+			}
+
+			// Keys for views in default sort mode are encoded once here, view
+			// is added on submit. Other modes need depth or sequence, and are
+			// encoded on submit from m_key.
+			SortKey key = _key;
+			key.m_view  = 0;
+			key.m_depth = 0;
+
+			m_key[m_num]     = _key;
+			m_sortKey[m_num] = key.encodeDraw(SortKey::SortProgram);
+			m_draw[m_num]    = _draw;
+			m_draw[m_num].m_bindIdx = m_numBinds-1;
+			++m_num;
 		}
 
-		bool free(ProgramHandle _handle)
+		void addResourceRef(ResourceRef::Enum _type, uint16_t _idx)
 		{
-			return m_freeProgram.queue(_handle);
+			m_resourceRef.insert(uint32_t(_type)<<16 | _idx);
 		}
 
-		bool free(TextureHandle _handle)
+		// Adds dynamic buffer used by last recorded draw call.
+		void addDynamicRef(uint8_t _slot, uint16_t _handle, uint32_t _offset)
 		{
-			return m_freeTexture.queue(_handle);
+			DynamicRef ref;
+			ref.m_draw   = m_num-1;
+			ref.m_offset = _offset;
+			ref.m_handle = _handle;
+			ref.m_slot   = _slot;
+			m_dynamicRef.push_back(ref);
 		}
 
-		bool free(FrameBufferHandle _handle)
+		SortKey*       m_key;
+		uint64_t*      m_sortKey;
+		RenderDraw*    m_draw;
+		RenderBind*    m_bind;
+		Matrix4*       m_matrix;
+		Rect*          m_rect;
+		UniformBuffer* m_uniformBuffer;
+
+		uint32_t m_num;
+		uint32_t m_max;
+		uint32_t m_numMatrices;
+		uint32_t m_maxMatrices;
+		uint32_t m_numRects;
+		uint32_t m_maxRects;
+		uint32_t m_numBinds;
+		uint32_t m_maxBinds;
+
+		// Resources referenced by recorded draw calls. Context holds reference
+		// on each of them from endDrawBundle until bundle is recorded again
+		// or destroyed.
+		ResourceRefSet m_resourceRef;
+
+		// Sorted by draw call.
+		DynamicRefArray m_dynamicRef;
+
+		bool m_recording;
+		bool m_destroyPending;
+	};
+
+	// Number of draw bundles referencing buffer handle. Destroying buffer
+	// while it's referenced is deferred until last bundle referencing it
+	// is destroyed or recorded again.
+	template<uint16_t MaxHandlesT>
+	struct BundleRefT
+	{
+		BundleRefT()
 		{
-			return m_freeFrameBuffer.queue(_handle);
+			bx::memSet(m_refCount, 0, sizeof(m_refCount) );
+			bx::memSet(m_destroyPending, 0, sizeof(m_destroyPending) );
 		}
 
-		bool free(UniformHandle _handle)
+		void ref(uint16_t _idx)
 		{
-			return m_freeUniform.queue(_handle);
+			++m_refCount[_idx];
 		}
 
-		void resetFreeHandles()
+		// Returns true when deferred destroy must be executed.
+		bool release(uint16_t _idx)
 		{
-			m_freeIndexBuffer.reset();
-			m_freeVertexDecl.reset();
-			m_freeVertexBuffer.reset();
-			m_freeShader.reset();
-			m_freeProgram.reset();
-			m_freeTexture.reset();
-			m_freeFrameBuffer.reset();
-			m_freeUniform.reset();
-		}
+			BX_CHECK(0 < m_refCount[_idx], "Draw bundle reference underflow %d.", _idx);
+			--m_refCount[_idx];
 
-		ViewId m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
-		float m_colorPalette[BGFX_CONFIG_MAX_COLOR_PALETTE][4];
+			if (0 == m_refCount[_idx]
+			&&  m_destroyPending[_idx])
+			{
+				m_destroyPending[_idx] = false;
+				return true;
+			}
 
-		View m_view[BGFX_CONFIG_MAX_VIEWS];
+			return false;
+		}
+
+		// Returns true when destroy is deferred.
+		bool deferDestroy(uint16_t _idx)
+		{
+			if (0 != m_refCount[_idx])
+			{
+				m_destroyPending[_idx] = true;
+				return true;
+			}
+
+			return false;
+		}
+
+		uint16_t m_refCount[MaxHandlesT];
+		bool     m_destroyPending[MaxHandlesT];
+	};
+
+	// Binds interned by one encoder during frame. Draw calls submitted by
+	// encoder reference them by encoder local index, until tables of all
+	// encoders are merged into frame bind table at the end of frame.
+	struct BindTable
+	{
+		BindTable()
+			: m_bind(NULL)
+			, m_hash(NULL)
+			, m_remap(NULL)
+			, m_num(0)
+			, m_max(0)
+		{
+		}
+
+		void destroy()
+		{
+			BX_ALIGNED_FREE(g_allocator, m_bind, 64);
+			BX_FREE(g_allocator, m_hash);
+			BX_FREE(g_allocator, m_remap);
+			m_bind  = NULL;
+			m_hash  = NULL;
+			m_remap = NULL;
+			m_max   = 0;
+		}
+
+		void reset()
+		{
+			m_map.reset();
+			m_num = 0;
+
+			RenderBind bind;
+			bind.clear();
+			add(bind);
+		}
+
+		uint32_t add(const RenderBind& _bind)
+		{
+			const uint32_t hash = bx::hash<bx::HashMurmur2A>(_bind.m_bind, sizeof(_bind.m_bind) );
+
+			const uint16_t found = m_map.find(hash);
+			if (kInvalidHandle != found
+			&&  m_bind[found].isEqual(_bind) )
+			{
+				return found;
+			}
+
+			if (m_num == m_max)
+			{
+				m_max   = bx::max<uint32_t>(256, m_max*2);
+				m_bind  = (RenderBind*)BX_ALIGNED_REALLOC(g_allocator, m_bind, sizeof(RenderBind)*m_max, 64);
+				m_hash  = (uint32_t*)BX_REALLOC(g_allocator, m_hash, sizeof(uint32_t)*m_max);
+				m_remap = (uint32_t*)BX_REALLOC(g_allocator, m_remap, sizeof(uint32_t)*m_max);
+			}
+
+			const uint32_t idx = m_num++;
+			m_bind[idx] = _bind;
+			m_hash[idx] = hash;
+
+			// Map is kept at most half full, so that lookups that miss stay
+			// short. Past BGFX_CONFIG_MAX_ENCODER_BIND_GROUPS, or on hash
+			// collision with different bind, bind is stored but can't be
+			// found by hash.
+			if (kInvalidHandle == found
+			&&  BGFX_CONFIG_MAX_ENCODER_BIND_GROUPS > m_map.getNumElements()
+			&&  UINT16_MAX > idx)
+			{
+				m_map.insert(hash, uint16_t(idx) );
+			}
+
+			return idx;
+		}
+
+		RenderBind* m_bind;
+		uint32_t*   m_hash;
+		uint32_t*   m_remap;
+		uint32_t    m_num;
+		uint32_t    m_max;
+		bx::HandleHashMapT<BGFX_CONFIG_MAX_ENCODER_BIND_GROUPS*2> m_map;
+	};
+
+	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
+	{
+		Frame()
+			: m_sortKeys(NULL)
+			, m_sortValues(NULL)
+			, m_maxSortKeys(0)
+			, m_numRenderBinds(0)
+			, m_numRenderItems(0)
+			, m_numRenderItemSlots(0)
+			, m_numPagesUsed(0)
+			, m_numPageFrames(0)
+			, m_waitSubmit(0)
+			, m_waitRender(0)
+			, m_capture(false)
+		{
+			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
+			bx::memSet(m_phaseTime, 0, sizeof(m_phaseTime) );
+
+			m_perfStats.viewStats = m_viewStats;
+		}
+
+		~Frame()
+		{
+		}
+
+		void create()
+		{
+			{
+				const uint32_t num = g_caps.limits.maxEncoders;
+
+				m_uniformBuffer = (UniformBuffer**)BX_ALLOC(g_allocator, sizeof(UniformBuffer*)*num);
+
+				for (uint32_t ii = 0; ii < num; ++ii)
+				{
+					m_uniformBuffer[ii] = UniformBuffer::create();
+				}
+
+				m_sortRun = (SortRun*)BX_ALLOC(g_allocator, sizeof(SortRun)*num);
+
+				m_bindTable = (BindTable*)BX_ALLOC(g_allocator, sizeof(BindTable)*num);
+
+				for (uint32_t ii = 0; ii < num; ++ii)
+				{
+					BX_PLACEMENT_NEW(&m_bindTable[ii], BindTable);
+				}
+			}
+
+			m_renderItem.init(g_caps.limits.maxDrawCalls);
+			reserveSortKeys(BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE);
+
+			// Each encoder table holds empty bind, and at most one bind per
+			// render item.
+			m_renderBind.init(g_caps.limits.maxDrawCalls + g_caps.limits.maxEncoders);
+			m_renderBindHash.init(g_caps.limits.maxDrawCalls + g_caps.limits.maxEncoders);
+
+			reset();
+			start();
+			m_textVideoMem = BX_NEW(g_allocator, TextVideoMem);
+		}
+
+		void destroy()
+		{
+			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+			{
+				UniformBuffer::destroy(m_uniformBuffer[ii]);
+			}
+
+			BX_FREE(g_allocator, m_sortRun);
+
+			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+			{
+				m_bindTable[ii].destroy();
+				m_bindTable[ii].~BindTable();
+			}
+
+			BX_FREE(g_allocator, m_bindTable);
+
+			BX_FREE(g_allocator, m_sortKeys);
+			BX_FREE(g_allocator, m_sortValues);
+			m_sortKeys    = NULL;
+			m_sortValues  = NULL;
+			m_maxSortKeys = 0;
+			m_renderItem.shutdown();
+			m_renderBind.shutdown();
+			m_renderBindHash.shutdown();
+
+			BX_FREE(g_allocator, m_uniformBuffer);
+			BX_DELETE(g_allocator, m_textVideoMem);
+		}
+
+		void reset()
+		{
+			start();
+			finish();
+			resetFreeHandles();
+		}
+
+		void start()
+		{
+			m_perfStats.transientVbUsed   = m_vboffset;
+			m_perfStats.transientIbUsed   = m_iboffset;
+			m_perfStats.transientVbWasted = m_vbwasted;
+			m_perfStats.transientIbWasted = m_ibwasted;
+
+			m_perfStats.cmdBufferUsed      = m_cmdPre.m_size + m_cmdPost.m_size;
+			m_perfStats.cmdBufferHighWater = m_cmdPre.m_highWater + m_cmdPost.m_highWater;
+			m_perfStats.cmdBufferCapacity  = m_cmdPre.m_capacity + m_cmdPost.m_capacity;
+
+			m_perfStats.uniformDataWritten   = 0;
+			m_perfStats.uniformDataSkipped   = 0;
+			m_perfStats.uniformDataUpdated   = 0;
+			m_perfStats.uniformDataRedundant = 0;
+
+			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+			{
+				UniformBuffer* uniformBuffer = m_uniformBuffer[ii];
+				m_perfStats.uniformDataWritten   += uniformBuffer->m_bytesWritten;
+				m_perfStats.uniformDataSkipped   += uniformBuffer->m_bytesSkipped;
+				m_perfStats.uniformDataUpdated   += uniformBuffer->m_bytesUpdated;
+				m_perfStats.uniformDataRedundant += uniformBuffer->m_bytesRedundant;
+				uniformBuffer->resetStats();
+			}
+
+			m_frameCache.reset();
+			trimRenderItems();
+			resetRenderBinds();
+			m_numRenderItems     = 0;
+			m_numRenderItemSlots = 0;
+			m_numBlitItems       = 0;
+			bx::memSet(m_sortRun, 0, sizeof(SortRun)*g_caps.limits.maxEncoders);
+			m_iboffset = 0;
+			m_vboffset = 0;
+			m_ibwasted = 0;
+			m_vbwasted = 0;
+			m_cmdPre.start();
+			m_cmdPost.start();
+			m_capture = false;
+			bx::memSet(m_phaseTime, 0, sizeof(m_phaseTime) );
+		}
+
+		void finish()
+		{
+			m_cmdPre.finish();
+			m_cmdPost.finish();
+
+//			if (0 < m_numDropped)
+//			{
+//				BX_TRACE("Too many draw calls: %d, dropped %d (max: %d)"
+//					, m_numRenderItems+m_numDropped
+//					, m_numDropped
+//					, BGFX_CONFIG_MAX_DRAW_CALLS
+//					);
+//			}
+		}
+
+		void sort();
+		bool mergeSortRuns(const ViewId* _viewRemap);
+		void autoInstance();
+
+		bool commitRenderItems(uint32_t _idx)
+		{
+			if (!m_renderItem.commit(_idx) )
+			{
+				return false;
+			}
+
+			// Every render item has at most one sort key, so sort key arrays
+			// grow together with committed render item pages.
+			reserveSortKeys(m_renderItem.getNumPages()*BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE);
+			return true;
+		}
+
+		void reserveSortKeys(uint32_t _num)
+		{
+			_num = bx::min(_num, g_caps.limits.maxDrawCalls);
+
+			if (_num > m_maxSortKeys)
+			{
+				bx::MutexScope lock(m_sortKeyLock);
+
+				if (_num > m_maxSortKeys)
+				{
+					resizeSortKeys(_num);
+				}
+			}
+		}
+
+		void resizeSortKeys(uint32_t _num)
+		{
+			m_sortKeys   = (uint64_t*)BX_REALLOC(g_allocator, m_sortKeys, sizeof(uint64_t)*(_num+1) );
+			m_sortValues = (RenderItemCount*)BX_REALLOC(g_allocator, m_sortValues, sizeof(RenderItemCount)*(_num+1) );
+
+			SortKey term;
+			term.reset();
+			term.m_program = BGFX_INVALID_HANDLE;
+			m_sortKeys[_num]   = term.encodeDraw(SortKey::SortProgram);
+			m_sortValues[_num] = RenderItemCount(_num);
+
+			bx::memoryBarrier();
+			m_maxSortKeys = _num;
+		}
+
+		void resetRenderBinds()
+		{
+			m_renderBindMap.reset();
+			m_numRenderBinds = 0;
+
+			RenderBind bind;
+			bind.clear();
+			addRenderBind(bind, bx::hash<bx::HashMurmur2A>(bind.m_bind, sizeof(bind.m_bind) ) );
+
+			for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
+			{
+				m_bindTable[ii].reset();
+			}
+		}
+
+		uint32_t addRenderBind(const RenderBind& _bind, uint32_t _hash)
+		{
+			const uint16_t found = m_renderBindMap.find(_hash);
+			if (kInvalidHandle != found
+			&&  m_renderBind[found].isEqual(_bind) )
+			{
+				return found;
+			}
+
+			if (!m_renderBind.commit(m_numRenderBinds)
+			||  !m_renderBindHash.commit(m_numRenderBinds) )
+			{
+				BX_WARN(false, "Frame bind table overflow, bind is dropped.");
+				return 0;
+			}
+
+			const uint32_t idx = m_numRenderBinds++;
+			m_renderBind[idx]     = _bind;
+			m_renderBindHash[idx] = _hash;
+
+			// Map is kept at most half full, so that lookups that miss stay
+			// short. Past BGFX_CONFIG_MAX_BIND_GROUPS, or on hash collision
+			// with different bind, bind is stored once per draw call and
+			// can't be found by hash.
+			if (kInvalidHandle == found
+			&&  BGFX_CONFIG_MAX_BIND_GROUPS > m_renderBindMap.getNumElements()
+			&&  UINT16_MAX > idx)
+			{
+				m_renderBindMap.insert(_hash, uint16_t(idx) );
+			}
+
+			return idx;
+		}
+
+		void mergeRenderBinds();
+
+		void trimRenderItems()
+		{
+			const uint32_t numPages = (m_numRenderItemSlots + BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE - 1) / BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE;
+			m_numPagesUsed = bx::max(m_numPagesUsed, numPages);
+
+			if (BGFX_CONFIG_RENDER_ITEM_PAGE_IDLE_FRAMES <= ++m_numPageFrames)
+			{
+				m_renderItem.trim(m_numPagesUsed);
+
+				const uint32_t numSortKeys = bx::min(
+					  bx::max<uint32_t>(m_numPagesUsed, 1)*BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE
+					, g_caps.limits.maxDrawCalls
+					);
+				if (numSortKeys < m_maxSortKeys)
+				{
+					resizeSortKeys(numSortKeys);
+				}
+
+				m_numPagesUsed  = 0;
+				m_numPageFrames = 0;
+			}
+		}
+
+		uint32_t getAvailTransientIndexBuffer(uint32_t _num)
+		{
+			uint32_t offset   = bx::strideAlign(m_iboffset, sizeof(uint16_t) );
+			uint32_t iboffset = offset + _num*sizeof(uint16_t);
+			iboffset = bx::min<uint32_t>(iboffset, g_caps.limits.transientIbSize);
+			uint32_t num = (iboffset-offset)/sizeof(uint16_t);
+			return num;
+		}
+
+		uint32_t allocTransientIndexBuffer(uint32_t& _num)
+		{
+			return reserveTransient(&m_iboffset, g_caps.limits.transientIbSize, sizeof(uint16_t), _num);
+		}
+
+		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
+		{
+			uint32_t offset   = bx::strideAlign(m_vboffset, _stride);
+			uint32_t vboffset = offset + _num * _stride;
+			vboffset = bx::min<uint32_t>(vboffset, g_caps.limits.transientVbSize);
+			uint32_t num = (vboffset-offset)/_stride;
+			return num;
+		}
+
+		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
+		{
+			return reserveTransient(&m_vboffset, g_caps.limits.transientVbSize, _stride, _num);
+		}
+
+		// Transient buffers are shared by all encoders, offset is bumped with
+		// CAS so that encoders can reserve space without taking a lock.
+		static uint32_t reserveTransient(volatile uint32_t* _offset, uint32_t _size, uint32_t _stride, uint32_t& _num)
+		{
+			uint32_t current = *_offset;
+
+			for (;;)
+			{
+				const uint32_t offset = bx::min<uint32_t>(bx::strideAlign(current, _stride), _size);
+				const uint32_t num    = bx::min<uint32_t>(_num, (_size-offset)/_stride);
+
+				if (0 == num)
+				{
+					_num = 0;
+					return offset;
+				}
+
+				const uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(_offset, current, offset + num*_stride);
+				if (prev == current)
+				{
+					_num = num;
+					return offset;
+				}
+
+				current = prev;
+			}
+		}
+
+		bool free(IndexBufferHandle _handle)
+		{
+			return m_freeIndexBuffer.queue(_handle);
+		}
+
+		bool free(VertexDeclHandle _handle)
+		{
+			return m_freeVertexDecl.queue(_handle);
+		}
+
+		bool free(VertexBufferHandle _handle)
+		{
+			return m_freeVertexBuffer.queue(_handle);
+		}
+
+		bool free(ShaderHandle _handle)
+		{
+			return m_freeShader.queue(_handle);
+		}
+
+		bool free(ProgramHandle _handle)
+		{
+			return m_freeProgram.queue(_handle);
+		}
+
+		bool free(TextureHandle _handle)
+		{
+			return m_freeTexture.queue(_handle);
+		}
+
+		bool free(FrameBufferHandle _handle)
+		{
+			return m_freeFrameBuffer.queue(_handle);
+		}
+
+		bool free(UniformHandle _handle)
+		{
+			return m_freeUniform.queue(_handle);
+		}
+
+		void resetFreeHandles()
+		{
+			m_freeIndexBuffer.reset();
+			m_freeVertexDecl.reset();
+			m_freeVertexBuffer.reset();
+			m_freeShader.reset();
+			m_freeProgram.reset();
+			m_freeTexture.reset();
+			m_freeFrameBuffer.reset();
+			m_freeUniform.reset();
+		}
+
+		ViewId m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
+		float m_colorPalette[BGFX_CONFIG_MAX_COLOR_PALETTE][4];
+
+		View m_view[BGFX_CONFIG_MAX_VIEWS];
 
 		int32_t m_occlusion[BGFX_CONFIG_MAX_OCCLUSION_QUERIES];
 
-		uint64_t m_sortKeys[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItemCount m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderItem m_renderItem[BGFX_CONFIG_MAX_DRAW_CALLS+1];
-		RenderBind m_renderItemBind[BGFX_CONFIG_MAX_DRAW_CALLS + 1];
+		// Sort keys are contiguous, and are reallocated under lock when
+		// render item page is committed. Encoders copy their keys in under
+		// the same lock.
+		uint64_t* m_sortKeys;
+		RenderItemCount* m_sortValues;
+		volatile uint32_t m_maxSortKeys;
+		bx::Mutex m_sortKeyLock;
+		PagedArrayT<RenderItem, BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE> m_renderItem;
+
+		// Unique binds used by frame, render items reference them by index.
+		// Index 0 is always empty bind. Hash is stored so that backends
+		// caching descriptors by bind don't need to hash it again.
+		PagedArrayT<RenderBind, 1<<10> m_renderBind;
+		PagedArrayT<uint32_t,   1<<10> m_renderBindHash;
+		bx::HandleHashMapT<BGFX_CONFIG_MAX_BIND_GROUPS*2> m_renderBindMap;
+		uint32_t m_numRenderBinds;
+
+		// Binds interned by encoders during frame, indexed by encoder
+		// uniform buffer index.
+		BindTable* m_bindTable;
 
 		uint32_t m_blitKeys[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
 		BlitItem m_blitItem[BGFX_CONFIG_MAX_BLIT_ITEMS+1];
@@ -2074,11 +3014,29 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		FrameCache m_frameCache;
 		UniformBuffer** m_uniformBuffer;
 
+		// Range of sort keys written and pre-sorted by encoder, indexed by
+		// encoder uniform buffer index.
+		struct SortRun
+		{
+			uint32_t m_begin;
+			uint32_t m_num;
+		};
+
+		SortRun* m_sortRun;
+
 		uint32_t m_numRenderItems;
+		uint32_t m_numRenderItemSlots;
+
+		// Highest number of render item pages used by frames since pages
+		// were last trimmed.
+		uint32_t m_numPagesUsed;
+		uint32_t m_numPageFrames;
 		uint16_t m_numBlitItems;
 
-		uint32_t m_iboffset;
-		uint32_t m_vboffset;
+		volatile uint32_t m_iboffset;
+		volatile uint32_t m_vboffset;
+		volatile uint32_t m_ibwasted;
+		volatile uint32_t m_vbwasted;
 		TransientIndexBuffer* m_transientIb;
 		TransientVertexBuffer* m_transientVb;
 
@@ -2161,28 +3119,84 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		int64_t m_waitSubmit;
 		int64_t m_waitRender;
 
+		// Phase times in ticks. API thread phases are set before frame is
+		// handed to renderer, and render thread phases while rendering it.
+		int64_t m_phaseTime[Phase::Count];
+
 		bool m_capture;
 	};
 
+	// Part of frame transient buffer reserved by single encoder.
+	struct TransientChunk
+	{
+		void reset()
+		{
+			m_offset = 0;
+			m_end    = 0;
+		}
+
+		uint32_t getAvail(uint32_t _num, uint16_t _stride) const
+		{
+			const uint32_t offset = bx::strideAlign(m_offset, _stride);
+			return offset < m_end
+				? bx::min<uint32_t>(_num, (m_end-offset)/_stride)
+				: 0
+				;
+		}
+
+		uint32_t m_offset;
+		uint32_t m_end;
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) EncoderImpl
 	{
 		EncoderImpl()
+			: m_lastBindIdx(UINT32_MAX)
+			, m_sortKeys(NULL)
+			, m_sortValues(NULL)
+			, m_tempKeys(NULL)
+			, m_tempValues(NULL)
+			, m_numSortKeys(0)
+			, m_maxSortKeys(0)
+			, m_itemBegin(0)
+			, m_itemEnd(0)
+			, m_drawBundle(NULL)
 		{
 			discard();
 		}
 
+		~EncoderImpl()
+		{
+			BX_FREE(g_allocator, m_sortKeys);
+			BX_FREE(g_allocator, m_sortValues);
+			BX_FREE(g_allocator, m_tempKeys);
+			BX_FREE(g_allocator, m_tempValues);
+		}
+
 		void begin(Frame* _frame, uint8_t _idx)
 		{
 			m_frame = _frame;
 
 			m_cpuTimeBegin = bx::getHPCounter();
 
+			m_numSortKeys = 0;
+			m_itemBegin   = 0;
+			m_itemEnd     = 0;
+			m_drawBundle  = NULL;
+			m_lastBindIdx = UINT32_MAX;
+
+			m_tibChunk.reset();
+			m_tvbChunk.reset();
+			m_lastDeclHash       = 0;
+			m_lastDeclHandle.idx = kInvalidHandle;
+
 			m_uniformIdx   = _idx;
 			m_uniformBegin = 0;
 			m_uniformEnd   = 0;
 
 			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 			uniformBuffer->reset();
+			bx::memSet(m_uniformPos, 0xff, sizeof(m_uniformPos) );
 
 			m_numSubmitted = 0;
 			m_numDropped   = 0;
@@ -2190,11 +3204,20 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void end(bool _finalize)
 		{
+			BX_CHECK(NULL == m_drawBundle, "Draw bundle recording is not finished. Call endDrawBundle before end.");
+
+			retireTransientChunk(m_tibChunk, &m_frame->m_ibwasted);
+			retireTransientChunk(m_tvbChunk, &m_frame->m_vbwasted);
+
 			if (_finalize)
 			{
+				BGFX_PROFILER_SCOPE("bgfx/Encoder end", 0xff2040ff);
+
 				UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
 				uniformBuffer->finish();
 
+				flushSortKeys();
+
 				m_cpuTimeEnd = bx::getHPCounter();
 			}
 
@@ -2209,9 +3232,17 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			}
 		}
 
+		UniformBuffer*& getUniformBuffer()
+		{
+			return NULL != m_drawBundle
+				? m_drawBundle->m_uniformBuffer
+				: m_frame->m_uniformBuffer[m_uniformIdx]
+				;
+		}
+
 		void setMarker(const char* _name)
 		{
-			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+			UniformBuffer* uniformBuffer = getUniformBuffer();
 			uniformBuffer->writeMarker(_name);
 		}
 
@@ -2227,17 +3258,43 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				m_uniformSet.insert(_handle.idx);
 			}
 
-			UniformBuffer::update(&m_frame->m_uniformBuffer[m_uniformIdx]);
-			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+			addResourceRef(DrawBundle::ResourceRef::Uniform, _handle.idx);
+
+			UniformBuffer::update(&getUniformBuffer() );
+			UniformBuffer* uniformBuffer = getUniformBuffer();
+
+			// Frame uniform buffer lives until the end of frame, so value identical
+			// to the last one written for this uniform is referenced instead of
+			// copied. Draw bundle buffers are copied into frame, and must be
+			// self-contained.
+			if (NULL == m_drawBundle
+			&&  sizeof(uint32_t) < g_uniformTypeSize[_type]*_num)
+			{
+				const uint32_t pos = m_uniformPos[_handle.idx];
+				if (UINT32_MAX != pos
+				&&  uniformBuffer->isUniformEqual(pos, _type, _handle.idx, _value, _num) )
+				{
+					uniformBuffer->writeUniformRef(_type, _handle.idx, pos, _num);
+					return;
+				}
+
+				m_uniformPos[_handle.idx] = uniformBuffer->getPos();
+			}
+
 			uniformBuffer->writeUniform(_type, _handle.idx, _value, _num);
 		}
 
-		void setState(uint64_t _state, uint32_t _rgba)
+		static uint8_t getTrans(uint64_t _state)
 		{
 			uint8_t blend = ( (_state&BGFX_STATE_BLEND_MASK)>>BGFX_STATE_BLEND_SHIFT)&0xff;
 			uint8_t alphaRef = ( (_state&BGFX_STATE_ALPHA_REF_MASK)>>BGFX_STATE_ALPHA_REF_SHIFT)&0xff;
 			// transparency sort order table
-			m_key.m_trans = "\x0\x2\x2\x3\x3\x2\x3\x2\x3\x2\x2\x2\x2\x2\x2\x2\x2\x2\x2"[( (blend)&0xf) + (!!blend)] + !!alphaRef;
+			return "\x0\x2\x2\x3\x3\x2\x3\x2\x3\x2\x2\x2\x2\x2\x2\x2\x2\x2\x2"[( (blend)&0xf) + (!!blend)] + !!alphaRef;
+		}
+
+		void setState(uint64_t _state, uint32_t _rgba)
+		{
+			m_key.m_trans = getTrans(_state);
 			m_draw.m_stateFlags = _state;
 			m_draw.m_rgba = _rgba;
 		}
@@ -2255,7 +3312,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		uint16_t setScissor(uint16_t _x, uint16_t _y, uint16_t _width, uint16_t _height)
 		{
-			uint16_t scissor = (uint16_t)m_frame->m_frameCache.m_rectCache.add(_x, _y, _width, _height);
+			uint16_t scissor = NULL != m_drawBundle
+				? m_drawBundle->addRect(_x, _y, _width, _height)
+				: (uint16_t)m_frame->m_frameCache.m_rectCache.add(_x, _y, _width, _height)
+				;
 			m_draw.m_scissor = scissor;
 			return scissor;
 		}
@@ -2267,7 +3327,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		uint32_t setTransform(const void* _mtx, uint16_t _num)
 		{
-			m_draw.m_startMatrix = m_frame->m_frameCache.m_matrixCache.add(_mtx, _num);
+			m_draw.m_startMatrix = NULL != m_drawBundle
+				? m_drawBundle->addMatrices(_mtx, _num)
+				: m_frame->m_frameCache.m_matrixCache.add(_mtx, _num)
+				;
 			m_draw.m_numMatrices = _num;
 
 			return m_draw.m_startMatrix;
@@ -2275,6 +3338,16 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		uint32_t allocTransform(Transform* _transform, uint16_t _num)
 		{
+			if (NULL != m_drawBundle)
+			{
+				// Pointer is valid only until next transform is added to bundle.
+				uint32_t first   = m_drawBundle->reserveMatrices(_num);
+				_transform->data = m_drawBundle->m_matrix[first].un.val;
+				_transform->num  = _num;
+
+				return first;
+			}
+
 			uint32_t first   = m_frame->m_frameCache.m_matrixCache.reserve(&_num);
 			_transform->data = m_frame->m_frameCache.m_matrixCache.toPtr(first);
 			_transform->num  = _num;
@@ -2284,6 +3357,17 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void setTransform(uint32_t _cache, uint16_t _num)
 		{
+			if (NULL != m_drawBundle)
+			{
+				BX_CHECK(_cache < m_drawBundle->m_numMatrices, "Draw bundle matrix out of bounds index %d (max: %d)"
+					, _cache
+					, m_drawBundle->m_numMatrices
+					);
+				m_draw.m_startMatrix = _cache;
+				m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, m_drawBundle->m_numMatrices) - _cache);
+				return;
+			}
+
 			BX_CHECK(_cache < BGFX_CONFIG_MAX_MATRIX_CACHE, "Matrix cache out of bounds index %d (max: %d)"
 				, _cache
 				, BGFX_CONFIG_MAX_MATRIX_CACHE
@@ -2292,12 +3376,103 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_draw.m_numMatrices = uint16_t(bx::min<uint32_t>(_cache+_num, BGFX_CONFIG_MAX_MATRIX_CACHE-1) - _cache);
 		}
 
+		uint32_t getAvailTransientIndexBuffer(uint32_t _num)
+		{
+			return _num == m_tibChunk.getAvail(_num, sizeof(uint16_t) )
+				? _num
+				: m_frame->getAvailTransientIndexBuffer(_num)
+				;
+		}
+
+		uint32_t getAvailTransientVertexBuffer(uint32_t _num, uint16_t _stride)
+		{
+			return _num == m_tvbChunk.getAvail(_num, _stride)
+				? _num
+				: m_frame->getAvailTransientVertexBuffer(_num, _stride)
+				;
+		}
+
+		uint32_t allocTransientIndexBuffer(uint32_t& _num)
+		{
+			return allocTransient(
+				  m_tibChunk
+				, &m_frame->m_iboffset
+				, &m_frame->m_ibwasted
+				, g_caps.limits.transientIbSize
+				, sizeof(uint16_t)
+				, _num
+				);
+		}
+
+		uint32_t allocTransientVertexBuffer(uint32_t& _num, uint16_t _stride)
+		{
+			return allocTransient(
+				  m_tvbChunk
+				, &m_frame->m_vboffset
+				, &m_frame->m_vbwasted
+				, g_caps.limits.transientVbSize
+				, _stride
+				, _num
+				);
+		}
+
+		// Sub-allocates from encoder chunk, and reserves new chunk from frame
+		// with single CAS when current one is exhausted. Large requests go to
+		// frame directly, so that they don't leave large unused chunk tails.
+		static uint32_t allocTransient(
+			  TransientChunk& _chunk
+			, volatile uint32_t* _offset
+			, volatile uint32_t* _wasted
+			, uint32_t _size
+			, uint16_t _stride
+			, uint32_t& _num
+			)
+		{
+			if (_num != _chunk.getAvail(_num, _stride) )
+			{
+				if (_num*_stride > BGFX_CONFIG_TRANSIENT_CHUNK_SIZE/4)
+				{
+					return Frame::reserveTransient(_offset, _size, _stride, _num);
+				}
+
+				retireTransientChunk(_chunk, _wasted);
+
+				uint32_t num = BGFX_CONFIG_TRANSIENT_CHUNK_SIZE/16;
+				_chunk.m_offset = Frame::reserveTransient(_offset, _size, 16, num);
+				_chunk.m_end    = _chunk.m_offset + num*16;
+
+				_num = _chunk.getAvail(_num, _stride);
+			}
+
+			const uint32_t offset = bx::min<uint32_t>(bx::strideAlign(_chunk.m_offset, _stride), _chunk.m_end);
+			_chunk.m_offset = offset + _num*_stride;
+
+			return offset;
+		}
+
+		static void retireTransientChunk(TransientChunk& _chunk, volatile uint32_t* _wasted)
+		{
+			if (_chunk.m_offset < _chunk.m_end)
+			{
+				bx::atomicFetchAndAdd<uint32_t>(_wasted, _chunk.m_end - _chunk.m_offset);
+			}
+
+			_chunk.reset();
+		}
+
+		void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num);
+
+		void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl);
+
+		void allocInstanceDataBuffer(InstanceDataBuffer* _idb, uint32_t _num, uint16_t _stride);
+
 		void setIndexBuffer(IndexBufferHandle _handle, uint32_t _firstIndex, uint32_t _numIndices)
 		{
 			BX_CHECK(UINT8_MAX != m_draw.m_streamMask, "");
 			m_draw.m_startIndex  = _firstIndex;
 			m_draw.m_numIndices  = _numIndices;
 			m_draw.m_indexBuffer = _handle;
+			m_dynamicRef[DrawBundle::DynamicSlot::IndexBuffer] = kInvalidHandle;
 		}
 
 		void setIndexBuffer(const DynamicIndexBuffer& _dib, uint32_t _firstIndex, uint32_t _numIndices)
@@ -2317,6 +3492,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_draw.m_startIndex  = _tib->startIndex + _firstIndex;
 			m_draw.m_numIndices  = numIndices;
 			m_discard = 0 == numIndices;
+			m_dynamicRef[DrawBundle::DynamicSlot::IndexBuffer] = kInvalidHandle;
 		}
 
 		void setVertexBuffer(
@@ -2337,6 +3513,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				stream.m_decl          = _declHandle;
 				m_numVertices[_stream] = _numVertices;
 			}
+
+			m_dynamicRef[_stream] = kInvalidHandle;
 		}
 
 		void setVertexBuffer(
@@ -2381,6 +3559,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 					bx::min(bx::uint32_imax(0, _tvb->size/_tvb->stride - _startVertex), _numVertices)
 					;
 			}
+
+			m_dynamicRef[_stream] = kInvalidHandle;
 		}
 
 		void setVertexCount(uint32_t _numVertices)
@@ -2392,6 +3572,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			stream.m_handle.idx  = kInvalidHandle;
 			stream.m_decl.idx    = kInvalidHandle;
 			m_numVertices[0]     = _numVertices;
+			m_dynamicRef[0]      = kInvalidHandle;
 		}
 
 		void setInstanceDataBuffer(const InstanceDataBuffer* _idb, uint32_t _start, uint32_t _num)
@@ -2402,6 +3583,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_draw.m_instanceDataStride = _idb->stride;
 			m_draw.m_numInstances       = num;
 			m_draw.m_instanceDataBuffer = _idb->handle;
+			m_dynamicRef[DrawBundle::DynamicSlot::InstanceDataBuffer] = kInvalidHandle;
 		}
 
 		void setInstanceDataBuffer(VertexBufferHandle _handle, uint32_t _startVertex, uint32_t _num, uint16_t _stride)
@@ -2410,6 +3592,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_draw.m_instanceDataStride = _stride;
 			m_draw.m_numInstances       = _num;
 			m_draw.m_instanceDataBuffer = _handle;
+			m_dynamicRef[DrawBundle::DynamicSlot::InstanceDataBuffer] = kInvalidHandle;
 		}
 
 		void setInstanceCount(uint32_t _numInstances)
@@ -2423,6 +3606,9 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			Binding& bind = m_bind.m_bind[_stage];
 			bind.m_idx    = _handle.idx;
 			bind.m_type   = uint8_t(Binding::Texture);
+			bind.m_format = 0;
+			bind.m_access = 0;
+			bind.m_mip    = 0;
 			bind.m_samplerFlags = (_flags&BGFX_SAMPLER_INTERNAL_DEFAULT)
 				? BGFX_SAMPLER_INTERNAL_DEFAULT
 				: _flags
@@ -2476,10 +3662,22 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_draw.clear();
 			m_compute.clear();
 			m_bind.clear();
+			clearDynamicRefs();
 		}
 
 		void submit(ViewId _id, ProgramHandle _program, OcclusionQueryHandle _occlusionQuery, uint32_t _depth, bool _preserveState);
 
+		void submitBatch(
+			  ViewId _id
+			, uint32_t _num
+			, const ProgramHandle* _program
+			, const uint32_t* _transform
+			, const VertexBufferHandle* _vertexBuffer
+			, const IndexBufferHandle* _indexBuffer
+			, const uint64_t* _state
+			, const uint32_t* _depth
+			);
+
 		void submit(ViewId _id, ProgramHandle _program, IndirectBufferHandle _indirectHandle, uint16_t _start, uint16_t _num, uint32_t _depth, bool _preserveState)
 		{
 			m_draw.m_startIndirect  = _start;
@@ -2501,6 +3699,128 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void blit(ViewId _id, TextureHandle _dst, uint8_t _dstMip, uint16_t _dstX, uint16_t _dstY, uint16_t _dstZ, TextureHandle _src, uint8_t _srcMip, uint16_t _srcX, uint16_t _srcY, uint16_t _srcZ, uint16_t _width, uint16_t _height, uint16_t _depth);
 
+		uint32_t allocRenderItem()
+		{
+			if (m_itemBegin == m_itemEnd)
+			{
+				const uint32_t max   = g_caps.limits.maxDrawCalls;
+				const uint32_t first = bx::atomicFetchAndAddsat<uint32_t>(
+					  &m_frame->m_numRenderItemSlots
+					, BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK
+					, max
+					);
+				m_itemBegin = bx::min<uint32_t>(first, max-1);
+				m_itemEnd   = bx::min<uint32_t>(first+BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK, max-1);
+
+				// Block never straddles page, committing first slot commits
+				// whole block.
+				if (m_itemBegin == m_itemEnd
+				|| !m_frame->commitRenderItems(m_itemBegin) )
+				{
+					m_itemBegin = m_itemEnd;
+					return UINT32_MAX;
+				}
+			}
+
+			return m_itemBegin++;
+		}
+
+		void reserveSortKeys(uint32_t _num)
+		{
+			const uint32_t num = m_numSortKeys + _num;
+			if (num > m_maxSortKeys)
+			{
+				m_maxSortKeys = bx::min<uint32_t>(bx::max<uint32_t>(bx::max<uint32_t>(m_maxSortKeys*2, 1<<10), num), g_caps.limits.maxDrawCalls);
+				m_sortKeys    = (uint64_t*)BX_REALLOC(g_allocator, m_sortKeys, sizeof(uint64_t)*m_maxSortKeys);
+				m_sortValues  = (RenderItemCount*)BX_REALLOC(g_allocator, m_sortValues, sizeof(RenderItemCount)*m_maxSortKeys);
+				m_tempKeys    = (uint64_t*)BX_REALLOC(g_allocator, m_tempKeys, sizeof(uint64_t)*m_maxSortKeys);
+				m_tempValues  = (RenderItemCount*)BX_REALLOC(g_allocator, m_tempValues, sizeof(RenderItemCount)*m_maxSortKeys);
+			}
+		}
+
+		void addSortKey(uint64_t _key, uint32_t _renderItemIdx)
+		{
+			reserveSortKeys(1);
+
+			m_sortKeys[m_numSortKeys]   = _key;
+			m_sortValues[m_numSortKeys] = RenderItemCount(_renderItemIdx);
+			++m_numSortKeys;
+		}
+
+		void flushSortKeys();
+
+		// Returns index of bind in encoder's bind table, it's remapped to
+		// frame bind table at the end of frame. Draw calls mostly use either
+		// same bind as previous draw call, or no bind at all, these are
+		// resolved without hashing.
+		uint32_t addRenderBind(const RenderBind& _bind)
+		{
+			BindTable& bindTable = m_frame->m_bindTable[m_uniformIdx];
+
+			if (_bind.isEqual(bindTable.m_bind[0]) )
+			{
+				return 0;
+			}
+
+			if (UINT32_MAX == m_lastBindIdx
+			|| !_bind.isEqual(m_lastBind) )
+			{
+				m_lastBind    = _bind;
+				m_lastBindIdx = bindTable.add(_bind);
+			}
+
+			return m_lastBindIdx;
+		}
+
+		void beginDrawBundle(DrawBundle* _drawBundle)
+		{
+			BX_CHECK(NULL == m_drawBundle, "Draw bundle recording already started.");
+
+			_drawBundle->reset();
+
+			m_drawBundle        = _drawBundle;
+			m_frameUniformBegin = m_uniformBegin;
+			m_uniformBegin      = 0;
+			m_uniformEnd        = 0;
+
+			discard();
+		}
+
+		DrawBundle* endDrawBundle()
+		{
+			BX_CHECK(NULL != m_drawBundle, "Draw bundle recording is not started.");
+
+			DrawBundle* drawBundle = m_drawBundle;
+
+			m_drawBundle   = NULL;
+			m_uniformBegin = m_frameUniformBegin;
+			m_uniformEnd   = m_frameUniformBegin;
+
+			discard();
+
+			return drawBundle;
+		}
+
+		void submit(ViewId _id, const DrawBundle& _drawBundle);
+
+		void addResourceRef(DrawBundle::ResourceRef::Enum _type, uint16_t _idx)
+		{
+			if (NULL != m_drawBundle)
+			{
+				m_drawBundle->addResourceRef(_type, _idx);
+			}
+		}
+
+		void setDynamicRef(uint8_t _slot, uint16_t _idx)
+		{
+			m_dynamicRef[_slot] = _idx;
+		}
+
+		void clearDynamicRefs()
+		{
+			bx::memSet(m_dynamicRef, 0xff, sizeof(m_dynamicRef) );
+		}
+
 		Frame* m_frame;
 
 		SortKey m_key;
@@ -2508,12 +3828,15 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		RenderDraw    m_draw;
 		RenderCompute m_compute;
 		RenderBind    m_bind;
+		RenderBind    m_lastBind;
+		uint32_t      m_lastBindIdx;
 
 		uint32_t m_numSubmitted;
 		uint32_t m_numDropped;
 
 		uint32_t m_uniformBegin;
 		uint32_t m_uniformEnd;
+		uint32_t m_uniformPos[BGFX_CONFIG_MAX_UNIFORMS]; // Position of last value written for uniform.
 		uint32_t m_numVertices[BGFX_CONFIG_MAX_VERTEX_STREAMS];
 		uint8_t  m_uniformIdx;
 		bool     m_discard;
@@ -2524,6 +3847,35 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		int64_t m_cpuTimeBegin;
 		int64_t m_cpuTimeEnd;
+
+		// Sort keys submitted by this encoder since begin, sorted and moved
+		// into frame as single run in end.
+		uint64_t*        m_sortKeys;
+		RenderItemCount* m_sortValues;
+		uint64_t*        m_tempKeys;
+		RenderItemCount* m_tempValues;
+		uint32_t         m_numSortKeys;
+		uint32_t         m_maxSortKeys;
+
+		// Render item slots reserved from frame and not used yet.
+		uint32_t m_itemBegin;
+		uint32_t m_itemEnd;
+
+		// Bundle being recorded, draw calls and uniforms go there instead of
+		// frame.
+		DrawBundle* m_drawBundle;
+		uint32_t    m_frameUniformBegin;
+
+		// Dynamic buffers set for draw call, indexed by DrawBundle::DynamicSlot.
+		// Only draw calls recorded into bundle use them.
+		uint16_t m_dynamicRef[DrawBundle::DynamicSlot::Count];
+
+		// Transient buffer space reserved from frame, sub-allocated without
+		// locking.
+		TransientChunk   m_tibChunk;
+		TransientChunk   m_tvbChunk;
+		uint32_t         m_lastDeclHash;
+		VertexDeclHandle m_lastDeclHandle;
 	};
 
 	struct VertexDeclRef
@@ -2624,128 +3976,281 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 	};
 
 	// First-fit non-local allocator.
-	class NonLocalAllocator
+	// LSD radix sort of sort keys split over helper threads. Each pass builds
+	// per-chunk histograms in parallel, computes bucket offsets on the calling
+	// thread, and scatters chunks in parallel. View remap is fused into the
+	// histogram phase of the first pass.
+	class ParallelRadixSort
 	{
 	public:
-		static const uint64_t kInvalidBlock = UINT64_MAX;
+		ParallelRadixSort();
+		~ParallelRadixSort();
 
-		NonLocalAllocator()
-		{
-		}
+		void init(uint16_t _numThreads);
+		void shutdown();
 
-		~NonLocalAllocator()
+		bool isEnabled() const
 		{
+			return 0 != m_numThreads;
 		}
 
-		void reset()
-		{
-			m_free.clear();
-			m_used.clear();
-		}
+		void sort(
+			  uint64_t* _keys
+			, uint64_t* _tempKeys
+			, RenderItemCount* _values
+			, RenderItemCount* _tempValues
+			, uint32_t _num
+			, const ViewId* _viewRemap
+			);
 
-		void add(uint64_t _ptr, uint32_t _size)
+	private:
+		struct Phase
 		{
-			m_free.push_back(Free(_ptr, _size) );
-		}
+			enum Enum
+			{
+				Histogram,
+				Scatter,
 
-		uint64_t remove()
-		{
-			BX_CHECK(0 == m_used.size(), "");
+				Count
+			};
+		};
 
-			if (0 < m_free.size() )
-			{
-				Free freeBlock = m_free.front();
-				m_free.pop_front();
-				return freeBlock.m_ptr;
-			}
+		static const uint32_t kRadixBits      = 11;
+		static const uint32_t kHistogramSize  = 1<<kRadixBits;
+		static const uint32_t kRadixMask      = kHistogramSize-1;
+		static const uint32_t kNumPasses      = (64+kRadixBits-1)/kRadixBits;
+		static const uint32_t kMaxChunks      = BGFX_CONFIG_MAX_SORT_THREADS+1;
+
+		static int32_t threadFunc(bx::Thread* _self, void* _userData);
+
+		void dispatch(Phase::Enum _phase);
+		void execute();
+		void histogram(uint32_t _chunk);
+		void scatter(uint32_t _chunk);
+		bool isSorted() const;
+
+		bx::Thread    m_thread[BGFX_CONFIG_MAX_SORT_THREADS];
+		bx::Semaphore m_workSem;
+		bx::Semaphore m_doneSem;
+
+		uint32_t m_histogram[kMaxChunks][kHistogramSize];
+		bool     m_sorted[kMaxChunks];
+
+		uint64_t*        m_keys;
+		uint64_t*        m_tempKeys;
+		RenderItemCount* m_values;
+		RenderItemCount* m_tempValues;
+		const ViewId*    m_viewRemap;
+
+		uint32_t    m_num;
+		uint32_t    m_numChunks;
+		uint32_t    m_chunkSize;
+		uint32_t    m_shift;
+		uint32_t    m_next;
+		Phase::Enum m_phase;
+		uint16_t    m_numThreads;
+		bool        m_exit;
+	};
 
-			return 0;
-		}
+	// Texture created with BGFX_TEXTURE_ASYNC, waiting for its data to be
+	// parsed and converted off the render thread.
+	struct TextureDecodeJob
+	{
+		TextureDecodeJob* m_next;
+		const Memory*     m_mem;
+		const Memory*     m_result;
+		uint64_t          m_flags;
+		TextureHandle     m_handle;
+		uint8_t           m_skip;
+		bool              m_fallback;
+		bool              m_canceled;
+		bool              m_failed;
+	};
+
+	// Worker pool preparing texture data for upload. Parses image container,
+	// drops skipped mips, and converts formats renderer doesn't support into
+	// RGBA8, so that renderer only copies data into texture. Jobs are pushed
+	// and finished jobs popped on API thread.
+	class TextureDecoder
+	{
+	public:
+		TextureDecoder();
+		~TextureDecoder();
+
+		void init(uint16_t _numThreads);
+		void shutdown();
 
-		uint64_t alloc(uint32_t _size)
+		TextureDecodeJob* push(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip, bool _fallback);
+		TextureDecodeJob* pop();
+
+		// Prepares texture memory renderer can upload without conversion.
+		// Returns false if _mem can't be parsed. On success _result is NULL
+		// when _mem can be used as is.
+		static bool decode(const Memory*& _result, const Memory* _mem, uint8_t _skip);
+
+	private:
+		struct Queue
 		{
-			_size = bx::max(_size, 16u);
+			void push(TextureDecodeJob* _job);
+			TextureDecodeJob* pop();
 
-			for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
-			{
-				if (it->m_size >= _size)
-				{
-					uint64_t ptr = it->m_ptr;
+			TextureDecodeJob* m_head;
+			TextureDecodeJob* m_tail;
+		};
 
-					m_used.insert(stl::make_pair(ptr, _size) );
+		static int32_t threadFunc(bx::Thread* _self, void* _userData);
 
-					if (it->m_size != _size)
-					{
-						it->m_size -= _size;
-						it->m_ptr  += _size;
-					}
-					else
-					{
-						m_free.erase(it);
-					}
+		bx::Thread    m_thread[BGFX_CONFIG_MAX_TEXTURE_DECODE_THREADS];
+		bx::Semaphore m_workSem;
+		bx::Mutex     m_lock;
 
-					return ptr;
-				}
-			}
+		Queue    m_pending;
+		Queue    m_done;
+		uint16_t m_numThreads;
+		bool     m_exit;
+	};
 
-			// there is no block large enough.
-			return kInvalidBlock;
-		}
+	// Frame scoped pool for small bgfx::alloc/copy memory blocks. Blocks are
+	// bump allocated from chunk current on allocating thread, and chunk is
+	// recycled once frame it was used for has ended and all of its blocks are
+	// released. Blocks can be allocated and released on any thread, lock is
+	// taken only when thread switches chunk. Chunks not needed for a while
+	// are returned to allocator.
+	class MemoryPool
+	{
+	public:
+		MemoryPool();
 
-		void free(uint64_t _block)
-		{
-			UsedList::iterator it = m_used.find(_block);
-			if (it != m_used.end() )
-			{
-				m_free.push_front(Free(it->first, it->second) );
-				m_used.erase(it);
-			}
-		}
+		void shutdown();
+
+		// Returns NULL when block should be allocated from g_allocator.
+		const Memory* alloc(uint32_t _size);
+
+		// Ends frame, blocks allocated after this go into new chunk.
+		void frame(Stats& _stats);
+
+		// Release function of pooled blocks.
+		static void release(void* _ptr, void* _userData);
 
-		bool compact()
+	private:
+		struct Chunk
+		{
+			MemoryPool* m_pool; // NULL once pool is shut down.
+			Chunk*      m_next; // Next free chunk.
+			Chunk*      m_prevChunk;
+			Chunk*      m_nextChunk;
+			int32_t     m_refCount;
+			uint32_t    m_offset;
+		};
+
+		// Allocation state of one thread. Counters are written only by
+		// owning thread, and collected in frame.
+		struct ThreadCache
 		{
-			m_free.sort();
+			ThreadCache* m_next;
+			Chunk*       m_current;
+			uint32_t     m_frame;
+			uint32_t     m_numAllocs;
+			uint32_t     m_numAllocsPooled;
+			uint32_t     m_allocSize;
+		};
 
-			for (FreeList::iterator it = m_free.begin(), next = it, itEnd = m_free.end(); next != itEnd;)
-			{
-				if ( (it->m_ptr + it->m_size) == next->m_ptr)
-				{
-					it->m_size += next->m_size;
-					next = m_free.erase(next);
-				}
-				else
-				{
-					it = next;
-					++next;
-				}
-			}
+		ThreadCache* getThreadCache();
+
+		// Must be called with m_lock held.
+		Chunk* acquire();
+		void retire(Chunk* _chunk);
+		void destroy(Chunk* _chunk);
+
+		bx::Mutex m_lock;
+
+		ThreadCache* m_caches;
+		ThreadCache* m_shared;
+		Chunk*   m_chunks;
+		Chunk*   m_free;
+		uint32_t m_frame;
+		uint32_t m_generation;
+		uint32_t m_numChunks;
+		uint32_t m_numFree;
+		uint32_t m_minFree;
+		uint32_t m_numTrimFrames;
+	};
 
-			return 0 == m_used.size();
-		}
+	// Keeps phase times of the last frames, and computes Stats::phaseStats
+	// from them. Used only on API thread.
+	class PhaseTimer
+	{
+	public:
+		PhaseTimer();
+
+		void init(uint16_t _window);
+		void shutdown();
+
+		// Adds phase times of rendered frame, in ticks.
+		void add(const int64_t* _phaseTime);
+
+		void get(Stats& _stats);
 
 	private:
-		struct Free
+		int64_t* m_time;    // m_window frames per phase, in nanoseconds.
+		int64_t* m_scratch; // Sorted copy of one phase, for percentile.
+		int64_t  m_last[Phase::Count];
+		uint16_t m_window;
+		uint16_t m_num;
+		uint16_t m_pos;
+	};
+
+	// Writes frames, as they are handed to renderer, into trace file. See
+	// frame_trace.h for file layout.
+	class FrameTraceWriter
+	{
+	public:
+		FrameTraceWriter();
+
+		bool open(const char* _filePath, const Resolution& _resolution, const Init::Limits& _limits, uint32_t _numResources);
+		void close();
+
+		bool isOpen() const
 		{
-			Free(uint64_t _ptr, uint32_t _size)
-				: m_ptr(_ptr)
-				, m_size(_size)
-			{
-			}
+			return m_open;
+		}
 
-			bool operator<(const Free& rhs) const
-			{
-				return m_ptr < rhs.m_ptr;
-			}
+		// Frame must be finished, and not yet sorted by renderer.
+		void write(Frame* _frame);
 
-			uint64_t m_ptr;
-			uint32_t m_size;
-		};
+	private:
+		bx::FileWriter  m_writer;
+		bx::MemoryBlock m_block;
+		View            m_view[BGFX_CONFIG_MAX_VIEWS];
+		bool            m_open;
+	};
+
+	// Reads frames from trace file into frame being submitted. Render items,
+	// uniforms and transient buffers of frame are replaced, and commands are
+	// appended to commands submitted by API.
+	class FrameTraceReader
+	{
+	public:
+		FrameTraceReader();
+
+		// Returns number of frames in trace, or 0 if trace can't be replayed.
+		uint32_t open(const char* _filePath);
+		void close();
+
+		bool isOpen() const
+		{
+			return m_open;
+		}
 
-		typedef stl::list<Free> FreeList;
-		FreeList m_free;
+		// Returns false when there are no more frames to read.
+		bool read(Frame* _frame);
 
-		typedef stl::unordered_map<uint64_t, uint32_t> UsedList;
-		UsedList m_used;
+	private:
+		bx::FileReader m_reader;
+		uint8_t*       m_data;
+		uint32_t       m_capacity;
+		View           m_view[BGFX_CONFIG_MAX_VIEWS];
+		bool           m_open;
 	};
 
 	struct BX_NO_VTABLE RendererContextI
@@ -2753,6 +4258,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		virtual ~RendererContextI() = 0;
 		virtual RendererType::Enum getRendererType() const = 0;
 		virtual const char* getRendererName() const = 0;
+		virtual uint32_t getReadBackLatency() const = 0;
 		virtual bool isDeviceRemoved() = 0;
 		virtual void flip() = 0;
 		virtual void createIndexBuffer(IndexBufferHandle _handle, const Memory* _mem, uint16_t _flags) = 0;
@@ -2787,7 +4293,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		virtual void destroyUniform(UniformHandle _handle) = 0;
 		virtual void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) = 0;
 		virtual void updateViewName(ViewId _id, const char* _name) = 0;
-		virtual void updateUniform(uint16_t _loc, const void* _data, uint32_t _size) = 0;
+		virtual bool updateUniform(uint16_t _loc, const void* _data, uint32_t _size) = 0;
 		virtual void invalidateOcclusionQuery(OcclusionQueryHandle _handle) = 0;
 		virtual void setMarker(const char* _marker, uint16_t _len) = 0;
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) = 0;
@@ -2800,7 +4306,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 	{
 	}
 
-	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
+	bool rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
 
 #if BGFX_CONFIG_DEBUG
 #	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
@@ -2813,6 +4319,9 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		Context()
 			: m_render(&m_frame[0])
 			, m_submit(&m_frame[BGFX_CONFIG_MULTITHREADED ? 1 : 0])
+			, m_tempKeys(NULL)
+			, m_tempValues(NULL)
+			, m_maxTempKeys(0)
 			, m_numFreeDynamicIndexBufferHandles(0)
 			, m_numFreeDynamicVertexBufferHandles(0)
 			, m_numFreeOcclusionQueryHandles(0)
@@ -2821,6 +4330,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			, m_debug(BGFX_DEBUG_NONE)
 			, m_rtMemoryUsed(0)
 			, m_textureMemoryUsed(0)
+			, m_numPendingTextures(0)
+			, m_numStreamedTextures(0)
 			, m_renderCtx(NULL)
 			, m_renderMain(NULL)
 			, m_renderNoop(NULL)
@@ -2828,7 +4339,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			, m_exit(false)
 			, m_flipAfterRender(false)
 			, m_singleThreaded(false)
+			, m_flipTime(0)
+			, m_textureUpdateScratch(NULL)
 		{
+			m_textureFallback.idx = kInvalidHandle;
+			m_numInitResources    = 0;
 		}
 
 		~Context()
@@ -2848,6 +4363,16 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		bool init(const Init& _init);
 		void shutdown();
 
+		void reserveTempKeys(uint32_t _num)
+		{
+			if (_num > m_maxTempKeys)
+			{
+				m_maxTempKeys = bx::max(_num, m_maxTempKeys*2);
+				m_tempKeys    = (uint64_t*)BX_REALLOC(g_allocator, m_tempKeys, sizeof(uint64_t)*m_maxTempKeys);
+				m_tempValues  = (RenderItemCount*)BX_REALLOC(g_allocator, m_tempValues, sizeof(RenderItemCount)*m_maxTempKeys);
+			}
+		}
+
 		CommandBuffer& getCommandBuffer(CommandBuffer::Enum _cmd)
 		{
 			CommandBuffer& cmdbuf = _cmd < CommandBuffer::End ? m_submit->m_cmdPre : m_submit->m_cmdPost;
@@ -2954,6 +4479,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			stats.textureMemoryUsed = m_textureMemoryUsed;
 			stats.rtMemoryUsed      = m_rtMemoryUsed;
 
+			m_phaseTimer.get(stats);
+
 			return &stats;
 		}
 
@@ -3001,6 +4528,12 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
 			BGFX_CHECK_HANDLE("destroyIndexBuffer", m_indexBufferHandle, _handle);
+
+			if (m_indexBufferBundleRef.deferDestroy(_handle.idx) )
+			{
+				return;
+			}
+
 			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 			BX_CHECK(ok, "Index buffer handle %d is already destroyed!", _handle.idx);
 
@@ -3109,6 +4642,12 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
 			BGFX_CHECK_HANDLE("destroyVertexBuffer", m_vertexBufferHandle, _handle);
+
+			if (m_vertexBufferBundleRef.deferDestroy(_handle.idx) )
+			{
+				return;
+			}
+
 			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 			BX_CHECK(ok, "Vertex buffer handle %d is already destroyed!", _handle.idx);
 
@@ -3156,11 +4695,27 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 				m_dynIndexBufferAllocator.add(uint64_t(indexBufferHandle.idx) << 32, allocSize);
 				ptr = m_dynIndexBufferAllocator.alloc(_size);
+
+				if (0 != BGFX_CONFIG_DYNAMIC_BUFFER_DEFRAG_SIZE)
+				{
+					m_dynIndexBufferShadow[indexBufferHandle.idx] = (uint8_t*)BX_ALLOC(g_allocator, allocSize);
+				}
 			}
 
 			return ptr;
 		}
 
+		void destroyDynamicIndexBufferPool(IndexBufferHandle _handle)
+		{
+			BX_FREE(g_allocator, m_dynIndexBufferShadow[_handle.idx]);
+			m_dynIndexBufferShadow[_handle.idx] = NULL;
+
+			destroyIndexBuffer(_handle);
+		}
+
+		void moveDynamicIndexBuffer(DynamicIndexBufferHandle _handle, uint64_t _ptr, uint32_t _size);
+		void defragDynamicIndexBuffers(uint32_t _budget);
+
 		BGFX_API_FUNC(DynamicIndexBufferHandle createDynamicIndexBuffer(uint32_t _num, uint16_t _flags) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -3250,7 +4805,6 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			&&  0 != (dib.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
 			{
 				m_dynIndexBufferAllocator.free(uint64_t(dib.m_handle.idx)<<32 | dib.m_offset);
-				m_dynIndexBufferAllocator.compact();
 
 				uint64_t ptr = allocDynamicIndexBuffer(_mem->size, dib.m_flags);
 				dib.m_handle.idx = uint16_t(ptr>>32);
@@ -3268,6 +4822,13 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				, size
 				, _mem->size
 				);
+
+			uint8_t* shadow = m_dynIndexBufferShadow[dib.m_handle.idx];
+			if (NULL != shadow)
+			{
+				bx::memCopy(&shadow[offset], _mem->data, size);
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicIndexBuffer);
 			cmdbuf.write(dib.m_handle);
 			cmdbuf.write(offset);
@@ -3281,6 +4842,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 			BGFX_CHECK_HANDLE("destroyDynamicIndexBuffer", m_dynamicIndexBufferHandle, _handle);
 
+			if (m_dynamicIndexBufferBundleRef.deferDestroy(_handle.idx) )
+			{
+				return;
+			}
+
 			m_freeDynamicIndexBufferHandle[m_numFreeDynamicIndexBufferHandles++] = _handle;
 		}
 
@@ -3295,12 +4861,12 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			else
 			{
 				m_dynIndexBufferAllocator.free(uint64_t(dib.m_handle.idx)<<32 | dib.m_offset);
-				if (m_dynIndexBufferAllocator.compact() )
+				if (m_dynIndexBufferAllocator.isEmpty() )
 				{
 					for (uint64_t ptr = m_dynIndexBufferAllocator.remove(); 0 != ptr; ptr = m_dynIndexBufferAllocator.remove() )
 					{
 						IndexBufferHandle handle = { uint16_t(ptr>>32) };
-						destroyIndexBuffer(handle);
+						destroyDynamicIndexBufferPool(handle);
 					}
 				}
 			}
@@ -3333,11 +4899,27 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 				m_dynVertexBufferAllocator.add(uint64_t(vertexBufferHandle.idx) << 32, allocSize);
 				ptr = m_dynVertexBufferAllocator.alloc(_size);
+
+				if (0 != BGFX_CONFIG_DYNAMIC_BUFFER_DEFRAG_SIZE)
+				{
+					m_dynVertexBufferShadow[vertexBufferHandle.idx] = (uint8_t*)BX_ALLOC(g_allocator, allocSize);
+				}
 			}
 
 			return ptr;
 		}
 
+		void destroyDynamicVertexBufferPool(VertexBufferHandle _handle)
+		{
+			BX_FREE(g_allocator, m_dynVertexBufferShadow[_handle.idx]);
+			m_dynVertexBufferShadow[_handle.idx] = NULL;
+
+			destroyVertexBuffer(_handle);
+		}
+
+		void moveDynamicVertexBuffer(DynamicVertexBufferHandle _handle, uint64_t _ptr, uint32_t _size);
+		void defragDynamicVertexBuffers(uint32_t _budget);
+
 		BGFX_API_FUNC(DynamicVertexBufferHandle createDynamicVertexBuffer(uint32_t _num, const VertexDecl& _decl, uint16_t _flags) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -3437,7 +5019,6 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			&&  0 != (dvb.m_flags & BGFX_BUFFER_ALLOW_RESIZE) )
 			{
 				m_dynVertexBufferAllocator.free(uint64_t(dvb.m_handle.idx)<<32 | dvb.m_offset);
-				m_dynVertexBufferAllocator.compact();
 
 				const uint32_t size = bx::strideAlign<16>(_mem->size, dvb.m_stride)+dvb.m_stride;
 				const uint64_t ptr  = allocDynamicVertexBuffer(size, dvb.m_flags);
@@ -3459,6 +5040,12 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				, _mem->size
 				);
 
+			uint8_t* shadow = m_dynVertexBufferShadow[dvb.m_handle.idx];
+			if (NULL != shadow)
+			{
+				bx::memCopy(&shadow[offset], _mem->data, size);
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateDynamicVertexBuffer);
 			cmdbuf.write(dvb.m_handle);
 			cmdbuf.write(offset);
@@ -3472,6 +5059,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 			BGFX_CHECK_HANDLE("destroyDynamicVertexBuffer", m_dynamicVertexBufferHandle, _handle);
 
+			if (m_dynamicVertexBufferBundleRef.deferDestroy(_handle.idx) )
+			{
+				return;
+			}
+
 			m_freeDynamicVertexBufferHandle[m_numFreeDynamicVertexBufferHandles++] = _handle;
 		}
 
@@ -3496,12 +5088,12 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			else
 			{
 				m_dynVertexBufferAllocator.free(uint64_t(dvb.m_handle.idx)<<32 | dvb.m_offset);
-				if (m_dynVertexBufferAllocator.compact() )
+				if (m_dynVertexBufferAllocator.isEmpty() )
 				{
 					for (uint64_t ptr = m_dynVertexBufferAllocator.remove(); 0 != ptr; ptr = m_dynVertexBufferAllocator.remove() )
 					{
 						VertexBufferHandle handle = { uint16_t(ptr>>32) };
-						destroyVertexBuffer(handle);
+						destroyDynamicVertexBufferPool(handle);
 					}
 				}
 			}
@@ -3622,14 +5214,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			BX_ALIGNED_FREE(g_allocator, _tvb, 16);
 		}
 
-		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl) )
+		VertexDeclHandle findTransientVertexDecl(const VertexDecl& _decl)
 		{
-			BGFX_MUTEX_SCOPE(m_resourceApiLock);
-
 			VertexDeclHandle declHandle = m_declRef.find(_decl.m_hash);
 
-			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
-
 			if (!isValid(declHandle) )
 			{
 				VertexDeclHandle temp = { m_vertexDeclHandle.alloc() };
@@ -3640,6 +5228,17 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				m_declRef.add(declHandle, _decl.m_hash);
 			}
 
+			return declHandle;
+		}
+
+		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			VertexDeclHandle declHandle = findTransientVertexDecl(_decl);
+
+			TransientVertexBuffer& dvb = *m_submit->m_transientVb;
+
 			uint32_t offset = m_submit->allocTransientVertexBuffer(_num, _decl.m_stride);
 
 			_tvb->data = &dvb.data[offset];
@@ -3691,6 +5290,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			VertexBufferHandle handle = { _handle.idx };
 			BGFX_CHECK_HANDLE("destroyDrawIndirectBuffer", m_vertexBufferHandle, handle);
 
+			if (m_vertexBufferBundleRef.deferDestroy(_handle.idx) )
+			{
+				return;
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyDynamicVertexBuffer);
 			cmdbuf.write(handle);
 			m_submit->free(handle);
@@ -4144,6 +5748,36 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				, _immutable
 				, 0 != (_flags & BGFX_TEXTURE_RT_MASK)
 				);
+			ref.m_atlas = 0 != (_flags & BGFX_TEXTURE_ATLAS);
+
+			uint32_t magic;
+			bx::memCopy(&magic, _mem->data, sizeof(magic) );
+
+			const bool streamed = true
+				&& 0 != (_flags & BGFX_TEXTURE_STREAMING)
+				&& 0 != m_init.limits.textureMemoryBudget
+				&& !ref.m_rt
+				&& 1 < imageContainer.m_numMips
+				&& BGFX_CHUNK_MAGIC_TEX != magic
+				;
+
+			if (streamed)
+			{
+				// Retained for texture lifetime, kept out of frame memory pool.
+				ref.m_streamMem   = copyUnpooled(_mem->data, _mem->size);
+				ref.m_streamFlags = _flags;
+				ref.m_lastUse     = m_frames;
+				ref.m_minSkip     = bx::min<uint8_t>(_skip, imageContainer.m_numMips-1);
+				ref.m_skip        = ref.m_minSkip;
+				ref.m_storageSize = calcStreamedTextureSize(imageContainer, ref.m_skip);
+				++m_numStreamedTextures;
+
+				BX_WARN(0 == (_flags & BGFX_TEXTURE_ASYNC)
+					, "Streamed texture %d can't be decoded asynchronously."
+					, handle.idx
+					);
+				_flags &= ~BGFX_TEXTURE_ASYNC;
+			}
 
 			if (ref.m_rt)
 			{
@@ -4154,6 +5788,28 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				m_textureMemoryUsed += int64_t(ref.m_storageSize);
 			}
 
+			if (0 != (_flags & BGFX_TEXTURE_ASYNC)
+			&&  !ref.m_rt)
+			{
+				if (!isValid(m_textureFallback) )
+				{
+					m_textureFallback = createTextureFallback();
+				}
+
+				// Only plain 2D textures have fallback, other pending textures
+				// are not bound.
+				const bool fallback = true
+					&& !imageContainer.m_cubeMap
+					&& 1 >= imageContainer.m_depth
+					&& 1 == imageContainer.m_numLayers
+					;
+
+				ref.m_decodeJob = m_textureDecoder.push(handle, _mem, _flags, _skip, fallback);
+				++m_numPendingTextures;
+
+				return handle;
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
 			cmdbuf.write(handle);
 			cmdbuf.write(_mem);
@@ -4165,6 +5821,51 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			return handle;
 		}
 
+		void setTextureName(TextureHandle _handle)
+		{
+			const TextureRef& ref = m_textureRef[_handle.idx];
+
+			if (ref.m_name.isEmpty() )
+			{
+				setDebugName(convert(_handle) );
+			}
+			else
+			{
+				setName(convert(_handle), ref.m_name);
+			}
+		}
+
+		TextureHandle createTextureFallback()
+		{
+			const Memory* data = alloc(4);
+			bx::memSet(data->data, 0x80, 3);
+			data->data[3] = 0xff;
+
+			const Memory* mem = alloc(sizeof(uint32_t)+sizeof(TextureCreate) );
+
+			bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
+			uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
+			bx::write(&writer, magic);
+
+			TextureCreate tc;
+			tc.m_width     = 1;
+			tc.m_height    = 1;
+			tc.m_depth     = 0;
+			tc.m_numLayers = 1;
+			tc.m_numMips   = 1;
+			tc.m_format    = TextureFormat::RGBA8;
+			tc.m_cubeMap   = false;
+			tc.m_mem       = data;
+			bx::write(&writer, tc);
+
+			return createTexture(mem, BGFX_TEXTURE_NONE, 0, NULL, BackbufferRatio::Count, true);
+		}
+
+		void flushTextureDecodes();
+		static uint32_t calcStreamedTextureSize(const bimg::ImageContainer& _imageContainer, uint8_t _skip);
+		void setStreamedTextureSkip(TextureHandle _handle, uint8_t _skip, uint32_t _size);
+		void updateTextureResidency();
+
 		BGFX_API_FUNC(void setName(TextureHandle _handle, const bx::StringView& _name) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4173,7 +5874,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			TextureRef& ref = m_textureRef[_handle.idx];
 			ref.m_name.set(_name);
 
-			setName(convert(_handle), _name);
+			if (!ref.isPending() )
+			{
+				setName(convert(_handle), _name);
+			}
 		}
 
 		void setDirectAccessPtr(TextureHandle _handle, void* _ptr)
@@ -4215,11 +5919,28 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			const TextureRef& ref = m_textureRef[_handle.idx];
 			BX_CHECK(_mip < ref.m_numMips, "Invalid mip: %d num mips:", _mip, ref.m_numMips); BX_UNUSED(ref);
 
+			if (ref.isPending() )
+			{
+				BX_WARN(false, "Can't read texture %d, it's still being decoded.", _handle.idx);
+				return m_frames;
+			}
+
+			if (ref.isStreamed() )
+			{
+				BX_WARN(false, "Can't read streamed texture %d.", _handle.idx);
+				return m_frames;
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::ReadTexture);
 			cmdbuf.write(_handle);
 			cmdbuf.write(_data);
 			cmdbuf.write(_mip);
-			return m_frames + 2;
+			const uint32_t latency = 0 == (m_init.resolution.reset & BGFX_RESET_SYNC_READ_BACK)
+				? m_renderCtx->getReadBackLatency()
+				: 0
+				;
+
+			return m_frames + 2 + latency;
 		}
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers)
@@ -4269,6 +5990,15 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			{
 				ref.m_name.clear();
 
+				// Pending texture was never created on renderer side, there is
+				// nothing to destroy there.
+				const bool pending = ref.isPending();
+				if (pending)
+				{
+					ref.m_decodeJob->m_canceled = true;
+					ref.m_decodeJob = NULL;
+				}
+
 				if (ref.m_rt)
 				{
 					m_rtMemoryUsed -= int64_t(ref.m_storageSize);
@@ -4281,8 +6011,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				bool ok = m_submit->free(_handle); BX_UNUSED(ok);
 				BX_CHECK(ok, "Texture handle %d is already destroyed!", _handle.idx);
 
-				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyTexture);
-				cmdbuf.write(_handle);
+				if (!pending)
+				{
+					CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyTexture);
+					cmdbuf.write(_handle);
+				}
 			}
 		}
 
@@ -4310,10 +6043,26 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				return;
 			}
 
+			if (textureRef.isPending() )
+			{
+				BX_WARN(false, "Can't update texture %d, it's still being decoded.", _handle.idx);
+				release(_mem);
+				return;
+			}
+
+			if (textureRef.isStreamed() )
+			{
+				BX_WARN(false, "Can't update streamed texture %d.", _handle.idx);
+				release(_mem);
+				return;
+			}
+
 			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture);
 			cmdbuf.write(_handle);
 			cmdbuf.write(_side);
 			cmdbuf.write(_mip);
+			cmdbuf.write(textureRef.m_format);
+			cmdbuf.write(textureRef.m_atlas);
 			Rect rect;
 			rect.m_x = _x;
 			rect.m_y = _y;
@@ -4635,6 +6384,213 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_freeOcclusionQueryHandle[m_numFreeOcclusionQueryHandles++] = _handle;
 		}
 
+		BGFX_API_FUNC(DrawBundleHandle createDrawBundle() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			DrawBundleHandle handle = { m_drawBundleHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate draw bundle handle.");
+
+			if (isValid(handle) )
+			{
+				m_drawBundle[handle.idx].create();
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(void destroyDrawBundle(DrawBundleHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyDrawBundle", m_drawBundleHandle, _handle);
+
+			DrawBundle& drawBundle = m_drawBundle[_handle.idx];
+			if (drawBundle.m_recording)
+			{
+				// Encoder is still recording into bundle, it's destroyed once
+				// recording ends.
+				drawBundle.m_destroyPending = true;
+				return;
+			}
+
+			destroyDrawBundleInternal(_handle);
+		}
+
+		void destroyDrawBundleInternal(DrawBundleHandle _handle)
+		{
+			DrawBundle& drawBundle = m_drawBundle[_handle.idx];
+			releaseDrawBundleRefs(drawBundle);
+			drawBundle.destroy();
+			m_drawBundleHandle.free(_handle.idx);
+		}
+
+		DrawBundle* beginDrawBundle(DrawBundleHandle _handle)
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			DrawBundle& drawBundle = m_drawBundle[_handle.idx];
+			BX_CHECK(!drawBundle.m_recording, "Draw bundle %d is already being recorded.", _handle.idx);
+
+			releaseDrawBundleRefs(drawBundle);
+			drawBundle.m_recording = true;
+
+			return &drawBundle;
+		}
+
+		void endDrawBundle(DrawBundle* _drawBundle)
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			for (DrawBundle::ResourceRefSet::iterator it = _drawBundle->m_resourceRef.begin(), itEnd = _drawBundle->m_resourceRef.end(); it != itEnd; ++it)
+			{
+				const uint16_t idx = uint16_t(*it);
+
+				switch (*it>>16)
+				{
+				case DrawBundle::ResourceRef::VertexBuffer:        m_vertexBufferBundleRef.ref(idx);        break;
+				case DrawBundle::ResourceRef::IndexBuffer:         m_indexBufferBundleRef.ref(idx);         break;
+				case DrawBundle::ResourceRef::DynamicVertexBuffer: m_dynamicVertexBufferBundleRef.ref(idx); break;
+				case DrawBundle::ResourceRef::DynamicIndexBuffer:  m_dynamicIndexBufferBundleRef.ref(idx);  break;
+				case DrawBundle::ResourceRef::IndirectBuffer:      m_vertexBufferBundleRef.ref(idx);        break;
+
+				// Textures, uniforms and programs are reference counted already,
+				// bundle holds reference same as application does.
+				case DrawBundle::ResourceRef::Texture:
+					{
+						TextureHandle handle = { idx };
+						textureIncRef(handle);
+					}
+					break;
+
+				case DrawBundle::ResourceRef::Uniform:
+					++m_uniformRef[idx].m_refCount;
+					break;
+
+				case DrawBundle::ResourceRef::Program:
+					{
+						ProgramRef& pr = m_programRef[idx];
+						++pr.m_refCount;
+						shaderIncRef(pr.m_vsh);
+
+						if (isValid(pr.m_fsh) )
+						{
+							shaderIncRef(pr.m_fsh);
+						}
+					}
+					break;
+
+				default: break;
+				}
+			}
+
+			_drawBundle->m_recording = false;
+
+			if (_drawBundle->m_destroyPending)
+			{
+				DrawBundleHandle handle = { uint16_t(_drawBundle - m_drawBundle) };
+				destroyDrawBundleInternal(handle);
+			}
+		}
+
+		// Bundle being recorded doesn't hold its buffer references yet.
+		bool isDrawBundleRecording() const
+		{
+			for (uint16_t ii = 0, num = m_drawBundleHandle.getNumHandles(); ii < num; ++ii)
+			{
+				if (m_drawBundle[m_drawBundleHandle.getHandleAt(ii)].m_recording)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		void releaseDrawBundleRefs(DrawBundle& _drawBundle)
+		{
+			if (_drawBundle.m_recording)
+			{
+				// References are taken only when recording ends.
+				_drawBundle.m_resourceRef.clear();
+				return;
+			}
+
+			for (DrawBundle::ResourceRefSet::iterator it = _drawBundle.m_resourceRef.begin(), itEnd = _drawBundle.m_resourceRef.end(); it != itEnd; ++it)
+			{
+				const uint16_t idx = uint16_t(*it);
+
+				switch (*it>>16)
+				{
+				case DrawBundle::ResourceRef::VertexBuffer:
+					if (m_vertexBufferBundleRef.release(idx) )
+					{
+						VertexBufferHandle handle = { idx };
+						destroyVertexBuffer(handle);
+					}
+					break;
+
+				case DrawBundle::ResourceRef::IndexBuffer:
+					if (m_indexBufferBundleRef.release(idx) )
+					{
+						IndexBufferHandle handle = { idx };
+						destroyIndexBuffer(handle);
+					}
+					break;
+
+				case DrawBundle::ResourceRef::DynamicVertexBuffer:
+					if (m_dynamicVertexBufferBundleRef.release(idx) )
+					{
+						DynamicVertexBufferHandle handle = { idx };
+						destroyDynamicVertexBuffer(handle);
+					}
+					break;
+
+				case DrawBundle::ResourceRef::DynamicIndexBuffer:
+					if (m_dynamicIndexBufferBundleRef.release(idx) )
+					{
+						DynamicIndexBufferHandle handle = { idx };
+						destroyDynamicIndexBuffer(handle);
+					}
+					break;
+
+				case DrawBundle::ResourceRef::IndirectBuffer:
+					if (m_vertexBufferBundleRef.release(idx) )
+					{
+						IndirectBufferHandle handle = { idx };
+						destroyIndirectBuffer(handle);
+					}
+					break;
+
+				case DrawBundle::ResourceRef::Texture:
+					{
+						TextureHandle handle = { idx };
+						textureDecRef(handle);
+					}
+					break;
+
+				case DrawBundle::ResourceRef::Uniform:
+					{
+						UniformHandle handle = { idx };
+						destroyUniform(handle);
+					}
+					break;
+
+				case DrawBundle::ResourceRef::Program:
+					{
+						ProgramHandle handle = { idx };
+						destroyProgram(handle);
+					}
+					break;
+
+				default:
+					break;
+				}
+			}
+
+			_drawBundle.m_resourceRef.clear();
+		}
+
 		BGFX_API_FUNC(void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4658,6 +6614,65 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			cmdbuf.write(_filePath, len);
 		}
 
+		BGFX_API_FUNC(bool frameTraceBegin(const char* _filePath) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			return m_frameTraceWriter.open(_filePath, m_init.resolution, m_init.limits, bx::uint32_satsub(getNumResources(), m_numInitResources) );
+		}
+
+		// Number of resources that must be created before frame can be
+		// rendered, used to tell if frame trace is complete.
+		uint32_t getNumResources() const
+		{
+			return 0
+				+ m_dynamicIndexBufferHandle.getNumHandles()
+				+ m_dynamicVertexBufferHandle.getNumHandles()
+				+ m_indexBufferHandle.getNumHandles()
+				+ m_vertexBufferHandle.getNumHandles()
+				+ m_shaderHandle.getNumHandles()
+				+ m_programHandle.getNumHandles()
+				+ m_textureHandle.getNumHandles()
+				+ m_frameBufferHandle.getNumHandles()
+				+ m_uniformHandle.getNumHandles()
+				;
+		}
+
+		BGFX_API_FUNC(void frameTraceEnd() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			m_frameTraceWriter.close();
+		}
+
+		BGFX_API_FUNC(uint32_t frameTraceReplay(const char* _filePath) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			return m_frameTraceReader.open(_filePath);
+		}
+
+		BGFX_API_FUNC(bool profilerTraceBegin(const char* _filePath, uint32_t _dumpInterval) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			return g_profilerTrace.open(_filePath, _dumpInterval);
+		}
+
+		BGFX_API_FUNC(void profilerTraceDump() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			g_profilerTrace.requestDump();
+		}
+
+		BGFX_API_FUNC(void profilerTraceEnd() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			g_profilerTrace.close();
+		}
+
 		BGFX_API_FUNC(void setPaletteColor(uint8_t _index, const float _rgba[4]) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4716,6 +6731,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_view[_id].setMode(_mode);
 		}
 
+		BGFX_API_FUNC(void setViewAutoInstancing(ViewId _id, bool _enabled) )
+		{
+			m_view[_id].setAutoInstancing(_enabled);
+		}
+
 		BGFX_API_FUNC(void setViewFrameBuffer(ViewId _id, FrameBufferHandle _handle) )
 		{
 			BGFX_CHECK_HANDLE_INVALID_OK("setViewFrameBuffer", m_frameBufferHandle, _handle);
@@ -4755,9 +6775,9 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		BGFX_API_FUNC(uint32_t frame(bool _capture = false) );
 
-		uint32_t getSeqIncr(ViewId _id)
+		uint32_t getSeqIncr(ViewId _id, uint32_t _num = 1)
 		{
-			return bx::atomicFetchAndAdd<uint32_t>(&m_seq[_id], 1);
+			return bx::atomicFetchAndAdd<uint32_t>(&m_seq[_id], _num);
 		}
 
 		void dumpViewStats();
@@ -4888,8 +6908,18 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		Frame* m_render;
 		Frame* m_submit;
 
-		uint64_t m_tempKeys[BGFX_CONFIG_MAX_DRAW_CALLS];
-		RenderItemCount m_tempValues[BGFX_CONFIG_MAX_DRAW_CALLS];
+		// Scratch for sorting frame sort keys and blit keys, grows with
+		// number of draw calls submitted.
+		uint64_t* m_tempKeys;
+		RenderItemCount* m_tempValues;
+		uint32_t m_maxTempKeys;
+		ParallelRadixSort m_parallelSort;
+		TextureDecoder    m_textureDecoder;
+		MemoryPool        m_memoryPool;
+		PhaseTimer        m_phaseTimer;
+		FrameTraceWriter  m_frameTraceWriter;
+		FrameTraceReader  m_frameTraceReader;
+		uint32_t          m_numInitResources;
 
 		IndexBuffer  m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
 		VertexBuffer m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
@@ -4909,6 +6939,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		NonLocalAllocator m_dynVertexBufferAllocator;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS> m_dynamicVertexBufferHandle;
 
+		// CPU copies of dynamic buffer pools, source data for defragmentation.
+		uint8_t* m_dynIndexBufferShadow[BGFX_CONFIG_MAX_INDEX_BUFFERS];
+		uint8_t* m_dynVertexBufferShadow[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+
 		bx::HandleAllocT<BGFX_CONFIG_MAX_INDEX_BUFFERS> m_indexBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_VERTEX_DECLS > m_vertexDeclHandle;
 
@@ -4919,6 +6953,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		bx::HandleAllocT<BGFX_CONFIG_MAX_FRAME_BUFFERS> m_frameBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORMS> m_uniformHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_OCCLUSION_QUERIES> m_occlusionQueryHandle;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_DRAW_BUNDLES> m_drawBundleHandle;
 
 		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_UNIFORMS*2> UniformHashMap;
 		UniformHashMap m_uniformHashMap;
@@ -4936,6 +6971,13 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		FrameBufferRef m_frameBufferRef[BGFX_CONFIG_MAX_FRAME_BUFFERS];
 		VertexDeclRef  m_declRef;
 
+		DrawBundle m_drawBundle[BGFX_CONFIG_MAX_DRAW_BUNDLES];
+
+		BundleRefT<BGFX_CONFIG_MAX_VERTEX_BUFFERS>         m_vertexBufferBundleRef;
+		BundleRefT<BGFX_CONFIG_MAX_INDEX_BUFFERS>          m_indexBufferBundleRef;
+		BundleRefT<BGFX_CONFIG_MAX_DYNAMIC_VERTEX_BUFFERS> m_dynamicVertexBufferBundleRef;
+		BundleRefT<BGFX_CONFIG_MAX_DYNAMIC_INDEX_BUFFERS>  m_dynamicIndexBufferBundleRef;
+
 		ViewId m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
 		uint32_t m_seq[BGFX_CONFIG_MAX_VIEWS];
 		View m_view[BGFX_CONFIG_MAX_VIEWS];
@@ -4952,6 +6994,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		int64_t m_rtMemoryUsed;
 		int64_t m_textureMemoryUsed;
 
+		TextureHandle m_textureFallback;
+		uint32_t      m_numPendingTextures;
+		uint32_t      m_numStreamedTextures;
+
 		TextVideoMemBlitter m_textVideoMemBlitter;
 		ClearQuad m_clearQuad;
 
@@ -4965,8 +7011,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		bool m_singleThreaded;
 		bool m_flipped;
 
+		int64_t m_flipTime; //!< Render thread, time of the last flip.
+
 		typedef UpdateBatchT<256> TextureUpdateBatch;
 		BX_ALIGN_DECL_CACHE_LINE(TextureUpdateBatch m_textureUpdateBatch);
+		uint8_t* m_textureUpdateScratch;
 	};
 
 #undef BGFX_API_FUNC
@@ -598,6 +598,10 @@ uniform mat4  u_modelViewProj;
 uniform vec4  u_alphaRef4;
 #define u_alphaRef u_alphaRef4.x
 
+// Model transform of draw calls merged by view auto-instancing, passed as
+// instance data in i_data0-3. See bgfx::setViewAutoInstancing.
+#define BGFX_AUTO_INSTANCE_MODEL mtxFromCols(i_data0, i_data1, i_data2, i_data3)
+
 #endif // __cplusplus
 
 #endif // BGFX_SHADER_H_HEADER_GUARD
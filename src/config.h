@@ -183,10 +183,44 @@
 #	define BGFX_CONFIG_MULTITHREADED ( (0 == BX_PLATFORM_EMSCRIPTEN) ? 1 : 0)
 #endif // BGFX_CONFIG_MULTITHREADED
 
+/// Upper bound for `Init::Limits::maxDrawCalls`. Render items and sort keys
+/// grow in pages on demand, so raising it doesn't cost render item memory by
+/// itself. It still selects width of render item index (16-bit below 64K),
+/// and size of frame matrix cache.
 #ifndef BGFX_CONFIG_MAX_DRAW_CALLS
 #	define BGFX_CONFIG_MAX_DRAW_CALLS ( (64<<10)-1)
 #endif // BGFX_CONFIG_MAX_DRAW_CALLS
 
+/// Default maximum number of draw calls per frame.
+#ifndef BGFX_CONFIG_DEFAULT_MAX_DRAW_CALLS
+#	define BGFX_CONFIG_DEFAULT_MAX_DRAW_CALLS BGFX_CONFIG_MAX_DRAW_CALLS
+#endif // BGFX_CONFIG_DEFAULT_MAX_DRAW_CALLS
+
+/// Number of render items in one page of frame render item storage. Must be
+/// multiple of BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK.
+#ifndef BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE
+#	define BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE (4<<10)
+#endif // BGFX_CONFIG_RENDER_ITEM_PAGE_SIZE
+
+/// Render item pages not used by any frame during this many frames are
+/// released.
+#ifndef BGFX_CONFIG_RENDER_ITEM_PAGE_IDLE_FRAMES
+#	define BGFX_CONFIG_RENDER_ITEM_PAGE_IDLE_FRAMES 120
+#endif // BGFX_CONFIG_RENDER_ITEM_PAGE_IDLE_FRAMES
+
+/// Number of unique texture/buffer binding sets per frame that are shared
+/// between draw calls. Binding sets past it are still stored, one per draw
+/// call. Must be power of 2.
+#ifndef BGFX_CONFIG_MAX_BIND_GROUPS
+#	define BGFX_CONFIG_MAX_BIND_GROUPS (32<<10)
+#endif // BGFX_CONFIG_MAX_BIND_GROUPS
+
+/// Number of unique texture/buffer binding sets shared between draw calls
+/// submitted by one encoder. Must be power of 2.
+#ifndef BGFX_CONFIG_MAX_ENCODER_BIND_GROUPS
+#	define BGFX_CONFIG_MAX_ENCODER_BIND_GROUPS (4<<10)
+#endif // BGFX_CONFIG_MAX_ENCODER_BIND_GROUPS
+
 #ifndef BGFX_CONFIG_MAX_BLIT_ITEMS
 #	define BGFX_CONFIG_MAX_BLIT_ITEMS (1<<10)
 #endif // BGFX_CONFIG_MAX_BLIT_ITEMS
@@ -258,6 +292,27 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_DYNAMIC_VERTEX_BUFFER_SIZE (3<<20)
 #endif // BGFX_CONFIG_DYNAMIC_VERTEX_BUFFER_SIZE
 
+/// Maximum number of bytes of pooled dynamic index/vertex buffers moved per
+/// frame to empty sparsely used pools so they can be released. Moved data
+/// comes from CPU copy of every pool, kept only when this is not 0. Pools
+/// holding buffers referenced by draw bundles are not emptied. Disabled by
+/// default, e.g. 256KB is reasonable budget.
+#ifndef BGFX_CONFIG_DYNAMIC_BUFFER_DEFRAG_SIZE
+#	define BGFX_CONFIG_DYNAMIC_BUFFER_DEFRAG_SIZE 0
+#endif // BGFX_CONFIG_DYNAMIC_BUFFER_DEFRAG_SIZE
+
+/// Maximum size of `bgfx::alloc`/`bgfx::copy` memory block served from frame
+/// memory pool, larger blocks are allocated with allocator. Setting it to 0
+/// disables frame memory pool.
+#ifndef BGFX_CONFIG_MAX_POOLED_MEMORY_SIZE
+#	define BGFX_CONFIG_MAX_POOLED_MEMORY_SIZE (16<<10)
+#endif // BGFX_CONFIG_MAX_POOLED_MEMORY_SIZE
+
+/// Size of frame memory pool chunk.
+#ifndef BGFX_CONFIG_MEMORY_POOL_CHUNK_SIZE
+#	define BGFX_CONFIG_MEMORY_POOL_CHUNK_SIZE (256<<10)
+#endif // BGFX_CONFIG_MEMORY_POOL_CHUNK_SIZE
+
 #ifndef BGFX_CONFIG_MAX_SHADERS
 #	define BGFX_CONFIG_MAX_SHADERS 512
 #endif // BGFX_CONFIG_MAX_FRAGMENT_SHADERS
@@ -286,9 +341,39 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_MAX_OCCLUSION_QUERIES 256
 #endif // BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 
-#ifndef BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
-#	define BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE (64<<10)
-#endif // BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
+#ifndef BGFX_CONFIG_MAX_DRAW_BUNDLES
+#	define BGFX_CONFIG_MAX_DRAW_BUNDLES 256
+#endif // BGFX_CONFIG_MAX_DRAW_BUNDLES
+
+/// Granularity in which pre/post resource command buffers grow. Buffers
+/// start with one chunk, and grow on demand when frame writes more commands.
+#ifndef BGFX_CONFIG_COMMAND_BUFFER_CHUNK_SIZE
+#	define BGFX_CONFIG_COMMAND_BUFFER_CHUNK_SIZE (64<<10)
+#endif // BGFX_CONFIG_COMMAND_BUFFER_CHUNK_SIZE
+
+/// Default texture memory budget in bytes, see
+/// `Init::Limits::textureMemoryBudget`. 0 disables texture streaming.
+#ifndef BGFX_CONFIG_DEFAULT_TEXTURE_MEMORY_BUDGET
+#	define BGFX_CONFIG_DEFAULT_TEXTURE_MEMORY_BUDGET 0
+#endif // BGFX_CONFIG_DEFAULT_TEXTURE_MEMORY_BUDGET
+
+/// Maximum number of streamed textures that drop or restore a mip per
+/// frame. Limits upload spikes when budget is exceeded.
+#ifndef BGFX_CONFIG_MAX_TEXTURE_STREAMING_CHANGES
+#	define BGFX_CONFIG_MAX_TEXTURE_STREAMING_CHANGES 4
+#endif // BGFX_CONFIG_MAX_TEXTURE_STREAMING_CHANGES
+
+/// Largest region, in bytes, that adjacent or overlapping texture updates
+/// of the same mip are merged into before upload. Set to 0 to disable.
+#ifndef BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_SIZE
+#	define BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_SIZE (64<<10)
+#endif // BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_SIZE
+
+/// Percent of merged region of `BGFX_TEXTURE_ATLAS` texture that may be
+/// left unwritten by updates merged into it. Unwritten texels are cleared.
+#ifndef BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_WASTE
+#	define BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_WASTE 25
+#endif // BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_WASTE
 
 #ifndef BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
 #	define BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE (6<<20)
@@ -298,6 +383,12 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+/// Size of transient vertex/index buffer chunk encoder reserves at once.
+/// Requests larger than quarter of the chunk bypass encoder chunk.
+#ifndef BGFX_CONFIG_TRANSIENT_CHUNK_SIZE
+#	define BGFX_CONFIG_TRANSIENT_CHUNK_SIZE (16<<10)
+#endif // BGFX_CONFIG_TRANSIENT_CHUNK_SIZE
+
 #ifndef BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
 #	define BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT 5
 #endif // BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
@@ -312,6 +403,12 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_PROFILER 0
 #endif // BGFX_CONFIG_PROFILER
 
+/// Number of profiler scope events each thread keeps for
+/// `bgfx::profilerTraceBegin`. Must be power of two.
+#ifndef BGFX_CONFIG_PROFILER_TRACE_EVENTS
+#	define BGFX_CONFIG_PROFILER_TRACE_EVENTS (16<<10)
+#endif // BGFX_CONFIG_PROFILER_TRACE_EVENTS
+
 #ifndef BGFX_CONFIG_RENDERDOC_LOG_FILEPATH
 #	define BGFX_CONFIG_RENDERDOC_LOG_FILEPATH "temp/bgfx"
 #endif // BGFX_CONFIG_RENDERDOC_LOG_FILEPATH
@@ -332,6 +429,118 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_DEFAULT_MAX_ENCODERS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 8 : 1)
 #endif // BGFX_CONFIG_DEFAULT_MAX_ENCODERS
 
+/// Default number of helper threads used by Frame::sort. When 0, sort key
+/// sorting is done single-threaded on the thread calling Frame::sort.
+#ifndef BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS
+#	define BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS 0
+#endif // BGFX_CONFIG_DEFAULT_MAX_SORT_THREADS
+
+/// Maximum number of helper threads that can be requested with
+/// `Init::Limits::maxSortThreads`.
+#ifndef BGFX_CONFIG_MAX_SORT_THREADS
+#	define BGFX_CONFIG_MAX_SORT_THREADS 8
+#endif // BGFX_CONFIG_MAX_SORT_THREADS
+
+/// Default number of worker threads decoding textures created with
+/// `BGFX_TEXTURE_ASYNC`. When 0, textures are decoded on API thread in
+/// `bgfx::frame`.
+#ifndef BGFX_CONFIG_DEFAULT_MAX_TEXTURE_DECODE_THREADS
+#	define BGFX_CONFIG_DEFAULT_MAX_TEXTURE_DECODE_THREADS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 2 : 0)
+#endif // BGFX_CONFIG_DEFAULT_MAX_TEXTURE_DECODE_THREADS
+
+/// Maximum number of texture decode threads that can be requested with
+/// `Init::Limits::maxTextureDecodeThreads`.
+#ifndef BGFX_CONFIG_MAX_TEXTURE_DECODE_THREADS
+#	define BGFX_CONFIG_MAX_TEXTURE_DECODE_THREADS 8
+#endif // BGFX_CONFIG_MAX_TEXTURE_DECODE_THREADS
+
+/// Default number of frames `Stats::phaseStats` are computed over, see
+/// `Init::Limits::statsWindow`.
+#ifndef BGFX_CONFIG_DEFAULT_STATS_WINDOW
+#	define BGFX_CONFIG_DEFAULT_STATS_WINDOW 120
+#endif // BGFX_CONFIG_DEFAULT_STATS_WINDOW
+
+/// Time uniform commit of each render item for `Phase::UniformCommit`.
+/// Costs two timer reads per render item on render thread.
+#ifndef BGFX_CONFIG_PHASE_TIME_UNIFORM_COMMIT
+#	define BGFX_CONFIG_PHASE_TIME_UNIFORM_COMMIT 1
+#endif // BGFX_CONFIG_PHASE_TIME_UNIFORM_COMMIT
+
+/// Minimum number of render items before Frame::sort switches to parallel
+/// sort. Below this, waking helper threads costs more than it saves.
+#ifndef BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS
+#	define BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS (4<<10)
+#endif // BGFX_CONFIG_PARALLEL_SORT_MIN_ITEMS
+
+/// Number of render item slots encoder reserves from frame at once. Encoder
+/// owns its block, so submit doesn't touch shared counter for every draw
+/// call. Up to block size - 1 slots per encoder can be left unused.
+#ifndef BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK
+#	define BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK 64
+#endif // BGFX_CONFIG_ENCODER_RENDER_ITEM_BLOCK
+
+/// Maximum number of pre-sorted encoder runs merged by Frame::sort. When
+/// more encoders submitted draw calls in frame, all keys are sorted again.
+#ifndef BGFX_CONFIG_MAX_SORT_MERGE_RUNS
+#	define BGFX_CONFIG_MAX_SORT_MERGE_RUNS 16
+#endif // BGFX_CONFIG_MAX_SORT_MERGE_RUNS
+
+/// Write transient buffers and dynamic buffer updates through persistently
+/// mapped buffers, when OpenGL 4.4 or ARB/EXT_buffer_storage is available.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_PERSISTENT_BUFFERS
+#	define BGFX_CONFIG_RENDERER_OPENGL_PERSISTENT_BUFFERS 1
+#endif // BGFX_CONFIG_RENDERER_OPENGL_PERSISTENT_BUFFERS
+
+/// Number of frames persistently mapped buffers have storage for. Renderer
+/// waits for GPU only when it gets this many frames ahead.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_FRAMES_IN_FLIGHT
+#	define BGFX_CONFIG_RENDERER_OPENGL_FRAMES_IN_FLIGHT 3
+#endif // BGFX_CONFIG_RENDERER_OPENGL_FRAMES_IN_FLIGHT
+
+/// Size of staging storage per frame in flight, used for dynamic buffer
+/// updates. Updates that don't fit fall back to glBufferSubData.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_STAGING_BUFFER_SIZE
+#	define BGFX_CONFIG_RENDERER_OPENGL_STAGING_BUFFER_SIZE (4<<20)
+#endif // BGFX_CONFIG_RENDERER_OPENGL_STAGING_BUFFER_SIZE
+
+/// Size of uniform stream per frame in flight. Uniform blocks of draw calls
+/// are written to it when their contents change. When it's full, blocks are
+/// updated with glBufferSubData.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_UNIFORM_STREAM_SIZE
+#	define BGFX_CONFIG_RENDERER_OPENGL_UNIFORM_STREAM_SIZE (2<<20)
+#endif // BGFX_CONFIG_RENDERER_OPENGL_UNIFORM_STREAM_SIZE
+
+/// Texture data GL renderer uploads per frame, in bytes. Updates over budget
+/// are spilled to the next frame, and applied before its draw calls. Spilled
+/// updates of texture that frame renders, blits or writes from compute to are
+/// applied before that frame instead. Pixel unpack buffer of this size is
+/// used per frame in flight. 0 disables both.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_BUDGET
+#	define BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_BUDGET (16<<20)
+#endif // BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_BUDGET
+
+/// Texture data GL renderer keeps spilled, in multiples of texture upload
+/// budget. When update would spill more, spilled updates are applied at
+/// once over budget, so that spilled data doesn't grow without bound.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_MAX_SPILL
+#	define BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_MAX_SPILL 4
+#endif // BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_MAX_SPILL
+
+/// Number of frames GL renderer delays `bgfx::readTexture` results and
+/// screen shots. Pixels are read to pixel pack buffer, and copied out when
+/// the frame returned by `bgfx::readTexture` is reached. 0 reads back
+/// synchronously, and render thread waits for GPU to finish. Synchronous
+/// read back can be also selected at runtime with `BGFX_RESET_SYNC_READ_BACK`.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_READBACK_LATENCY
+#	define BGFX_CONFIG_RENDERER_OPENGL_READBACK_LATENCY 2
+#endif // BGFX_CONFIG_RENDERER_OPENGL_READBACK_LATENCY
+
+/// Maximum number of vertex array objects GL renderer keeps for recently
+/// used vertex stream layouts. Least recently used are deleted first.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_MAX_VERTEX_ARRAYS
+#	define BGFX_CONFIG_RENDERER_OPENGL_MAX_VERTEX_ARRAYS (1<<10)
+#endif // BGFX_CONFIG_RENDERER_OPENGL_MAX_VERTEX_ARRAYS
+
 #ifndef BGFX_CONFIG_MAX_BACK_BUFFERS
 #	define BGFX_CONFIG_MAX_BACK_BUFFERS 4
 #endif // BGFX_CONFIG_MAX_BACK_BUFFERS
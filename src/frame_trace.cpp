@@ -0,0 +1,1074 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_p.h"
+#include "frame_trace.h"
+
+namespace bgfx
+{
+	// Frame payload is written as internal structures are laid out in memory,
+	// any change of their size or of limits they are sized with makes old
+	// traces unreadable.
+	static uint32_t frameTraceLayout()
+	{
+		const uint32_t layout[] =
+		{
+			sizeof(View),
+			sizeof(RenderItem),
+			sizeof(RenderBind),
+			sizeof(BlitItem),
+			sizeof(Matrix4),
+			sizeof(Rect),
+			sizeof(VertexDecl),
+			sizeof(Attachment),
+			sizeof(TextureCreate),
+			BGFX_CONFIG_MAX_VIEWS,
+			BGFX_CONFIG_MAX_COLOR_PALETTE,
+			BGFX_CONFIG_MAX_MATRIX_CACHE,
+			BGFX_CONFIG_MAX_RECT_CACHE,
+			BGFX_CONFIG_MAX_BIND_GROUPS,
+			BGFX_CONFIG_MAX_BLIT_ITEMS,
+			BGFX_CONFIG_MAX_VERTEX_STREAMS,
+			BGFX_CONFIG_MAX_TEXTURE_SAMPLERS,
+		};
+
+		return bx::hash<bx::HashMurmur2A>(layout, sizeof(layout) );
+	}
+
+	// Texture memory can be TextureCreate chunk referencing another memory
+	// block with texture data.
+	static const Memory* getTextureCreateMemory(const Memory* _mem)
+	{
+		if (sizeof(uint32_t)+sizeof(TextureCreate) <= _mem->size)
+		{
+			bx::MemoryReader reader(_mem->data, _mem->size);
+
+			uint32_t magic;
+			bx::read(&reader, magic);
+
+			if (BGFX_CHUNK_MAGIC_TEX == magic)
+			{
+				TextureCreate tc;
+				bx::read(&reader, tc);
+				return tc.m_mem;
+			}
+		}
+
+		return NULL;
+	}
+
+	// Command stream adapters, the same command walker copies commands from
+	// command buffer into trace when capturing, and back when replaying.
+	struct CommandBufferReader
+	{
+		CommandBufferReader(CommandBuffer& _cmdbuf)
+			: m_cmdbuf(_cmdbuf)
+		{
+		}
+
+		template<typename Ty>
+		void read(Ty& _value)
+		{
+			m_cmdbuf.read(_value);
+		}
+
+		void read(void* _data, uint32_t _size)
+		{
+			m_cmdbuf.read(_data, _size);
+		}
+
+		void readMemory(const Memory*& _mem)
+		{
+			m_cmdbuf.read(_mem);
+		}
+
+		void readTexture(const Memory*& _mem)
+		{
+			m_cmdbuf.read(_mem);
+		}
+
+		bool isOk() const
+		{
+			return true;
+		}
+
+		CommandBuffer& m_cmdbuf;
+	};
+
+	struct CommandBufferWriter
+	{
+		CommandBufferWriter(CommandBuffer& _cmdbuf)
+			: m_cmdbuf(_cmdbuf)
+		{
+		}
+
+		template<typename Ty>
+		void write(const Ty& _value)
+		{
+			m_cmdbuf.write(_value);
+		}
+
+		void write(const void* _data, uint32_t _size)
+		{
+			m_cmdbuf.write(_data, _size);
+		}
+
+		void writeMemory(const Memory* _mem)
+		{
+			m_cmdbuf.write(_mem);
+		}
+
+		void writeTexture(const Memory* _mem)
+		{
+			m_cmdbuf.write(_mem);
+		}
+
+		CommandBuffer& m_cmdbuf;
+	};
+
+	struct TraceWriter
+	{
+		TraceWriter(bx::WriterI* _writer)
+			: m_writer(_writer)
+		{
+		}
+
+		template<typename Ty>
+		void write(const Ty& _value)
+		{
+			write(&_value, sizeof(Ty) );
+		}
+
+		void write(const void* _data, uint32_t _size)
+		{
+			bx::write(m_writer, _data, int32_t(_size) );
+		}
+
+		void writeMemory(const Memory* _mem)
+		{
+			write(_mem->size);
+			write(_mem->data, _mem->size);
+		}
+
+		void writeTexture(const Memory* _mem)
+		{
+			writeMemory(_mem);
+
+			const Memory* mem = getTextureCreateMemory(_mem);
+			write(uint8_t(NULL != mem) );
+
+			if (NULL != mem)
+			{
+				writeMemory(mem);
+			}
+		}
+
+		bx::WriterI* m_writer;
+	};
+
+	struct TraceReader
+	{
+		TraceReader(bx::MemoryReader* _reader, bx::Error* _err)
+			: m_reader(_reader)
+			, m_err(_err)
+		{
+		}
+
+		template<typename Ty>
+		void read(Ty& _value)
+		{
+			read(&_value, sizeof(Ty) );
+		}
+
+		void read(void* _data, uint32_t _size)
+		{
+			bx::read(m_reader, _data, int32_t(_size), m_err);
+		}
+
+		// Returns pointer to _size bytes of trace, and skips them.
+		const void* skip(uint32_t _size)
+		{
+			if (int64_t(_size) > m_reader->remaining() )
+			{
+				BX_ERROR_SET(m_err, BX_ERROR_READERWRITER_EOF, "Frame trace: Truncated frame.");
+				return NULL;
+			}
+
+			const void* data = m_reader->getDataPtr();
+			bx::seek(m_reader, _size, bx::Whence::Current);
+			return data;
+		}
+
+		void readMemory(const Memory*& _mem)
+		{
+			uint32_t size = 0;
+			read(size);
+
+			const void* data = skip(size);
+			_mem = isOk() && 0 < size
+				? copy(data, size)
+				: NULL
+				;
+		}
+
+		void readTexture(const Memory*& _mem)
+		{
+			readMemory(_mem);
+
+			uint8_t hasMem = 0;
+			read(hasMem);
+
+			if (0 != hasMem)
+			{
+				const Memory* mem;
+				readMemory(mem);
+
+				if (NULL != _mem
+				&&  NULL != mem
+				&&  sizeof(uint32_t)+sizeof(TextureCreate) <= _mem->size)
+				{
+					TextureCreate tc;
+					bx::memCopy(&tc, &_mem->data[sizeof(uint32_t)], sizeof(tc) );
+					tc.m_mem = mem;
+					bx::memCopy(&_mem->data[sizeof(uint32_t)], &tc, sizeof(tc) );
+				}
+			}
+		}
+
+		bool isOk() const
+		{
+			return m_err->isOk();
+		}
+
+		bx::MemoryReader* m_reader;
+		bx::Error*        m_err;
+	};
+
+	template<typename Ty, typename ReaderT, typename WriterT>
+	static void copyField(ReaderT& _reader, WriterT& _writer)
+	{
+		Ty value;
+		_reader.read(value);
+		_writer.write(value);
+	}
+
+	// Copies string in pieces, so that stack use doesn't depend on string
+	// length. String is skipped when _writer is NULL.
+	template<typename ReaderT, typename WriterT>
+	static void copyString(ReaderT& _reader, WriterT* _writer, uint32_t _len)
+	{
+		char str[256];
+		for (uint32_t ii = 0; ii < _len; ii += sizeof(str) )
+		{
+			const uint32_t num = bx::min<uint32_t>(sizeof(str), _len-ii);
+			_reader.read(str, num);
+
+			if (NULL != _writer)
+			{
+				_writer->write(str, num);
+			}
+		}
+	}
+
+	// Copies commands until the end of command buffer. Commands that can't be
+	// replayed, because they reference application memory or native window
+	// handles, or are issued only on init and shutdown, are dropped.
+	template<typename ReaderT, typename WriterT>
+	static void copyCommands(ReaderT& _reader, WriterT& _writer)
+	{
+		// Command layout must match Context::rendererExecCommands, update
+		// both when command is added.
+		BX_STATIC_ASSERT(CommandBuffer::Count == 33);
+
+		for (;;)
+		{
+			uint8_t command = CommandBuffer::End;
+			_reader.read(command);
+
+			if (!_reader.isOk()
+			||  CommandBuffer::End                 == command
+			||  CommandBuffer::RendererShutdownEnd == command)
+			{
+				return;
+			}
+
+			switch (command)
+			{
+			case CommandBuffer::RendererInit:
+				{
+					Init init;
+					_reader.read(init);
+				}
+				break;
+
+			case CommandBuffer::RendererShutdownBegin:
+				break;
+
+			case CommandBuffer::ReadTexture:
+				{
+					TextureHandle handle;
+					_reader.read(handle);
+
+					void* data;
+					_reader.read(data);
+
+					uint8_t mip;
+					_reader.read(mip);
+				}
+				break;
+
+			case CommandBuffer::RequestScreenShot:
+				{
+					FrameBufferHandle handle;
+					_reader.read(handle);
+
+					uint16_t len;
+					_reader.read(len);
+
+					copyString(_reader, (WriterT*)NULL, len);
+				}
+				break;
+
+			case CommandBuffer::CreateFrameBuffer:
+				{
+					FrameBufferHandle handle;
+					_reader.read(handle);
+
+					bool window;
+					_reader.read(window);
+
+					if (window)
+					{
+						void* nwh;
+						_reader.read(nwh);
+
+						uint16_t width;
+						_reader.read(width);
+
+						uint16_t height;
+						_reader.read(height);
+
+						TextureFormat::Enum format;
+						_reader.read(format);
+
+						TextureFormat::Enum depthFormat;
+						_reader.read(depthFormat);
+					}
+					else
+					{
+						uint8_t num;
+						_reader.read(num);
+
+						num = bx::min<uint8_t>(num, BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS);
+
+						Attachment attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+						_reader.read(attachment, sizeof(Attachment) * num);
+
+						_writer.write(command);
+						_writer.write(handle);
+						_writer.write(window);
+						_writer.write(num);
+						_writer.write(attachment, sizeof(Attachment) * num);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateIndexBuffer:
+				{
+					_writer.write(command);
+					copyField<IndexBufferHandle>(_reader, _writer);
+
+					const Memory* mem;
+					_reader.readMemory(mem);
+					_writer.writeMemory(mem);
+
+					copyField<uint16_t>(_reader, _writer);
+				}
+				break;
+
+			case CommandBuffer::CreateVertexDecl:
+				_writer.write(command);
+				copyField<VertexDeclHandle>(_reader, _writer);
+				copyField<VertexDecl>(_reader, _writer);
+				break;
+
+			case CommandBuffer::CreateVertexBuffer:
+				{
+					_writer.write(command);
+					copyField<VertexBufferHandle>(_reader, _writer);
+
+					const Memory* mem;
+					_reader.readMemory(mem);
+					_writer.writeMemory(mem);
+
+					copyField<VertexDeclHandle>(_reader, _writer);
+					copyField<uint16_t>(_reader, _writer);
+				}
+				break;
+
+			case CommandBuffer::CreateDynamicIndexBuffer:
+				_writer.write(command);
+				copyField<IndexBufferHandle>(_reader, _writer);
+				copyField<uint32_t>(_reader, _writer);
+				copyField<uint16_t>(_reader, _writer);
+				break;
+
+			case CommandBuffer::UpdateDynamicIndexBuffer:
+				{
+					_writer.write(command);
+					copyField<IndexBufferHandle>(_reader, _writer);
+					copyField<uint32_t>(_reader, _writer);
+					copyField<uint32_t>(_reader, _writer);
+
+					const Memory* mem;
+					_reader.readMemory(mem);
+					_writer.writeMemory(mem);
+				}
+				break;
+
+			case CommandBuffer::CreateDynamicVertexBuffer:
+				_writer.write(command);
+				copyField<VertexBufferHandle>(_reader, _writer);
+				copyField<uint32_t>(_reader, _writer);
+				copyField<uint16_t>(_reader, _writer);
+				break;
+
+			case CommandBuffer::UpdateDynamicVertexBuffer:
+				{
+					_writer.write(command);
+					copyField<VertexBufferHandle>(_reader, _writer);
+					copyField<uint32_t>(_reader, _writer);
+					copyField<uint32_t>(_reader, _writer);
+
+					const Memory* mem;
+					_reader.readMemory(mem);
+					_writer.writeMemory(mem);
+				}
+				break;
+
+			case CommandBuffer::CreateShader:
+				{
+					_writer.write(command);
+					copyField<ShaderHandle>(_reader, _writer);
+
+					const Memory* mem;
+					_reader.readMemory(mem);
+					_writer.writeMemory(mem);
+				}
+				break;
+
+			case CommandBuffer::CreateProgram:
+				_writer.write(command);
+				copyField<ProgramHandle>(_reader, _writer);
+				copyField<ShaderHandle>(_reader, _writer);
+				copyField<ShaderHandle>(_reader, _writer);
+				break;
+
+			case CommandBuffer::CreateTexture:
+				{
+					_writer.write(command);
+					copyField<TextureHandle>(_reader, _writer);
+
+					const Memory* mem;
+					_reader.readTexture(mem);
+					_writer.writeTexture(mem);
+
+					copyField<uint64_t>(_reader, _writer);
+					copyField<uint8_t>(_reader, _writer);
+				}
+				break;
+
+			case CommandBuffer::UpdateTexture:
+				{
+					_writer.write(command);
+					copyField<TextureHandle>(_reader, _writer);
+					copyField<uint8_t>(_reader, _writer);
+					copyField<uint8_t>(_reader, _writer);
+					copyField<uint8_t>(_reader, _writer);
+					copyField<bool>(_reader, _writer);
+					copyField<Rect>(_reader, _writer);
+					copyField<uint16_t>(_reader, _writer);
+					copyField<uint16_t>(_reader, _writer);
+					copyField<uint16_t>(_reader, _writer);
+
+					const Memory* mem;
+					_reader.readMemory(mem);
+					_writer.writeMemory(mem);
+				}
+				break;
+
+			case CommandBuffer::ResizeTexture:
+				_writer.write(command);
+				copyField<TextureHandle>(_reader, _writer);
+				copyField<uint16_t>(_reader, _writer);
+				copyField<uint16_t>(_reader, _writer);
+				copyField<uint8_t>(_reader, _writer);
+				copyField<uint16_t>(_reader, _writer);
+				break;
+
+			case CommandBuffer::CreateUniform:
+				{
+					_writer.write(command);
+					copyField<UniformHandle>(_reader, _writer);
+					copyField<UniformType::Enum>(_reader, _writer);
+					copyField<uint16_t>(_reader, _writer);
+
+					uint8_t len;
+					_reader.read(len);
+					_writer.write(len);
+					copyString(_reader, &_writer, len);
+				}
+				break;
+
+			case CommandBuffer::UpdateViewName:
+				{
+					_writer.write(command);
+					copyField<ViewId>(_reader, _writer);
+
+					uint16_t len;
+					_reader.read(len);
+					_writer.write(len);
+					copyString(_reader, &_writer, len);
+				}
+				break;
+
+			case CommandBuffer::InvalidateOcclusionQuery:
+				_writer.write(command);
+				copyField<OcclusionQueryHandle>(_reader, _writer);
+				break;
+
+			case CommandBuffer::SetName:
+				{
+					_writer.write(command);
+					copyField<Handle>(_reader, _writer);
+
+					uint16_t len;
+					_reader.read(len);
+					_writer.write(len);
+					copyString(_reader, &_writer, len);
+				}
+				break;
+
+			case CommandBuffer::DestroyVertexDecl:
+				_writer.write(command);
+				copyField<VertexDeclHandle>(_reader, _writer);
+				break;
+
+			case CommandBuffer::DestroyIndexBuffer:
+			case CommandBuffer::DestroyDynamicIndexBuffer:
+				_writer.write(command);
+				copyField<IndexBufferHandle>(_reader, _writer);
+				break;
+
+			case CommandBuffer::DestroyVertexBuffer:
+			case CommandBuffer::DestroyDynamicVertexBuffer:
+				_writer.write(command);
+				copyField<VertexBufferHandle>(_reader, _writer);
+				break;
+
+			case CommandBuffer::DestroyShader:
+				_writer.write(command);
+				copyField<ShaderHandle>(_reader, _writer);
+				break;
+
+			case CommandBuffer::DestroyProgram:
+				_writer.write(command);
+				copyField<ProgramHandle>(_reader, _writer);
+				break;
+
+			case CommandBuffer::DestroyTexture:
+				_writer.write(command);
+				copyField<TextureHandle>(_reader, _writer);
+				break;
+
+			case CommandBuffer::DestroyFrameBuffer:
+				_writer.write(command);
+				copyField<FrameBufferHandle>(_reader, _writer);
+				break;
+
+			case CommandBuffer::DestroyUniform:
+				_writer.write(command);
+				copyField<UniformHandle>(_reader, _writer);
+				break;
+
+			default:
+				BX_CHECK(false, "Invalid command: %d", command);
+				return;
+			}
+		}
+	}
+
+	FrameTraceWriter::FrameTraceWriter()
+		: m_block(g_allocator)
+		, m_open(false)
+	{
+	}
+
+	bool FrameTraceWriter::open(const char* _filePath, const Resolution& _resolution, const Init::Limits& _limits, uint32_t _numResources)
+	{
+		close();
+
+		bx::Error err;
+		if (!bx::open(&m_writer, _filePath, false, &err) )
+		{
+			BX_TRACE("Failed to open frame trace file %s.", _filePath);
+			return false;
+		}
+
+		FrameTraceHeader header;
+		header.magic        = BGFX_CHUNK_MAGIC_FTR;
+		header.version      = BGFX_API_VERSION;
+		header.layout       = frameTraceLayout();
+		header.rendererType = g_caps.rendererType;
+		header.resolution   = _resolution;
+		header.limits       = _limits;
+		header.numResources = _numResources;
+
+		// Frame stores per encoder data for number of encoders actually
+		// created, which can be less than requested.
+		header.limits.maxEncoders = uint16_t(g_caps.limits.maxEncoders);
+		bx::write(&m_writer, &header, sizeof(header), &err);
+
+		bx::memSet(m_view, 0, sizeof(m_view) );
+		m_open = true;
+
+		return true;
+	}
+
+	void FrameTraceWriter::close()
+	{
+		if (m_open)
+		{
+			bx::close(&m_writer);
+			m_open = false;
+		}
+	}
+
+	void FrameTraceWriter::write(Frame* _frame)
+	{
+		BGFX_PROFILER_SCOPE("bgfx/FrameTraceWrite", 0xff2040ff);
+
+		bx::MemoryWriter memWriter(&m_block);
+		TraceWriter writer(&memWriter);
+
+		writer.write(_frame->m_resolution);
+		writer.write(_frame->m_debug);
+		writer.write(_frame->m_viewRemap,    sizeof(_frame->m_viewRemap) );
+		writer.write(_frame->m_colorPalette, sizeof(_frame->m_colorPalette) );
+
+		// Views rarely change, only views that changed since previous frame
+		// are stored.
+		ViewId changed[BGFX_CONFIG_MAX_VIEWS];
+		uint16_t numChanged = 0;
+		for (uint16_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+		{
+			if (0 != bx::memCmp(&m_view[ii], &_frame->m_view[ii], sizeof(View) ) )
+			{
+				bx::memCopy(&m_view[ii], &_frame->m_view[ii], sizeof(View) );
+				changed[numChanged++] = ViewId(ii);
+			}
+		}
+
+		writer.write(numChanged);
+		for (uint16_t ii = 0; ii < numChanged; ++ii)
+		{
+			writer.write(changed[ii]);
+			writer.write(m_view[changed[ii] ]);
+		}
+
+		// Transient buffers are written before render items, so that reader
+		// can remap transient buffer handles while reading render items.
+		const uint32_t vbsize = _frame->m_vboffset;
+		writer.write(_frame->m_transientVb->handle);
+		writer.write(vbsize);
+		writer.write(_frame->m_transientVb->data, vbsize);
+
+		const uint32_t ibsize = _frame->m_iboffset;
+		writer.write(_frame->m_transientIb->handle);
+		writer.write(ibsize);
+		writer.write(_frame->m_transientIb->data, ibsize);
+
+		CommandBufferReader cmdPre(_frame->m_cmdPre);
+		copyCommands(cmdPre, writer);
+		writer.write(uint8_t(CommandBuffer::End) );
+		_frame->m_cmdPre.reset();
+
+		CommandBufferReader cmdPost(_frame->m_cmdPost);
+		copyCommands(cmdPost, writer);
+		writer.write(uint8_t(CommandBuffer::End) );
+		_frame->m_cmdPost.reset();
+
+		const MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+		const uint32_t numMatrices = matrixCache.m_num;
+		writer.write(numMatrices);
+		writer.write(matrixCache.m_cache, numMatrices*sizeof(Matrix4) );
+
+		const RectCache& rectCache = _frame->m_frameCache.m_rectCache;
+		const uint32_t numRects = rectCache.m_num;
+		writer.write(numRects);
+		writer.write(rectCache.m_cache, numRects*sizeof(Rect) );
+
+		const uint32_t numRenderBinds = _frame->m_numRenderBinds;
+		writer.write(numRenderBinds);
+		for (uint32_t ii = 0; ii < numRenderBinds; ++ii)
+		{
+			writer.write(_frame->m_renderBind[ii]);
+			writer.write(_frame->m_renderBindHash[ii]);
+		}
+
+		// Render items are written in sort key order, so that reader doesn't
+		// need sort values. Keys are written before frame is sorted, and
+		// replayed frame goes through the same sort.
+		const uint32_t numRenderItems = _frame->m_numRenderItems;
+		writer.write(numRenderItems);
+		writer.write(_frame->m_sortKeys, numRenderItems*sizeof(uint64_t) );
+
+		const uint32_t numEncoders = g_caps.limits.maxEncoders;
+		uint32_t* uniformEnd = (uint32_t*)alloca(numEncoders*sizeof(uint32_t) );
+		bx::memSet(uniformEnd, 0, numEncoders*sizeof(uint32_t) );
+
+		for (uint32_t ii = 0; ii < numRenderItems; ++ii)
+		{
+			const RenderItem& renderItem = _frame->m_renderItem[_frame->m_sortValues[ii] ];
+			writer.write(renderItem);
+
+			const bool isDraw = 0 != (_frame->m_sortKeys[ii] & kSortKeyDrawBit);
+			const uint8_t  idx = isDraw ? renderItem.draw.m_uniformIdx : renderItem.compute.m_uniformIdx;
+			const uint32_t end = isDraw ? renderItem.draw.m_uniformEnd : renderItem.compute.m_uniformEnd;
+			if (idx < numEncoders)
+			{
+				uniformEnd[idx] = bx::max(uniformEnd[idx], end);
+			}
+		}
+
+		writer.write(_frame->m_sortRun, numEncoders*sizeof(Frame::SortRun) );
+
+		// Uniform buffers don't keep size once finished, only part referenced
+		// by render items is written.
+		for (uint32_t ii = 0; ii < numEncoders; ++ii)
+		{
+			writer.write(uniformEnd[ii]);
+			writer.write(_frame->m_uniformBuffer[ii]->getData(0), uniformEnd[ii]);
+		}
+
+		const uint16_t numBlitItems = _frame->m_numBlitItems;
+		writer.write(numBlitItems);
+		writer.write(_frame->m_blitKeys, numBlitItems*sizeof(uint32_t) );
+		writer.write(_frame->m_blitItem, numBlitItems*sizeof(BlitItem) );
+
+		const uint32_t size = uint32_t(bx::seek(&memWriter) );
+
+		bx::write(&m_writer, BGFX_CHUNK_MAGIC_FRM);
+		bx::write(&m_writer, size);
+		bx::write(&m_writer, m_block.more(), int32_t(size) );
+	}
+
+	FrameTraceReader::FrameTraceReader()
+		: m_data(NULL)
+		, m_capacity(0)
+		, m_open(false)
+	{
+	}
+
+	uint32_t FrameTraceReader::open(const char* _filePath)
+	{
+		close();
+
+		if (!bx::open(&m_reader, _filePath) )
+		{
+			BX_TRACE("Failed to open frame trace file %s.", _filePath);
+			return 0;
+		}
+
+		bx::Error err;
+		FrameTraceHeader header;
+		bx::read(&m_reader, &header, sizeof(header), &err);
+
+		if (!err.isOk()
+		||  BGFX_CHUNK_MAGIC_FTR != header.magic
+		||  BGFX_API_VERSION     != header.version
+		||  frameTraceLayout()   != header.layout)
+		{
+			BX_TRACE("Frame trace %s was captured with different bgfx version or configuration.", _filePath);
+			bx::close(&m_reader);
+			return 0;
+		}
+
+		if (header.limits.maxEncoders     != g_caps.limits.maxEncoders
+		||  header.limits.maxDrawCalls    >  g_caps.limits.maxDrawCalls
+		||  header.limits.transientVbSize >  g_caps.limits.transientVbSize
+		||  header.limits.transientIbSize >  g_caps.limits.transientIbSize)
+		{
+			BX_TRACE("Frame trace %s requires bgfx initialized with limits it was captured with.", _filePath);
+			bx::close(&m_reader);
+			return 0;
+		}
+
+		// Noop renderer ignores resource handles, other renderers would use
+		// resources trace doesn't create.
+		if (0 != header.numResources
+		&&  RendererType::Noop != g_caps.rendererType)
+		{
+			BX_TRACE("Frame trace %s began after %d resources were created, it can be replayed only with noop renderer."
+				, _filePath
+				, header.numResources
+				);
+			bx::close(&m_reader);
+			return 0;
+		}
+
+		const int64_t begin = bx::seek(&m_reader);
+
+		uint32_t numFrames = 0;
+		for (;;)
+		{
+			uint32_t magic = 0;
+			uint32_t size  = 0;
+			bx::read(&m_reader, magic, &err);
+			bx::read(&m_reader, size,  &err);
+
+			if (!err.isOk()
+			||  BGFX_CHUNK_MAGIC_FRM != magic)
+			{
+				break;
+			}
+
+			bx::seek(&m_reader, size, bx::Whence::Current);
+			++numFrames;
+		}
+
+		bx::seek(&m_reader, begin, bx::Whence::Begin);
+
+		bx::memSet(m_view, 0, sizeof(m_view) );
+		m_open = true;
+
+		if (0 == numFrames)
+		{
+			close();
+		}
+
+		return numFrames;
+	}
+
+	void FrameTraceReader::close()
+	{
+		if (m_open)
+		{
+			bx::close(&m_reader);
+			m_open = false;
+		}
+
+		BX_FREE(g_allocator, m_data);
+		m_data     = NULL;
+		m_capacity = 0;
+	}
+
+	static void remapTransient(RenderDraw& _draw, VertexBufferHandle _fromVb, VertexBufferHandle _toVb, IndexBufferHandle _fromIb, IndexBufferHandle _toIb)
+	{
+		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VERTEX_STREAMS; ++ii)
+		{
+			if (_draw.m_stream[ii].m_handle.idx == _fromVb.idx)
+			{
+				_draw.m_stream[ii].m_handle = _toVb;
+			}
+		}
+
+		if (_draw.m_instanceDataBuffer.idx == _fromVb.idx)
+		{
+			_draw.m_instanceDataBuffer = _toVb;
+		}
+
+		if (_draw.m_indexBuffer.idx == _fromIb.idx)
+		{
+			_draw.m_indexBuffer = _toIb;
+		}
+	}
+
+	bool FrameTraceReader::read(Frame* _frame)
+	{
+		BGFX_PROFILER_SCOPE("bgfx/FrameTraceRead", 0xff2040ff);
+
+		bx::Error err;
+
+		uint32_t magic = 0;
+		uint32_t size  = 0;
+		bx::read(&m_reader, magic, &err);
+		bx::read(&m_reader, size,  &err);
+
+		if (!err.isOk()
+		||  BGFX_CHUNK_MAGIC_FRM != magic)
+		{
+			return false;
+		}
+
+		if (size > m_capacity)
+		{
+			m_data     = (uint8_t*)BX_REALLOC(g_allocator, m_data, size);
+			m_capacity = size;
+		}
+
+		bx::read(&m_reader, m_data, int32_t(size), &err);
+		if (!err.isOk() )
+		{
+			return false;
+		}
+
+		bx::MemoryReader memReader(m_data, size);
+		TraceReader reader(&memReader, &err);
+
+		reader.read(_frame->m_resolution);
+		reader.read(_frame->m_debug);
+		reader.read(_frame->m_viewRemap,    sizeof(_frame->m_viewRemap) );
+		reader.read(_frame->m_colorPalette, sizeof(_frame->m_colorPalette) );
+
+		uint16_t numChanged = 0;
+		reader.read(numChanged);
+		for (uint16_t ii = 0; ii < numChanged && reader.isOk(); ++ii)
+		{
+			ViewId id;
+			reader.read(id);
+
+			if (id >= BGFX_CONFIG_MAX_VIEWS)
+			{
+				return false;
+			}
+
+			reader.read(m_view[id]);
+		}
+
+		bx::memCopy(_frame->m_view, m_view, sizeof(m_view) );
+
+		VertexBufferHandle tvb;
+		uint32_t vbsize = 0;
+		reader.read(tvb);
+		reader.read(vbsize);
+		if (vbsize > _frame->m_transientVb->size)
+		{
+			return false;
+		}
+		reader.read(_frame->m_transientVb->data, vbsize);
+		_frame->m_vboffset = vbsize;
+
+		IndexBufferHandle tib;
+		uint32_t ibsize = 0;
+		reader.read(tib);
+		reader.read(ibsize);
+		if (ibsize > _frame->m_transientIb->size)
+		{
+			return false;
+		}
+		reader.read(_frame->m_transientIb->data, ibsize);
+		_frame->m_iboffset = ibsize;
+
+		CommandBufferWriter cmdPre(_frame->m_cmdPre);
+		copyCommands(reader, cmdPre);
+
+		CommandBufferWriter cmdPost(_frame->m_cmdPost);
+		copyCommands(reader, cmdPost);
+
+		MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+		uint32_t numMatrices = 0;
+		reader.read(numMatrices);
+		if (numMatrices > BGFX_CONFIG_MAX_MATRIX_CACHE)
+		{
+			return false;
+		}
+		reader.read(matrixCache.m_cache, numMatrices*sizeof(Matrix4) );
+		matrixCache.m_num = numMatrices;
+
+		RectCache& rectCache = _frame->m_frameCache.m_rectCache;
+		uint32_t numRects = 0;
+		reader.read(numRects);
+		if (numRects > BGFX_CONFIG_MAX_RECT_CACHE)
+		{
+			return false;
+		}
+		reader.read(rectCache.m_cache, numRects*sizeof(Rect) );
+		rectCache.m_num = numRects;
+
+		uint32_t numRenderBinds = 0;
+		reader.read(numRenderBinds);
+		for (uint32_t ii = 0; ii < numRenderBinds; ++ii)
+		{
+			if (!_frame->m_renderBind.commit(ii)
+			||  !_frame->m_renderBindHash.commit(ii) )
+			{
+				return false;
+			}
+
+			reader.read(_frame->m_renderBind[ii]);
+			reader.read(_frame->m_renderBindHash[ii]);
+		}
+		_frame->m_numRenderBinds = numRenderBinds;
+
+		uint32_t numRenderItems = 0;
+		reader.read(numRenderItems);
+		if (numRenderItems > g_caps.limits.maxDrawCalls)
+		{
+			return false;
+		}
+
+		_frame->reserveSortKeys(numRenderItems);
+		reader.read(_frame->m_sortKeys, numRenderItems*sizeof(uint64_t) );
+
+		const VertexBufferHandle vbh = _frame->m_transientVb->handle;
+		const IndexBufferHandle  ibh = _frame->m_transientIb->handle;
+
+		for (uint32_t ii = 0; ii < numRenderItems; ++ii)
+		{
+			if (!_frame->commitRenderItems(ii) )
+			{
+				return false;
+			}
+
+			RenderItem& renderItem = _frame->m_renderItem[ii];
+			reader.read(renderItem);
+			_frame->m_sortValues[ii] = RenderItemCount(ii);
+
+			if (0 != (_frame->m_sortKeys[ii] & kSortKeyDrawBit) )
+			{
+				remapTransient(renderItem.draw, tvb, vbh, tib, ibh);
+			}
+		}
+		_frame->m_numRenderItems     = numRenderItems;
+		_frame->m_numRenderItemSlots = numRenderItems;
+
+		const uint32_t numEncoders = g_caps.limits.maxEncoders;
+		reader.read(_frame->m_sortRun, numEncoders*sizeof(Frame::SortRun) );
+
+		for (uint32_t ii = 0; ii < numEncoders; ++ii)
+		{
+			uint32_t uniformSize = 0;
+			reader.read(uniformSize);
+
+			const void* data = reader.skip(uniformSize);
+			if (!reader.isOk() )
+			{
+				return false;
+			}
+
+			UniformBuffer::update(&_frame->m_uniformBuffer[ii], uniformSize+sizeof(uint32_t), uniformSize);
+
+			UniformBuffer* uniformBuffer = _frame->m_uniformBuffer[ii];
+			uniformBuffer->reset();
+			uniformBuffer->write(data, uniformSize);
+			uniformBuffer->finish();
+		}
+
+		uint16_t numBlitItems = 0;
+		reader.read(numBlitItems);
+		if (numBlitItems > BGFX_CONFIG_MAX_BLIT_ITEMS)
+		{
+			return false;
+		}
+		reader.read(_frame->m_blitKeys, numBlitItems*sizeof(uint32_t) );
+		reader.read(_frame->m_blitItem, numBlitItems*sizeof(BlitItem) );
+		_frame->m_numBlitItems = numBlitItems;
+
+		BX_WARN(reader.isOk(), "Frame trace: Failed to read frame.");
+		return reader.isOk();
+	}
+
+} // namespace bgfx
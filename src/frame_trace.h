@@ -0,0 +1,40 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_FRAME_TRACE_H_HEADER_GUARD
+#define BGFX_FRAME_TRACE_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+
+#define BGFX_CHUNK_MAGIC_FTR BX_MAKEFOURCC('F', 'T', 'R', 0x0)
+#define BGFX_CHUNK_MAGIC_FRM BX_MAKEFOURCC('F', 'R', 'M', 0x0)
+
+namespace bgfx
+{
+	/// Frame trace file header, written by `bgfx::frameTraceBegin`. Header is
+	/// followed by frames, each frame is `BGFX_CHUNK_MAGIC_FRM` magic and
+	/// payload size in bytes, followed by payload.
+	///
+	/// Payload stores internal frame structures as they are, so trace can be
+	/// replayed only by the same bgfx version built with the same
+	/// configuration. Replay tool uses header to initialize bgfx with the
+	/// same resolution and limits trace was captured with. Trace that began
+	/// after application created resources can be replayed only with noop
+	/// renderer.
+	///
+	struct FrameTraceHeader
+	{
+		uint32_t           magic;        //!< `BGFX_CHUNK_MAGIC_FTR`.
+		uint32_t           version;      //!< `BGFX_API_VERSION` trace was captured with.
+		uint32_t           layout;       //!< Hash of internal structure sizes and configuration.
+		RendererType::Enum rendererType; //!< Renderer trace was captured with.
+		Resolution         resolution;   //!< Resolution at the time capture began.
+		Init::Limits       limits;       //!< Limits bgfx was initialized with.
+		uint32_t           numResources; //!< Resources created by application before capture began, missing from trace.
+	};
+
+} // namespace bgfx
+
+#endif // BGFX_FRAME_TRACE_H_HEADER_GUARD
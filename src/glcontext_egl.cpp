@@ -28,6 +28,7 @@ namespace bgfx { namespace gl
 	typedef EGLBoolean  (EGLAPIENTRY* PFNEGLCHOOSECONFIGPROC)(EGLDisplay dpy, const EGLint *attrib_list,	EGLConfig *configs, EGLint config_size,	EGLint *num_config);
 	typedef EGLContext  (EGLAPIENTRY* PFNEGLCREATECONTEXTPROC)(EGLDisplay dpy, EGLConfig config, EGLContext share_context, const EGLint *attrib_list);
 	typedef EGLSurface  (EGLAPIENTRY* PFNEGLCREATEWINDOWSURFACEPROC)(EGLDisplay dpy, EGLConfig config, EGLNativeWindowType win, const EGLint *attrib_list);
+	typedef EGLSurface  (EGLAPIENTRY* PFNEGLCREATEPBUFFERSURFACEPROC)(EGLDisplay dpy, EGLConfig config, const EGLint *attrib_list);
 	typedef EGLint      (EGLAPIENTRY* PFNEGLGETERRORPROC)(void);
 	typedef EGLDisplay  (EGLAPIENTRY* PFNEGLGETDISPLAYPROC)(EGLNativeDisplayType display_id);
 	typedef EGLPROC     (EGLAPIENTRY* PFNEGLGETPROCADDRESSPROC)(const char *procname);
@@ -40,21 +41,22 @@ namespace bgfx { namespace gl
 	typedef EGLBoolean  (EGLAPIENTRY* PFNEGLSWAPINTERVALPROC)(EGLDisplay dpy, EGLint interval);
 	typedef EGLBoolean  (EGLAPIENTRY* PFNEGLTERMINATEPROC)(EGLDisplay dpy);
 
-#define EGL_IMPORT                                                          \
-	EGL_IMPORT_FUNC(PFNEGLCHOOSECONFIGPROC,        eglChooseConfig);        \
-	EGL_IMPORT_FUNC(PFNEGLCREATECONTEXTPROC,       eglCreateContext);       \
-	EGL_IMPORT_FUNC(PFNEGLCREATEWINDOWSURFACEPROC, eglCreateWindowSurface); \
-	EGL_IMPORT_FUNC(PFNEGLGETDISPLAYPROC,          eglGetDisplay);          \
-	EGL_IMPORT_FUNC(PFNEGLGETERRORPROC,            eglGetError);            \
-	EGL_IMPORT_FUNC(PFNEGLGETPROCADDRESSPROC,      eglGetProcAddress);      \
-	EGL_IMPORT_FUNC(PFNEGLDESTROYCONTEXTPROC,      eglDestroyContext);      \
-	EGL_IMPORT_FUNC(PFNEGLDESTROYSURFACEPROC,      eglDestroySurface);      \
-	EGL_IMPORT_FUNC(PFNEGLINITIALIZEPROC,          eglInitialize);          \
-	EGL_IMPORT_FUNC(PFNEGLMAKECURRENTPROC,         eglMakeCurrent);         \
-	EGL_IMPORT_FUNC(PGNEGLQUERYSTRINGPROC,         eglQueryString);         \
-	EGL_IMPORT_FUNC(PFNEGLSWAPBUFFERSPROC,         eglSwapBuffers);         \
-	EGL_IMPORT_FUNC(PFNEGLSWAPINTERVALPROC,        eglSwapInterval);        \
-	EGL_IMPORT_FUNC(PFNEGLTERMINATEPROC,           eglTerminate);
+#define EGL_IMPORT                                                            \
+	EGL_IMPORT_FUNC(PFNEGLCHOOSECONFIGPROC,         eglChooseConfig);         \
+	EGL_IMPORT_FUNC(PFNEGLCREATECONTEXTPROC,        eglCreateContext);        \
+	EGL_IMPORT_FUNC(PFNEGLCREATEPBUFFERSURFACEPROC, eglCreatePbufferSurface); \
+	EGL_IMPORT_FUNC(PFNEGLCREATEWINDOWSURFACEPROC,  eglCreateWindowSurface);  \
+	EGL_IMPORT_FUNC(PFNEGLGETDISPLAYPROC,           eglGetDisplay);           \
+	EGL_IMPORT_FUNC(PFNEGLGETERRORPROC,             eglGetError);             \
+	EGL_IMPORT_FUNC(PFNEGLGETPROCADDRESSPROC,       eglGetProcAddress);       \
+	EGL_IMPORT_FUNC(PFNEGLDESTROYCONTEXTPROC,       eglDestroyContext);       \
+	EGL_IMPORT_FUNC(PFNEGLDESTROYSURFACEPROC,       eglDestroySurface);       \
+	EGL_IMPORT_FUNC(PFNEGLINITIALIZEPROC,           eglInitialize);           \
+	EGL_IMPORT_FUNC(PFNEGLMAKECURRENTPROC,          eglMakeCurrent);          \
+	EGL_IMPORT_FUNC(PGNEGLQUERYSTRINGPROC,          eglQueryString);          \
+	EGL_IMPORT_FUNC(PFNEGLSWAPBUFFERSPROC,          eglSwapBuffers);          \
+	EGL_IMPORT_FUNC(PFNEGLSWAPINTERVALPROC,         eglSwapInterval);         \
+	EGL_IMPORT_FUNC(PFNEGLTERMINATEPROC,            eglTerminate);
 
 #define EGL_IMPORT_FUNC(_proto, _func) _proto _func
 EGL_IMPORT
@@ -148,6 +150,18 @@ EGL_IMPORT
 	static EGL_DISPMANX_WINDOW_T s_dispmanWindow;
 #	endif // BX_PLATFORM_RPI
 
+	static EGLSurface createPbufferSurface(EGLDisplay _display, EGLConfig _config, uint32_t _width, uint32_t _height)
+	{
+		const EGLint attrs[] =
+		{
+			EGL_WIDTH,  EGLint(bx::max<uint32_t>(_width,  1) ),
+			EGL_HEIGHT, EGLint(bx::max<uint32_t>(_height, 1) ),
+			EGL_NONE
+		};
+
+		return eglCreatePbufferSurface(_display, _config, attrs);
+	}
+
 	void GlContext::create(uint32_t _width, uint32_t _height)
 	{
 #	if BX_PLATFORM_RPI
@@ -166,14 +180,49 @@ EGL_IMPORT
 			EGLNativeDisplayType ndt = (EGLNativeDisplayType)g_platformData.ndt;
 			EGLNativeWindowType  nwh = (EGLNativeWindowType )g_platformData.nwh;
 
+			// Without native window, rendering goes into pbuffer surface. This
+			// runs headless, e.g. on Mesa llvmpipe without X11 or Wayland.
+			m_headless = true
+				&& NULL == g_platformData.nwh
+				&& !BX_ENABLED(0
+					| BX_PLATFORM_ANDROID
+					| BX_PLATFORM_EMSCRIPTEN
+					| BX_PLATFORM_RPI
+					)
+				;
+
+			m_display = EGL_NO_DISPLAY;
+
+			if (m_headless
+			&&  NULL == g_platformData.ndt)
+			{
+				// https://www.khronos.org/registry/EGL/extensions/MESA/EGL_MESA_platform_surfaceless.txt
+				const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+				if (NULL != clientExtensions
+				&&  !bx::findIdentifierMatch(clientExtensions, "EGL_MESA_platform_surfaceless").isEmpty() )
+				{
+					PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+					if (NULL != getPlatformDisplay)
+					{
+						m_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+					}
+				}
+			}
+
 #	if BX_PLATFORM_WINDOWS
-			if (NULL == g_platformData.ndt)
+			if (NULL == g_platformData.ndt
+			&&  !m_headless)
 			{
 				ndt = GetDC( (HWND)g_platformData.nwh);
 			}
 #	endif // BX_PLATFORM_WINDOWS
 
-			m_display = eglGetDisplay(ndt);
+			if (EGL_NO_DISPLAY == m_display)
+			{
+				m_display = eglGetDisplay(ndt);
+			}
+
 			BGFX_FATAL(m_display != EGL_NO_DISPLAY, Fatal::UnableToInitialize, "Failed to create display %p", m_display);
 
 			EGLint major = 0;
@@ -201,6 +250,7 @@ EGL_IMPORT
 			EGLint attrs[] =
 			{
 				EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+				EGL_SURFACE_TYPE,    m_headless ? EGL_PBUFFER_BIT : EGL_WINDOW_BIT,
 
 #	if BX_PLATFORM_ANDROID
 				EGL_DEPTH_SIZE, 16,
@@ -253,7 +303,10 @@ EGL_IMPORT
 			vc_dispmanx_update_submit_sync(dispmanUpdate);
 #	endif // BX_PLATFORM_ANDROID
 
-			m_surface = eglCreateWindowSurface(m_display, m_config, nwh, NULL);
+			m_surface = m_headless
+				? createPbufferSurface(m_display, m_config, _width, _height)
+				: eglCreateWindowSurface(m_display, m_config, nwh, NULL)
+				;
 			BGFX_FATAL(m_surface != EGL_NO_SURFACE, Fatal::UnableToInitialize, "Failed to create surface.");
 
 			const bool hasEglKhrCreateContext = !bx::findIdentifierMatch(extensions, "EGL_KHR_create_context").isEmpty();
@@ -365,7 +418,17 @@ EGL_IMPORT
 #	elif BX_PLATFORM_EMSCRIPTEN
 		emscripten_set_canvas_size(_width, _height);
 #	else
-		BX_UNUSED(_width, _height);
+		if (m_headless
+		&&  NULL != m_display)
+		{
+			eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			eglDestroySurface(m_display, m_surface);
+			m_surface = createPbufferSurface(m_display, m_config, _width, _height);
+			BGFX_FATAL(m_surface != EGL_NO_SURFACE, Fatal::UnableToInitialize, "Failed to create surface.");
+			EGLBoolean success = eglMakeCurrent(m_display, m_surface, m_surface, m_context);
+			BGFX_FATAL(success, Fatal::UnableToInitialize, "Failed to set context.");
+			m_current = NULL;
+		}
 #	endif // BX_PLATFORM_*
 
 		if (NULL != m_display)
@@ -382,6 +445,7 @@ EGL_IMPORT
 						| BX_PLATFORM_WINDOWS
 						| BX_PLATFORM_ANDROID
 						)
+			&& !m_headless
 			? BGFX_CAPS_SWAP_CHAIN
 			: 0
 			;
@@ -444,6 +508,10 @@ EGL_IMPORT
 				if (NULL == _func)                                                                                                                               \
 				{                                                                                                                                                \
 					_func = (_proto)bx::dlsym(glesv2, #_import);                                                                                                 \
+					if (NULL == _func)                                                                                                                           \
+					{                                                                                                                                            \
+						_func = (_proto)eglGetProcAddress(#_import);                                                                                             \
+					}                                                                                                                                            \
 					BX_TRACE("\t%p " #_func " (" #_import ")", _func);                                                                                           \
 					BGFX_FATAL(_optional || NULL != _func, Fatal::UnableToInitialize, "Failed to create OpenGLES context. eglGetProcAddress(\"%s\")", #_import); \
 				}                                                                                                                                                \
@@ -0,0 +1,494 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_NONLOCAL_ALLOCATOR_H_HEADER_GUARD
+#define BGFX_NONLOCAL_ALLOCATOR_H_HEADER_GUARD
+
+#include <bx/bx.h>
+#include <bx/uint32_t.h>
+
+namespace bgfx
+{
+	/// Allocator of ranges in memory not accessible by CPU, like offsets
+	/// into GPU buffers. Block bookkeeping is kept outside of managed memory.
+	///
+	/// Free blocks are kept in two-level segregated fit lists (TLSF), first
+	/// level by power of two, second level splits each power of two into
+	/// 16 linear ranges. Alloc and free are O(1), and freed block is merged
+	/// with free neighbours immediately.
+	///
+	/// Includer must provide `stl` namespace alias, see bgfx_p.h.
+	///
+	class NonLocalAllocator
+	{
+	public:
+		static const uint64_t kInvalidBlock = UINT64_MAX;
+
+		NonLocalAllocator()
+		{
+			reset();
+		}
+
+		~NonLocalAllocator()
+		{
+		}
+
+		void reset()
+		{
+			m_block.clear();
+			m_unused.clear();
+			m_used.clear();
+			m_region.clear();
+
+			m_flBitmap = 0;
+			m_freeSize = 0;
+
+			for (uint32_t fl = 0; fl < kFlCount; ++fl)
+			{
+				m_slBitmap[fl] = 0;
+
+				for (uint32_t sl = 0; sl < kSlCount; ++sl)
+				{
+					m_head[fl][sl] = kInvalidIndex;
+				}
+			}
+		}
+
+		/// Add range of `_size` bytes starting at `_ptr`.
+		void add(uint64_t _ptr, uint32_t _size)
+		{
+			const uint32_t idx = allocBlock();
+
+			Block& block = m_block[idx];
+			block.m_ptr      = _ptr;
+			block.m_size     = _size;
+			block.m_prevPhys = kInvalidIndex;
+			block.m_nextPhys = kInvalidIndex;
+
+			insertFree(idx);
+
+			// First block of range keeps its index while range exists, blocks
+			// split from it or merged into it always follow it.
+			m_region.insert(stl::make_pair(_ptr, idx) );
+		}
+
+		/// Remove one of added ranges, returns 0 when there are no more. Can
+		/// be called only when all blocks are free.
+		uint64_t remove()
+		{
+			BX_CHECK(isEmpty(), "");
+
+			if (0 != m_flBitmap)
+			{
+				const uint32_t fl  = bx::uint32_cnttz(m_flBitmap);
+				const uint32_t sl  = bx::uint32_cnttz(m_slBitmap[fl]);
+				const uint32_t idx = m_head[fl][sl];
+
+				const uint64_t ptr = m_block[idx].m_ptr;
+				removeFree(idx);
+				freeBlock(idx);
+				m_region.erase(m_region.find(ptr) );
+
+				return ptr;
+			}
+
+			return 0;
+		}
+
+		/// Remove range added at `_ptr`, if there are no allocated blocks in
+		/// it. Returns true if range was removed.
+		bool remove(uint64_t _ptr)
+		{
+			RegionMap::iterator it = m_region.find(_ptr);
+			if (it == m_region.end() )
+			{
+				return false;
+			}
+
+			const uint32_t idx = it->second;
+			const Block& block = m_block[idx];
+
+			if (!block.m_free
+			||  kInvalidIndex != block.m_nextPhys)
+			{
+				return false;
+			}
+
+			removeFree(idx);
+			freeBlock(idx);
+			m_region.erase(it);
+
+			return true;
+		}
+
+		uint64_t alloc(uint32_t _size)
+		{
+			_size = bx::max(_size, uint32_t(kMinSize) );
+
+			uint32_t fl;
+			uint32_t sl;
+			if (!mappingSearch(_size, fl, sl) )
+			{
+				return kInvalidBlock;
+			}
+
+			const uint32_t idx = findFree(fl, sl);
+			if (kInvalidIndex == idx)
+			{
+				// there is no block large enough.
+				return kInvalidBlock;
+			}
+
+			return use(idx, _size);
+		}
+
+		/// Allocate block outside of range [_begin, _end), used to move
+		/// blocks out of range. Unlike alloc, this walks free lists.
+		uint64_t allocOutside(uint32_t _size, uint64_t _begin, uint64_t _end)
+		{
+			_size = bx::max(_size, uint32_t(kMinSize) );
+
+			uint32_t fl;
+			uint32_t sl;
+			if (!mappingSearch(_size, fl, sl) )
+			{
+				return kInvalidBlock;
+			}
+
+			for (uint32_t flBitmap = m_flBitmap & (UINT32_MAX << fl); 0 != flBitmap; flBitmap &= flBitmap-1)
+			{
+				const uint32_t ffl = bx::uint32_cnttz(flBitmap);
+				const uint32_t mask = ffl == fl ? UINT32_MAX << sl : UINT32_MAX;
+
+				for (uint32_t slBitmap = m_slBitmap[ffl] & mask; 0 != slBitmap; slBitmap &= slBitmap-1)
+				{
+					const uint32_t ssl = bx::uint32_cnttz(slBitmap);
+
+					for (uint32_t idx = m_head[ffl][ssl]; kInvalidIndex != idx; idx = m_block[idx].m_nextFree)
+					{
+						const Block& block = m_block[idx];
+
+						if (block.m_ptr + block.m_size <= _begin
+						||  block.m_ptr >= _end)
+						{
+							return use(idx, _size);
+						}
+					}
+				}
+			}
+
+			return kInvalidBlock;
+		}
+
+		void free(uint64_t _block)
+		{
+			UsedMap::iterator it = m_used.find(_block);
+			if (it == m_used.end() )
+			{
+				return;
+			}
+
+			uint32_t idx = it->second;
+			m_used.erase(it);
+
+			const uint32_t prev = m_block[idx].m_prevPhys;
+			if (kInvalidIndex != prev
+			&&  m_block[prev].m_free)
+			{
+				removeFree(prev);
+				merge(prev, idx);
+				idx = prev;
+			}
+
+			const uint32_t next = m_block[idx].m_nextPhys;
+			if (kInvalidIndex != next
+			&&  m_block[next].m_free)
+			{
+				removeFree(next);
+				merge(idx, next);
+			}
+
+			insertFree(idx);
+		}
+
+		/// Returns true when there are no allocated blocks.
+		bool isEmpty() const
+		{
+			return 0 == m_used.size();
+		}
+
+		/// Returns total size of free blocks.
+		uint64_t getFreeSize() const
+		{
+			return m_freeSize;
+		}
+
+		/// Returns total size of free blocks in range added at `_ptr`.
+		uint64_t getFreeSize(uint64_t _ptr) const
+		{
+			RegionMap::const_iterator it = m_region.find(_ptr);
+			if (it == m_region.end() )
+			{
+				return 0;
+			}
+
+			uint64_t size = 0;
+			for (uint32_t idx = it->second; kInvalidIndex != idx; idx = m_block[idx].m_nextPhys)
+			{
+				size += m_block[idx].m_free ? m_block[idx].m_size : 0;
+			}
+
+			return size;
+		}
+
+		/// Returns size of largest free block.
+		uint32_t getMaxFreeSize() const
+		{
+			if (0 == m_flBitmap)
+			{
+				return 0;
+			}
+
+			const uint32_t fl = 31 - bx::uint32_cntlz(m_flBitmap);
+			const uint32_t sl = 31 - bx::uint32_cntlz(m_slBitmap[fl]);
+
+			uint32_t size = 0;
+			for (uint32_t idx = m_head[fl][sl]; kInvalidIndex != idx; idx = m_block[idx].m_nextFree)
+			{
+				size = bx::max(size, m_block[idx].m_size);
+			}
+
+			return size;
+		}
+
+	private:
+		static const uint32_t kInvalidIndex = UINT32_MAX;
+		static const uint32_t kMinSize      = 16;
+		static const uint32_t kSlBits       = 4;
+		static const uint32_t kSlCount      = 1<<kSlBits;
+		static const uint32_t kFlCount      = 32-kSlBits+1;
+
+		struct Block
+		{
+			uint64_t m_ptr;
+			uint32_t m_size;
+			uint32_t m_prevPhys;
+			uint32_t m_nextPhys;
+			uint32_t m_prevFree;
+			uint32_t m_nextFree;
+			bool     m_free;
+		};
+
+		// Sizes below kSlCount are in first level 0, otherwise first level is
+		// position of most significant bit, and second level next kSlBits bits.
+		static void mapping(uint32_t _size, uint32_t& _fl, uint32_t& _sl)
+		{
+			if (_size < kSlCount)
+			{
+				_fl = 0;
+				_sl = _size;
+			}
+			else
+			{
+				const uint32_t msb = 31 - bx::uint32_cntlz(_size);
+				_fl = msb - kSlBits + 1;
+				_sl = (_size >> (msb - kSlBits) ) ^ kSlCount;
+			}
+		}
+
+		// Rounds size up to next second level range, so that any block in
+		// found list is large enough.
+		static bool mappingSearch(uint32_t _size, uint32_t& _fl, uint32_t& _sl)
+		{
+			if (_size >= kSlCount)
+			{
+				const uint32_t msb   = 31 - bx::uint32_cntlz(_size);
+				const uint32_t round = (1<<(msb - kSlBits) ) - 1;
+
+				if (_size > UINT32_MAX - round)
+				{
+					return false;
+				}
+
+				_size += round;
+			}
+
+			mapping(_size, _fl, _sl);
+
+			return true;
+		}
+
+		uint32_t findFree(uint32_t _fl, uint32_t _sl) const
+		{
+			uint32_t slBitmap = m_slBitmap[_fl] & (UINT32_MAX << _sl);
+
+			if (0 == slBitmap)
+			{
+				const uint32_t flBitmap = m_flBitmap & (UINT32_MAX << (_fl+1) );
+				if (0 == flBitmap)
+				{
+					return kInvalidIndex;
+				}
+
+				_fl = bx::uint32_cnttz(flBitmap);
+				slBitmap = m_slBitmap[_fl];
+			}
+
+			_sl = bx::uint32_cnttz(slBitmap);
+
+			return m_head[_fl][_sl];
+		}
+
+		void insertFree(uint32_t _idx)
+		{
+			Block& block = m_block[_idx];
+
+			uint32_t fl;
+			uint32_t sl;
+			mapping(block.m_size, fl, sl);
+
+			block.m_free     = true;
+			block.m_prevFree = kInvalidIndex;
+			block.m_nextFree = m_head[fl][sl];
+
+			if (kInvalidIndex != block.m_nextFree)
+			{
+				m_block[block.m_nextFree].m_prevFree = _idx;
+			}
+
+			m_head[fl][sl]  = _idx;
+			m_flBitmap     |= 1<<fl;
+			m_slBitmap[fl] |= 1<<sl;
+			m_freeSize     += block.m_size;
+		}
+
+		void removeFree(uint32_t _idx)
+		{
+			Block& block = m_block[_idx];
+
+			uint32_t fl;
+			uint32_t sl;
+			mapping(block.m_size, fl, sl);
+
+			if (kInvalidIndex != block.m_prevFree)
+			{
+				m_block[block.m_prevFree].m_nextFree = block.m_nextFree;
+			}
+			else
+			{
+				m_head[fl][sl] = block.m_nextFree;
+
+				if (kInvalidIndex == block.m_nextFree)
+				{
+					m_slBitmap[fl] &= ~(1<<sl);
+
+					if (0 == m_slBitmap[fl])
+					{
+						m_flBitmap &= ~(1<<fl);
+					}
+				}
+			}
+
+			if (kInvalidIndex != block.m_nextFree)
+			{
+				m_block[block.m_nextFree].m_prevFree = block.m_prevFree;
+			}
+
+			block.m_free  = false;
+			m_freeSize   -= block.m_size;
+		}
+
+		// Merges block _next into physically preceding block _idx.
+		void merge(uint32_t _idx, uint32_t _next)
+		{
+			Block& block     = m_block[_idx];
+			Block& nextBlock = m_block[_next];
+
+			block.m_size    += nextBlock.m_size;
+			block.m_nextPhys = nextBlock.m_nextPhys;
+
+			if (kInvalidIndex != nextBlock.m_nextPhys)
+			{
+				m_block[nextBlock.m_nextPhys].m_prevPhys = _idx;
+			}
+
+			freeBlock(_next);
+		}
+
+		uint32_t allocBlock()
+		{
+			if (0 != m_unused.size() )
+			{
+				const uint32_t idx = m_unused.back();
+				m_unused.pop_back();
+				return idx;
+			}
+
+			Block block;
+			block.m_free = false;
+			m_block.push_back(block);
+
+			return uint32_t(m_block.size()-1);
+		}
+
+		void freeBlock(uint32_t _idx)
+		{
+			m_unused.push_back(_idx);
+		}
+
+		uint64_t use(uint32_t _idx, uint32_t _size)
+		{
+			removeFree(_idx);
+
+			const uint32_t rest = m_block[_idx].m_size - _size;
+			if (rest >= kMinSize)
+			{
+				const uint32_t split = allocBlock();
+
+				Block& block      = m_block[_idx];
+				Block& splitBlock = m_block[split];
+				splitBlock.m_ptr      = block.m_ptr + _size;
+				splitBlock.m_size     = rest;
+				splitBlock.m_prevPhys = _idx;
+				splitBlock.m_nextPhys = block.m_nextPhys;
+
+				if (kInvalidIndex != block.m_nextPhys)
+				{
+					m_block[block.m_nextPhys].m_prevPhys = split;
+				}
+
+				block.m_size     = _size;
+				block.m_nextPhys = split;
+
+				insertFree(split);
+			}
+
+			const uint64_t ptr = m_block[_idx].m_ptr;
+			m_used.insert(stl::make_pair(ptr, _idx) );
+
+			return ptr;
+		}
+
+		typedef stl::vector<Block> BlockArray;
+		BlockArray m_block;
+
+		typedef stl::vector<uint32_t> IndexArray;
+		IndexArray m_unused;
+
+		typedef stl::unordered_map<uint64_t, uint32_t> UsedMap;
+		UsedMap m_used;
+
+		typedef stl::unordered_map<uint64_t, uint32_t> RegionMap;
+		RegionMap m_region;
+
+		uint32_t m_flBitmap;
+		uint32_t m_slBitmap[kFlCount];
+		uint32_t m_head[kFlCount][kSlCount];
+		uint64_t m_freeSize;
+	};
+
+} // namespace bgfx
+
+#endif // BGFX_NONLOCAL_ALLOCATOR_H_HEADER_GUARD
@@ -0,0 +1,322 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_p.h"
+
+namespace bgfx
+{
+	BX_STATIC_ASSERT(0 == (BGFX_CONFIG_PROFILER_TRACE_EVENTS & (BGFX_CONFIG_PROFILER_TRACE_EVENTS-1) )
+		, "BGFX_CONFIG_PROFILER_TRACE_EVENTS must be power of two."
+		);
+
+#if defined(BX_THREAD_LOCAL)
+#	define BGFX_PROFILER_TRACE_THREAD_LOCAL BX_THREAD_LOCAL
+#	define BGFX_PROFILER_TRACE_SUPPORTED BGFX_CONFIG_PROFILER
+#else
+	// Without thread local storage profiler trace can't be opened, and these
+	// are never used for recording.
+#	define BGFX_PROFILER_TRACE_THREAD_LOCAL
+#	define BGFX_PROFILER_TRACE_SUPPORTED 0
+#endif // defined(BX_THREAD_LOCAL)
+
+	// Ring of the current thread is valid only for generation it was
+	// allocated in, rings are freed on bgfx::shutdown.
+	static BGFX_PROFILER_TRACE_THREAD_LOCAL void*       s_ring;
+	static BGFX_PROFILER_TRACE_THREAD_LOCAL uint32_t    s_ringGeneration;
+	static BGFX_PROFILER_TRACE_THREAD_LOCAL const char* s_threadName;
+
+	static uint32_t atomicLoad(uint32_t* _ptr)
+	{
+		return bx::atomicFetchAndAdd<uint32_t>(_ptr, 0);
+	}
+
+	static void writef(bx::WriterI* _writer, bx::Error* _err, const char* _format, ...)
+	{
+		char temp[256];
+
+		va_list argList;
+		va_start(argList, _format);
+		int32_t len = bx::vsnprintf(temp, sizeof(temp), _format, argList);
+		va_end(argList);
+
+		bx::write(_writer, temp, bx::min<int32_t>(len, sizeof(temp)-1), _err);
+	}
+
+	static void writeName(bx::WriterI* _writer, bx::Error* _err, const char* _name)
+	{
+		char temp[128];
+		uint32_t len = 0;
+
+		for (const char* ptr = _name; '\0' != *ptr && len < sizeof(temp)-2; ++ptr)
+		{
+			const char ch = *ptr;
+			if ('"' == ch
+			||  '\\' == ch)
+			{
+				temp[len++] = '\\';
+				temp[len++] = ch;
+			}
+			else if (' ' <= ch)
+			{
+				temp[len++] = ch;
+			}
+		}
+
+		bx::write(_writer, temp, int32_t(len), _err);
+	}
+
+	ProfilerTrace::ProfilerTrace()
+		: m_rings(NULL)
+		, m_scratch(NULL)
+		, m_timeBegin(0)
+		, m_generation(1)
+		, m_numThreads(0)
+		, m_dumpInterval(0)
+		, m_enabled(false)
+		, m_dumpRequested(false)
+	{
+		m_filePath[0] = '\0';
+	}
+
+	bool ProfilerTrace::open(const char* _filePath, uint32_t _dumpInterval)
+	{
+		if (!BX_ENABLED(BGFX_PROFILER_TRACE_SUPPORTED) )
+		{
+			BX_TRACE("Profiler trace requires bgfx built with BGFX_CONFIG_PROFILER, and thread local storage.");
+			return false;
+		}
+
+		close();
+
+		if (NULL == m_scratch)
+		{
+			m_scratch = (Event*)BX_ALLOC(g_allocator, sizeof(Event)*BGFX_CONFIG_PROFILER_TRACE_EVENTS);
+		}
+
+		bx::strCopy(m_filePath, sizeof(m_filePath), _filePath);
+		m_dumpInterval  = _dumpInterval;
+		m_dumpRequested = false;
+		m_timeBegin     = bx::getHPCounter();
+
+		{
+			bx::MutexScope scope(m_lock);
+
+			for (Ring* ring = m_rings; NULL != ring; ring = ring->m_next)
+			{
+				ring->m_read = atomicLoad(&ring->m_write);
+			}
+		}
+
+		m_enabled = true;
+
+		return true;
+	}
+
+	void ProfilerTrace::close()
+	{
+		if (m_enabled)
+		{
+			m_enabled = false;
+			dump(UINT32_MAX);
+		}
+	}
+
+	void ProfilerTrace::shutdown()
+	{
+		close();
+
+		bx::MutexScope scope(m_lock);
+
+		for (Ring* ring = m_rings; NULL != ring;)
+		{
+			Ring* next = ring->m_next;
+			BX_FREE(g_allocator, ring);
+			ring = next;
+		}
+
+		BX_FREE(g_allocator, m_scratch);
+
+		m_rings      = NULL;
+		m_scratch    = NULL;
+		m_numThreads = 0;
+		++m_generation;
+	}
+
+	void ProfilerTrace::frame(uint32_t _frame)
+	{
+		if (m_dumpRequested
+		|| (0 != m_dumpInterval && 0 == _frame % m_dumpInterval) )
+		{
+			m_dumpRequested = false;
+			dump(_frame);
+		}
+	}
+
+	void ProfilerTrace::setThreadName(const char* _name)
+	{
+		s_threadName = _name;
+
+		if (m_generation == s_ringGeneration
+		&&  NULL != s_ring)
+		{
+			( (Ring*)s_ring)->m_name = _name;
+		}
+	}
+
+	void ProfilerTrace::record(EventType::Enum _type, const char* _name, bool _literal)
+	{
+		Ring* ring = getRing();
+
+		const uint32_t pos = ring->m_write;
+		Event& event = ring->m_event[pos & (BGFX_CONFIG_PROFILER_TRACE_EVENTS-1)];
+		event.m_time = bx::getHPCounter();
+		event.m_type = uint8_t(_type);
+
+		if (_literal
+		||  NULL == _name)
+		{
+			event.m_name = _name;
+		}
+		else
+		{
+			bx::strCopy(event.m_copy, sizeof(event.m_copy), _name);
+			event.m_name = NULL;
+		}
+
+		// Publishes event to dump.
+		bx::atomicFetchAndAdd<uint32_t>(&ring->m_write, 1);
+	}
+
+	ProfilerTrace::Ring* ProfilerTrace::getRing()
+	{
+		if (m_generation == s_ringGeneration
+		&&  NULL != s_ring)
+		{
+			return (Ring*)s_ring;
+		}
+
+		Ring* ring = (Ring*)BX_ALLOC(g_allocator, sizeof(Ring) );
+		ring->m_name  = s_threadName;
+		ring->m_write = 0;
+		ring->m_read  = 0;
+
+		{
+			bx::MutexScope scope(m_lock);
+			ring->m_tid  = ++m_numThreads;
+			ring->m_next = m_rings;
+			m_rings = ring;
+		}
+
+		s_ring = ring;
+		s_ringGeneration = m_generation;
+
+		return ring;
+	}
+
+	// Dump reads rings while their threads keep recording. Events are copied
+	// first, and events that got overwritten while copying are dropped.
+	//
+	// Rings are only prepended to list and freed on shutdown, so list can be
+	// walked without lock once its head is taken.
+	void ProfilerTrace::dump(uint32_t _frame)
+	{
+		char filePath[1024];
+		if (UINT32_MAX == _frame)
+		{
+			bx::snprintf(filePath, sizeof(filePath), "%s-end.json", m_filePath);
+		}
+		else
+		{
+			bx::snprintf(filePath, sizeof(filePath), "%s-%d.json", m_filePath, _frame);
+		}
+
+		bx::FileWriter writer;
+		if (!bx::open(&writer, filePath) )
+		{
+			BX_TRACE("Failed to open profiler trace file %s.", filePath);
+			return;
+		}
+
+		const double toUs = 1000000.0/double(bx::getHPFrequency() );
+
+		bx::Error err;
+		writef(&writer, &err, "{\"traceEvents\":[\n");
+
+		Ring* rings;
+		{
+			bx::MutexScope scope(m_lock);
+			rings = m_rings;
+		}
+
+		bool first = true;
+		for (Ring* ring = rings; NULL != ring; ring = ring->m_next)
+		{
+			writef(&writer, &err, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\""
+				, first ? "" : ",\n"
+				, ring->m_tid
+				);
+
+			if (NULL != ring->m_name)
+			{
+				writeName(&writer, &err, ring->m_name);
+			}
+			else
+			{
+				writef(&writer, &err, "Thread %d", ring->m_tid);
+			}
+
+			writef(&writer, &err, "\"}}");
+			first = false;
+
+			const uint32_t write = atomicLoad(&ring->m_write);
+			uint32_t begin = write - ring->m_read > BGFX_CONFIG_PROFILER_TRACE_EVENTS
+				? write - BGFX_CONFIG_PROFILER_TRACE_EVENTS
+				: ring->m_read
+				;
+
+			for (uint32_t pos = begin; pos != write; ++pos)
+			{
+				m_scratch[pos - begin] = ring->m_event[pos & (BGFX_CONFIG_PROFILER_TRACE_EVENTS-1)];
+			}
+
+			// Event at position `written` might be in flight, and it shares slot
+			// with event at `written - BGFX_CONFIG_PROFILER_TRACE_EVENTS`.
+			const uint32_t written = atomicLoad(&ring->m_write);
+			const uint32_t skip = written - begin >= BGFX_CONFIG_PROFILER_TRACE_EVENTS
+				? bx::min(written - BGFX_CONFIG_PROFILER_TRACE_EVENTS + 1 - begin, write - begin)
+				: 0
+				;
+
+			for (uint32_t ii = skip, num = write - begin; ii < num; ++ii)
+			{
+				const Event& event = m_scratch[ii];
+
+				writef(&writer, &err, ",\n{\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f"
+					, EventType::Begin == event.m_type ? 'B' : 'E'
+					, ring->m_tid
+					, double(event.m_time - m_timeBegin)*toUs
+					);
+
+				if (EventType::Begin == event.m_type)
+				{
+					writef(&writer, &err, ",\"name\":\"");
+					writeName(&writer, &err, NULL != event.m_name ? event.m_name : event.m_copy);
+					writef(&writer, &err, "\"");
+				}
+
+				writef(&writer, &err, "}");
+			}
+
+			ring->m_read = write;
+		}
+
+		writef(&writer, &err, "\n]}\n");
+
+		bx::close(&writer);
+
+		BX_TRACE("Profiler trace written to %s.", filePath);
+	}
+
+} // namespace bgfx
@@ -371,6 +371,28 @@ namespace bgfx
 			}
 		}
 
+		/// Invalidates entries for which `isReferencing(value, _id)` is true.
+		template<typename IdT>
+		void invalidateReferencing(IdT _id)
+		{
+			for (uint16_t ii = 0; ii < m_alloc.getNumHandles();)
+			{
+				uint16_t handle = m_alloc.getHandleAt(ii);
+				Data& data = m_data[handle];
+
+				if (isReferencing(data.m_value, _id) )
+				{
+					m_alloc.free(handle);
+					m_hashMap.erase(m_hashMap.find(data.m_hash) );
+					release(data.m_value);
+				}
+				else
+				{
+					++ii;
+				}
+			}
+		}
+
 		void invalidate()
 		{
 			for (uint16_t ii = 0, num = m_alloc.getNumHandles(); ii < num; ++ii)
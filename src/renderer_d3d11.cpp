@@ -1675,6 +1675,11 @@ namespace bgfx { namespace d3d11
 			return BGFX_RENDERER_DIRECT3D11_NAME;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return 0;
+		}
+
 		void createIndexBuffer(IndexBufferHandle _handle, const Memory* _mem, uint16_t _flags) override
 		{
 			m_indexBuffers[_handle.idx].create(_mem->size, _mem->data, _flags);
@@ -2005,9 +2010,15 @@ namespace bgfx { namespace d3d11
 				);
 		}
 
-		void updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
+		bool updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
 		{
+			if (0 == bx::memCmp(m_uniforms[_loc], _data, _size) )
+			{
+				return false;
+			}
+
 			bx::memCopy(m_uniforms[_loc], _data, _size);
+			return true;
 		}
 
 		void invalidateOcclusionQuery(OcclusionQueryHandle _handle) override
@@ -2364,6 +2375,7 @@ namespace bgfx { namespace d3d11
 				| BGFX_RESET_MAXANISOTROPY
 				| BGFX_RESET_DEPTH_CLAMP
 				| BGFX_RESET_SUSPEND
+				| BGFX_RESET_SYNC_READ_BACK
 				);
 
 			if (m_resolution.width            !=  _resolution.width
@@ -3995,7 +4007,7 @@ namespace bgfx { namespace d3d11
 		else if (isShaderType(magic, 'V') )
 		{
 			m_hash = bx::hash<bx::HashMurmur2A>(code, shaderSize);
-			m_code = copy(code, shaderSize);
+			m_code = copyUnpooled(code, shaderSize);
 
 			DX_CHECK(s_renderD3D11->m_device->CreateVertexShader(code, shaderSize, NULL, &m_vertexShader) );
 			BGFX_FATAL(NULL != m_ptr, bgfx::Fatal::InvalidShader, "Failed to create vertex shader.");
@@ -5285,6 +5297,8 @@ namespace bgfx { namespace d3d11
 			frameQueryIdx = m_gpuTimer.begin(BGFX_CONFIG_MAX_VIEWS);
 		}
 
+		_render->sort();
+
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
@@ -5299,8 +5313,6 @@ namespace bgfx { namespace d3d11
 			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
 		}
 
-		_render->sort();
-
 		RenderDraw currentState;
 		currentState.clear();
 		currentState.m_stateFlags = BGFX_STATE_NONE;
@@ -5308,6 +5320,7 @@ namespace bgfx { namespace d3d11
 
 		RenderBind currentBind;
 		currentBind.clear();
+		uint32_t currentBindIdx = UINT32_MAX;
 
 		static ViewState viewState;
 		viewState.reset(_render);
@@ -5374,7 +5387,7 @@ namespace bgfx { namespace d3d11
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderBind& renderBind = _render->m_renderBind[isCompute ? renderItem.compute.m_bindIdx : renderItem.draw.m_bindIdx];
 				++item;
 
 				if (viewChanged)
@@ -5613,6 +5626,7 @@ namespace bgfx { namespace d3d11
 							currentState.clear();
 							currentState.m_scissor = !draw.m_scissor;
 							currentBind.clear();
+							currentBindIdx = UINT32_MAX;
 						}
 
 						continue;
@@ -5641,6 +5655,7 @@ namespace bgfx { namespace d3d11
 					currentState.m_stencil    = newStencil;
 
 					currentBind.clear();
+					currentBindIdx = UINT32_MAX;
 
 					setBlendState(newFlags);
 					setDepthStencilState(newFlags, packStencil(BGFX_STENCIL_DEFAULT, BGFX_STENCIL_DEFAULT) );
@@ -5737,8 +5752,12 @@ namespace bgfx { namespace d3d11
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+
+				// Compute, blit and clear can update uniforms without committing
+				// them to current program.
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd)
+					|| resetState
+					;
 
 				if (key.m_program.idx != currentProgram.idx)
 				{
@@ -5808,7 +5827,11 @@ namespace bgfx { namespace d3d11
 					}
 				}
 
+				if (currentBindIdx != draw.m_bindIdx
+				||  programChanged)
 				{
+					currentBindIdx = draw.m_bindIdx;
+
 					uint32_t changes = 0;
 					for (uint8_t stage = 0; stage < maxTextureSamplers; ++stage)
 					{
@@ -988,6 +988,11 @@ namespace bgfx { namespace d3d9
 			return BGFX_RENDERER_DIRECT3D9_NAME;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return 0;
+		}
+
 		void createIndexBuffer(IndexBufferHandle _handle, const Memory* _mem, uint16_t _flags) override
 		{
 			m_indexBuffers[_handle.idx].create(_mem->size, _mem->data, _flags);
@@ -1310,9 +1315,15 @@ namespace bgfx { namespace d3d9
 				);
 		}
 
-		void updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
+		bool updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
 		{
+			if (0 == bx::memCmp(m_uniforms[_loc], _data, _size) )
+			{
+				return false;
+			}
+
 			bx::memCopy(m_uniforms[_loc], _data, _size);
+			return true;
 		}
 
 		void invalidateOcclusionQuery(OcclusionQueryHandle _handle) override
@@ -1446,6 +1457,7 @@ namespace bgfx { namespace d3d9
 				| BGFX_RESET_MAXANISOTROPY
 				| BGFX_RESET_DEPTH_CLAMP
 				| BGFX_RESET_SUSPEND
+				| BGFX_RESET_SYNC_READ_BACK
 				);
 
 			if (m_resolution.width            !=  _resolution.width
@@ -3737,6 +3749,8 @@ namespace bgfx { namespace d3d9
 			frameQueryIdx = m_gpuTimer.begin(BGFX_CONFIG_MAX_VIEWS);
 		}
 
+		_render->sort();
+
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
@@ -3751,8 +3765,6 @@ namespace bgfx { namespace d3d9
 			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
 		}
 
-		_render->sort();
-
 		RenderDraw currentState;
 		currentState.clear();
 		currentState.m_stateFlags = BGFX_STATE_NONE;
@@ -3760,6 +3772,7 @@ namespace bgfx { namespace d3d9
 
 		RenderBind currentBind;
 		currentBind.clear();
+		uint32_t currentBindIdx = UINT32_MAX;
 
 		static ViewState viewState;
 		viewState.reset(_render);
@@ -3820,7 +3833,7 @@ namespace bgfx { namespace d3d9
 
 				const uint32_t itemIdx = _render->m_sortValues[item];
 				const RenderDraw& draw = _render->m_renderItem[itemIdx].draw;
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderBind& renderBind = _render->m_renderBind[draw.m_bindIdx];
 
 				const bool hasOcclusionQuery = 0 != (draw.m_stateFlags & BGFX_STATE_INTERNAL_OCCLUSION_QUERY);
 				{
@@ -4180,7 +4193,11 @@ namespace bgfx { namespace d3d9
 					viewState.setPredefined<4>(this, view, program, _render, draw);
 				}
 
+				if (currentBindIdx != draw.m_bindIdx
+				||  programChanged)
 				{
+					currentBindIdx = draw.m_bindIdx;
+
 					for (uint8_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
 					{
 						const Binding& bind = renderBind.m_bind[stage];
@@ -481,9 +481,11 @@ namespace bgfx { namespace gl
 			APPLE_texture_format_BGRA8888,
 			APPLE_texture_max_level,
 
+			ARB_buffer_storage,
 			ARB_clip_control,
 			ARB_compute_shader,
 			ARB_conservative_depth,
+			ARB_copy_buffer,
 			ARB_copy_image,
 			ARB_debug_label,
 			ARB_debug_output,
@@ -514,6 +516,7 @@ namespace bgfx { namespace gl
 			ARB_shader_image_load_store,
 			ARB_shader_storage_buffer_object,
 			ARB_shader_texture_lod,
+			ARB_sync,
 			ARB_texture_compression_bptc,
 			ARB_texture_compression_rgtc,
 			ARB_texture_cube_map_array,
@@ -542,6 +545,7 @@ namespace bgfx { namespace gl
 			EXT_blend_color,
 			EXT_blend_minmax,
 			EXT_blend_subtract,
+			EXT_buffer_storage,
 			EXT_color_buffer_half_float,
 			EXT_color_buffer_float,
 			EXT_copy_image,
@@ -691,9 +695,11 @@ namespace bgfx { namespace gl
 		{ "APPLE_texture_format_BGRA8888",            false,                             true  },
 		{ "APPLE_texture_max_level",                  false,                             true  },
 
+		{ "ARB_buffer_storage",                       BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_clip_control",                         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_compute_shader",                       BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_conservative_depth",                   BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
+		{ "ARB_copy_buffer",                          BGFX_CONFIG_RENDERER_OPENGL >= 31, true  },
 		{ "ARB_copy_image",                           BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
 		{ "ARB_debug_label",                          false,                             true  },
 		{ "ARB_debug_output",                         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
@@ -724,6 +730,7 @@ namespace bgfx { namespace gl
 		{ "ARB_shader_image_load_store",              BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
 		{ "ARB_shader_storage_buffer_object",         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_shader_texture_lod",                   BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
+		{ "ARB_sync",                                 BGFX_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_texture_compression_bptc",             BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_texture_compression_rgtc",             BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
 		{ "ARB_texture_cube_map_array",               BGFX_CONFIG_RENDERER_OPENGL >= 40, true  },
@@ -752,6 +759,7 @@ namespace bgfx { namespace gl
 		{ "EXT_blend_color",                          BGFX_CONFIG_RENDERER_OPENGL >= 31, true  },
 		{ "EXT_blend_minmax",                         BGFX_CONFIG_RENDERER_OPENGL >= 14, true  },
 		{ "EXT_blend_subtract",                       BGFX_CONFIG_RENDERER_OPENGL >= 14, true  },
+		{ "EXT_buffer_storage",                       false,                             true  }, // GLES3 extension.
 		{ "EXT_color_buffer_half_float",              false,                             true  }, // GLES2 extension.
 		{ "EXT_color_buffer_float",                   false,                             true  }, // GLES2 extension.
 		{ "EXT_copy_image",                           false,                             true  }, // GLES2 extension.
@@ -1750,6 +1758,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			, m_occlusionQuerySupport(false)
 			, m_atocSupport(false)
 			, m_conservativeRasterSupport(false)
+			, m_persistentBufferSupport(false)
+			, m_uniformBlockSupport(false)
+			, m_uniformStreamSupport(false)
+			, m_textureUploadSupport(false)
+			, m_readBackAsyncSupport(false)
+			, m_readBackSync(false)
 			, m_flip(false)
 			, m_hash( (BX_PLATFORM_WINDOWS<<1) | BX_ARCH_64BIT)
 			, m_backBufferFbo(0)
@@ -1758,6 +1772,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			, m_clearQuadDepth(BGFX_INVALID_HANDLE)
 		{
 			bx::memSet(m_msaaBackBufferRbos, 0, sizeof(m_msaaBackBufferRbos) );
+			bx::memSet(m_frameFence, 0, sizeof(m_frameFence) );
 		}
 
 		~RendererContextGL()
@@ -2439,6 +2454,84 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					|| s_extension[Extension::EXT_shader_image_load_store].m_supported
 					;
 
+				m_persistentBufferSupport = true
+					&& BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL_PERSISTENT_BUFFERS)
+					&& !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN)
+					&& (!!(BGFX_CONFIG_RENDERER_OPENGL >= 44)
+						|| s_extension[Extension::ARB_buffer_storage].m_supported
+						|| s_extension[Extension::EXT_buffer_storage].m_supported
+						)
+					&& NULL != glBufferStorage
+					&& NULL != glMapBufferRange
+					&& NULL != glCopyBufferSubData
+					&& NULL != glFenceSync
+					&& NULL != glClientWaitSync
+					&& NULL != glDeleteSync
+					;
+
+				if (m_persistentBufferSupport)
+				{
+					m_persistentBufferSupport = m_staging.create(BGFX_CONFIG_RENDERER_OPENGL_STAGING_BUFFER_SIZE);
+					BX_WARN(m_persistentBufferSupport, "Failed to create persistently mapped staging buffer.");
+				}
+
+				m_frameInFlight = 0;
+				m_frameInFlightReady = false;
+				m_stagingOffset = 0;
+
+				m_uniformBlockSupport = true
+					&& (s_extension[Extension::ARB_uniform_buffer_object].m_supported
+						|| !!(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+						)
+					&& NULL != glGetActiveUniformBlockiv
+					&& NULL != glGetActiveUniformsiv
+					&& NULL != glUniformBlockBinding
+					&& NULL != glBindBufferRange
+					;
+
+				m_uniformBufferOffsetAlign = 256;
+
+				if (m_uniformBlockSupport)
+				{
+					GLint align = 0;
+					GL_CHECK(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align) );
+					m_uniformBufferOffsetAlign = bx::uint32_max(align, 16);
+
+					if (m_persistentBufferSupport)
+					{
+						m_uniformStreamSupport = m_uniformStream.create(BGFX_CONFIG_RENDERER_OPENGL_UNIFORM_STREAM_SIZE);
+						BX_WARN(m_uniformStreamSupport, "Failed to create persistently mapped uniform stream buffer.");
+					}
+				}
+
+				m_uniformStreamOffset = 0;
+				m_uniformStreamFrame  = 0;
+				m_uniformProgram      = NULL;
+				resetUniformBlockBindings();
+
+				if (m_persistentBufferSupport
+				&&  0 != BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_BUDGET)
+				{
+					m_textureUploadSupport = m_textureUpload.create(BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_BUDGET);
+					BX_WARN(m_textureUploadSupport, "Failed to create persistently mapped pixel unpack buffer.");
+				}
+
+				m_textureUploadOffset = 0;
+				m_textureUploadUsed   = 0;
+				m_textureUploadQueued = 0;
+
+				m_readBackAsyncSupport = true
+					&& 0 != BGFX_CONFIG_RENDERER_OPENGL_READBACK_LATENCY
+					&& !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN)
+					&& NULL != glMapBufferRange
+					&& NULL != glUnmapBuffer
+					&& NULL != glFenceSync
+					&& NULL != glClientWaitSync
+					&& NULL != glDeleteSync
+					;
+
+				m_readBackFrame = 0;
+
 				g_caps.supported |= 0
 					| (m_atocSupport               ? BGFX_CAPS_ALPHA_TO_COVERAGE      : 0)
 					| (m_conservativeRasterSupport ? BGFX_CAPS_CONSERVATIVE_RASTER    : 0)
@@ -2597,6 +2690,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		{
 			if (m_vaoSupport)
 			{
+				m_vaoCache.invalidate();
+
 				GL_CHECK(glBindVertexArray(0) );
 				GL_CHECK(glDeleteVertexArrays(1, &m_vao) );
 				m_vao = 0;
@@ -2606,6 +2701,50 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 			invalidateCache();
 
+			for (TextureUploadArray::iterator it = m_textureUploadQueue.begin(), itEnd = m_textureUploadQueue.end(); it != itEnd; ++it)
+			{
+				BX_FREE(g_allocator, it->m_mem.data);
+			}
+
+			m_textureUploadQueue.clear();
+			m_textureUploadQueued = 0;
+
+			discardReadBacks();
+
+			for (ReadBackBufferArray::iterator it = m_readBackBuffers.begin(), itEnd = m_readBackBuffers.end(); it != itEnd; ++it)
+			{
+				GL_CHECK(glDeleteBuffers(1, &it->m_id) );
+			}
+
+			m_readBackBuffers.clear();
+
+			if (m_persistentBufferSupport)
+			{
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameFence); ++ii)
+				{
+					if (NULL != m_frameFence[ii])
+					{
+						GL_CHECK(glDeleteSync(m_frameFence[ii]) );
+						m_frameFence[ii] = NULL;
+					}
+				}
+
+				if (m_uniformStreamSupport)
+				{
+					m_uniformStream.destroy();
+					m_uniformStreamSupport = false;
+				}
+
+				if (m_textureUploadSupport)
+				{
+					m_textureUpload.destroy();
+					m_textureUploadSupport = false;
+				}
+
+				m_staging.destroy();
+				m_persistentBufferSupport = false;
+			}
+
 			if (m_timerQuerySupport)
 			{
 				m_gpuTimer.destroy();
@@ -2639,6 +2778,17 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			return BGFX_RENDERER_OPENGL_NAME;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			// API side doesn't add latency with BGFX_RESET_SYNC_READ_BACK.
+			return m_readBackAsyncSupport ? BGFX_CONFIG_RENDERER_OPENGL_READBACK_LATENCY : 0;
+		}
+
+		bool isReadBackAsync() const
+		{
+			return m_readBackAsyncSupport && !m_readBackSync;
+		}
+
 		bool isDeviceRemoved() override
 		{
 			return false;
@@ -2676,6 +2826,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void destroyIndexBuffer(IndexBufferHandle _handle) override
 		{
+			invalidateVertexArrays(m_indexBuffers[_handle.idx]);
 			m_indexBuffers[_handle.idx].destroy();
 		}
 
@@ -2697,6 +2848,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void destroyVertexBuffer(VertexBufferHandle _handle) override
 		{
+			invalidateVertexArrays(m_vertexBuffers[_handle.idx]);
 			m_vertexBuffers[_handle.idx].destroy();
 		}
 
@@ -2712,6 +2864,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void destroyDynamicIndexBuffer(IndexBufferHandle _handle) override
 		{
+			invalidateVertexArrays(m_indexBuffers[_handle.idx]);
 			m_indexBuffers[_handle.idx].destroy();
 		}
 
@@ -2728,6 +2881,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void destroyDynamicVertexBuffer(VertexBufferHandle _handle) override
 		{
+			invalidateVertexArrays(m_vertexBuffers[_handle.idx]);
 			m_vertexBuffers[_handle.idx].destroy();
 		}
 
@@ -2749,6 +2903,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void destroyProgram(ProgramHandle _handle) override
 		{
+			if (m_vaoSupport)
+			{
+				m_vaoCache.invalidateWithParent(_handle.idx);
+			}
+
 			m_program[_handle.idx].destroy();
 		}
 
@@ -2764,6 +2923,37 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void updateTexture(TextureHandle _handle, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem) override
 		{
+			// Once updates are spilled, all following updates are queued too,
+			// so that they are applied in submission order.
+			if (!m_textureUploadQueue.empty()
+			||  !reserveTextureUpload(_mem->size) )
+			{
+				// When too much is spilled, spilled updates are applied at once
+				// over budget, and this update is uploaded right away.
+				if (uint64_t(m_textureUploadQueued) + _mem->size > uint64_t(BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_MAX_SPILL)*BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_BUDGET)
+				{
+					flushTextureUploads(true);
+					m_textureUploadUsed += _mem->size;
+					m_textures[_handle.idx].update(_side, _mip, _rect, _z, _depth, _pitch, _mem);
+					return;
+				}
+
+				TextureUploadGL upload;
+				upload.m_handle   = _handle;
+				upload.m_side     = _side;
+				upload.m_mip      = _mip;
+				upload.m_rect     = _rect;
+				upload.m_z        = _z;
+				upload.m_depth    = _depth;
+				upload.m_pitch    = _pitch;
+				upload.m_mem.size = _mem->size;
+				upload.m_mem.data = (uint8_t*)BX_ALLOC(g_allocator, _mem->size);
+				bx::memCopy(upload.m_mem.data, _mem->data, _mem->size);
+				m_textureUploadQueue.push_back(upload);
+				m_textureUploadQueued += _mem->size;
+				return;
+			}
+
 			m_textures[_handle.idx].update(_side, _mip, _rect, _z, _depth, _pitch, _mem);
 		}
 
@@ -2787,6 +2977,25 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 						, _data
 						) );
 				}
+				else if (isReadBackAsync()
+				&&       GL_TEXTURE_2D == texture.m_target)
+				{
+					const uint32_t bpp    = bimg::getBitsPerPixel(bimg::TextureFormat::Enum(texture.m_textureFormat) );
+					const uint32_t width  = bx::uint32_max(1, texture.m_width  >> _mip);
+					const uint32_t height = bx::uint32_max(1, texture.m_height >> _mip);
+
+					// Rows are padded to default pack alignment.
+					const uint32_t size = bx::strideAlign(width*bpp/8, 4)*height;
+
+					ReadBackBufferGL buffer = beginReadBack(size);
+					GL_CHECK(glGetTexImage(texture.m_target
+						, _mip
+						, texture.m_fmt
+						, texture.m_type
+						, NULL
+						) );
+					endReadBack(buffer, size, _data);
+				}
 				else
 				{
 					GL_CHECK(glGetTexImage(texture.m_target
@@ -2828,6 +3037,16 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 					if (GL_FRAMEBUFFER_COMPLETE == glCheckFramebufferStatus(GL_FRAMEBUFFER) )
 					{
+						const uint32_t size = texture.m_width*texture.m_height*4;
+
+						const bool async = isReadBackAsync();
+
+						ReadBackBufferGL buffer = { 0, 0 };
+						if (async)
+						{
+							buffer = beginReadBack(size);
+						}
+
 						GL_CHECK(glReadPixels(
 							  0
 							, 0
@@ -2835,8 +3054,13 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							, texture.m_height
 							, m_readPixelsFmt
 							, GL_UNSIGNED_BYTE
-							, _data
+							, async ? NULL : _data
 							) );
+
+						if (async)
+						{
+							endReadBack(buffer, size, _data);
+						}
 					}
 
 					frameBuffer.destroy();
@@ -2846,6 +3070,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) override
 		{
+			discardTextureUploads(_handle);
+
 			TextureGL& texture = m_textures[_handle.idx];
 
 			uint32_t size = sizeof(uint32_t) + sizeof(TextureCreate);
@@ -2884,6 +3110,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void destroyTexture(TextureHandle _handle) override
 		{
+			discardTextureUploads(_handle);
 			m_textures[_handle.idx].destroy();
 		}
 
@@ -2956,6 +3183,30 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			m_glctx.makeCurrent(swapChain);
 
 			uint32_t length = width*height*4;
+
+			if (isReadBackAsync() )
+			{
+				ReadBackBufferGL buffer = beginReadBack(length);
+				GL_CHECK(glReadPixels(0
+					, 0
+					, width
+					, height
+					, m_readPixelsFmt
+					, GL_UNSIGNED_BYTE
+					, NULL
+					) );
+				endReadBack(buffer, length, NULL, _filePath, width, height);
+
+				// Fence is waited on from main context, and it must be flushed
+				// in context that inserted it.
+				if (NULL != swapChain)
+				{
+					GL_CHECK(glFlush() );
+				}
+
+				return;
+			}
+
 			uint8_t* data = (uint8_t*)BX_ALLOC(g_allocator, length);
 
 			GL_CHECK(glReadPixels(0
@@ -2991,9 +3242,15 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				);
 		}
 
-		void updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
+		bool updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
 		{
+			if (0 == bx::memCmp(m_uniforms[_loc], _data, _size) )
+			{
+				return false;
+			}
+
 			bx::memCopy(m_uniforms[_loc], _data, _size);
+			return true;
 		}
 
 		void invalidateOcclusionQuery(OcclusionQueryHandle _handle) override
@@ -3127,6 +3384,17 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void updateResolution(const Resolution& _resolution)
 		{
+			const bool readBackSync = !!(_resolution.reset & BGFX_RESET_SYNC_READ_BACK);
+			if (readBackSync
+			&&  !m_readBackSync)
+			{
+				// Read backs requested before switching are resolved now,
+				// earlier than frame returned for them.
+				resolveReadBacks(true);
+			}
+
+			m_readBackSync = readBackSync;
+
 			m_maxAnisotropy = !!(_resolution.reset & BGFX_RESET_MAXANISOTROPY)
 				? m_maxAnisotropyDefault
 				: 0.0f
@@ -3148,6 +3416,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				| BGFX_RESET_MAXANISOTROPY
 				| BGFX_RESET_DEPTH_CLAMP
 				| BGFX_RESET_SUSPEND
+				| BGFX_RESET_SYNC_READ_BACK
 				);
 
 			if (m_resolution.width            !=  _resolution.width
@@ -3181,6 +3450,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void setShaderUniform4f(uint8_t /*_flags*/, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
+			if (0 != (kUniformBlockFlag & _regIndex) )
+			{
+				writeUniformBlock(_regIndex, UniformType::Vec4, _val, _numRegs);
+				return;
+			}
+
 			GL_CHECK(glUniform4fv(_regIndex
 				, _numRegs
 				, (const GLfloat*)_val
@@ -3189,6 +3464,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void setShaderUniform4x4f(uint8_t /*_flags*/, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
+			if (0 != (kUniformBlockFlag & _regIndex) )
+			{
+				writeUniformBlock(_regIndex, UniformType::Mat4, _val, _numRegs);
+				return;
+			}
+
 			GL_CHECK(glUniformMatrix4fv(_regIndex
 				, _numRegs
 				, GL_FALSE
@@ -3297,85 +3578,793 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					, glCheckFramebufferStatus(GL_FRAMEBUFFER)
 					);
 
-				GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_msaaBackBufferFbo) );
+				GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_msaaBackBufferFbo) );
+			}
+		}
+
+		void destroyMsaaFbo()
+		{
+			if (m_backBufferFbo != m_msaaBackBufferFbo // iOS
+			&&  0 != m_msaaBackBufferFbo)
+			{
+				GL_CHECK(glDeleteFramebuffers(1, &m_msaaBackBufferFbo) );
+				m_msaaBackBufferFbo = 0;
+
+				if (0 != m_msaaBackBufferRbos[0])
+				{
+					GL_CHECK(glDeleteRenderbuffers(BX_COUNTOF(m_msaaBackBufferRbos), m_msaaBackBufferRbos) );
+					m_msaaBackBufferRbos[0] = 0;
+					m_msaaBackBufferRbos[1] = 0;
+				}
+			}
+		}
+
+		void blitMsaaFbo()
+		{
+			if (m_backBufferFbo != m_msaaBackBufferFbo // iOS
+			&&  0 != m_msaaBackBufferFbo)
+			{
+				GL_CHECK(glDisable(GL_SCISSOR_TEST) );
+				GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_backBufferFbo) );
+				GL_CHECK(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_msaaBackBufferFbo) );
+				GL_CHECK(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0) );
+				uint32_t width  = m_resolution.width;
+				uint32_t height = m_resolution.height;
+				GLenum filter = BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) || BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES < 30)
+					? GL_NEAREST
+					: GL_LINEAR
+					;
+				GL_CHECK(glBlitFramebuffer(0
+					, 0
+					, width
+					, height
+					, 0
+					, 0
+					, width
+					, height
+					, GL_COLOR_BUFFER_BIT
+					, filter
+					) );
+				GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_backBufferFbo) );
+			}
+		}
+
+		void setRenderContextSize(uint32_t _width, uint32_t _height, uint32_t _flags = 0)
+		{
+			if (_width  != 0
+			||  _height != 0)
+			{
+				if (!m_glctx.isValid() )
+				{
+					m_glctx.create(_width, _height);
+
+#if BX_PLATFORM_IOS
+					// iOS: need to figure out how to deal with FBO created by context.
+					m_backBufferFbo = m_msaaBackBufferFbo = m_glctx.getFbo();
+#endif // BX_PLATFORM_IOS
+				}
+				else
+				{
+					destroyMsaaFbo();
+
+					m_glctx.resize(_width, _height, _flags);
+
+					uint32_t msaa = (_flags&BGFX_RESET_MSAA_MASK)>>BGFX_RESET_MSAA_SHIFT;
+					msaa = bx::uint32_min(m_maxMsaa, msaa == 0 ? 0 : 1<<msaa);
+
+					createMsaaFbo(_width, _height, msaa);
+				}
+			}
+
+			m_flip = true;
+		}
+
+		uint8_t waitFrameInFlight()
+		{
+			if (!m_frameInFlightReady)
+			{
+				GLsync fence = m_frameFence[m_frameInFlight];
+				if (NULL != fence)
+				{
+					BGFX_PROFILER_SCOPE("bgfx/Wait frame in flight", kColorFrame);
+
+					GLenum result;
+					do
+					{
+						result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_C(1000000) );
+					}
+					while (GL_TIMEOUT_EXPIRED == result);
+
+					GL_CHECK(glDeleteSync(fence) );
+					m_frameFence[m_frameInFlight] = NULL;
+				}
+
+				m_frameInFlightReady = true;
+			}
+
+			return m_frameInFlight;
+		}
+
+		void fenceFrameInFlight()
+		{
+			if (m_persistentBufferSupport)
+			{
+				// Fence inserted now is signaled after fence of the same frame
+				// in flight that wasn't waited on, so it can be replaced.
+				if (NULL != m_frameFence[m_frameInFlight])
+				{
+					GL_CHECK(glDeleteSync(m_frameFence[m_frameInFlight]) );
+				}
+
+				m_frameFence[m_frameInFlight] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+				m_frameInFlight       = (m_frameInFlight + 1) % BGFX_CONFIG_RENDERER_OPENGL_FRAMES_IN_FLIGHT;
+				m_frameInFlightReady  = false;
+				m_stagingOffset       = 0;
+				m_textureUploadOffset = 0;
+			}
+		}
+
+		bool updateStaged(GLuint _id, uint32_t _offset, uint32_t _size, const void* _data)
+		{
+			if (!m_persistentBufferSupport
+			||  m_stagingOffset + _size > m_staging.m_size)
+			{
+				return false;
+			}
+
+			const uint8_t frame = waitFrameInFlight();
+			bx::memCopy(&m_staging.m_data[frame][m_stagingOffset], _data, _size);
+
+			GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER,  m_staging.m_id[frame]) );
+			GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, _id) );
+			GL_CHECK(glCopyBufferSubData(GL_COPY_READ_BUFFER
+				, GL_COPY_WRITE_BUFFER
+				, m_stagingOffset
+				, _offset
+				, _size
+				) );
+			GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER,  0) );
+			GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, 0) );
+
+			m_stagingOffset += bx::strideAlign(_size, 16);
+
+			return true;
+		}
+
+		bool updateTransient(PersistentBufferGL*& _persistent, GLuint& _id, uint32_t _bufferSize, uint32_t _size, const void* _data)
+		{
+			if (!m_persistentBufferSupport)
+			{
+				return false;
+			}
+
+			if (NULL == _persistent)
+			{
+				PersistentBufferGL* persistent = BX_NEW(g_allocator, PersistentBufferGL);
+				if (!persistent->create(_bufferSize) )
+				{
+					BX_TRACE("Failed to create persistently mapped buffer, falling back to buffer orphaning.");
+					BX_DELETE(g_allocator, persistent);
+					return false;
+				}
+
+				// Buffer created with create is replaced by persistent storage.
+				invalidateVertexArrays(_id);
+				GL_CHECK(glDeleteBuffers(1, &_id) );
+				_persistent = persistent;
+			}
+
+			const uint8_t frame = waitFrameInFlight();
+			bx::memCopy(_persistent->m_data[frame], _data, _size);
+			_id = _persistent->m_id[frame];
+
+			return true;
+		}
+
+		bool reserveTextureUpload(uint32_t _size)
+		{
+			// Update larger than budget is uploaded alone in its frame.
+			if (0 != BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_BUDGET
+			&&  0 != m_textureUploadUsed
+			&&  m_textureUploadUsed + _size > BGFX_CONFIG_RENDERER_OPENGL_TEXTURE_UPLOAD_BUDGET)
+			{
+				return false;
+			}
+
+			m_textureUploadUsed += _size;
+
+			return true;
+		}
+
+		bool stageTextureUpload(const void* _data, uint32_t _size, const void*& _offset)
+		{
+			const uint32_t offset = bx::strideAlign(m_textureUploadOffset, 16);
+
+			if (!m_textureUploadSupport
+			||  offset + _size > m_textureUpload.m_size)
+			{
+				return false;
+			}
+
+			const uint8_t frame = waitFrameInFlight();
+			bx::memCopy(&m_textureUpload.m_data[frame][offset], _data, _size);
+
+			GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_textureUpload.m_id[frame]) );
+			_offset = (const void*)uintptr_t(offset);
+
+			m_textureUploadOffset = offset + _size;
+
+			return true;
+		}
+
+		void applyTextureUpload(uint32_t _idx)
+		{
+			TextureUploadGL& upload = m_textureUploadQueue[_idx];
+
+			m_textures[upload.m_handle.idx].update(upload.m_side
+				, upload.m_mip
+				, upload.m_rect
+				, upload.m_z
+				, upload.m_depth
+				, upload.m_pitch
+				, &upload.m_mem
+				);
+
+			m_textureUploadQueued -= upload.m_mem.size;
+			BX_FREE(g_allocator, upload.m_mem.data);
+		}
+
+		void flushTextureUploads(bool _overBudget = false)
+		{
+			uint32_t num = 0;
+
+			for (uint32_t size = uint32_t(m_textureUploadQueue.size() ); num < size; ++num)
+			{
+				const uint32_t uploadSize = m_textureUploadQueue[num].m_mem.size;
+
+				if (!reserveTextureUpload(uploadSize) )
+				{
+					if (!_overBudget)
+					{
+						break;
+					}
+
+					m_textureUploadUsed += uploadSize;
+				}
+
+				applyTextureUpload(num);
+			}
+
+			m_textureUploadQueue.erase(m_textureUploadQueue.begin(), m_textureUploadQueue.begin() + num);
+		}
+
+		// Spilled updates are applied when next frame is submitted, after this
+		// frame's blits, compute and draw calls wrote to textures. Spilled
+		// updates of textures written by this frame are applied now, over
+		// budget, so that they don't overwrite what this frame writes.
+		void flushWrittenTextureUploads(const Frame* _render)
+		{
+			uint32_t written[(BGFX_CONFIG_MAX_TEXTURES+31)/32];
+			bx::memSet(written, 0, sizeof(written) );
+
+			for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
+			{
+				const FrameBufferHandle fbh = _render->m_view[ii].m_fbh;
+				if (isValid(fbh) )
+				{
+					const FrameBufferGL& frameBuffer = m_frameBuffers[fbh.idx];
+					for (uint32_t jj = 0; jj < frameBuffer.m_numTh; ++jj)
+					{
+						const TextureHandle th = frameBuffer.m_attachment[jj].handle;
+						if (isValid(th) )
+						{
+							written[th.idx/32] |= UINT32_C(1)<<(th.idx%32);
+						}
+					}
+				}
+			}
+
+			for (uint32_t ii = 0, num = _render->m_numBlitItems; ii < num; ++ii)
+			{
+				const TextureHandle th = _render->m_blitItem[ii].m_dst;
+				written[th.idx/32] |= UINT32_C(1)<<(th.idx%32);
+			}
+
+			for (uint32_t ii = 0, num = _render->m_numRenderBinds; ii < num; ++ii)
+			{
+				const RenderBind& renderBind = _render->m_renderBind[ii];
+				for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+				{
+					const Binding& bind = renderBind.m_bind[stage];
+					if (Binding::Image  == bind.m_type
+					&&  Access::Read    != bind.m_access
+					&&  kInvalidHandle  != bind.m_idx)
+					{
+						written[bind.m_idx/32] |= UINT32_C(1)<<(bind.m_idx%32);
+					}
+				}
+			}
+
+			for (uint32_t ii = 0; ii < uint32_t(m_textureUploadQueue.size() );)
+			{
+				const uint16_t idx = m_textureUploadQueue[ii].m_handle.idx;
+				if (0 != (written[idx/32] & (UINT32_C(1)<<(idx%32) ) ) )
+				{
+					m_textureUploadUsed += m_textureUploadQueue[ii].m_mem.size;
+					applyTextureUpload(ii);
+					m_textureUploadQueue.erase(m_textureUploadQueue.begin() + ii);
+				}
+				else
+				{
+					++ii;
+				}
+			}
+		}
+
+		void discardTextureUploads(TextureHandle _handle)
+		{
+			for (TextureUploadArray::iterator it = m_textureUploadQueue.begin(); it != m_textureUploadQueue.end();)
+			{
+				if (it->m_handle.idx == _handle.idx)
+				{
+					m_textureUploadQueued -= it->m_mem.size;
+					BX_FREE(g_allocator, it->m_mem.data);
+					it = m_textureUploadQueue.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		ReadBackBufferGL beginReadBack(uint32_t _size)
+		{
+			ReadBackBufferGL buffer;
+
+			// Smallest pooled buffer that fits, so that small read backs
+			// don't take buffers large enough for screen shots.
+			ReadBackBufferArray::iterator best = m_readBackBuffers.end();
+			for (ReadBackBufferArray::iterator it = m_readBackBuffers.begin(), itEnd = m_readBackBuffers.end(); it != itEnd; ++it)
+			{
+				if (it->m_size >= _size
+				&& (best == itEnd || it->m_size < best->m_size) )
+				{
+					best = it;
+
+					if (best->m_size == _size)
+					{
+						break;
+					}
+				}
+			}
+
+			if (best != m_readBackBuffers.end() )
+			{
+				buffer = *best;
+				m_readBackBuffers.erase(best);
+				GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.m_id) );
+			}
+			else
+			{
+				buffer.m_size = _size;
+				GL_CHECK(glGenBuffers(1, &buffer.m_id) );
+				GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer.m_id) );
+				GL_CHECK(glBufferData(GL_PIXEL_PACK_BUFFER, _size, NULL, GL_STREAM_READ) );
+			}
+
+			// Pixels read while pack buffer is bound are written to it, at
+			// offset passed instead of client memory pointer.
+			return buffer;
+		}
+
+		void endReadBack(const ReadBackBufferGL& _buffer, uint32_t _size, void* _data, const char* _filePath = NULL, uint32_t _width = 0, uint32_t _height = 0)
+		{
+			GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+
+			ReadBackGL readBack;
+			readBack.m_buffer   = _buffer;
+			readBack.m_fence    = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			readBack.m_data     = _data;
+			readBack.m_filePath = NULL;
+			readBack.m_size     = _size;
+			readBack.m_width    = _width;
+			readBack.m_height   = _height;
+			readBack.m_frame    = m_readBackFrame + BGFX_CONFIG_RENDERER_OPENGL_READBACK_LATENCY - 1;
+
+			if (NULL != _filePath)
+			{
+				const uint32_t len = bx::strLen(_filePath) + 1;
+				readBack.m_filePath = (char*)BX_ALLOC(g_allocator, len);
+				bx::memCopy(readBack.m_filePath, _filePath, len);
+			}
+
+			m_readBack.push_back(readBack);
+		}
+
+		void resolveReadBacks(bool _all)
+		{
+			for (ReadBackArray::iterator it = m_readBack.begin(); it != m_readBack.end();)
+			{
+				ReadBackGL& readBack = *it;
+
+				if (!_all
+				&&  readBack.m_frame > m_readBackFrame)
+				{
+					++it;
+					continue;
+				}
+
+				// Result is due in this frame, or renderer is shutting down.
+				// Frames in flight are limited, so GPU is usually done with it,
+				// and this doesn't wait.
+				GLenum result;
+				do
+				{
+					result = glClientWaitSync(readBack.m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_C(1000000) );
+				}
+				while (GL_TIMEOUT_EXPIRED == result);
+
+				GL_CHECK(glDeleteSync(readBack.m_fence) );
+
+				GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, readBack.m_buffer.m_id) );
+				const uint8_t* data = (const uint8_t*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readBack.m_size, GL_MAP_READ_BIT);
+
+				if (NULL == data)
+				{
+					BX_TRACE("Failed to map pixel pack buffer.");
+				}
+				else if (NULL == readBack.m_filePath)
+				{
+					bx::memCopy(readBack.m_data, data, readBack.m_size);
+				}
+				else
+				{
+					const uint32_t pitch = readBack.m_width*4;
+					uint8_t* temp = (uint8_t*)BX_ALLOC(g_allocator, readBack.m_size);
+
+					if (GL_RGBA == m_readPixelsFmt)
+					{
+						bimg::imageSwizzleBgra8(temp, pitch, readBack.m_width, readBack.m_height, data, pitch);
+					}
+					else
+					{
+						bx::memCopy(temp, data, readBack.m_size);
+					}
+
+					g_callback->screenShot(readBack.m_filePath
+						, readBack.m_width
+						, readBack.m_height
+						, pitch
+						, temp
+						, readBack.m_size
+						, true
+						);
+					BX_FREE(g_allocator, temp);
+				}
+
+				if (NULL != data)
+				{
+					GL_CHECK(glUnmapBuffer(GL_PIXEL_PACK_BUFFER) );
+				}
+
+				GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+
+				m_readBackBuffers.push_back(readBack.m_buffer);
+				BX_FREE(g_allocator, readBack.m_filePath);
+
+				it = m_readBack.erase(it);
+			}
+		}
+
+		void discardReadBacks()
+		{
+			// Results are not written into user memory, which might be already
+			// released when renderer is shutting down.
+			for (ReadBackArray::iterator it = m_readBack.begin(), itEnd = m_readBack.end(); it != itEnd; ++it)
+			{
+				GL_CHECK(glDeleteSync(it->m_fence) );
+				m_readBackBuffers.push_back(it->m_buffer);
+				BX_FREE(g_allocator, it->m_filePath);
+			}
+
+			m_readBack.clear();
+		}
+
+		void resetUniformBlockBindings()
+		{
+			bx::memSet(m_uniformBlockBinding, 0, sizeof(m_uniformBlockBinding) );
+		}
+
+		void writeUniformBlock(UniformBlockGL& _block, uint32_t _offset, const void* _data, uint32_t _size)
+		{
+			// Uniform array in shader can be shorter than uniform data.
+			_offset = bx::min(_offset, _block.m_size);
+			_size   = bx::min(_size,   _block.m_size - _offset);
+
+			uint8_t* dst = &_block.m_data[_offset];
+			if (0 != bx::memCmp(dst, _data, _size) )
+			{
+				bx::memCopy(dst, _data, _size);
+				_block.m_dirty = true;
+			}
+		}
+
+		void writeUniformBlock(uint32_t _loc, UniformType::Enum _type, const void* _data, uint32_t _num)
+		{
+			BX_CHECK(NULL != m_uniformProgram, "Uniform block written without program.");
+
+			UniformBlockGL& block = m_uniformProgram->m_uniformBlock[(_loc & kUniformBlockSlotMask) >> kUniformBlockSlotShift];
+			const uint32_t offset = _loc & kUniformBlockOffsetMask;
+
+			switch (_type)
+			{
+			case UniformType::Vec4:
+				writeUniformBlock(block, offset, _data, _num*16);
+				break;
+
+			case UniformType::Mat4:
+				writeUniformBlock(block, offset, _data, _num*64);
+				break;
+
+			case UniformType::Mat3:
+				{
+					// std140 pads mat3 columns to vec4.
+					const float* src = (const float*)_data;
+
+					for (uint32_t ii = 0; ii < _num; ++ii, src += 9)
+					{
+						const float mtx[12] =
+						{
+							src[0], src[1], src[2], 0.0f,
+							src[3], src[4], src[5], 0.0f,
+							src[6], src[7], src[8], 0.0f,
+						};
+
+						writeUniformBlock(block, offset + ii*uint32_t(sizeof(mtx) ), mtx, sizeof(mtx) );
+					}
+				}
+				break;
+
+			default:
+				BX_CHECK(false, "Uniform type %d can't be in uniform block.", _type);
+				break;
+			}
+		}
+
+		void commitUniformBlocks(ProgramGL& _program)
+		{
+			for (uint32_t ii = 0, num = _program.m_numUniformBlocks; ii < num; ++ii)
+			{
+				UniformBlockGL& block = _program.m_uniformBlock[ii];
+
+				// Ranges in uniform stream are valid only in frame they were
+				// written in.
+				if (block.m_dirty
+				|| (UINT32_MAX != block.m_frame && m_uniformStreamFrame != block.m_frame) )
+				{
+					const uint32_t offset = bx::strideAlign(m_uniformStreamOffset, m_uniformBufferOffsetAlign);
+
+					if (m_uniformStreamSupport
+					&&  offset + block.m_size <= m_uniformStream.m_size)
+					{
+						const uint8_t frame = waitFrameInFlight();
+						bx::memCopy(&m_uniformStream.m_data[frame][offset], block.m_data, block.m_size);
+
+						block.m_bufferId = m_uniformStream.m_id[frame];
+						block.m_offset   = offset;
+						block.m_frame    = m_uniformStreamFrame;
+
+						m_uniformStreamOffset = offset + block.m_size;
+					}
+					else
+					{
+						if (0 == block.m_id)
+						{
+							GL_CHECK(glGenBuffers(1, &block.m_id) );
+							GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, block.m_id) );
+							GL_CHECK(glBufferData(GL_UNIFORM_BUFFER, block.m_size, NULL, GL_DYNAMIC_DRAW) );
+						}
+						else
+						{
+							GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, block.m_id) );
+						}
+
+						GL_CHECK(glBufferSubData(GL_UNIFORM_BUFFER, 0, block.m_size, block.m_data) );
+						GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, 0) );
+
+						block.m_bufferId = block.m_id;
+						block.m_offset   = 0;
+						block.m_frame    = UINT32_MAX;
+					}
+
+					block.m_dirty = false;
+				}
+
+				UniformBlockBinding& binding = m_uniformBlockBinding[ii];
+				if (binding.m_id     != block.m_bufferId
+				||  binding.m_offset != block.m_offset
+				||  binding.m_size   != block.m_size)
+				{
+					binding.m_id     = block.m_bufferId;
+					binding.m_offset = block.m_offset;
+					binding.m_size   = block.m_size;
+
+					GL_CHECK(glBindBufferRange(GL_UNIFORM_BUFFER
+						, ii
+						, block.m_bufferId
+						, block.m_offset
+						, block.m_size
+						) );
+				}
+			}
+		}
+
+		// Buffer names of deleted buffers can be reused, and vertex array
+		// objects referencing them would keep deleted buffer alive. Only
+		// vertex array objects referencing deleted buffer are dropped.
+		void invalidateVertexArrays(GLuint _id)
+		{
+			if (m_vaoSupport
+			&&  0 != _id)
+			{
+				m_vaoCache.invalidateReferencing(_id);
+			}
+		}
+
+		template<typename BufferT>
+		void invalidateVertexArrays(const BufferT& _buffer)
+		{
+			if (NULL == _buffer.m_persistent)
+			{
+				invalidateVertexArrays(_buffer.m_id);
+			}
+			else
+			{
+				for (uint32_t ii = 0; ii < BX_COUNTOF(_buffer.m_persistent->m_id); ++ii)
+				{
+					invalidateVertexArrays(_buffer.m_persistent->m_id[ii]);
+				}
+			}
+		}
+
+		void bindVertexArray(ProgramHandle _program, const RenderDraw& _draw)
+		{
+			ProgramGL& program = m_program[_program.idx];
+
+			const GLuint indexBuffer = isValid(_draw.m_indexBuffer)
+				? m_indexBuffers[_draw.m_indexBuffer.idx].m_id
+				: 0
+				;
+
+			const bool hasStreams  = 0 != _draw.m_streamMask && UINT8_MAX != _draw.m_streamMask;
+			const bool hasInstance = 0 != _draw.m_streamMask && isValid(_draw.m_instanceDataBuffer);
+
+			bx::HashMurmur2A murmur;
+			murmur.begin();
+			murmur.add(_program.idx);
+			murmur.add(indexBuffer);
+			murmur.add(_draw.m_streamMask);
+
+			if (hasStreams)
+			{
+				for (uint32_t idx = 0, streamMask = _draw.m_streamMask
+					; 0 != streamMask
+					; streamMask >>= 1, idx += 1
+					)
+				{
+					const uint32_t ntz = bx::uint32_cnttz(streamMask);
+					streamMask >>= ntz;
+					idx         += ntz;
+
+					const VertexBufferGL& vb = m_vertexBuffers[_draw.m_stream[idx].m_handle.idx];
+					const uint16_t decl = isValid(_draw.m_stream[idx].m_decl)
+						? _draw.m_stream[idx].m_decl.idx
+						: vb.m_decl.idx;
+					murmur.add(vb.m_id);
+					murmur.add(m_vertexDecls[decl].m_hash);
+				}
+			}
+
+			if (hasInstance)
+			{
+				murmur.add(m_vertexBuffers[_draw.m_instanceDataBuffer.idx].m_id);
+				murmur.add(_draw.m_instanceDataStride);
 			}
-		}
 
-		void destroyMsaaFbo()
-		{
-			if (m_backBufferFbo != m_msaaBackBufferFbo // iOS
-			&&  0 != m_msaaBackBufferFbo)
+			const uint32_t hash = murmur.end();
+
+			VertexArrayGL* vao = m_vaoCache.find(hash);
+			if (NULL == vao)
 			{
-				GL_CHECK(glDeleteFramebuffers(1, &m_msaaBackBufferFbo) );
-				m_msaaBackBufferFbo = 0;
+				VertexArrayGL vertexArray;
+				GL_CHECK(glGenVertexArrays(1, &vertexArray.m_id) );
+				bx::memSet(vertexArray.m_startVertex, 0xff, sizeof(vertexArray.m_startVertex) );
+				vertexArray.m_instanceDataOffset = UINT32_MAX;
+				vertexArray.m_numBuffers = 0;
+				vertexArray.m_buffer[vertexArray.m_numBuffers++] = indexBuffer;
+
+				if (hasStreams)
+				{
+					for (uint32_t idx = 0, streamMask = _draw.m_streamMask
+						; 0 != streamMask
+						; streamMask >>= 1, idx += 1
+						)
+					{
+						const uint32_t ntz = bx::uint32_cnttz(streamMask);
+						streamMask >>= ntz;
+						idx         += ntz;
 
-				if (0 != m_msaaBackBufferRbos[0])
+						vertexArray.m_buffer[vertexArray.m_numBuffers++] = m_vertexBuffers[_draw.m_stream[idx].m_handle.idx].m_id;
+					}
+				}
+
+				if (hasInstance)
 				{
-					GL_CHECK(glDeleteRenderbuffers(BX_COUNTOF(m_msaaBackBufferRbos), m_msaaBackBufferRbos) );
-					m_msaaBackBufferRbos[0] = 0;
-					m_msaaBackBufferRbos[1] = 0;
+					vertexArray.m_buffer[vertexArray.m_numBuffers++] = m_vertexBuffers[_draw.m_instanceDataBuffer.idx].m_id;
 				}
-			}
-		}
 
-		void blitMsaaFbo()
-		{
-			if (m_backBufferFbo != m_msaaBackBufferFbo // iOS
-			&&  0 != m_msaaBackBufferFbo)
+				vao = m_vaoCache.add(hash, vertexArray, _program.idx);
+
+				GL_CHECK(glBindVertexArray(vao->m_id) );
+				GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer) );
+			}
+			else
 			{
-				GL_CHECK(glDisable(GL_SCISSOR_TEST) );
-				GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_backBufferFbo) );
-				GL_CHECK(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_msaaBackBufferFbo) );
-				GL_CHECK(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0) );
-				uint32_t width  = m_resolution.width;
-				uint32_t height = m_resolution.height;
-				GLenum filter = BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) || BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGLES < 30)
-					? GL_NEAREST
-					: GL_LINEAR
-					;
-				GL_CHECK(glBlitFramebuffer(0
-					, 0
-					, width
-					, height
-					, 0
-					, 0
-					, width
-					, height
-					, GL_COLOR_BUFFER_BIT
-					, filter
-					) );
-				GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_backBufferFbo) );
+				GL_CHECK(glBindVertexArray(vao->m_id) );
 			}
-		}
 
-		void setRenderContextSize(uint32_t _width, uint32_t _height, uint32_t _flags = 0)
-		{
-			if (_width  != 0
-			||  _height != 0)
+			if (hasStreams)
 			{
-				if (!m_glctx.isValid() )
+				bool diffStartVertex = false;
+				for (uint32_t idx = 0, streamMask = _draw.m_streamMask
+					; 0 != streamMask
+					; streamMask >>= 1, idx += 1
+					)
 				{
-					m_glctx.create(_width, _height);
+					const uint32_t ntz = bx::uint32_cnttz(streamMask);
+					streamMask >>= ntz;
+					idx         += ntz;
 
-#if BX_PLATFORM_IOS
-					// iOS: need to figure out how to deal with FBO created by context.
-					m_backBufferFbo = m_msaaBackBufferFbo = m_glctx.getFbo();
-#endif // BX_PLATFORM_IOS
+					diffStartVertex |= vao->m_startVertex[idx] != _draw.m_stream[idx].m_startVertex;
 				}
-				else
-				{
-					destroyMsaaFbo();
 
-					m_glctx.resize(_width, _height, _flags);
+				if (diffStartVertex)
+				{
+					program.bindAttributesBegin();
 
-					uint32_t msaa = (_flags&BGFX_RESET_MSAA_MASK)>>BGFX_RESET_MSAA_SHIFT;
-					msaa = bx::uint32_min(m_maxMsaa, msaa == 0 ? 0 : 1<<msaa);
+					for (uint32_t idx = 0, streamMask = _draw.m_streamMask
+						; 0 != streamMask
+						; streamMask >>= 1, idx += 1
+						)
+					{
+						const uint32_t ntz = bx::uint32_cnttz(streamMask);
+						streamMask >>= ntz;
+						idx         += ntz;
+
+						vao->m_startVertex[idx] = _draw.m_stream[idx].m_startVertex;
+
+						const VertexBufferGL& vb = m_vertexBuffers[_draw.m_stream[idx].m_handle.idx];
+						const uint16_t decl = isValid(_draw.m_stream[idx].m_decl)
+							? _draw.m_stream[idx].m_decl.idx
+							: vb.m_decl.idx;
+						GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, vb.m_id) );
+						program.bindAttributes(m_vertexDecls[decl], _draw.m_stream[idx].m_startVertex);
+					}
 
-					createMsaaFbo(_width, _height, msaa);
+					program.bindAttributesEnd();
 				}
 			}
 
-			m_flip = true;
+			if (hasInstance
+			&&  vao->m_instanceDataOffset != _draw.m_instanceDataOffset)
+			{
+				vao->m_instanceDataOffset = _draw.m_instanceDataOffset;
+
+				GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffers[_draw.m_instanceDataBuffer.idx].m_id) );
+				program.bindInstanceData(_draw.m_instanceDataStride, _draw.m_instanceDataOffset);
+			}
 		}
 
 		void invalidateCache()
@@ -3648,6 +4637,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 				uint32_t loc = _uniformBuffer.read();
 
+				if (0 != (kUniformBlockFlag & loc) )
+				{
+					writeUniformBlock(loc, type, data, num);
+					continue;
+				}
+
 #define CASE_IMPLEMENT_UNIFORM(_uniform, _glsuffix, _dxsuffix, _type) \
 		case UniformType::_uniform: \
 				{ \
@@ -3837,7 +4832,9 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 				updateUniform(m_clearQuadColor.idx, mrtClearColor[0], numMrt * sizeof(float) * 4);
 
+				m_uniformProgram = &program;
 				commit(*program.m_constantBuffer);
+				commitUniformBlocks(program);
 
 				GL_CHECK(glDrawArrays(GL_TRIANGLE_STRIP
 					, 0
@@ -3865,6 +4862,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		OcclusionQueryGL m_occlusionQuery;
 
 		SamplerStateCache m_samplerStateCache;
+		StateCacheLru<VertexArrayGL, BGFX_CONFIG_RENDERER_OPENGL_MAX_VERTEX_ARRAYS> m_vaoCache;
 
 		TextVideoMem m_textVideoMem;
 		bool m_rtMsaa;
@@ -3895,8 +4893,61 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		bool m_atocSupport;
 		bool m_conservativeRasterSupport;
 		bool m_imageLoadStoreSupport;
+		bool m_persistentBufferSupport;
+		bool m_uniformBlockSupport;
+		bool m_uniformStreamSupport;
+		bool m_textureUploadSupport;
+		bool m_readBackAsyncSupport;
+		bool m_readBackSync;
 		bool m_flip;
 
+		PersistentBufferGL m_staging;
+		GLsync   m_frameFence[BGFX_CONFIG_RENDERER_OPENGL_FRAMES_IN_FLIGHT];
+		uint32_t m_stagingOffset;
+		uint8_t  m_frameInFlight;
+		bool     m_frameInFlightReady;
+
+		struct UniformBlockBinding
+		{
+			GLuint   m_id;
+			uint32_t m_offset;
+			uint32_t m_size;
+		};
+
+		PersistentBufferGL m_uniformStream;
+		UniformBlockBinding m_uniformBlockBinding[kMaxUniformBlocks];
+		ProgramGL* m_uniformProgram;
+		uint32_t m_uniformStreamOffset;
+		uint32_t m_uniformStreamFrame;
+		uint32_t m_uniformBufferOffsetAlign;
+
+		struct TextureUploadGL
+		{
+			TextureHandle m_handle;
+			Rect     m_rect;
+			Memory   m_mem;
+			uint16_t m_z;
+			uint16_t m_depth;
+			uint16_t m_pitch;
+			uint8_t  m_side;
+			uint8_t  m_mip;
+		};
+
+		typedef stl::vector<TextureUploadGL> TextureUploadArray;
+
+		PersistentBufferGL m_textureUpload;
+		TextureUploadArray m_textureUploadQueue;
+		uint32_t m_textureUploadOffset;
+		uint32_t m_textureUploadUsed;
+		uint32_t m_textureUploadQueued;
+
+		typedef stl::vector<ReadBackBufferGL> ReadBackBufferArray;
+		typedef stl::vector<ReadBackGL>       ReadBackArray;
+
+		ReadBackBufferArray m_readBackBuffers;
+		ReadBackArray m_readBack;
+		uint32_t m_readBackFrame;
+
 		uint64_t m_hash;
 
 		GLenum m_readPixelsFmt;
@@ -4185,6 +5236,29 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		}
 		m_numPredefined = 0;
 
+		for (uint32_t ii = 0; ii < m_numUniformBlocks; ++ii)
+		{
+			UniformBlockGL& block = m_uniformBlock[ii];
+			BX_FREE(g_allocator, block.m_data);
+
+			if (0 != block.m_id)
+			{
+				GL_CHECK(glDeleteBuffers(1, &block.m_id) );
+			}
+		}
+
+		if (0 != m_numUniformBlocks)
+		{
+			s_renderGL->resetUniformBlockBindings();
+		}
+
+		m_numUniformBlocks = 0;
+
+		if (s_renderGL->m_uniformProgram == this)
+		{
+			s_renderGL->m_uniformProgram = NULL;
+		}
+
 		if (0 != m_id)
 		{
 			GL_CHECK(glUseProgram(0) );
@@ -4265,6 +5339,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		m_numPredefined = 0;
 		m_numSamplers = 0;
+		m_numUniformBlocks = 0;
 
 		BX_TRACE("Uniforms (%d):", activeUniforms);
 		for (int32_t ii = 0; ii < activeUniforms; ++ii)
@@ -4314,6 +5389,15 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 			num = bx::uint32_max(num, 1);
 
+			GLint blockIndex  = -1;
+			GLint blockOffset = 0;
+			if (s_renderGL->m_uniformBlockSupport)
+			{
+				const GLuint index = GLuint(ii);
+				GL_CHECK(glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_BLOCK_INDEX, &blockIndex ) );
+				GL_CHECK(glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_OFFSET,      &blockOffset) );
+			}
+
 			int32_t offset = 0;
 			const bx::StringView array = bx::strFind(name, '[');
 			if (!array.isEmpty() )
@@ -4324,6 +5408,52 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				bx::fromString(&offset, bx::StringView(array.getPtr()+1, end.getPtr() ) );
 			}
 
+			// Members of uniform blocks generated by shaderc are reported as
+			// `<block name>.<uniform name>`.
+			const bx::StringView member = bx::strFind(name, '.');
+			if (0 <= blockIndex
+			&&  0 == bx::strCmp(name, "bgfx_", 5)
+			&&  !member.isEmpty() )
+			{
+				uint32_t slot = 0;
+				while (slot < m_numUniformBlocks
+				&&     m_uniformBlock[slot].m_index != GLuint(blockIndex) )
+				{
+					++slot;
+				}
+
+				if (slot == m_numUniformBlocks
+				&&  slot <  BX_COUNTOF(m_uniformBlock) )
+				{
+					GLint size = 0;
+					GL_CHECK(glGetActiveUniformBlockiv(m_id, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &size) );
+
+					UniformBlockGL& block = m_uniformBlock[slot];
+					block.m_data     = (uint8_t*)BX_ALLOC(g_allocator, size);
+					block.m_size     = uint32_t(size);
+					block.m_index    = GLuint(blockIndex);
+					block.m_id       = 0;
+					block.m_bufferId = 0;
+					block.m_offset   = 0;
+					block.m_frame    = UINT32_MAX;
+					block.m_dirty    = true;
+					bx::memSet(block.m_data, 0, size);
+
+					GL_CHECK(glUniformBlockBinding(m_id, blockIndex, slot) );
+					BX_TRACE("Uniform block #%d, index %d, size %d.", slot, blockIndex, size);
+
+					++m_numUniformBlocks;
+				}
+
+				BX_WARN(slot < m_numUniformBlocks, "Too many uniform blocks (max: %d)!", BX_COUNTOF(m_uniformBlock) );
+				if (slot < m_numUniformBlocks)
+				{
+					loc = GLint(kUniformBlockFlag | (slot<<kUniformBlockSlotShift) | uint32_t(blockOffset) );
+				}
+
+				bx::memMove(name, member.getPtr()+1, bx::strLen(member.getPtr()+1)+1);
+			}
+
 			switch (gltype)
 			{
 			case GL_SAMPLER_2D:
@@ -4580,16 +5710,152 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		}
 	}
 
+	bool PersistentBufferGL::create(uint32_t _size)
+	{
+		const GLbitfield flags = 0
+			| GL_MAP_WRITE_BIT
+			| GL_MAP_PERSISTENT_BIT
+			| GL_MAP_COHERENT_BIT
+			;
+
+		m_size = _size;
+		bx::memSet(m_data, 0, sizeof(m_data) );
+
+		GL_CHECK(glGenBuffers(BX_COUNTOF(m_id), m_id) );
+
+		bool ok = true;
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_id) && ok; ++ii)
+		{
+			// Copy target is used, so element array binding of bound VAO is
+			// not changed.
+			GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, m_id[ii]) );
+			GL_CHECK(glBufferStorage(GL_COPY_WRITE_BUFFER, _size, NULL, flags) );
+			m_data[ii] = (uint8_t*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, _size, flags);
+			ok = NULL != m_data[ii];
+		}
+
+		GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, 0) );
+
+		if (!ok)
+		{
+			destroy();
+		}
+
+		return ok;
+	}
+
+	void PersistentBufferGL::destroy()
+	{
+		// Deleting buffer unmaps it.
+		GL_CHECK(glDeleteBuffers(BX_COUNTOF(m_id), m_id) );
+		bx::memSet(m_id,   0, sizeof(m_id)   );
+		bx::memSet(m_data, 0, sizeof(m_data) );
+	}
+
+	void IndexBufferGL::update(uint32_t _offset, uint32_t _size, void* _data, bool _discard)
+	{
+		BX_CHECK(0 != m_id, "Updating invalid index buffer.");
+
+		if (_discard)
+		{
+			if (s_renderGL->updateTransient(m_persistent, m_id, m_size, _size, _data) )
+			{
+				return;
+			}
+		}
+		else if (s_renderGL->updateStaged(m_id, _offset, _size, _data) )
+		{
+			return;
+		}
+
+		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
+
+		if (_discard)
+		{
+			// Orphan buffer storage. Buffer name is kept, so vertex array
+			// objects referencing it use new storage.
+			GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER
+				, m_size
+				, NULL
+				, GL_DYNAMIC_DRAW
+				) );
+		}
+
+		GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER
+			, _offset
+			, _size
+			, _data
+			) );
+		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+	}
+
 	void IndexBufferGL::destroy()
 	{
 		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
-		GL_CHECK(glDeleteBuffers(1, &m_id) );
+
+		if (NULL != m_persistent)
+		{
+			m_persistent->destroy();
+			BX_DELETE(g_allocator, m_persistent);
+			m_persistent = NULL;
+		}
+		else
+		{
+			GL_CHECK(glDeleteBuffers(1, &m_id) );
+		}
+	}
+
+	void VertexBufferGL::update(uint32_t _offset, uint32_t _size, void* _data, bool _discard)
+	{
+		BX_CHECK(0 != m_id, "Updating invalid vertex buffer.");
+
+		if (_discard)
+		{
+			if (s_renderGL->updateTransient(m_persistent, m_id, m_size, _size, _data) )
+			{
+				return;
+			}
+		}
+		else if (s_renderGL->updateStaged(m_id, _offset, _size, _data) )
+		{
+			return;
+		}
+
+		GL_CHECK(glBindBuffer(m_target, m_id) );
+
+		if (_discard)
+		{
+			// Orphan buffer storage. Buffer name is kept, so vertex array
+			// objects referencing it use new storage.
+			GL_CHECK(glBufferData(m_target
+				, m_size
+				, NULL
+				, GL_DYNAMIC_DRAW
+				) );
+		}
+
+		GL_CHECK(glBufferSubData(m_target
+			, _offset
+			, _size
+			, _data
+			) );
+		GL_CHECK(glBindBuffer(m_target, 0) );
 	}
 
 	void VertexBufferGL::destroy()
 	{
 		GL_CHECK(glBindBuffer(m_target, 0) );
-		GL_CHECK(glDeleteBuffers(1, &m_id) );
+
+		if (NULL != m_persistent)
+		{
+			m_persistent->destroy();
+			BX_DELETE(g_allocator, m_persistent);
+			m_persistent = NULL;
+		}
+		else
+		{
+			GL_CHECK(glDeleteBuffers(1, &m_id) );
+		}
 	}
 
 	bool TextureGL::init(GLenum _target, uint32_t _width, uint32_t _height, uint32_t _depth, uint8_t _numMips, uint64_t _flags)
@@ -5025,6 +6291,15 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		const uint32_t width  = _rect.m_width;
 		const uint32_t height = _rect.m_height;
 
+		// Data used as is is copied to pixel unpack buffer, and texture is
+		// updated from it without waiting for driver to copy client memory.
+		const void* staged = NULL;
+		const bool pbo = true
+			&& !convert
+			&& unpackRowLength
+			&& s_renderGL->stageTextureUpload(_mem->data, _mem->size, staged)
+			;
+
 		uint8_t* temp = NULL;
 		if (convert
 		||  !unpackRowLength)
@@ -5038,7 +6313,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		if (compressed)
 		{
-			const uint8_t* data = _mem->data;
+			const uint8_t* data = pbo ? (const uint8_t*)staged : _mem->data;
 
 			if (!unpackRowLength)
 			{
@@ -5061,7 +6336,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		}
 		else
 		{
-			const uint8_t* data = _mem->data;
+			const uint8_t* data = pbo ? (const uint8_t*)staged : _mem->data;
 
 			if (convert)
 			{
@@ -5098,6 +6373,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			GL_CHECK(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0) );
 		}
 
+		if (pbo)
+		{
+			GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0) );
+		}
+
 		if (NULL != temp)
 		{
 			BX_FREE(g_allocator, temp);
@@ -6360,6 +7640,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		if (1 < m_numWindows
 		&&  m_vaoSupport)
 		{
+			// Vertex array objects are not shared between contexts.
+			m_vaoCache.invalidate();
 			m_vaoSupport = false;
 			GL_CHECK(glBindVertexArray(0) );
 			GL_CHECK(glDeleteVertexArrays(1, &m_vao) );
@@ -6368,6 +7650,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		m_glctx.makeCurrent(NULL);
 
+		if (!m_readBack.empty() )
+		{
+			BGFX_PROFILER_SCOPE("bgfx/Resolve read backs", kColorResource);
+			resolveReadBacks(false);
+		}
+
 		const GLuint defaultVao = m_vao;
 		if (0 != defaultVao)
 		{
@@ -6379,6 +7667,20 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		updateResolution(_render->m_resolution);
 
+		if (!m_textureUploadQueue.empty() )
+		{
+			BGFX_PROFILER_SCOPE("bgfx/Spilled texture uploads", kColorResource);
+			const int64_t uploadBegin = bx::getHPCounter();
+			flushTextureUploads();
+
+			if (!m_textureUploadQueue.empty() )
+			{
+				flushWrittenTextureUploads(_render);
+			}
+
+			_render->m_phaseTime[Phase::TextureUpdate] += bx::getHPCounter() - uploadBegin;
+		}
+
 		int64_t timeBegin = bx::getHPCounter();
 		int64_t captureElapsed = 0;
 
@@ -6390,6 +7692,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			frameQueryIdx = m_gpuTimer.begin(BGFX_CONFIG_MAX_VIEWS);
 		}
 
+		_render->sort();
+
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
@@ -6404,8 +7708,6 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
 		}
 
-		_render->sort();
-
 		RenderDraw currentState;
 		currentState.clear();
 		currentState.m_stateFlags = BGFX_STATE_NONE;
@@ -6413,6 +7715,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		RenderBind currentBind;
 		currentBind.clear();
+		uint32_t currentBindIdx = UINT32_MAX;
 
 		static ViewState viewState;
 		viewState.reset(_render);
@@ -6492,7 +7795,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderBind& renderBind = _render->m_renderBind[isCompute ? renderItem.compute.m_bindIdx : renderItem.draw.m_bindIdx];
 				++item;
 
 				if (viewChanged)
@@ -6619,6 +7922,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							bool constantsChanged = compute.m_uniformBegin < compute.m_uniformEnd;
 							rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
 
+							m_uniformProgram = &program;
+
 							if (constantsChanged
 							&&  NULL != program.m_constantBuffer)
 							{
@@ -6626,6 +7931,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							}
 
 							viewState.setPredefined<1>(this, view, program, _render, compute);
+							commitUniformBlocks(program);
 
 							if (isValid(compute.m_indirectBuffer) )
 							{
@@ -6695,6 +8001,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							currentState.clear();
 							currentState.m_scissor = !draw.m_scissor;
 							currentBind.clear();
+							currentBindIdx = UINT32_MAX;
 						}
 
 						continue;
@@ -6719,6 +8026,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					currentState.m_stencil    = newStencil;
 
 					currentBind.clear();
+					currentBindIdx = UINT32_MAX;
 				}
 
 				uint16_t scissor = draw.m_scissor;
@@ -7039,9 +8347,13 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				}
 
 				bool programChanged = false;
-				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
 				bool bindAttribs = false;
-				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+
+				// Backend uniform values are only committed to current program,
+				// any state reset might have left them out of sync.
+				bool constantsChanged = rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd)
+					|| resetState
+					;
 
 				if (key.m_program.idx != currentProgram.idx)
 				{
@@ -7061,6 +8373,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				{
 					ProgramGL& program = m_program[currentProgram.idx];
 
+					m_uniformProgram = &program;
+
 					if (constantsChanged
 					&&  NULL != program.m_constantBuffer)
 					{
@@ -7068,8 +8382,13 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					}
 
 					viewState.setPredefined<1>(this, view, program, _render, draw);
+					commitUniformBlocks(program);
 
+					if (currentBindIdx != draw.m_bindIdx
+					||  programChanged)
 					{
+						currentBindIdx = draw.m_bindIdx;
+
 						for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
 						{
 							const Binding& bind = renderBind.m_bind[stage];
@@ -7161,7 +8480,13 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							currentState.m_indexBuffer = draw.m_indexBuffer;
 
 							uint16_t handle = draw.m_indexBuffer.idx;
-							if (kInvalidHandle != handle)
+							if (m_vaoSupport)
+							{
+								// Index buffer binding is part of vertex array
+								// object state.
+								bindAttribs = true;
+							}
+							else if (kInvalidHandle != handle)
 							{
 								IndexBufferGL& ib = m_indexBuffers[handle];
 								GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib.m_id) );
@@ -7172,25 +8497,47 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							}
 						}
 
-						if (0 != currentState.m_streamMask)
+						bool diffStartVertex = false;
+						for (uint32_t idx = 0, streamMask = draw.m_streamMask
+							; 0 != streamMask
+							; streamMask >>= 1, idx += 1
+							)
 						{
-							bool diffStartVertex = false;
-							for (uint32_t idx = 0, streamMask = draw.m_streamMask
-								; 0 != streamMask
-								; streamMask >>= 1, idx += 1
-								)
+							const uint32_t ntz = bx::uint32_cnttz(streamMask);
+							streamMask >>= ntz;
+							idx         += ntz;
+
+							if (currentState.m_stream[idx].m_startVertex != draw.m_stream[idx].m_startVertex)
 							{
-								const uint32_t ntz = bx::uint32_cnttz(streamMask);
-								streamMask >>= ntz;
-								idx         += ntz;
+								diffStartVertex = true;
+								break;
+							}
+						}
 
-								if (currentState.m_stream[idx].m_startVertex != draw.m_stream[idx].m_startVertex)
+						if (m_vaoSupport)
+						{
+							if (bindAttribs || diffStartVertex)
+							{
+								if (UINT8_MAX != draw.m_streamMask)
 								{
-									diffStartVertex = true;
-									break;
+									for (uint32_t idx = 0, streamMask = draw.m_streamMask
+										; 0 != streamMask
+										; streamMask >>= 1, idx += 1
+										)
+									{
+										const uint32_t ntz = bx::uint32_cnttz(streamMask);
+										streamMask >>= ntz;
+										idx         += ntz;
+
+										currentState.m_stream[idx].m_startVertex = draw.m_stream[idx].m_startVertex;
+									}
 								}
-							}
 
+								bindVertexArray(currentProgram, draw);
+							}
+						}
+						else if (0 != currentState.m_streamMask)
+						{
 							if (bindAttribs || diffStartVertex)
 							{
 								if (isValid(boundProgram) )
@@ -7380,7 +8727,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							m_occlusionQuery.end();
 						}
 
-						if(isValid(draw.m_instanceDataBuffer))
+						if (isValid(draw.m_instanceDataBuffer)
+						&&  !m_vaoSupport)
 						{
 							program.unbindInstanceData();
 						}
@@ -7658,6 +9006,13 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 			BGFX_GL_PROFILER_END();
 		}
+
+		m_uniformStreamOffset = 0;
+		++m_uniformStreamFrame;
+		m_textureUploadUsed = 0;
+		++m_readBackFrame;
+
+		fenceFrameInFlight();
 	}
 } } // namespace bgfx
 
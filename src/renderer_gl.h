@@ -96,6 +96,7 @@ typedef double GLdouble;
 #		endif // BX_PLATFORM_
 typedef int64_t  GLint64;
 typedef uint64_t GLuint64;
+typedef struct __GLsync* GLsync;
 #		define GL_PROGRAM_BINARY_LENGTH GL_PROGRAM_BINARY_LENGTH_OES
 #		define GL_HALF_FLOAT GL_HALF_FLOAT_OES
 #		define GL_RGBA8 GL_RGBA8_OES
@@ -1041,6 +1042,78 @@ typedef uint64_t GLuint64;
 #	define GL_TEXTURE_LOD_BIAS 0x8501
 #endif // GL_TEXTURE_LOD_BIAS
 
+#ifndef GL_COPY_READ_BUFFER
+#	define GL_COPY_READ_BUFFER 0x8F36
+#endif // GL_COPY_READ_BUFFER
+
+#ifndef GL_COPY_WRITE_BUFFER
+#	define GL_COPY_WRITE_BUFFER 0x8F37
+#endif // GL_COPY_WRITE_BUFFER
+
+#ifndef GL_MAP_READ_BIT
+#	define GL_MAP_READ_BIT 0x0001
+#endif // GL_MAP_READ_BIT
+
+#ifndef GL_MAP_WRITE_BIT
+#	define GL_MAP_WRITE_BIT 0x0002
+#endif // GL_MAP_WRITE_BIT
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#	define GL_MAP_PERSISTENT_BIT 0x0040
+#endif // GL_MAP_PERSISTENT_BIT
+
+#ifndef GL_MAP_COHERENT_BIT
+#	define GL_MAP_COHERENT_BIT 0x0080
+#endif // GL_MAP_COHERENT_BIT
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#	define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif // GL_SYNC_GPU_COMMANDS_COMPLETE
+
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#	define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif // GL_SYNC_FLUSH_COMMANDS_BIT
+
+#ifndef GL_TIMEOUT_EXPIRED
+#	define GL_TIMEOUT_EXPIRED 0x911B
+#endif // GL_TIMEOUT_EXPIRED
+
+#ifndef GL_PIXEL_PACK_BUFFER
+#	define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif // GL_PIXEL_PACK_BUFFER
+
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#	define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif // GL_PIXEL_UNPACK_BUFFER
+
+#ifndef GL_STREAM_READ
+#	define GL_STREAM_READ 0x88E1
+#endif // GL_STREAM_READ
+
+#ifndef GL_UNIFORM_BUFFER
+#	define GL_UNIFORM_BUFFER 0x8A11
+#endif // GL_UNIFORM_BUFFER
+
+#ifndef GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+#	define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#endif // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+
+#ifndef GL_UNIFORM_BLOCK_INDEX
+#	define GL_UNIFORM_BLOCK_INDEX 0x8A3A
+#endif // GL_UNIFORM_BLOCK_INDEX
+
+#ifndef GL_UNIFORM_OFFSET
+#	define GL_UNIFORM_OFFSET 0x8A3B
+#endif // GL_UNIFORM_OFFSET
+
+#ifndef GL_UNIFORM_BLOCK_DATA_SIZE
+#	define GL_UNIFORM_BLOCK_DATA_SIZE 0x8A40
+#endif // GL_UNIFORM_BLOCK_DATA_SIZE
+
+#ifndef GL_INVALID_INDEX
+#	define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif // GL_INVALID_INDEX
+
 #if BX_PLATFORM_WINDOWS
 #	include <windows.h>
 #elif BX_PLATFORM_LINUX || BX_PLATFORM_BSD
@@ -1156,12 +1229,47 @@ namespace bgfx { namespace gl
 		HashMap m_hashMap;
 	};
 
+	/// Persistently mapped buffer with separate storage for each frame in
+	/// flight. Storage of frame is written only after fence of the frame that
+	/// used it before is signaled, see `RendererContextGL::waitFrameInFlight`.
+	struct PersistentBufferGL
+	{
+		bool create(uint32_t _size);
+		void destroy();
+
+		GLuint   m_id[BGFX_CONFIG_RENDERER_OPENGL_FRAMES_IN_FLIGHT];
+		uint8_t* m_data[BGFX_CONFIG_RENDERER_OPENGL_FRAMES_IN_FLIGHT];
+		uint32_t m_size;
+	};
+
+	/// Pixel pack buffer that pixels are read to.
+	struct ReadBackBufferGL
+	{
+		GLuint   m_id;
+		uint32_t m_size;
+	};
+
+	/// Pending texture or screen shot read back. Its data is copied out when
+	/// `m_frame` is reached, see `RendererContextGL::resolveReadBacks`.
+	struct ReadBackGL
+	{
+		ReadBackBufferGL m_buffer;
+		GLsync   m_fence;
+		void*    m_data;
+		char*    m_filePath;
+		uint32_t m_size;
+		uint32_t m_width;
+		uint32_t m_height;
+		uint32_t m_frame;
+	};
+
 	struct IndexBufferGL
 	{
 		void create(uint32_t _size, void* _data, uint16_t _flags)
 		{
-			m_size  = _size;
-			m_flags = _flags;
+			m_size       = _size;
+			m_flags      = _flags;
+			m_persistent = NULL;
 
 			GL_CHECK(glGenBuffers(1, &m_id) );
 			BX_CHECK(0 != m_id, "Failed to generate buffer id.");
@@ -1174,39 +1282,22 @@ namespace bgfx { namespace gl
 			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
 		}
 
-		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false)
-		{
-			BX_CHECK(0 != m_id, "Updating invalid index buffer.");
-
-			if (_discard)
-			{
-				// orphan buffer...
-				destroy();
-				create(m_size, NULL, m_flags);
-			}
-
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
-			GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER
-				, _offset
-				, _size
-				, _data
-				) );
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
-		}
-
+		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false);
 		void destroy();
 
 		GLuint m_id;
 		uint32_t m_size;
 		uint16_t m_flags;
+		PersistentBufferGL* m_persistent;
 	};
 
 	struct VertexBufferGL
 	{
 		void create(uint32_t _size, void* _data, VertexDeclHandle _declHandle, uint16_t _flags)
 		{
-			m_size = _size;
-			m_decl = _declHandle;
+			m_size       = _size;
+			m_decl       = _declHandle;
+			m_persistent = NULL;
 			const bool drawIndirect = 0 != (_flags & BGFX_BUFFER_DRAW_INDIRECT);
 
 			m_target = drawIndirect ? GL_DRAW_INDIRECT_BUFFER : GL_ARRAY_BUFFER;
@@ -1222,32 +1313,14 @@ namespace bgfx { namespace gl
 			GL_CHECK(glBindBuffer(m_target, 0) );
 		}
 
-		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false)
-		{
-			BX_CHECK(0 != m_id, "Updating invalid vertex buffer.");
-
-			if (_discard)
-			{
-				// orphan buffer...
-				destroy();
-				create(m_size, NULL, m_decl, 0);
-			}
-
-			GL_CHECK(glBindBuffer(m_target, m_id) );
-			GL_CHECK(glBufferSubData(m_target
-				, _offset
-				, _size
-				, _data
-				) );
-			GL_CHECK(glBindBuffer(m_target, 0) );
-		}
-
+		void update(uint32_t _offset, uint32_t _size, void* _data, bool _discard = false);
 		void destroy();
 
 		GLuint m_id;
 		GLenum m_target;
 		uint32_t m_size;
 		VertexDeclHandle m_decl;
+		PersistentBufferGL* m_persistent;
 	};
 
 	struct TextureGL
@@ -1344,12 +1417,39 @@ namespace bgfx { namespace gl
 		Attachment m_attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
 	};
 
+	/// Location of uniform packed in std140 uniform block. Slot of block in
+	/// program and byte offset of uniform in block are stored in the rest of
+	/// bits.
+	constexpr uint32_t kUniformBlockFlag       = UINT32_C(0x80000000);
+	constexpr uint32_t kUniformBlockSlotShift  = 24;
+	constexpr uint32_t kUniformBlockSlotMask   = UINT32_C(0x7f000000);
+	constexpr uint32_t kUniformBlockOffsetMask = UINT32_C(0x00ffffff);
+
+	/// Vertex and fragment shader block.
+	constexpr uint32_t kMaxUniformBlocks = 2;
+
+	/// CPU copy of program uniform block. Block is uploaded only when its
+	/// contents changed since last upload, otherwise the same buffer range
+	/// is bound again, see `RendererContextGL::commitUniformBlocks`.
+	struct UniformBlockGL
+	{
+		uint8_t* m_data;
+		uint32_t m_size;
+		GLuint   m_index;    // Uniform block index in program.
+		GLuint   m_id;       // Buffer used when uniform stream is not available.
+		GLuint   m_bufferId; // Buffer holding last upload.
+		uint32_t m_offset;   // Offset of last upload in m_bufferId.
+		uint32_t m_frame;    // Uniform stream frame of last upload, UINT32_MAX when in m_id.
+		bool     m_dirty;
+	};
+
 	struct ProgramGL
 	{
 		ProgramGL()
 			: m_id(0)
 			, m_constantBuffer(NULL)
 			, m_numPredefined(0)
+			, m_numUniformBlocks(0)
 		{
 		}
 
@@ -1393,10 +1493,43 @@ namespace bgfx { namespace gl
 		uint8_t m_numSamplers;
 
 		UniformBuffer* m_constantBuffer;
-		PredefinedUniform m_predefined[PredefinedUniform::Count];
+		PredefinedUniform m_predefined[PredefinedUniform::Count*2];
 		uint8_t m_numPredefined;
+
+		UniformBlockGL m_uniformBlock[kMaxUniformBlocks];
+		uint8_t m_numUniformBlocks;
+	};
+
+	/// Vertex array object cached by vertex stream layout. Start vertices are
+	/// not part of the cache key, attribute pointers are specified again
+	/// only when they change.
+	struct VertexArrayGL
+	{
+		GLuint   m_id;
+		uint32_t m_startVertex[BGFX_CONFIG_MAX_VERTEX_STREAMS];
+		uint32_t m_instanceDataOffset;
+		GLuint   m_buffer[BGFX_CONFIG_MAX_VERTEX_STREAMS+2]; //!< Index, vertex and instance data buffers.
+		uint8_t  m_numBuffers;
 	};
 
+	inline void release(VertexArrayGL _vao)
+	{
+		GL_CHECK(glDeleteVertexArrays(1, &_vao.m_id) );
+	}
+
+	inline bool isReferencing(const VertexArrayGL& _vao, GLuint _id)
+	{
+		for (uint32_t ii = 0; ii < _vao.m_numBuffers; ++ii)
+		{
+			if (_id == _vao.m_buffer[ii])
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	struct TimerQueryGL
 	{
 		TimerQueryGL()
@@ -722,6 +722,11 @@ namespace bgfx { namespace mtl
 			return BGFX_RENDERER_METAL_NAME;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return 0;
+		}
+
 		void createIndexBuffer(IndexBufferHandle _handle, const Memory* _mem, uint16_t _flags) override
 		{
 			m_indexBuffers[_handle.idx].create(_mem->size, _mem->data, _flags);
@@ -1021,9 +1026,15 @@ namespace bgfx { namespace mtl
 				);
 		}
 
-		void updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
+		bool updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
 		{
+			if (0 == bx::memCmp(m_uniforms[_loc], _data, _size) )
+			{
+				return false;
+			}
+
 			bx::memCopy(m_uniforms[_loc], _data, _size);
+			return true;
 		}
 
 		void invalidateOcclusionQuery(OcclusionQueryHandle _handle) override
@@ -1226,6 +1237,7 @@ namespace bgfx { namespace mtl
 				| BGFX_RESET_MAXANISOTROPY
 				| BGFX_RESET_DEPTH_CLAMP
 				| BGFX_RESET_SUSPEND
+				| BGFX_RESET_SYNC_READ_BACK
 				);
 
 			if (m_resolution.width            !=  _resolution.width
@@ -3649,6 +3661,8 @@ namespace bgfx { namespace mtl
 		m_uniformBufferVertexOffset = 0;
 		m_uniformBufferFragmentOffset = 0;
 
+		_render->sort();
+
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
@@ -3663,8 +3677,6 @@ namespace bgfx { namespace mtl
 			m_vertexBuffers[vb->handle.idx].update(0, bx::strideAlign(_render->m_vboffset,4), vb->data, true);
 		}
 
-		_render->sort();
-
 		RenderDraw currentState;
 		currentState.clear();
 		currentState.m_stateFlags = BGFX_STATE_NONE;
@@ -3672,6 +3684,7 @@ namespace bgfx { namespace mtl
 
 		RenderBind currentBind;
 		currentBind.clear();
+		uint32_t currentBindIdx = UINT32_MAX;
 
 		static ViewState viewState;
 		viewState.reset(_render);
@@ -3732,7 +3745,7 @@ namespace bgfx { namespace mtl
 
 				const uint32_t itemIdx       = _render->m_sortValues[item];
 				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
-				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				const RenderBind& renderBind = _render->m_renderBind[isCompute ? renderItem.compute.m_bindIdx : renderItem.draw.m_bindIdx];
 				++item;
 
 				if (viewChanged
@@ -4109,6 +4122,7 @@ namespace bgfx { namespace mtl
 							currentState.clear();
 							currentState.m_scissor = !draw.m_scissor;
 							currentBind.clear();
+							currentBindIdx = UINT32_MAX;
 						}
 
 						continue;
@@ -4133,6 +4147,7 @@ namespace bgfx { namespace mtl
 					currentState.m_stencil    = newStencil;
 
 					currentBind.clear();
+					currentBindIdx = UINT32_MAX;
 
 					currentProgram = BGFX_INVALID_HANDLE;
 					setDepthStencilState(newFlags, packStencil(BGFX_STENCIL_DEFAULT, BGFX_STENCIL_DEFAULT) );
@@ -4371,8 +4386,11 @@ namespace bgfx { namespace mtl
 					m_uniformBufferVertexOffset    = m_uniformBufferFragmentOffset;
 				}
 
-				if (isValid(currentProgram) )
+				if (isValid(currentProgram)
+				&& (currentBindIdx != draw.m_bindIdx || programChanged) )
 				{
+					currentBindIdx = draw.m_bindIdx;
+
 					for (uint32_t sampler = 0, numSamplers = currentPso->m_samplerCount; sampler < numSamplers; ++sampler)
 					{
 						const SamplerInfo& samplerInfo = currentPso->m_samplers[sampler];
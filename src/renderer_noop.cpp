@@ -83,6 +83,11 @@ namespace bgfx { namespace noop
 			return BGFX_RENDERER_NOOP_NAME;
 		}
 
+		uint32_t getReadBackLatency() const override
+		{
+			return 0;
+		}
+
 		bool isDeviceRemoved() override
 		{
 			return false;
@@ -222,8 +227,9 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void updateUniform(uint16_t /*_loc*/, const void* /*_data*/, uint32_t /*_size*/) override
+		bool updateUniform(uint16_t /*_loc*/, const void* /*_data*/, uint32_t /*_size*/) override
 		{
+			return true;
 		}
 
 		void invalidateOcclusionQuery(OcclusionQueryHandle /*_handle*/) override
@@ -243,14 +249,48 @@ namespace bgfx { namespace noop
 			const int64_t timerFreq = bx::getHPFrequency();
 			const int64_t timeBegin = bx::getHPCounter();
 
+			// Sort and walk render items even though nothing is drawn, so that
+			// CPU side of frame submission, that doesn't depend on graphics API,
+			// can be measured with noop renderer.
+			_render->sort();
+
+			uint32_t statsKeyType[2] = {};
+
+			SortKey key;
+			for (uint32_t item = 0, numItems = _render->m_numRenderItems; item < numItems; ++item)
+			{
+				const uint64_t encodedKey = _render->m_sortKeys[item];
+				const bool isCompute = key.decode(encodedKey, _render->m_viewRemap);
+				statsKeyType[isCompute]++;
+
+				const uint32_t itemIdx = _render->m_sortValues[item];
+				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
+
+				if (isCompute)
+				{
+					const RenderCompute& compute = renderItem.compute;
+					rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+				}
+				else
+				{
+					const RenderDraw& draw = renderItem.draw;
+					rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+				}
+			}
+
+			const int64_t timeEnd = bx::getHPCounter();
+
 			Stats& perfStats = _render->m_perfStats;
 			perfStats.cpuTimeBegin  = timeBegin;
-			perfStats.cpuTimeEnd    = timeBegin;
+			perfStats.cpuTimeEnd    = timeEnd;
 			perfStats.cpuTimerFreq  = timerFreq;
 
 			perfStats.gpuTimeBegin  = 0;
 			perfStats.gpuTimeEnd    = 0;
 			perfStats.gpuTimerFreq  = 1000000000;
+			perfStats.numDraw       = statsKeyType[0];
+			perfStats.numCompute    = statsKeyType[1];
+			perfStats.numBlit       = _render->m_numBlitItems;
 
 			bx::memSet(perfStats.numPrims, 0, sizeof(perfStats.numPrims) );
 
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_TEXTURE_UPDATE_H_HEADER_GUARD
+#define BGFX_TEXTURE_UPDATE_H_HEADER_GUARD
+
+#include <bx/bx.h>
+#include <bx/uint32_t.h>
+#include <bgfx/bgfx.h>
+
+namespace bgfx
+{
+	/// Merges sub-rect _rect, updated after region _merged, into region that
+	/// is uploaded at once. Rects must touch or overlap.
+	///
+	/// _covered is number of texels of _merged written by updates, and it's
+	/// set to number of texels of _result written by updates on success.
+	/// Texels of _result not written by any update are wasted, merge is
+	/// accepted only when they are at most _maxWaste percent of _result.
+	/// With _maxWaste 0, rects are merged only when their union is rect.
+	///
+	/// Coverage is estimated conservatively, part of _rect overlapping
+	/// _merged is assumed to be covered already.
+	///
+	/// RectT must have uint16_t m_x, m_y, m_width, and m_height members.
+	///
+	template<typename RectT>
+	inline bool mergeTextureUpdateRect(RectT& _result, uint32_t& _covered, const RectT& _merged, const RectT& _rect, uint32_t _maxWaste)
+	{
+		const uint32_t mx0 = _merged.m_x;
+		const uint32_t my0 = _merged.m_y;
+		const uint32_t mx1 = mx0 + _merged.m_width;
+		const uint32_t my1 = my0 + _merged.m_height;
+		const uint32_t rx0 = _rect.m_x;
+		const uint32_t ry0 = _rect.m_y;
+		const uint32_t rx1 = rx0 + _rect.m_width;
+		const uint32_t ry1 = ry0 + _rect.m_height;
+
+		if (rx0 > mx1
+		||  mx0 > rx1
+		||  ry0 > my1
+		||  my0 > ry1)
+		{
+			return false;
+		}
+
+		const uint32_t x0 = bx::min(mx0, rx0);
+		const uint32_t y0 = bx::min(my0, ry0);
+		const uint32_t x1 = bx::max(mx1, rx1);
+		const uint32_t y1 = bx::max(my1, ry1);
+
+		const uint32_t overlap = 0
+			+ (bx::min(mx1, rx1) - bx::max(mx0, rx0) )
+			* (bx::min(my1, ry1) - bx::max(my0, ry0) )
+			;
+
+		const uint64_t area    = uint64_t(x1 - x0) * (y1 - y0);
+		const uint64_t covered = uint64_t(_covered) + uint32_t(_rect.m_width)*_rect.m_height - overlap;
+		const uint64_t waste   = area - covered;
+
+		if (waste*100 > area*_maxWaste)
+		{
+			return false;
+		}
+
+		_result.m_x      = uint16_t(x0);
+		_result.m_y      = uint16_t(y0);
+		_result.m_width  = uint16_t(x1 - x0);
+		_result.m_height = uint16_t(y1 - y0);
+		_covered = uint32_t(covered);
+
+		return true;
+	}
+
+	/// Texture update of one texture side and mip, as read from command
+	/// buffer. _pitch is UINT16_MAX when data is tightly packed.
+	///
+	/// RectT must have uint16_t m_x, m_y, m_width, and m_height members.
+	///
+	template<typename RectT>
+	struct TextureUpdateT
+	{
+		RectT m_rect;
+		const Memory* m_mem;
+		uint16_t m_z;
+		uint16_t m_depth;
+		uint16_t m_pitch;
+	};
+
+	/// Merges run of updates, starting at _first, into region _rect that is
+	/// uploaded at once, and returns index of first update after the run.
+	/// Run of single update is not merged, and it's uploaded as it is.
+	///
+	/// _covered is set to number of texels of _rect written by updates. Only
+	/// 2D updates of the same layer are merged, merged region data must fit
+	/// into _maxSize bytes, see mergeTextureUpdateRect for _maxWaste.
+	///
+	template<typename RectT>
+	inline uint32_t mergeTextureUpdates(
+		  RectT& _rect
+		, uint32_t& _covered
+		, const TextureUpdateT<RectT>* _updates
+		, uint32_t _first
+		, uint32_t _num
+		, uint32_t _bpp
+		, uint32_t _maxWaste
+		, uint32_t _maxSize
+		)
+	{
+		const TextureUpdateT<RectT>& first = _updates[_first];
+
+		_rect    = first.m_rect;
+		_covered = uint32_t(_rect.m_width)*_rect.m_height;
+
+		uint32_t end = _first + 1;
+
+		if (1 == first.m_depth)
+		{
+			for (; end < _num && first.m_z == _updates[end].m_z && 1 == _updates[end].m_depth; ++end)
+			{
+				RectT merged;
+				uint32_t mergedCovered = _covered;
+				if (!mergeTextureUpdateRect(merged, mergedCovered, _rect, _updates[end].m_rect, _maxWaste)
+				||  uint32_t(merged.m_width)*merged.m_height*_bpp/8 > _maxSize)
+				{
+					break;
+				}
+
+				_rect    = merged;
+				_covered = mergedCovered;
+			}
+		}
+
+		return end;
+	}
+
+	/// Copies run of updates [_first, _end) merged by mergeTextureUpdates into
+	/// _dst, tightly packed data of region _rect, and returns its size in
+	/// bytes. Updates are copied in submission order, so that later update
+	/// wins where rects overlap. Texels not written by any update are zero.
+	///
+	template<typename RectT>
+	inline uint32_t stageTextureUpdates(
+		  uint8_t* _dst
+		, const RectT& _rect
+		, uint32_t _covered
+		, const TextureUpdateT<RectT>* _updates
+		, uint32_t _first
+		, uint32_t _end
+		, uint32_t _bpp
+		)
+	{
+		const uint32_t dstPitch = _rect.m_width*_bpp/8;
+		const uint32_t size     = dstPitch*_rect.m_height;
+
+		if (_covered < uint32_t(_rect.m_width)*_rect.m_height)
+		{
+			bx::memSet(_dst, 0, size);
+		}
+
+		for (uint32_t ii = _first; ii < _end; ++ii)
+		{
+			const TextureUpdateT<RectT>& update = _updates[ii];
+			const uint32_t rectPitch = update.m_rect.m_width*_bpp/8;
+			const uint32_t srcPitch  = UINT16_MAX == update.m_pitch ? rectPitch : update.m_pitch;
+			const uint32_t offset    = (update.m_rect.m_y - _rect.m_y)*dstPitch + (update.m_rect.m_x - _rect.m_x)*_bpp/8;
+
+			bx::memCopy(&_dst[offset]
+				, update.m_mem->data
+				, rectPitch
+				, update.m_rect.m_height
+				, srcPitch
+				, dstPitch
+				);
+		}
+
+		return size;
+	}
+
+} // namespace bgfx
+
+#endif // BGFX_TEXTURE_UPDATE_H_HEADER_GUARD
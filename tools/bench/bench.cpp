@@ -0,0 +1,2279 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/commandline.h>
+#include <bx/file.h>
+#include <bx/math.h>
+#include <bx/rng.h>
+#include <bx/semaphore.h>
+#include <bx/string.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+#include <bgfx/bgfx.h>
+
+#include <stdio.h>  // remove
+#include <stdlib.h> // abort
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace stl = std;
+#include "../../src/frame_trace.h"
+#include "../../src/nonlocal_allocator.h"
+#include "../../src/texture_update.h"
+
+#include "../../src/vs_clear.bin.h"
+#include "../../src/fs_clear0.bin.h"
+
+#define BGFX_BENCH_VERSION_MAJOR 1
+#define BGFX_BENCH_VERSION_MINOR 4
+
+static const uint16_t kNumViews = 8;
+
+struct Timing
+{
+	void reset()
+	{
+		m_min = INT64_MAX;
+		m_max = 0;
+		m_sum = 0;
+		m_num = 0;
+	}
+
+	void add(int64_t _time)
+	{
+		m_min  = bx::min(m_min, _time);
+		m_max  = bx::max(m_max, _time);
+		m_sum += _time;
+		++m_num;
+	}
+
+	double toMs(int64_t _time) const
+	{
+		return 1000.0 * double(_time) / double(bx::getHPFrequency() );
+	}
+
+	double minMs() const { return 0 == m_num ? 0.0 : toMs(m_min); }
+	double maxMs() const { return 0 == m_num ? 0.0 : toMs(m_max); }
+	double avgMs() const { return 0 == m_num ? 0.0 : toMs(m_sum) / double(m_num); }
+
+	int64_t  m_min;
+	int64_t  m_max;
+	int64_t  m_sum;
+	uint32_t m_num;
+};
+
+static const uint16_t kMaxEncoders = 32;
+
+static bool benchInit(uint16_t _sortThreads)
+{
+	bgfx::Init init;
+	init.type              = bgfx::RendererType::Noop;
+	init.resolution.width  = 1;
+	init.resolution.height = 1;
+	init.resolution.reset  = BGFX_RESET_NONE;
+	init.limits.maxEncoders    = kMaxEncoders;
+	init.limits.maxSortThreads = _sortThreads;
+
+	if (!bgfx::init(init) )
+	{
+		return false;
+	}
+
+	// Depth sorted views submitted in reverse order, so that every sort
+	// key needs view remap and full key width is used.
+	bgfx::ViewId order[kNumViews];
+	for (uint16_t ii = 0; ii < kNumViews; ++ii)
+	{
+		bgfx::setViewMode(ii, bgfx::ViewMode::DepthAscending);
+		order[ii] = bgfx::ViewId(kNumViews-ii-1);
+	}
+	bgfx::setViewOrder(0, kNumViews, order);
+
+	return true;
+}
+
+// Splits draw calls between _numEncoders encoders. Each encoder sorts its own
+// run in bgfx::end, and Frame::sort merges runs, or sorts everything again
+// when there are more runs than it merges.
+static void submitDraws(uint32_t _num, uint32_t _numEncoders, bx::RngMwc& _rng)
+{
+	const bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
+
+	for (uint32_t encoderIdx = 0; encoderIdx < _numEncoders; ++encoderIdx)
+	{
+		bgfx::Encoder* encoder = bgfx::begin(true);
+		if (NULL == encoder)
+		{
+			break;
+		}
+
+		const uint32_t begin = _num *  encoderIdx    / _numEncoders;
+		const uint32_t end   = _num * (encoderIdx+1) / _numEncoders;
+
+		for (uint32_t ii = begin; ii < end; ++ii)
+		{
+			encoder->setVertexCount(3);
+			encoder->submit(bgfx::ViewId(ii % kNumViews), program, _rng.gen() );
+		}
+
+		bgfx::end(encoder);
+	}
+}
+
+struct BenchSort
+{
+	Timing m_submit; //!< API thread, submit and per-encoder sort in bgfx::end.
+	Timing m_sort;   //!< Render side sort + noop submit (Stats::cpuTimeBegin/End).
+};
+
+static bool benchSort(BenchSort& _result, uint32_t _numItems, uint32_t _numEncoders, uint16_t _sortThreads, uint32_t _numFrames)
+{
+	if (!benchInit(_sortThreads) )
+	{
+		return false;
+	}
+
+	bx::RngMwc rng;
+	_result.m_submit.reset();
+	_result.m_sort.reset();
+
+	const uint32_t kWarmUpFrames = 4;
+
+	for (uint32_t frame = 0, num = _numFrames+kWarmUpFrames; frame < num; ++frame)
+	{
+		const int64_t submitBegin = bx::getHPCounter();
+		submitDraws(_numItems, _numEncoders, rng);
+		const int64_t submitEnd = bx::getHPCounter();
+
+		bgfx::frame();
+
+		const bgfx::Stats* stats = bgfx::getStats();
+		if (frame >= kWarmUpFrames)
+		{
+			_result.m_submit.add(submitEnd - submitBegin);
+			_result.m_sort.add(stats->cpuTimeEnd - stats->cpuTimeBegin);
+		}
+	}
+
+	bgfx::shutdown();
+
+	return true;
+}
+
+struct PosVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+};
+
+static const PosVertex s_triangleVertices[] =
+{
+	{ 0.0f, 0.0f, 0.0f },
+	{ 1.0f, 0.0f, 0.0f },
+	{ 0.0f, 1.0f, 0.0f },
+};
+
+static const uint16_t s_triangleIndices[] = { 0, 1, 2 };
+
+struct BenchSubmit
+{
+	Timing m_perDraw; //!< setTransform/setVertexBuffer/setIndexBuffer/setState/submit per draw.
+	Timing m_batch;   //!< Single Encoder::submitBatch call.
+};
+
+// Same draws are submitted both ways on API thread encoder, only submission
+// is timed, matrices are allocated before timer starts.
+static bool benchSubmit(BenchSubmit& _result, uint32_t _numDraws, uint32_t _numFrames)
+{
+	if (!benchInit(0) )
+	{
+		return false;
+	}
+
+	bgfx::VertexDecl decl;
+	decl.begin()
+		.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+		.end();
+
+	bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(bgfx::makeRef(s_triangleVertices, sizeof(s_triangleVertices) ), decl);
+	bgfx::IndexBufferHandle  ibh = bgfx::createIndexBuffer(bgfx::makeRef(s_triangleIndices, sizeof(s_triangleIndices) ) );
+
+	bgfx::ProgramHandle*      program      = new bgfx::ProgramHandle[_numDraws];
+	uint32_t*                 transform    = new uint32_t[_numDraws];
+	bgfx::VertexBufferHandle* vertexBuffer = new bgfx::VertexBufferHandle[_numDraws];
+	bgfx::IndexBufferHandle*  indexBuffer  = new bgfx::IndexBufferHandle[_numDraws];
+	uint64_t*                 state        = new uint64_t[_numDraws];
+	uint32_t*                 depth        = new uint32_t[_numDraws];
+
+	bx::RngMwc rng;
+	for (uint32_t ii = 0; ii < _numDraws; ++ii)
+	{
+		program[ii].idx = bgfx::kInvalidHandle;
+		vertexBuffer[ii] = vbh;
+		indexBuffer[ii]  = ibh;
+		state[ii]        = BGFX_STATE_DEFAULT;
+		depth[ii]        = rng.gen();
+	}
+
+	_result.m_perDraw.reset();
+	_result.m_batch.reset();
+
+	const uint32_t kWarmUpFrames = 4;
+
+	for (uint32_t frame = 0, num = _numFrames+kWarmUpFrames; frame < num; ++frame)
+	{
+		const bool batch = 0 != (frame & 1);
+
+		bgfx::Encoder* encoder = bgfx::begin();
+
+		bgfx::Transform mtx;
+		const uint32_t first = encoder->allocTransform(&mtx, uint16_t(bx::min<uint32_t>(_numDraws, UINT16_MAX) ) );
+		bx::memSet(mtx.data, 0, mtx.num*16*sizeof(float) );
+		for (uint32_t ii = 0; ii < _numDraws; ++ii)
+		{
+			transform[ii] = first + ii%mtx.num;
+		}
+
+		const int64_t submitBegin = bx::getHPCounter();
+
+		if (batch)
+		{
+			encoder->submitBatch(0, _numDraws, program, transform, vertexBuffer, indexBuffer, state, depth);
+		}
+		else
+		{
+			for (uint32_t ii = 0; ii < _numDraws; ++ii)
+			{
+				encoder->setTransform(transform[ii]);
+				encoder->setVertexBuffer(0, vertexBuffer[ii]);
+				encoder->setIndexBuffer(indexBuffer[ii]);
+				encoder->setState(state[ii]);
+				encoder->submit(0, program[ii], depth[ii]);
+			}
+		}
+
+		const int64_t submitEnd = bx::getHPCounter();
+
+		bgfx::end(encoder);
+		bgfx::frame();
+
+		if (frame >= kWarmUpFrames)
+		{
+			Timing& timing = batch ? _result.m_batch : _result.m_perDraw;
+			timing.add(submitEnd - submitBegin);
+		}
+	}
+
+	delete [] program;
+	delete [] transform;
+	delete [] vertexBuffer;
+	delete [] indexBuffer;
+	delete [] state;
+	delete [] depth;
+
+	bgfx::destroy(ibh);
+	bgfx::destroy(vbh);
+
+	bgfx::shutdown();
+
+	return true;
+}
+
+static const uint32_t kBatchDraws     = 1024;
+static const char*    kBatchTracePath = "bench-batch.trace";
+
+struct BatchCheck
+{
+	uint32_t m_numDraws;     //!< Draws passed to submitBatch, empty draws included.
+	uint32_t m_numSubmitted; //!< Draws that reached renderer in each frame.
+	uint32_t m_numErrors;    //!< Frames that don't match expected draw count or each other.
+};
+
+// Every 8th batch draw has neither vertex nor index buffer, and must be
+// discarded.
+static bool isEmptyBatchDraw(uint32_t _idx)
+{
+	return 0 == _idx%8;
+}
+
+static bool readTraceFrames(std::vector<std::vector<uint8_t> >& _frames, const char* _filePath)
+{
+	bx::FileReader reader;
+	if (!bx::open(&reader, _filePath) )
+	{
+		return false;
+	}
+
+	bx::Error err;
+	bgfx::FrameTraceHeader header;
+	bx::read(&reader, &header, sizeof(header), &err);
+
+	while (err.isOk() )
+	{
+		uint32_t magic = 0;
+		uint32_t size  = 0;
+		bx::read(&reader, magic, &err);
+		bx::read(&reader, size,  &err);
+
+		if (!err.isOk()
+		||  BGFX_CHUNK_MAGIC_FRM != magic)
+		{
+			break;
+		}
+
+		_frames.push_back(std::vector<uint8_t>(size) );
+		bx::read(&reader, _frames.back().data(), int32_t(size), &err);
+	}
+
+	bx::close(&reader);
+
+	return BGFX_CHUNK_MAGIC_FTR == header.magic;
+}
+
+// Submits the same draws one by one with Encoder::submit in one frame, and
+// with Encoder::submitBatch in the next frame, into depth sorted and into
+// sequential view. Both frames are captured with frame trace, and payloads,
+// that hold sort keys in sorted order and render items, must be identical.
+static bool batchCheck(BatchCheck& _result)
+{
+	if (!benchInit(0) )
+	{
+		return false;
+	}
+
+	bgfx::setViewMode(1, bgfx::ViewMode::Sequential);
+
+	bgfx::VertexDecl decl;
+	decl.begin()
+		.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+		.end();
+
+	bgfx::VertexBufferHandle vbh = bgfx::createVertexBuffer(bgfx::makeRef(s_triangleVertices, sizeof(s_triangleVertices) ), decl);
+	bgfx::IndexBufferHandle  ibh = bgfx::createIndexBuffer(bgfx::makeRef(s_triangleIndices, sizeof(s_triangleIndices) ) );
+
+	bgfx::ProgramHandle      program[kBatchDraws];
+	uint32_t                 transform[kBatchDraws];
+	bgfx::VertexBufferHandle vertexBuffer[kBatchDraws];
+	bgfx::IndexBufferHandle  indexBuffer[kBatchDraws];
+	uint64_t                 state[kBatchDraws];
+	uint32_t                 depth[kBatchDraws];
+
+	const bgfx::VertexBufferHandle invalidVbh = BGFX_INVALID_HANDLE;
+	const bgfx::IndexBufferHandle  invalidIbh = BGFX_INVALID_HANDLE;
+
+	bx::RngMwc rng;
+	for (uint32_t ii = 0; ii < kBatchDraws; ++ii)
+	{
+		// Draw that follows empty one is not indexed.
+		const bool empty   = isEmptyBatchDraw(ii);
+		const bool indexed = !empty && 1 != ii%8;
+
+		program[ii].idx  = bgfx::kInvalidHandle;
+		vertexBuffer[ii] = empty   ? invalidVbh : vbh;
+		indexBuffer[ii]  = indexed ? ibh : invalidIbh;
+		state[ii]        = 0 != (ii & 2) ? BGFX_STATE_DEFAULT|BGFX_STATE_BLEND_ALPHA : BGFX_STATE_DEFAULT;
+		depth[ii]        = rng.gen();
+	}
+
+	// Resources are created before capture begins.
+	bgfx::frame();
+
+	_result.m_numDraws     = kBatchDraws;
+	_result.m_numSubmitted = 0;
+	_result.m_numErrors    = 0;
+
+	bgfx::frameTraceBegin(kBatchTracePath);
+
+	// Stats are of frame rendered by previous bgfx::frame call, last frame
+	// isn't captured, and only checks stats of batched frame.
+	uint32_t lastSubmitted = 0;
+
+	for (uint32_t frame = 0; frame < 4; ++frame)
+	{
+		if (3 == frame)
+		{
+			bgfx::frameTraceEnd();
+		}
+
+		bgfx::Encoder* encoder = bgfx::begin();
+
+		bgfx::Transform mtx;
+		const uint32_t first = encoder->allocTransform(&mtx, 16);
+		for (uint32_t ii = 0; ii < mtx.num; ++ii)
+		{
+			bx::mtxTranslate(&mtx.data[ii*16], float(ii), 0.0f, 0.0f);
+		}
+
+		for (uint32_t ii = 0; ii < kBatchDraws; ++ii)
+		{
+			transform[ii] = first + ii%mtx.num;
+		}
+
+		// First frame holds views changed since capture began, only the
+		// next two are compared.
+		const bool compared = 1 == frame || 2 == frame;
+
+		for (bgfx::ViewId view = 0; view < 2 && compared; ++view)
+		{
+			if (2 == frame)
+			{
+				encoder->submitBatch(view, kBatchDraws, program, transform, vertexBuffer, indexBuffer, state, depth);
+				continue;
+			}
+
+			for (uint32_t ii = 0; ii < kBatchDraws; ++ii)
+			{
+				if (isEmptyBatchDraw(ii) )
+				{
+					continue;
+				}
+
+				encoder->setTransform(transform[ii]);
+				encoder->setVertexBuffer(0, vertexBuffer[ii]);
+				if (bgfx::isValid(indexBuffer[ii]) )
+				{
+					encoder->setIndexBuffer(indexBuffer[ii]);
+				}
+				encoder->setState(state[ii]);
+				encoder->submit(view, program[ii], depth[ii]);
+			}
+		}
+
+		bgfx::end(encoder);
+		bgfx::frame();
+
+		const bgfx::Stats* stats = bgfx::getStats();
+		if (lastSubmitted != stats->numDraw)
+		{
+			++_result.m_numErrors;
+		}
+
+		lastSubmitted = compared ? 2*(kBatchDraws - (kBatchDraws+7)/8) : 0;
+		_result.m_numSubmitted = bx::max(_result.m_numSubmitted, lastSubmitted);
+	}
+
+	std::vector<std::vector<uint8_t> > frames;
+	if (!readTraceFrames(frames, kBatchTracePath)
+	||  3 != frames.size()
+	||  frames[1] != frames[2])
+	{
+		++_result.m_numErrors;
+	}
+
+	remove(kBatchTracePath);
+
+	bgfx::destroy(ibh);
+	bgfx::destroy(vbh);
+
+	bgfx::shutdown();
+
+	return true;
+}
+
+static const uint16_t kBindTextures  = 256;
+static const uint32_t kBindDraws     = 48<<10;
+static const uint32_t kBindMaxGroups = 32<<10; // BGFX_CONFIG_MAX_BIND_GROUPS
+
+struct BenchBind
+{
+	Timing   m_shared;          //!< Submit of draws that share kBindTextures binds.
+	Timing   m_unique;          //!< Submit of draws with unique binds, past bind table limits.
+	uint32_t m_numSharedErrors; //!< Shared bind frames where not every draw call reached renderer.
+	uint32_t m_numUniqueErrors; //!< Unique bind frames where not every draw call reached renderer.
+};
+
+// Submits kBindDraws draws per frame from API thread encoder. In odd frames
+// every draw has unique pair of textures bound, so that both encoder and
+// frame bind tables go past their limits, and the rest of binds is stored
+// one per draw.
+static bool benchBind(BenchBind& _result, uint32_t _numFrames)
+{
+	if (!benchInit(0) )
+	{
+		return false;
+	}
+
+	bgfx::UniformHandle sampler[2] =
+	{
+		bgfx::createUniform("s_tex0", bgfx::UniformType::Sampler),
+		bgfx::createUniform("s_tex1", bgfx::UniformType::Sampler),
+	};
+
+	bgfx::TextureHandle texture[kBindTextures];
+	for (uint16_t ii = 0; ii < kBindTextures; ++ii)
+	{
+		texture[ii] = bgfx::createTexture2D(1, 1, false, 1, bgfx::TextureFormat::RGBA8);
+	}
+
+	const bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
+
+	_result.m_shared.reset();
+	_result.m_unique.reset();
+	_result.m_numSharedErrors = 0;
+	_result.m_numUniqueErrors = 0;
+
+	const uint32_t kWarmUpFrames = 4;
+
+	for (uint32_t frame = 0, num = _numFrames+kWarmUpFrames; frame < num; ++frame)
+	{
+		const bool unique = 0 != (frame & 1);
+
+		bgfx::Encoder* encoder = bgfx::begin();
+
+		const int64_t submitBegin = bx::getHPCounter();
+
+		for (uint32_t ii = 0; ii < kBindDraws; ++ii)
+		{
+			const uint16_t tex0 = uint16_t(ii % kBindTextures);
+			const uint16_t tex1 = unique ? uint16_t(ii / kBindTextures) : tex0;
+			encoder->setTexture(0, sampler[0], texture[tex0]);
+			encoder->setTexture(1, sampler[1], texture[tex1]);
+			encoder->setVertexCount(3);
+			encoder->submit(0, program);
+		}
+
+		const int64_t submitEnd = bx::getHPCounter();
+
+		bgfx::end(encoder);
+		bgfx::frame();
+
+		// Stats are of frame rendered by previous bgfx::frame call, which
+		// used the other kind of binds.
+		const bgfx::Stats* stats = bgfx::getStats();
+		if (0 != frame
+		&&  kBindDraws != stats->numDraw)
+		{
+			++(unique ? _result.m_numSharedErrors : _result.m_numUniqueErrors);
+		}
+
+		if (frame >= kWarmUpFrames)
+		{
+			Timing& timing = unique ? _result.m_unique : _result.m_shared;
+			timing.add(submitEnd - submitBegin);
+		}
+	}
+
+	for (uint16_t ii = 0; ii < kBindTextures; ++ii)
+	{
+		bgfx::destroy(texture[ii]);
+	}
+
+	bgfx::destroy(sampler[0]);
+	bgfx::destroy(sampler[1]);
+
+	bgfx::shutdown();
+
+	return true;
+}
+
+// First-fit NonLocalAllocator used before TLSF, kept as baseline for
+// allocator churn test.
+class FirstFitAllocator
+{
+public:
+	static const uint64_t kInvalidBlock = UINT64_MAX;
+
+	void add(uint64_t _ptr, uint32_t _size)
+	{
+		m_free.push_back(Free(_ptr, _size) );
+	}
+
+	uint64_t alloc(uint32_t _size)
+	{
+		_size = bx::max(_size, 16u);
+
+		for (FreeList::iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+		{
+			if (it->m_size >= _size)
+			{
+				uint64_t ptr = it->m_ptr;
+
+				m_used.insert(std::make_pair(ptr, _size) );
+
+				if (it->m_size != _size)
+				{
+					it->m_size -= _size;
+					it->m_ptr  += _size;
+				}
+				else
+				{
+					m_free.erase(it);
+				}
+
+				return ptr;
+			}
+		}
+
+		return kInvalidBlock;
+	}
+
+	void free(uint64_t _block)
+	{
+		UsedList::iterator it = m_used.find(_block);
+		if (it != m_used.end() )
+		{
+			m_free.push_front(Free(it->first, it->second) );
+			m_used.erase(it);
+		}
+
+		compact();
+	}
+
+	void compact()
+	{
+		m_free.sort();
+
+		for (FreeList::iterator it = m_free.begin(), next = it, itEnd = m_free.end(); next != itEnd;)
+		{
+			if ( (it->m_ptr + it->m_size) == next->m_ptr)
+			{
+				it->m_size += next->m_size;
+				next = m_free.erase(next);
+			}
+			else
+			{
+				it = next;
+				++next;
+			}
+		}
+	}
+
+	uint64_t getFreeSize() const
+	{
+		uint64_t size = 0;
+		for (FreeList::const_iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+		{
+			size += it->m_size;
+		}
+
+		return size;
+	}
+
+	uint32_t getMaxFreeSize() const
+	{
+		uint32_t size = 0;
+		for (FreeList::const_iterator it = m_free.begin(), itEnd = m_free.end(); it != itEnd; ++it)
+		{
+			size = bx::max(size, it->m_size);
+		}
+
+		return size;
+	}
+
+private:
+	struct Free
+	{
+		Free(uint64_t _ptr, uint32_t _size)
+			: m_ptr(_ptr)
+			, m_size(_size)
+		{
+		}
+
+		bool operator<(const Free& rhs) const
+		{
+			return m_ptr < rhs.m_ptr;
+		}
+
+		uint64_t m_ptr;
+		uint32_t m_size;
+	};
+
+	typedef std::list<Free> FreeList;
+	FreeList m_free;
+
+	typedef std::unordered_map<uint64_t, uint32_t> UsedList;
+	UsedList m_used;
+};
+
+// Allocation size 0 frees block allocated in slot.
+struct ChurnOp
+{
+	uint32_t m_slot;
+	uint32_t m_size;
+};
+
+static const uint32_t kChurnSlots      = 2048;
+static const uint32_t kChurnRegionSize = 3<<20; // BGFX_CONFIG_DYNAMIC_VERTEX_BUFFER_SIZE
+
+// Records churn of dynamic buffers, mostly small buffers, with occasional
+// large ones. Each op frees slot when it's used, or allocates it.
+static void recordChurn(std::vector<ChurnOp>& _trace, uint32_t _numOps)
+{
+	bx::RngMwc rng;
+
+	bool used[kChurnSlots] = {};
+
+	_trace.resize(_numOps);
+	for (uint32_t ii = 0; ii < _numOps; ++ii)
+	{
+		ChurnOp& op = _trace[ii];
+		op.m_slot = rng.gen() % kChurnSlots;
+
+		if (used[op.m_slot])
+		{
+			op.m_size = 0;
+		}
+		else
+		{
+			const uint32_t bucket = rng.gen() % 100;
+			if (bucket < 75)
+			{
+				op.m_size = 64 + rng.gen() % (4<<10);
+			}
+			else if (bucket < 95)
+			{
+				op.m_size = (4<<10) + rng.gen() % (60<<10);
+			}
+			else
+			{
+				op.m_size = (64<<10) + rng.gen() % (448<<10);
+			}
+		}
+
+		used[op.m_slot] = !used[op.m_slot];
+	}
+}
+
+struct BenchChurn
+{
+	double   m_timeMs;
+	uint32_t m_numRegions; //!< Regions added when no free block was large enough.
+	double   m_fragmentation; //!< 1 - largest free block / total free, at the end of trace.
+};
+
+// Replays trace the way Context uses allocator for dynamic buffers, new
+// region is added when allocation fails.
+template<typename Ty>
+static void benchChurn(BenchChurn& _result, const std::vector<ChurnOp>& _trace)
+{
+	Ty allocator;
+
+	uint64_t ptr[kChurnSlots];
+	uint32_t numRegions = 0;
+
+	const int64_t begin = bx::getHPCounter();
+
+	for (uint32_t ii = 0, num = uint32_t(_trace.size() ); ii < num; ++ii)
+	{
+		const ChurnOp& op = _trace[ii];
+
+		if (0 == op.m_size)
+		{
+			allocator.free(ptr[op.m_slot]);
+		}
+		else
+		{
+			ptr[op.m_slot] = allocator.alloc(op.m_size);
+
+			if (Ty::kInvalidBlock == ptr[op.m_slot])
+			{
+				++numRegions;
+				allocator.add(uint64_t(numRegions)<<32, bx::max(kChurnRegionSize, op.m_size) );
+				ptr[op.m_slot] = allocator.alloc(op.m_size);
+			}
+		}
+	}
+
+	const int64_t end = bx::getHPCounter();
+
+	const uint64_t freeSize = allocator.getFreeSize();
+
+	_result.m_timeMs        = 1000.0 * double(end - begin) / double(bx::getHPFrequency() );
+	_result.m_numRegions    = numRegions;
+	_result.m_fragmentation = 0 == freeSize ? 0.0 : 1.0 - double(allocator.getMaxFreeSize() ) / double(freeSize);
+}
+
+struct AtlasRect
+{
+	uint16_t m_x;
+	uint16_t m_y;
+	uint16_t m_width;
+	uint16_t m_height;
+};
+
+typedef bgfx::TextureUpdateT<AtlasRect> AtlasUpdate;
+
+static const uint16_t kAtlasSize         = 512;
+static const uint32_t kAtlasMaxMergeSize = 64<<10; // BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_SIZE
+static const uint32_t kAtlasMaxWaste     = 25;     // BGFX_CONFIG_MAX_TEXTURE_UPDATE_MERGE_WASTE
+
+struct BenchAtlas
+{
+	uint32_t m_numUpdates;
+	uint32_t m_numUploads;
+	double   m_waste;      //!< Uploaded texels not written by any update, in percent.
+	uint32_t m_numErrors;  //!< Glyph texels that don't match after merged uploads.
+	uint32_t m_numStatsErrors; //!< Frames where uploads reported by bgfx don't match merged updates.
+};
+
+// Packs glyphs of mixed sizes into R8 atlas with shelf packer, few glyphs
+// per frame, like font cache does. Each frame's updates are submitted with
+// bgfx::updateTexture2D to noop renderer, and number of uploads and bytes
+// uploaded by Context::flushTextureUpdateBatch must match updates merged
+// and staged into CPU copy of atlas with the same helpers. Every glyph
+// written so far must be intact after each frame.
+static bool benchAtlas(BenchAtlas& _result, bool _atlas)
+{
+	if (!benchInit(0) )
+	{
+		return false;
+	}
+
+	// Texture without BGFX_TEXTURE_ATLAS flag merges only updates which
+	// union is rect.
+	const uint32_t maxWaste = _atlas ? kAtlasMaxWaste : 0;
+
+	bgfx::TextureHandle texture = bgfx::createTexture2D(
+		  kAtlasSize
+		, kAtlasSize
+		, false
+		, 1
+		, bgfx::TextureFormat::R8
+		, _atlas ? BGFX_TEXTURE_ATLAS : BGFX_TEXTURE_NONE
+		);
+
+	bx::RngMwc rng;
+
+	std::vector<uint8_t>      atlas(kAtlasSize*kAtlasSize, 0);
+	std::vector<uint8_t>      expected(kAtlasSize*kAtlasSize, 0);
+	std::vector<bool>         written(kAtlasSize*kAtlasSize, false);
+	std::vector<uint8_t>      scratch(kAtlasMaxMergeSize);
+	std::vector<AtlasRect>    rects;
+	std::vector<AtlasUpdate>  updates;
+	std::vector<bgfx::Memory> mems;
+	std::vector<uint8_t>      data;
+
+	uint32_t shelfX = 0;
+	uint32_t shelfY = 0;
+	uint32_t shelfHeight = 0;
+	uint64_t uploaded = 0;
+	uint64_t useful   = 0;
+
+	uint32_t lastUpdates    = 0;
+	uint32_t lastUploads    = 0;
+	uint32_t lastUploadSize = 0;
+
+	_result.m_numUpdates     = 0;
+	_result.m_numUploads     = 0;
+	_result.m_numStatsErrors = 0;
+
+	for (bool full = false; !full;)
+	{
+		rects.clear();
+
+		const uint32_t numGlyphs = 1 + rng.gen() % 24;
+		for (uint32_t ii = 0; ii < numGlyphs; ++ii)
+		{
+			// Mostly small glyphs, with occasional large ones.
+			const uint32_t big    = 0 == rng.gen() % 8;
+			const uint16_t width  = uint16_t( (big ? 24 : 4) + rng.gen() % (big ? 40 : 12) );
+			const uint16_t height = uint16_t( (big ? 24 : 8) + rng.gen() % (big ? 40 : 10) );
+
+			if (shelfX + width > kAtlasSize)
+			{
+				shelfX = 0;
+				shelfY += shelfHeight;
+				shelfHeight = 0;
+			}
+
+			if (shelfY + height > kAtlasSize)
+			{
+				full = true;
+				break;
+			}
+
+			AtlasRect rect = { uint16_t(shelfX), uint16_t(shelfY), width, height };
+			rects.push_back(rect);
+
+			shelfX += width;
+			shelfHeight = bx::max<uint32_t>(shelfHeight, height);
+		}
+
+		// Glyph texels are never 0, so that cleared texels stand out.
+		data.clear();
+		for (uint32_t ii = 0, num = uint32_t(rects.size() ); ii < num; ++ii)
+		{
+			const AtlasRect& rect = rects[ii];
+			for (uint32_t yy = 0; yy < rect.m_height; ++yy)
+			{
+				for (uint32_t xx = 0; xx < rect.m_width; ++xx)
+				{
+					const uint8_t texel = uint8_t(1 + rng.gen() % 255);
+					data.push_back(texel);
+
+					const uint32_t idx = (rect.m_y+yy)*kAtlasSize + rect.m_x+xx;
+					expected[idx] = texel;
+					written[idx]  = true;
+				}
+			}
+		}
+
+		const uint32_t num = uint32_t(rects.size() );
+
+		mems.resize(num);
+		updates.resize(num);
+
+		uint32_t offset = 0;
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			const AtlasRect& rect = rects[ii];
+			const uint32_t size = rect.m_width*rect.m_height;
+
+			mems[ii].data = &data[offset];
+			mems[ii].size = size;
+			offset += size;
+
+			AtlasUpdate& update = updates[ii];
+			update.m_rect  = rect;
+			update.m_mem   = &mems[ii];
+			update.m_z     = 0;
+			update.m_depth = 1;
+			update.m_pitch = UINT16_MAX;
+
+			bgfx::updateTexture2D(texture, 0, 0, rect.m_x, rect.m_y, rect.m_width, rect.m_height, bgfx::copy(mems[ii].data, size) );
+		}
+
+		uint32_t numUploads = 0;
+		uint32_t uploadSize = 0;
+
+		for (uint32_t jj = 0; jj < num; ++numUploads)
+		{
+			AtlasRect rect;
+			uint32_t covered;
+			const uint32_t end = bgfx::mergeTextureUpdates(rect, covered, updates.data(), jj, num, 8, maxWaste, kAtlasMaxMergeSize);
+
+			const uint8_t* src = mems[jj].data;
+			if (end - jj != 1)
+			{
+				bgfx::stageTextureUpdates(scratch.data(), rect, covered, updates.data(), jj, end, 8);
+				src = scratch.data();
+			}
+
+			bx::memCopy(&atlas[rect.m_y*kAtlasSize + rect.m_x]
+				, src
+				, rect.m_width
+				, rect.m_height
+				, rect.m_width
+				, kAtlasSize
+				);
+
+			for (uint32_t kk = jj; kk < end; ++kk)
+			{
+				useful += mems[kk].size;
+			}
+
+			uploadSize += rect.m_width*rect.m_height;
+
+			jj = end;
+		}
+
+		bgfx::frame();
+
+		// Stats are of frame rendered by previous bgfx::frame call.
+		const bgfx::Stats* stats = bgfx::getStats();
+		if (lastUpdates    != stats->numTextureUpdates
+		||  lastUploads    != stats->numTextureUploads
+		||  lastUploadSize != stats->textureUploadSize)
+		{
+			++_result.m_numStatsErrors;
+		}
+
+		lastUpdates    = num;
+		lastUploads    = numUploads;
+		lastUploadSize = uploadSize;
+
+		uploaded += uploadSize;
+		_result.m_numUpdates += num;
+		_result.m_numUploads += numUploads;
+	}
+
+	bgfx::frame();
+
+	const bgfx::Stats* stats = bgfx::getStats();
+	if (lastUpdates    != stats->numTextureUpdates
+	||  lastUploads    != stats->numTextureUploads
+	||  lastUploadSize != stats->textureUploadSize)
+	{
+		++_result.m_numStatsErrors;
+	}
+
+	bgfx::destroy(texture);
+
+	bgfx::shutdown();
+
+	_result.m_numErrors = 0;
+	for (uint32_t ii = 0; ii < kAtlasSize*kAtlasSize; ++ii)
+	{
+		if (written[ii]
+		&&  atlas[ii] != expected[ii])
+		{
+			++_result.m_numErrors;
+		}
+	}
+
+	_result.m_waste = 0 == uploaded ? 0.0 : 100.0 * double(uploaded - useful) / double(uploaded);
+
+	return true;
+}
+
+// Scenario submits one frame worth of API calls, and returns number of
+// operations submitted. Operation is draw call, except for texture scenario
+// where it's texture update.
+struct BX_NO_VTABLE BenchScenarioI
+{
+	virtual ~BenchScenarioI() = 0;
+	virtual void create() = 0;
+	virtual uint32_t submit() = 0;
+	virtual void destroy() = 0;
+};
+
+inline BenchScenarioI::~BenchScenarioI()
+{
+}
+
+struct StaticGeometry
+{
+	void create()
+	{
+		m_decl.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.end();
+
+		m_vbh = bgfx::createVertexBuffer(bgfx::makeRef(s_triangleVertices, sizeof(s_triangleVertices) ), m_decl);
+		m_ibh = bgfx::createIndexBuffer(bgfx::makeRef(s_triangleIndices, sizeof(s_triangleIndices) ) );
+	}
+
+	void destroy()
+	{
+		bgfx::destroy(m_ibh);
+		bgfx::destroy(m_vbh);
+	}
+
+	bgfx::VertexDecl         m_decl;
+	bgfx::VertexBufferHandle m_vbh;
+	bgfx::IndexBufferHandle  m_ibh;
+};
+
+static const uint32_t kStaticDraws = (64<<10)-2;
+
+// Draw calls with own transform, spread over views, with scattered depth.
+static void submitStatic(bgfx::Encoder* _encoder, const StaticGeometry& _geometry, uint32_t _begin, uint32_t _end)
+{
+	const bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
+
+	float mtx[16];
+	for (uint32_t ii = _begin; ii < _end; ++ii)
+	{
+		bx::mtxTranslate(mtx, float(ii), 0.0f, 0.0f);
+		_encoder->setTransform(mtx);
+		_encoder->setVertexBuffer(0, _geometry.m_vbh);
+		_encoder->setIndexBuffer(_geometry.m_ibh);
+		_encoder->setState(BGFX_STATE_DEFAULT);
+		_encoder->submit(bgfx::ViewId(ii % kNumViews), program, ii*UINT32_C(0x9e3779b1) );
+	}
+}
+
+struct ScenarioStatic : public BenchScenarioI
+{
+	void create()
+	{
+		m_geometry.create();
+	}
+
+	uint32_t submit()
+	{
+		bgfx::Encoder* encoder = bgfx::begin();
+		submitStatic(encoder, m_geometry, 0, kStaticDraws);
+		bgfx::end(encoder);
+
+		return kStaticDraws;
+	}
+
+	void destroy()
+	{
+		m_geometry.destroy();
+	}
+
+	StaticGeometry m_geometry;
+};
+
+// Static draws split between worker threads, each submitting with its own
+// encoder. Submit time is wall time until all workers are done.
+struct ScenarioEncoders : public BenchScenarioI
+{
+	static const uint32_t kMaxThreads = 16;
+
+	ScenarioEncoders(uint32_t _numThreads)
+		: m_numThreads(bx::min(_numThreads, kMaxThreads) )
+		, m_exit(false)
+	{
+	}
+
+	void create()
+	{
+		m_geometry.create();
+		m_exit = false;
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			Worker& worker = m_worker[ii];
+			worker.m_owner = this;
+			worker.m_begin = kStaticDraws *  ii    / m_numThreads;
+			worker.m_end   = kStaticDraws * (ii+1) / m_numThreads;
+			worker.m_thread.init(threadFunc, &worker, 0, "bench - encoder");
+		}
+	}
+
+	uint32_t submit()
+	{
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_worker[ii].m_start.post();
+		}
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_done.wait();
+		}
+
+		return kStaticDraws;
+	}
+
+	void destroy()
+	{
+		m_exit = true;
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_worker[ii].m_start.post();
+			m_worker[ii].m_thread.shutdown();
+		}
+
+		m_geometry.destroy();
+	}
+
+	struct Worker
+	{
+		ScenarioEncoders* m_owner;
+		bx::Thread        m_thread;
+		bx::Semaphore     m_start;
+		uint32_t          m_begin;
+		uint32_t          m_end;
+	};
+
+	static int32_t threadFunc(bx::Thread* _self, void* _userData)
+	{
+		BX_UNUSED(_self);
+
+		Worker* worker = (Worker*)_userData;
+		ScenarioEncoders* owner = worker->m_owner;
+
+		for (;;)
+		{
+			worker->m_start.wait();
+
+			if (owner->m_exit)
+			{
+				break;
+			}
+
+			bgfx::Encoder* encoder = bgfx::begin(true);
+			if (NULL != encoder)
+			{
+				submitStatic(encoder, owner->m_geometry, worker->m_begin, worker->m_end);
+				bgfx::end(encoder);
+			}
+
+			owner->m_done.post();
+		}
+
+		return bx::kExitSuccess;
+	}
+
+	StaticGeometry m_geometry;
+	Worker         m_worker[kMaxThreads];
+	bx::Semaphore  m_done;
+	uint32_t       m_numThreads;
+	volatile bool  m_exit;
+};
+
+// Material with several uniforms, different value for each draw call so
+// that no uniform is skipped as redundant.
+struct ScenarioUniforms : public BenchScenarioI
+{
+	static const uint32_t kDraws = 16<<10;
+
+	void create()
+	{
+		m_geometry.create();
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_vec4); ++ii)
+		{
+			char name[32];
+			bx::snprintf(name, sizeof(name), "u_bench%d", ii);
+			m_vec4[ii] = bgfx::createUniform(name, bgfx::UniformType::Vec4);
+		}
+
+		m_mtx = bgfx::createUniform("u_benchMtx", bgfx::UniformType::Mat4);
+	}
+
+	uint32_t submit()
+	{
+		const bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
+
+		bgfx::Encoder* encoder = bgfx::begin();
+
+		float mtx[16];
+		for (uint32_t ii = 0; ii < kDraws; ++ii)
+		{
+			const float value[4] = { float(ii), 1.0f, 2.0f, 3.0f };
+			for (uint32_t jj = 0; jj < BX_COUNTOF(m_vec4); ++jj)
+			{
+				encoder->setUniform(m_vec4[jj], value);
+			}
+
+			bx::mtxTranslate(mtx, float(ii), 0.0f, 0.0f);
+			encoder->setUniform(m_mtx, mtx);
+
+			encoder->setTransform(mtx);
+			encoder->setVertexBuffer(0, m_geometry.m_vbh);
+			encoder->setIndexBuffer(m_geometry.m_ibh);
+			encoder->setState(BGFX_STATE_DEFAULT);
+			encoder->submit(bgfx::ViewId(ii % kNumViews), program, ii);
+		}
+
+		bgfx::end(encoder);
+
+		return kDraws;
+	}
+
+	void destroy()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_vec4); ++ii)
+		{
+			bgfx::destroy(m_vec4[ii]);
+		}
+
+		bgfx::destroy(m_mtx);
+		m_geometry.destroy();
+	}
+
+	StaticGeometry      m_geometry;
+	bgfx::UniformHandle m_vec4[4];
+	bgfx::UniformHandle m_mtx;
+};
+
+// Every draw call allocates and fills its own transient geometry.
+struct ScenarioTransient : public BenchScenarioI
+{
+	static const uint32_t kDraws = 16<<10;
+
+	void create()
+	{
+		m_decl.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.end();
+	}
+
+	uint32_t submit()
+	{
+		const bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
+
+		bgfx::Encoder* encoder = bgfx::begin();
+
+		uint32_t num = 0;
+		for (; num < kDraws; ++num)
+		{
+			bgfx::TransientVertexBuffer tvb;
+			bgfx::TransientIndexBuffer  tib;
+			if (!bgfx::allocTransientBuffers(&tvb, m_decl, BX_COUNTOF(s_triangleVertices), &tib, BX_COUNTOF(s_triangleIndices) ) )
+			{
+				break;
+			}
+
+			bx::memCopy(tvb.data, s_triangleVertices, sizeof(s_triangleVertices) );
+			bx::memCopy(tib.data, s_triangleIndices,  sizeof(s_triangleIndices) );
+
+			encoder->setVertexBuffer(0, &tvb);
+			encoder->setIndexBuffer(&tib);
+			encoder->setState(BGFX_STATE_DEFAULT);
+			encoder->submit(bgfx::ViewId(num % kNumViews), program, num);
+		}
+
+		bgfx::end(encoder);
+
+		return num;
+	}
+
+	void destroy()
+	{
+	}
+
+	bgfx::VertexDecl m_decl;
+};
+
+// Dynamic buffers updated every frame, part of them destroyed and created
+// again, so that pooled buffer allocator churns.
+struct ScenarioDynamic : public BenchScenarioI
+{
+	static const uint32_t kBuffers  = 1024;
+	static const uint32_t kRecreate = 128;
+
+	void create()
+	{
+		m_decl.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.end();
+
+		for (uint32_t ii = 0; ii < kBuffers; ++ii)
+		{
+			m_dvbh[ii] = bgfx::createDynamicVertexBuffer(BX_COUNTOF(s_triangleVertices), m_decl);
+		}
+
+		m_next = 0;
+	}
+
+	uint32_t submit()
+	{
+		const bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
+
+		for (uint32_t ii = 0; ii < kRecreate; ++ii)
+		{
+			bgfx::destroy(m_dvbh[m_next]);
+			m_dvbh[m_next] = bgfx::createDynamicVertexBuffer(BX_COUNTOF(s_triangleVertices), m_decl);
+			m_next = (m_next + 1) % kBuffers;
+		}
+
+		bgfx::Encoder* encoder = bgfx::begin();
+
+		for (uint32_t ii = 0; ii < kBuffers; ++ii)
+		{
+			bgfx::update(m_dvbh[ii], 0, bgfx::copy(s_triangleVertices, sizeof(s_triangleVertices) ) );
+
+			encoder->setVertexBuffer(0, m_dvbh[ii]);
+			encoder->setState(BGFX_STATE_DEFAULT);
+			encoder->submit(bgfx::ViewId(ii % kNumViews), program, ii);
+		}
+
+		bgfx::end(encoder);
+
+		return kBuffers;
+	}
+
+	void destroy()
+	{
+		for (uint32_t ii = 0; ii < kBuffers; ++ii)
+		{
+			bgfx::destroy(m_dvbh[ii]);
+		}
+	}
+
+	bgfx::VertexDecl m_decl;
+	bgfx::DynamicVertexBufferHandle m_dvbh[kBuffers];
+	uint32_t m_next;
+};
+
+// Many small texture updates per frame, with draw call sampling each
+// texture.
+struct ScenarioTexture : public BenchScenarioI
+{
+	static const uint32_t kTextures = 16;
+	static const uint32_t kUpdates  = 1024;
+	static const uint16_t kSize     = 256;
+	static const uint16_t kTile     = 16;
+
+	void create()
+	{
+		m_geometry.create();
+
+		for (uint32_t ii = 0; ii < kTextures; ++ii)
+		{
+			m_texture[ii] = bgfx::createTexture2D(kSize, kSize, false, 1, bgfx::TextureFormat::RGBA8);
+		}
+
+		m_sampler = bgfx::createUniform("s_bench", bgfx::UniformType::Sampler);
+	}
+
+	uint32_t submit()
+	{
+		const bgfx::ProgramHandle program = BGFX_INVALID_HANDLE;
+		const uint16_t tilesPerRow = kSize/kTile;
+
+		for (uint32_t ii = 0; ii < kUpdates; ++ii)
+		{
+			const uint32_t tile = (ii / kTextures) % (tilesPerRow*tilesPerRow);
+			bgfx::updateTexture2D(m_texture[ii % kTextures]
+				, 0
+				, 0
+				, uint16_t(tile % tilesPerRow * kTile)
+				, uint16_t(tile / tilesPerRow * kTile)
+				, kTile
+				, kTile
+				, bgfx::alloc(kTile*kTile*4)
+				);
+		}
+
+		bgfx::Encoder* encoder = bgfx::begin();
+
+		for (uint32_t ii = 0; ii < kTextures; ++ii)
+		{
+			encoder->setTexture(0, m_sampler, m_texture[ii]);
+			encoder->setVertexBuffer(0, m_geometry.m_vbh);
+			encoder->setIndexBuffer(m_geometry.m_ibh);
+			encoder->setState(BGFX_STATE_DEFAULT);
+			encoder->submit(0, program);
+		}
+
+		bgfx::end(encoder);
+
+		return kUpdates;
+	}
+
+	void destroy()
+	{
+		for (uint32_t ii = 0; ii < kTextures; ++ii)
+		{
+			bgfx::destroy(m_texture[ii]);
+		}
+
+		bgfx::destroy(m_sampler);
+		m_geometry.destroy();
+	}
+
+	StaticGeometry      m_geometry;
+	bgfx::TextureHandle m_texture[kTextures];
+	bgfx::UniformHandle m_sampler;
+};
+
+struct BenchScenario
+{
+	Timing   m_submit; //!< API thread, scenario's API calls.
+	Timing   m_sort;   //!< Render side sort (Phase::Sort).
+	Timing   m_walk;   //!< Render side render item walk, renderer submit without sort.
+	Timing   m_frame;  //!< bgfx::frame, render side command execution included.
+	uint32_t m_numOps;
+};
+
+static bool benchScenario(BenchScenario& _result, BenchScenarioI& _scenario, uint32_t _numFrames)
+{
+	if (!benchInit(0) )
+	{
+		return false;
+	}
+
+	_scenario.create();
+
+	_result.m_submit.reset();
+	_result.m_sort.reset();
+	_result.m_walk.reset();
+	_result.m_frame.reset();
+	_result.m_numOps = 0;
+
+	const uint32_t kWarmUpFrames = 4;
+
+	for (uint32_t frame = 0, num = _numFrames+kWarmUpFrames; frame < num; ++frame)
+	{
+		const int64_t submitBegin = bx::getHPCounter();
+		const uint32_t numOps = _scenario.submit();
+		const int64_t submitEnd = bx::getHPCounter();
+
+		bgfx::frame();
+		const int64_t frameEnd = bx::getHPCounter();
+
+		const bgfx::Stats* stats = bgfx::getStats();
+		if (frame >= kWarmUpFrames)
+		{
+			_result.m_submit.add(submitEnd - submitBegin);
+			const int64_t sort = int64_t(double(stats->phaseStats[bgfx::Phase::Sort].last)*double(bx::getHPFrequency() )/1000000000.0);
+			_result.m_sort.add(sort);
+			_result.m_walk.add(stats->cpuTimeEnd - stats->cpuTimeBegin - sort);
+			_result.m_frame.add(frameEnd - submitEnd);
+			_result.m_numOps = numOps;
+		}
+	}
+
+	_scenario.destroy();
+
+	bgfx::shutdown();
+
+	return true;
+}
+
+static const uint16_t kGlCheckSize = 64;
+
+// Screen shots are compared against quadrants drawn in frame that requested
+// them. Read back can complete few frames later, but always in order.
+struct GlCheckCallback : public bgfx::CallbackI
+{
+	GlCheckCallback()
+		: m_numChecked(0)
+		, m_numErrors(0)
+	{
+	}
+
+	virtual ~GlCheckCallback()
+	{
+	}
+
+	virtual void fatal(const char* _filePath, uint16_t _line, bgfx::Fatal::Enum _code, const char* _str) override
+	{
+		bx::printf("%s (%d): Fatal error 0x%08x: %s\n", _filePath, _line, _code, _str);
+
+		if (bgfx::Fatal::DebugCheck != _code)
+		{
+			abort();
+		}
+	}
+
+	virtual void traceVargs(const char* /*_filePath*/, uint16_t /*_line*/, const char* /*_format*/, va_list /*_argList*/) override
+	{
+	}
+
+	virtual void profilerBegin(const char* /*_name*/, uint32_t /*_abgr*/, const char* /*_filePath*/, uint16_t /*_line*/) override
+	{
+	}
+
+	virtual void profilerBeginLiteral(const char* /*_name*/, uint32_t /*_abgr*/, const char* /*_filePath*/, uint16_t /*_line*/) override
+	{
+	}
+
+	virtual void profilerEnd() override
+	{
+	}
+
+	virtual uint32_t cacheReadSize(uint64_t /*_id*/) override
+	{
+		return 0;
+	}
+
+	virtual bool cacheRead(uint64_t /*_id*/, void* /*_data*/, uint32_t /*_size*/) override
+	{
+		return false;
+	}
+
+	virtual void cacheWrite(uint64_t /*_id*/, const void* /*_data*/, uint32_t /*_size*/) override
+	{
+	}
+
+	virtual void screenShot(const char* /*_filePath*/, uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _data, uint32_t /*_size*/, bool _yflip) override
+	{
+		if (m_expected.empty() )
+		{
+			++m_numErrors;
+			return;
+		}
+
+		// Dynamic buffer quad is red, transient buffer quad is green in
+		// opposite quadrant, and other quadrants are cleared to black.
+		const uint32_t dynamicQuadrant   = m_expected.front();
+		const uint32_t transientQuadrant = (dynamicQuadrant+2) % 4;
+		m_expected.pop_front();
+
+		for (uint32_t quadrant = 0; quadrant < 4; ++quadrant)
+		{
+			const uint32_t xx  = (quadrant&1) ? _width *3/4 : _width /4;
+			const uint32_t yy  = (quadrant&2) ? _height*3/4 : _height/4;
+			const uint32_t row = _yflip ? yy : _height-yy-1;
+
+			const uint8_t* bgra = (const uint8_t*)_data + row*_pitch + xx*4;
+			const bool red   = bgra[2] > 128;
+			const bool green = bgra[1] > 128;
+
+			const bool valid = quadrant == dynamicQuadrant   ?  red && !green
+				:              quadrant == transientQuadrant ? !red &&  green
+				:                                              !red && !green
+				;
+
+			if (!valid)
+			{
+				++m_numErrors;
+				break;
+			}
+		}
+
+		++m_numChecked;
+	}
+
+	virtual void captureBegin(uint32_t /*_width*/, uint32_t /*_height*/, uint32_t /*_pitch*/, bgfx::TextureFormat::Enum /*_format*/, bool /*_yflip*/) override
+	{
+	}
+
+	virtual void captureEnd() override
+	{
+	}
+
+	virtual void captureFrame(const void* /*_data*/, uint32_t /*_size*/) override
+	{
+	}
+
+	std::list<uint32_t> m_expected;
+	uint32_t m_numChecked;
+	uint32_t m_numErrors;
+};
+
+static void quadVertices(PosVertex* _vertices, uint32_t _quadrant)
+{
+	const float x0 = (_quadrant&1) ? 0.0f : -1.0f;
+	const float y0 = (_quadrant&2) ? 0.0f : -1.0f;
+
+	const PosVertex vertices[4] =
+	{
+		{ x0,      y0,      0.0f },
+		{ x0+1.0f, y0,      0.0f },
+		{ x0,      y0+1.0f, 0.0f },
+		{ x0+1.0f, y0+1.0f, 0.0f },
+	};
+
+	bx::memCopy(_vertices, vertices, sizeof(vertices) );
+}
+
+static const uint16_t s_quadIndices[] = { 0, 1, 2, 1, 3, 2 };
+
+struct GlCheck
+{
+	bgfx::RendererType::Enum m_type;
+	uint32_t m_numFrames;
+	uint32_t m_numChecked;
+	uint32_t m_numErrors;
+};
+
+// Every frame moves quad drawn from dynamic vertex buffer, and quad drawn from
+// transient buffers, to other quadrant, and reads back result. Data written to
+// buffer storage still used by frame in flight shows up as quad in quadrant of
+// other frame.
+static bool glCheck(GlCheck& _result, uint32_t _numFrames)
+{
+	bgfx::RendererType::Enum renderers[bgfx::RendererType::Count];
+	const uint8_t num = bgfx::getSupportedRenderers(BX_COUNTOF(renderers), renderers);
+
+	_result.m_type = bgfx::RendererType::Count;
+	for (uint8_t ii = 0; ii < num; ++ii)
+	{
+		if (bgfx::RendererType::OpenGL   == renderers[ii]
+		||  bgfx::RendererType::OpenGLES == renderers[ii])
+		{
+			_result.m_type = renderers[ii];
+			break;
+		}
+	}
+
+	if (bgfx::RendererType::Count == _result.m_type)
+	{
+		return false;
+	}
+
+	GlCheckCallback callback;
+
+	// Without native window handle EGL context renders into pbuffer.
+	bgfx::Init init;
+	init.type              = _result.m_type;
+	init.resolution.width  = kGlCheckSize;
+	init.resolution.height = kGlCheckSize;
+	init.resolution.reset  = BGFX_RESET_NONE;
+	init.callback          = &callback;
+
+	if (!bgfx::init(init) )
+	{
+		return false;
+	}
+
+	bgfx::VertexDecl decl;
+	decl.begin()
+		.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+		.end();
+
+	bgfx::ShaderHandle  vsh     = bgfx::createShader(bgfx::makeRef(vs_clear_glsl,  sizeof(vs_clear_glsl)  ) );
+	bgfx::ShaderHandle  fsh     = bgfx::createShader(bgfx::makeRef(fs_clear0_glsl, sizeof(fs_clear0_glsl) ) );
+	bgfx::ProgramHandle program = bgfx::createProgram(vsh, fsh, true);
+
+	// Uniforms used by embedded clear shaders.
+	bgfx::UniformHandle clearColor = bgfx::createUniform("bgfx_clear_color", bgfx::UniformType::Vec4, 8);
+	bgfx::UniformHandle clearDepth = bgfx::createUniform("bgfx_clear_depth", bgfx::UniformType::Vec4);
+
+	bgfx::DynamicVertexBufferHandle dvbh = bgfx::createDynamicVertexBuffer(4, decl);
+	bgfx::IndexBufferHandle         ibh  = bgfx::createIndexBuffer(bgfx::makeRef(s_quadIndices, sizeof(s_quadIndices) ) );
+
+	bgfx::setViewClear(0, BGFX_CLEAR_COLOR, 0x000000ff);
+	bgfx::setViewRect(0, 0, 0, kGlCheckSize, kGlCheckSize);
+
+	const float red[4]   = { 1.0f, 0.0f, 0.0f, 1.0f };
+	const float green[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
+	const float depth[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	const uint64_t state = 0
+		| BGFX_STATE_WRITE_RGB
+		| BGFX_STATE_WRITE_A
+		;
+
+	_result.m_numFrames = 0;
+	uint32_t numErrors  = 0;
+
+	for (uint32_t frame = 0; frame < _numFrames; ++frame)
+	{
+		const uint32_t quadrant = frame % 4;
+
+		PosVertex quad[4];
+		quadVertices(quad, quadrant);
+		bgfx::update(dvbh, 0, bgfx::copy(quad, sizeof(quad) ) );
+
+		bgfx::TransientVertexBuffer tvb;
+		bgfx::TransientIndexBuffer  tib;
+		if (!bgfx::allocTransientBuffers(&tvb, decl, 4, &tib, BX_COUNTOF(s_quadIndices) ) )
+		{
+			++numErrors;
+			break;
+		}
+
+		quadVertices( (PosVertex*)tvb.data, (quadrant+2) % 4);
+		bx::memCopy(tib.data, s_quadIndices, sizeof(s_quadIndices) );
+
+		bgfx::setUniform(clearDepth, depth);
+		bgfx::setUniform(clearColor, red);
+		bgfx::setVertexBuffer(0, dvbh);
+		bgfx::setIndexBuffer(ibh);
+		bgfx::setState(state);
+		bgfx::submit(0, program);
+
+		bgfx::setUniform(clearDepth, depth);
+		bgfx::setUniform(clearColor, green);
+		bgfx::setVertexBuffer(0, &tvb);
+		bgfx::setIndexBuffer(&tib);
+		bgfx::setState(state);
+		bgfx::submit(0, program);
+
+		bgfx::requestScreenShot(BGFX_INVALID_HANDLE, "gl");
+		callback.m_expected.push_back(quadrant);
+
+		bgfx::frame();
+		++_result.m_numFrames;
+	}
+
+	// Wait for outstanding read backs, pending ones are dropped on shutdown.
+	for (uint32_t ii = 0; ii < 16 && !callback.m_expected.empty(); ++ii)
+	{
+		bgfx::frame();
+	}
+
+	_result.m_numChecked = callback.m_numChecked;
+	_result.m_numErrors  = callback.m_numErrors + numErrors + uint32_t(callback.m_expected.size() );
+
+	bgfx::destroy(ibh);
+	bgfx::destroy(dvbh);
+	bgfx::destroy(clearDepth);
+	bgfx::destroy(clearColor);
+	bgfx::destroy(program);
+
+	bgfx::shutdown();
+
+	return true;
+}
+
+static double nsPerOp(const Timing& _timing, uint32_t _numOps)
+{
+	return 0 == _numOps ? 0.0 : _timing.avgMs()*1000000.0/double(_numOps);
+}
+
+void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		bx::printf("Error:\n%s\n\n", _error);
+	}
+
+	bx::printf(
+		  "bench, bgfx headless CPU benchmark, version %d.%d.%d.\n"
+		  "Copyright 2011-2019 Branimir Karadzic. All rights reserved.\n"
+		  "License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause\n\n"
+		, BGFX_BENCH_VERSION_MAJOR
+		, BGFX_BENCH_VERSION_MINOR
+		, BGFX_API_VERSION
+		);
+
+	bx::printf(
+		  "Usage: bench [options]\n"
+
+		  "\n"
+		  "Options:\n"
+		  "  -h, --help               Help.\n"
+		  "  -v, --version            Version information only.\n"
+		  "  -n, --frames <num>       Number of measured frames per test (default 64).\n"
+		  "                           Submit test alternates per-draw and batched frames.\n"
+		  "  -e, --encoders <num>     Number of encoders for merge test (default 4).\n"
+		  "  -t, --threads <num>      Number of sort helper threads to compare against\n"
+		  "                           single-threaded sort (default 4).\n"
+		  "  -c, --churn <num>        Number of dynamic buffer alloc/free ops replayed\n"
+		  "                           against buffer allocators (default 100000).\n"
+		  "  -s, --scenario <name>    Run only named scenario: static, encoders-<1..16>,\n"
+		  "                           uniforms, transient, dynamic, or texture.\n"
+		  "      --json               Print scenario results only, as JSON.\n"
+		  "      --gl                 Only check transient and dynamic buffer updates with\n"
+		  "                           GL renderer, rendering headless and reading back\n"
+		  "                           every frame.\n"
+
+		  "\n"
+		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
+		);
+}
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('v', "version") )
+	{
+		bx::printf(
+			  "bench, bgfx headless CPU benchmark, version %d.%d.%d.\n"
+			, BGFX_BENCH_VERSION_MAJOR
+			, BGFX_BENCH_VERSION_MINOR
+			, BGFX_API_VERSION
+			);
+		return bx::kExitSuccess;
+	}
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitFailure;
+	}
+
+	uint32_t numFrames = 64;
+	const char* frames = cmdLine.findOption('n', "frames");
+	if (NULL != frames)
+	{
+		bx::fromString(&numFrames, frames);
+	}
+
+	uint32_t numEncoders = 4;
+	const char* encoders = cmdLine.findOption('e', "encoders");
+	if (NULL != encoders)
+	{
+		bx::fromString(&numEncoders, encoders);
+		numEncoders = bx::clamp<uint32_t>(numEncoders, 1, kMaxEncoders-1);
+	}
+
+	uint32_t numThreads = 4;
+	const char* threads = cmdLine.findOption('t', "threads");
+	if (NULL != threads)
+	{
+		bx::fromString(&numThreads, threads);
+	}
+
+	uint32_t numChurnOps = 100000;
+	const char* churn = cmdLine.findOption('c', "churn");
+	if (NULL != churn)
+	{
+		bx::fromString(&numChurnOps, churn);
+	}
+
+	const char* scenarioName = cmdLine.findOption('s', "scenario");
+	const bool json = cmdLine.hasArg("json");
+
+	// Calling bgfx::renderFrame before bgfx::init selects single-threaded
+	// mode, so that scenario frame time includes render side of the frame.
+	bgfx::renderFrame();
+
+	if (cmdLine.hasArg("gl") )
+	{
+		GlCheck result;
+		if (!glCheck(result, numFrames) )
+		{
+			help("Failed to initialize bgfx with GL renderer.");
+			return bx::kExitFailure;
+		}
+
+		bx::printf("%-10s %10s %8s %8s %8s\n"
+			, "gl"
+			, "renderer"
+			, "frames"
+			, "checked"
+			, "errors"
+			);
+
+		bx::printf("%-10s %10s %8d %8d %8d\n"
+			, "buffers"
+			, bgfx::getRendererName(result.m_type)
+			, result.m_numFrames
+			, result.m_numChecked
+			, result.m_numErrors
+			);
+
+		if (0 != result.m_numErrors)
+		{
+			bx::printf("\nError: read back doesn't match transient and dynamic buffer updates.\n");
+			return bx::kExitFailure;
+		}
+
+		return bx::kExitSuccess;
+	}
+
+	ScenarioStatic    scenarioStatic;
+	ScenarioEncoders  scenarioEncoders1(1);
+	ScenarioEncoders  scenarioEncoders2(2);
+	ScenarioEncoders  scenarioEncoders4(4);
+	ScenarioEncoders  scenarioEncoders8(8);
+	ScenarioEncoders  scenarioEncoders16(16);
+	ScenarioUniforms  scenarioUniforms;
+	ScenarioTransient scenarioTransient;
+	ScenarioDynamic   scenarioDynamic;
+	ScenarioTexture   scenarioTexture;
+
+	const struct { const char* name; BenchScenarioI* scenario; } scenarios[] =
+	{
+		{ "static",      &scenarioStatic     },
+		{ "encoders-1",  &scenarioEncoders1  },
+		{ "encoders-2",  &scenarioEncoders2  },
+		{ "encoders-4",  &scenarioEncoders4  },
+		{ "encoders-8",  &scenarioEncoders8  },
+		{ "encoders-16", &scenarioEncoders16 },
+		{ "uniforms",    &scenarioUniforms   },
+		{ "transient",   &scenarioTransient  },
+		{ "dynamic",     &scenarioDynamic    },
+		{ "texture",     &scenarioTexture    },
+	};
+
+	if (json)
+	{
+		bx::printf("{\n"
+			"\t\"version\": \"%d.%d.%d\",\n"
+			"\t\"renderer\": \"%s\",\n"
+			"\t\"frames\": %d,\n"
+			"\t\"scenarios\": ["
+			, BGFX_BENCH_VERSION_MAJOR
+			, BGFX_BENCH_VERSION_MINOR
+			, BGFX_API_VERSION
+			, bgfx::getRendererName(bgfx::RendererType::Noop)
+			, numFrames
+			);
+	}
+	else
+	{
+		bx::printf("%-12s %8s %12s %12s %12s %12s\n"
+			, "scenario"
+			, "ops"
+			, "submit ns/op"
+			, "sort ns/op"
+			, "walk ns/op"
+			, "frame ns/op"
+			);
+	}
+
+	uint32_t numScenarios = 0;
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(scenarios); ++ii)
+	{
+		if (NULL != scenarioName
+		&&  0 != bx::strCmp(scenarioName, scenarios[ii].name) )
+		{
+			continue;
+		}
+
+		BenchScenario result;
+		if (!benchScenario(result, *scenarios[ii].scenario, numFrames) )
+		{
+			help("Failed to initialize bgfx with noop renderer.");
+			return bx::kExitFailure;
+		}
+
+		if (json)
+		{
+			bx::printf("%s\n\t\t{ \"name\": \"%s\", \"ops\": %d, \"submit_ns\": %.3f, \"sort_ns\": %.3f, \"walk_ns\": %.3f, \"frame_ns\": %.3f }"
+				, 0 == numScenarios ? "" : ","
+				, scenarios[ii].name
+				, result.m_numOps
+				, nsPerOp(result.m_submit, result.m_numOps)
+				, nsPerOp(result.m_sort,   result.m_numOps)
+				, nsPerOp(result.m_walk,   result.m_numOps)
+				, nsPerOp(result.m_frame,  result.m_numOps)
+				);
+		}
+		else
+		{
+			bx::printf("%-12s %8d %12.3f %12.3f %12.3f %12.3f\n"
+				, scenarios[ii].name
+				, result.m_numOps
+				, nsPerOp(result.m_submit, result.m_numOps)
+				, nsPerOp(result.m_sort,   result.m_numOps)
+				, nsPerOp(result.m_walk,   result.m_numOps)
+				, nsPerOp(result.m_frame,  result.m_numOps)
+				);
+		}
+
+		++numScenarios;
+	}
+
+	if (json)
+	{
+		bx::printf("\n\t]\n}\n");
+	}
+
+	if (0 == numScenarios)
+	{
+		help("Unknown scenario.");
+		return bx::kExitFailure;
+	}
+
+	if (json
+	||  NULL != scenarioName)
+	{
+		return bx::kExitSuccess;
+	}
+
+	const uint32_t numItems[] =
+	{
+		1<<10,
+		16<<10,
+		(64<<10)-2, // BGFX_CONFIG_MAX_DRAW_CALLS-1 is the last accepted item.
+	};
+
+	struct Config
+	{
+		const char* name;
+		uint32_t numEncoders;
+		uint16_t sortThreads;
+	};
+
+	// Using all encoders produces more runs than Frame::sort merges, which
+	// forces full radix sort.
+	const Config configs[] =
+	{
+		{ "merge",    numEncoders,    0                    },
+		{ "radix",    kMaxEncoders-1, 0                    },
+		{ "radix mt", kMaxEncoders-1, uint16_t(numThreads) },
+	};
+
+	bx::printf("\n%-10s %8s %8s %8s %12s %10s %10s %10s\n"
+		, "sort"
+		, "items"
+		, "encoders"
+		, "threads"
+		, "submit ms"
+		, "min ms"
+		, "avg ms"
+		, "max ms"
+		);
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(numItems); ++ii)
+	{
+		for (uint32_t jj = 0; jj < BX_COUNTOF(configs); ++jj)
+		{
+			const Config& config = configs[jj];
+
+			BenchSort result;
+			if (!benchSort(result, numItems[ii], config.numEncoders, config.sortThreads, numFrames) )
+			{
+				help("Failed to initialize bgfx with noop renderer.");
+				return bx::kExitFailure;
+			}
+
+			bx::printf("%-10s %8d %8d %8d %12.3f %10.3f %10.3f %10.3f\n"
+				, config.name
+				, numItems[ii]
+				, config.numEncoders
+				, config.sortThreads
+				, result.m_submit.avgMs()
+				, result.m_sort.minMs()
+				, result.m_sort.avgMs()
+				, result.m_sort.maxMs()
+				);
+		}
+	}
+
+	const uint32_t numDraws[] =
+	{
+		10000,
+		60000,
+	};
+
+	bx::printf("\n%-10s %8s %10s %10s %10s\n"
+		, "submit"
+		, "draws"
+		, "min ms"
+		, "avg ms"
+		, "max ms"
+		);
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(numDraws); ++ii)
+	{
+		BenchSubmit result;
+		if (!benchSubmit(result, numDraws[ii], numFrames) )
+		{
+			help("Failed to initialize bgfx with noop renderer.");
+			return bx::kExitFailure;
+		}
+
+		bx::printf("%-10s %8d %10.3f %10.3f %10.3f\n"
+			, "per-draw"
+			, numDraws[ii]
+			, result.m_perDraw.minMs()
+			, result.m_perDraw.avgMs()
+			, result.m_perDraw.maxMs()
+			);
+
+		bx::printf("%-10s %8d %10.3f %10.3f %10.3f\n"
+			, "batch"
+			, numDraws[ii]
+			, result.m_batch.minMs()
+			, result.m_batch.avgMs()
+			, result.m_batch.maxMs()
+			);
+	}
+
+	BatchCheck batch;
+	if (!batchCheck(batch) )
+	{
+		help("Failed to initialize bgfx with noop renderer.");
+		return bx::kExitFailure;
+	}
+
+	bx::printf("\n%-10s %8s %10s %10s\n"
+		, "batch"
+		, "draws"
+		, "submitted"
+		, "errors"
+		);
+
+	bx::printf("%-10s %8d %10d %10d\n"
+		, "check"
+		, batch.m_numDraws
+		, batch.m_numSubmitted
+		, batch.m_numErrors
+		);
+
+	if (0 != batch.m_numErrors)
+	{
+		bx::printf("\nError: batched draws don't match the same draws submitted one by one.\n");
+		return bx::kExitFailure;
+	}
+
+	BX_STATIC_ASSERT(kBindDraws > kBindMaxGroups);
+
+	BenchBind bind;
+	if (!benchBind(bind, numFrames) )
+	{
+		help("Failed to initialize bgfx with noop renderer.");
+		return bx::kExitFailure;
+	}
+
+	bx::printf("\n%-10s %8s %10s %10s %10s %10s\n"
+		, "bind"
+		, "draws"
+		, "min ms"
+		, "avg ms"
+		, "max ms"
+		, "errors"
+		);
+
+	bx::printf("%-10s %8d %10.3f %10.3f %10.3f %10d\n"
+		, "shared"
+		, kBindDraws
+		, bind.m_shared.minMs()
+		, bind.m_shared.avgMs()
+		, bind.m_shared.maxMs()
+		, bind.m_numSharedErrors
+		);
+
+	bx::printf("%-10s %8d %10.3f %10.3f %10.3f %10d\n"
+		, "unique"
+		, kBindDraws
+		, bind.m_unique.minMs()
+		, bind.m_unique.avgMs()
+		, bind.m_unique.maxMs()
+		, bind.m_numUniqueErrors
+		);
+
+	if (0 != bind.m_numSharedErrors + bind.m_numUniqueErrors)
+	{
+		bx::printf("\nError: draw calls past bind table limits didn't reach renderer.\n");
+		return bx::kExitFailure;
+	}
+
+	std::vector<ChurnOp> trace;
+	recordChurn(trace, numChurnOps);
+
+	bx::printf("\n%-10s %8s %10s %10s %10s\n"
+		, "allocator"
+		, "ops"
+		, "time ms"
+		, "regions"
+		, "frag %"
+		);
+
+	BenchChurn firstFit;
+	benchChurn<FirstFitAllocator>(firstFit, trace);
+
+	bx::printf("%-10s %8d %10.3f %10d %10.2f\n"
+		, "first-fit"
+		, numChurnOps
+		, firstFit.m_timeMs
+		, firstFit.m_numRegions
+		, firstFit.m_fragmentation*100.0
+		);
+
+	BenchChurn tlsf;
+	benchChurn<bgfx::NonLocalAllocator>(tlsf, trace);
+
+	bx::printf("%-10s %8d %10.3f %10d %10.2f\n"
+		, "tlsf"
+		, numChurnOps
+		, tlsf.m_timeMs
+		, tlsf.m_numRegions
+		, tlsf.m_fragmentation*100.0
+		);
+
+	bx::printf("\n%-10s %8s %10s %10s %10s %10s\n"
+		, "atlas"
+		, "updates"
+		, "uploads"
+		, "waste %"
+		, "errors"
+		, "stats"
+		);
+
+	uint32_t numAtlasErrors = 0;
+	uint32_t numAtlasStatsErrors = 0;
+
+	for (uint32_t ii = 0; ii < 2; ++ii)
+	{
+		const bool atlas = 0 != ii;
+
+		BenchAtlas result;
+		if (!benchAtlas(result, atlas) )
+		{
+			help("Failed to initialize bgfx with noop renderer.");
+			return bx::kExitFailure;
+		}
+
+		char name[16];
+		bx::snprintf(name, sizeof(name), "waste<=%d", atlas ? kAtlasMaxWaste : 0);
+
+		bx::printf("%-10s %8d %10d %10.2f %10d %10d\n"
+			, name
+			, result.m_numUpdates
+			, result.m_numUploads
+			, result.m_waste
+			, result.m_numErrors
+			, result.m_numStatsErrors
+			);
+
+		numAtlasErrors      += result.m_numErrors;
+		numAtlasStatsErrors += result.m_numStatsErrors;
+	}
+
+	if (0 != numAtlasErrors)
+	{
+		bx::printf("\nError: merged atlas updates overwrote glyph texels.\n");
+		return bx::kExitFailure;
+	}
+
+	if (0 != numAtlasStatsErrors)
+	{
+		bx::printf("\nError: texture uploads reported by bgfx don't match merged atlas updates.\n");
+		return bx::kExitFailure;
+	}
+
+	return bx::kExitSuccess;
+}
@@ -0,0 +1,313 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/commandline.h>
+#include <bx/file.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+#include <bgfx/bgfx.h>
+
+#include "../../src/frame_trace.h"
+
+#define BGFX_REPLAY_VERSION_MAJOR 1
+#define BGFX_REPLAY_VERSION_MINOR 1
+
+struct Timing
+{
+	void reset()
+	{
+		m_min = INT64_MAX;
+		m_max = 0;
+		m_sum = 0;
+		m_num = 0;
+	}
+
+	void add(int64_t _time)
+	{
+		m_min  = bx::min(m_min, _time);
+		m_max  = bx::max(m_max, _time);
+		m_sum += _time;
+		++m_num;
+	}
+
+	double toMs(int64_t _time) const
+	{
+		return 1000.0 * double(_time) / double(bx::getHPFrequency() );
+	}
+
+	double minMs() const { return 0 == m_num ? 0.0 : toMs(m_min); }
+	double maxMs() const { return 0 == m_num ? 0.0 : toMs(m_max); }
+	double avgMs() const { return 0 == m_num ? 0.0 : toMs(m_sum) / double(m_num); }
+
+	int64_t  m_min;
+	int64_t  m_max;
+	int64_t  m_sum;
+	uint32_t m_num;
+};
+
+struct Replay
+{
+	void reset()
+	{
+		m_frame.reset();
+		m_submit.reset();
+		m_waitRender.reset();
+		m_waitSubmit.reset();
+
+		for (uint32_t ii = 0; ii < bgfx::Phase::Count; ++ii)
+		{
+			m_phase[ii].reset();
+		}
+
+		m_numFrames = 0;
+	}
+
+	Timing m_frame;      //!< bgfx::frame on API thread, reading trace frame included.
+	Timing m_submit;     //!< Render side sort + renderer submit (Stats::cpuTimeBegin/End).
+	Timing m_waitRender; //!< Stats::waitRender.
+	Timing m_waitSubmit; //!< Stats::waitSubmit.
+	Timing m_phase[bgfx::Phase::Count]; //!< Stats::phaseStats last frame time.
+	uint32_t m_numFrames;
+};
+
+static bool readHeader(bgfx::FrameTraceHeader& _header, const char* _filePath)
+{
+	bx::FileReader reader;
+	if (!bx::open(&reader, _filePath) )
+	{
+		return false;
+	}
+
+	bx::Error err;
+	bx::read(&reader, &_header, sizeof(_header), &err);
+	bx::close(&reader);
+
+	return err.isOk()
+		&& BGFX_CHUNK_MAGIC_FTR == _header.magic
+		;
+}
+
+// Each loop replays whole trace in new bgfx instance, trace creates its own
+// resources in the first frames.
+static bool replay(Replay& _result, const bgfx::FrameTraceHeader& _header, const char* _filePath, bgfx::RendererType::Enum _type)
+{
+	bgfx::Init init;
+	init.type       = _type;
+	init.resolution = _header.resolution;
+	init.limits     = _header.limits;
+
+	if (!bgfx::init(init) )
+	{
+		return false;
+	}
+
+	const uint32_t numFrames = bgfx::frameTraceReplay(_filePath);
+
+	for (uint32_t frame = 0; frame < numFrames; ++frame)
+	{
+		const int64_t frameBegin = bx::getHPCounter();
+		bgfx::frame();
+		const int64_t frameEnd = bx::getHPCounter();
+
+		const bgfx::Stats* stats = bgfx::getStats();
+		_result.m_frame.add(frameEnd - frameBegin);
+		_result.m_submit.add(stats->cpuTimeEnd - stats->cpuTimeBegin);
+		_result.m_waitRender.add(stats->waitRender);
+		_result.m_waitSubmit.add(stats->waitSubmit);
+
+		// Phase times are in nanoseconds.
+		for (uint32_t ii = 0; ii < bgfx::Phase::Count; ++ii)
+		{
+			_result.m_phase[ii].add(stats->phaseStats[ii].last*bx::getHPFrequency()/INT64_C(1000000000) );
+		}
+	}
+
+	_result.m_numFrames += numFrames;
+
+	bgfx::shutdown();
+
+	return 0 != numFrames;
+}
+
+void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		bx::printf("Error:\n%s\n\n", _error);
+	}
+
+	bx::printf(
+		  "bgfx-replay, bgfx frame trace replay, version %d.%d.%d.\n"
+		  "Copyright 2011-2019 Branimir Karadzic. All rights reserved.\n"
+		  "License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause\n\n"
+		, BGFX_REPLAY_VERSION_MAJOR
+		, BGFX_REPLAY_VERSION_MINOR
+		, BGFX_API_VERSION
+		);
+
+	bx::printf(
+		  "Usage: bgfx-replay -f <trace file> [options]\n"
+
+		  "\n"
+		  "Options:\n"
+		  "  -h, --help               Help.\n"
+		  "  -v, --version            Version information only.\n"
+		  "  -f <file path>           Trace file captured with bgfx::frameTraceBegin.\n"
+		  "  -l, --loops <num>        Number of times trace is replayed (default 8).\n"
+		  "      --native             Replay with renderer trace was captured with,\n"
+		  "                           instead of noop renderer. Capture must begin\n"
+		  "                           before application creates any resource.\n"
+
+		  "\n"
+		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
+		);
+}
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('v', "version") )
+	{
+		bx::printf(
+			  "bgfx-replay, bgfx frame trace replay, version %d.%d.%d.\n"
+			, BGFX_REPLAY_VERSION_MAJOR
+			, BGFX_REPLAY_VERSION_MINOR
+			, BGFX_API_VERSION
+			);
+		return bx::kExitSuccess;
+	}
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitFailure;
+	}
+
+	const char* filePath = cmdLine.findOption('f');
+	if (NULL == filePath)
+	{
+		help("Trace file must be specified.");
+		return bx::kExitFailure;
+	}
+
+	uint32_t numLoops = 8;
+	const char* loops = cmdLine.findOption('l', "loops");
+	if (NULL != loops)
+	{
+		bx::fromString(&numLoops, loops);
+		numLoops = bx::max<uint32_t>(numLoops, 1);
+	}
+
+	bgfx::FrameTraceHeader header;
+	if (!readHeader(header, filePath) )
+	{
+		help("Failed to read trace file header.");
+		return bx::kExitFailure;
+	}
+
+	if (BGFX_API_VERSION != header.version)
+	{
+		bx::printf("Error:\nTrace was captured with bgfx API version %d, replay is built with %d.\n"
+			, header.version
+			, BGFX_API_VERSION
+			);
+		return bx::kExitFailure;
+	}
+
+	const bool native = cmdLine.hasArg("native");
+
+	if (native
+	&&  0 != header.numResources)
+	{
+		bx::printf("Error:\nCapture began after %d resources were created, trace can be replayed only with noop renderer.\n"
+			, header.numResources
+			);
+		return bx::kExitFailure;
+	}
+
+	const bgfx::RendererType::Enum type = native
+		? header.rendererType
+		: bgfx::RendererType::Noop
+		;
+
+	Replay result;
+	result.reset();
+
+	for (uint32_t loop = 0; loop < numLoops; ++loop)
+	{
+		if (!replay(result, header, filePath, type) )
+		{
+			help("Failed to replay trace. Trace must be captured with the same bgfx build.");
+			return bx::kExitFailure;
+		}
+	}
+
+	bx::printf("%s, %d x %d, %d frames, %d loops\n\n"
+		, bgfx::getRendererName(type)
+		, header.resolution.width
+		, header.resolution.height
+		, result.m_numFrames/numLoops
+		, numLoops
+		);
+
+	bx::printf("%-12s %10s %10s %10s\n"
+		, "phase"
+		, "min ms"
+		, "avg ms"
+		, "max ms"
+		);
+
+	const struct { const char* name; const Timing* timing; } phases[] =
+	{
+		{ "frame",       &result.m_frame      },
+		{ "submit",      &result.m_submit     },
+		{ "wait render", &result.m_waitRender },
+		{ "wait submit", &result.m_waitSubmit },
+	};
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(phases); ++ii)
+	{
+		bx::printf("%-12s %10.3f %10.3f %10.3f\n"
+			, phases[ii].name
+			, phases[ii].timing->minMs()
+			, phases[ii].timing->avgMs()
+			, phases[ii].timing->maxMs()
+			);
+	}
+
+	static const char* s_phaseName[] =
+	{
+		"encoder wait",
+		"free handles",
+		"exec pre",
+		"sort",
+		"submit",
+		"uniforms",
+		"exec post",
+		"tex update",
+		"flip",
+	};
+	BX_STATIC_ASSERT(BX_COUNTOF(s_phaseName) == bgfx::Phase::Count);
+
+	bx::printf("\n%-12s %10s %10s %10s\n"
+		, "stats phase"
+		, "min ms"
+		, "avg ms"
+		, "max ms"
+		);
+
+	for (uint32_t ii = 0; ii < bgfx::Phase::Count; ++ii)
+	{
+		bx::printf("%-12s %10.3f %10.3f %10.3f\n"
+			, s_phaseName[ii]
+			, result.m_phase[ii].minMs()
+			, result.m_phase[ii].avgMs()
+			, result.m_phase[ii].maxMs()
+			);
+	}
+
+	return bx::kExitSuccess;
+}
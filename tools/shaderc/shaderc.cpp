@@ -197,6 +197,7 @@ namespace bgfx
 		, backwardsCompatibility(false)
 		, warningsAreErrors(false)
 		, keepIntermediate(false)
+		, uniformBlocks(false)
 		, optimize(false)
 		, optimizationLevel(3)
 	{
@@ -222,6 +223,7 @@ namespace bgfx
 			"\t  backwardsCompatibility: %s\n"
 			"\t  warningsAreErrors: %s\n"
 			"\t  keepIntermediate: %s\n"
+			"\t  uniformBlocks: %s\n"
 			"\t  optimize: %s\n"
 			"\t  optimizationLevel: %d\n"
 
@@ -242,6 +244,7 @@ namespace bgfx
 			, backwardsCompatibility ? "true" : "false"
 			, warningsAreErrors ? "true" : "false"
 			, keepIntermediate ? "true" : "false"
+			, uniformBlocks ? "true" : "false"
 			, optimize ? "true" : "false"
 			, optimizationLevel
 			);
@@ -916,6 +919,13 @@ namespace bgfx
 			  "  -O <level>                    Optimization level (0, 1, 2, 3).\n"
 			  "      --Werror                  Treat warnings as errors.\n"
 
+			  "\n"
+			  "Options (GLSL 140 and up only):\n"
+
+			  "\n"
+			  "      --uniform-blocks          Pack vec4, mat3 and mat4 uniforms into std140 uniform block.\n"
+			  "                                Requires renderer built with BGFX_CONFIG_RENDERER_OPENGL >= 31.\n"
+
 			  "\n"
 			  "For additional information, see https://github.com/bkaradzic/bgfx\n"
 			);
@@ -2388,6 +2398,7 @@ namespace bgfx
 			options.backwardsCompatibility = cmdLine.hasArg('\0', "backwards-compatibility");
 			options.warningsAreErrors      = cmdLine.hasArg('\0', "Werror");
 			options.keepIntermediate       = cmdLine.hasArg('\0', "keep-intermediate");
+			options.uniformBlocks          = cmdLine.hasArg('\0', "uniform-blocks");
 
 			uint32_t optimization = 3;
 			if (cmdLine.hasArg(optimization, 'O') )
@@ -8,6 +8,16 @@
 
 namespace bgfx { namespace glsl
 {
+	struct BlockUniform
+	{
+		const char*    begin;
+		const char*    end;
+		bx::StringView decl;
+		bx::StringView name;
+	};
+
+	typedef std::vector<BlockUniform> BlockUniformArray;
+
 	static bool compile(const Options& _options, uint32_t _version, const std::string& _code, bx::WriterI* _writer)
 	{
 		char ch = _options.shaderType;
@@ -102,6 +112,21 @@ namespace bgfx { namespace glsl
 
 		UniformArray uniforms;
 
+		// With --uniform-blocks, for GLSL 1.40+ vec4/mat3/mat4 uniforms are packed
+		// into std140 uniform block, so renderer can set all of them with one
+		// buffer range bind. Samplers stay in default uniform block. Renderer
+		// built with BGFX_CONFIG_RENDERER_OPENGL < 31 can't load such shaders.
+		uint32_t glsl = 0;
+		bx::fromString(&glsl, _options.profile.c_str() );
+
+		const bool packUniforms = true
+			&& _options.uniformBlocks
+			&& kGlslTargetOpenGL == target
+			&& 140 <= glsl
+			;
+
+		BlockUniformArray blockUniforms;
+
 		if (target != kGlslTargetMetal)
 		{
 			bx::StringView parse(optimizedShader);
@@ -112,6 +137,7 @@ namespace bgfx { namespace glsl
 				bx::StringView eol = bx::strFind(parse, ';');
 				if (!eol.isEmpty() )
 				{
+					const char* begin = parse.getPtr();
 					bx::StringView qualifier = nextWord(parse);
 
 					if (0 == bx::strCmp(qualifier, "attribute", 9)
@@ -189,6 +215,17 @@ namespace bgfx { namespace glsl
 						un.regIndex = 0;
 						un.regCount = num;
 						uniforms.push_back(un);
+
+						if (packUniforms
+						&&  (UniformType::Vec4 == un.type || UniformType::Mat3 == un.type || UniformType::Mat4 == un.type) )
+						{
+							BlockUniform bu;
+							bu.begin = begin;
+							bu.end   = eol.getPtr() + 1;
+							bu.decl  = bx::StringView(typen.getPtr(), eol.getPtr() );
+							bu.name  = name;
+							blockUniforms.push_back(bu);
+						}
 					}
 
 					parse = bx::strLTrimSpace(bx::strFindNl(bx::StringView(eol.getPtr(), parse.getTerm() ) ) );
@@ -338,16 +375,63 @@ namespace bgfx { namespace glsl
 				);
 		}
 
-		uint32_t shaderSize = (uint32_t)bx::strLen(optimizedShader);
+		std::string code;
+
+		if (blockUniforms.empty() )
+		{
+			code = optimizedShader;
+		}
+		else
+		{
+			// Block is declared where the first packed uniform was, and members
+			// are accessed through instance name. Vertex and fragment blocks
+			// have different names, so the same uniform used in both stages
+			// doesn't clash when program is linked.
+			const bool fragment = 'f' == _options.shaderType;
+			const char* blockName    = fragment ? "bgfx_FragmentUniforms" : "bgfx_VertexUniforms";
+			const char* instanceName = fragment ? "bgfx_fs"               : "bgfx_vs";
+
+			code.append(optimizedShader, blockUniforms[0].begin);
+
+			bx::stringPrintf(code, "layout(std140) uniform %s\n{\n", blockName);
+
+			for (BlockUniformArray::const_iterator it = blockUniforms.begin(); it != blockUniforms.end(); ++it)
+			{
+				bx::stringPrintf(code, "\t%.*s;\n", it->decl.getLength(), it->decl.getPtr() );
+			}
+
+			bx::stringPrintf(code, "} %s;\n", instanceName);
+
+			for (BlockUniformArray::const_iterator it = blockUniforms.begin(); it != blockUniforms.end(); ++it)
+			{
+				bx::stringPrintf(code, "#define %.*s %s.%.*s\n"
+					, it->name.getLength()
+					, it->name.getPtr()
+					, instanceName
+					, it->name.getLength()
+					, it->name.getPtr()
+					);
+			}
+
+			const char* term = optimizedShader + bx::strLen(optimizedShader);
+
+			for (uint32_t ii = 0, num = uint32_t(blockUniforms.size() ); ii < num; ++ii)
+			{
+				const char* next = ii+1 < num ? blockUniforms[ii+1].begin : term;
+				code.append(blockUniforms[ii].end, next);
+			}
+		}
+
+		uint32_t shaderSize = (uint32_t)code.size();
 		bx::write(_writer, shaderSize);
-		bx::write(_writer, optimizedShader, shaderSize);
+		bx::write(_writer, code.c_str(), shaderSize);
 		uint8_t nul = 0;
 		bx::write(_writer, nul);
 
 		if (_options.disasm )
 		{
 			std::string disasmfp = _options.outputFilePath + ".disasm";
-			writeFile(disasmfp.c_str(), optimizedShader, shaderSize);
+			writeFile(disasmfp.c_str(), code.c_str(), shaderSize);
 		}
 
 		glslopt_shader_delete(shader);